@@ -0,0 +1,162 @@
+#include "AssetPack.h"
+
+// NOTE: Own stb_image implementation so the baker does not pull Core's GL texture code
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct BakedAsset
+{
+  public:
+	AssetPackEntry Entry;
+	std::vector<unsigned char> Data;
+};
+
+static bool EndsWith(const std::string &Value, const std::string &Suffix)
+{
+	return Value.size() >= Suffix.size() && Value.compare(Value.size() - Suffix.size(), Suffix.size(), Suffix) == 0;
+}
+
+static bool ReadFile(const std::string &FilePath, std::vector<unsigned char> &Bytes)
+{
+	FILE *File = std::fopen(FilePath.c_str(), "rb");
+	if (!File)
+		return false;
+
+	std::fseek(File, 0, SEEK_END);
+	const long FILE_SIZE = std::ftell(File);
+	std::fseek(File, 0, SEEK_SET);
+	if (FILE_SIZE <= 0)
+	{
+		std::fclose(File);
+		return false;
+	}
+
+	Bytes.resize(static_cast<size_t>(FILE_SIZE));
+	const size_t READ_SIZE = std::fread(Bytes.data(), 1, Bytes.size(), File);
+	std::fclose(File);
+
+	return READ_SIZE == Bytes.size();
+}
+
+static bool Bake(const std::string &Name, const std::string &FilePath, BakedAsset &Asset)
+{
+	if (Name.empty() || Name.size() >= ASSET_PACK_NAME_SIZE)
+	{
+		std::fprintf(stderr, "Invalid asset name: %s\n", Name.c_str());
+		return false;
+	}
+	std::memcpy(Asset.Entry.Name, Name.data(), Name.size());
+
+	std::vector<unsigned char> FileBytes;
+	if (!ReadFile(FilePath, FileBytes))
+	{
+		std::fprintf(stderr, "Failed to read asset: %s\n", FilePath.c_str());
+		return false;
+	}
+
+	// Fonts are stored as is, ImGui rasterizes their glyphs on demand
+	if (EndsWith(FilePath, ".ttf") || EndsWith(FilePath, ".otf") || EndsWith(FilePath, ".ttc"))
+	{
+		Asset.Entry.Type = AssetType::Font;
+		Asset.Data = std::move(FileBytes);
+		return true;
+	}
+
+	// Images are decoded with their own channels count so the upload matches Texture::Load
+	int Width = 0;
+	int Height = 0;
+	int ChannelsCount = 0;
+	unsigned char *ImageRawData = stbi_load_from_memory(FileBytes.data(), static_cast<int>(FileBytes.size()), &Width,
+	                                                    &Height, &ChannelsCount, 0);
+	if (!ImageRawData)
+	{
+		std::fprintf(stderr, "Failed to decode image: %s\n", FilePath.c_str());
+		return false;
+	}
+
+	Asset.Entry.Type = AssetType::Image;
+	Asset.Entry.Width = static_cast<uint32_t>(Width);
+	Asset.Entry.Height = static_cast<uint32_t>(Height);
+	Asset.Entry.ChannelsCount = static_cast<uint32_t>(ChannelsCount);
+	Asset.Data.assign(ImageRawData, ImageRawData + static_cast<size_t>(Width) * Height * ChannelsCount);
+	stbi_image_free(ImageRawData);
+
+	return true;
+}
+
+// NOTE: Usage is AssetBaker <OutputFilePath> <Name>=<FilePath>...
+int main(int ArgumentsCount, char **Arguments)
+{
+	if (ArgumentsCount < 3)
+	{
+		std::fprintf(stderr, "Usage: %s <OutputFilePath> <Name>=<FilePath>...\n", Arguments[0]);
+		return 1;
+	}
+
+	std::vector<BakedAsset> Assets;
+	for (int i = 2; i < ArgumentsCount; i++)
+	{
+		const std::string ARGUMENT = Arguments[i];
+		const size_t SEPARATOR_POSITION = ARGUMENT.find('=');
+		if (SEPARATOR_POSITION == std::string::npos)
+		{
+			std::fprintf(stderr, "Expected <Name>=<FilePath>: %s\n", ARGUMENT.c_str());
+			return 1;
+		}
+
+		BakedAsset Asset = {};
+		if (!Bake(ARGUMENT.substr(0, SEPARATOR_POSITION), ARGUMENT.substr(SEPARATOR_POSITION + 1), Asset))
+			return 1;
+		Assets.push_back(std::move(Asset));
+	}
+
+	// Lays out asset data after the entries table
+	AssetPackHeader Header = {};
+	Header.EntriesCount = static_cast<uint32_t>(Assets.size());
+
+	uint64_t Offset = sizeof(AssetPackHeader) + Assets.size() * sizeof(AssetPackEntry);
+	for (BakedAsset &Asset : Assets)
+	{
+		Offset = (Offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+		Asset.Entry.Offset = Offset;
+		Asset.Entry.Size = Asset.Data.size();
+		Offset += Asset.Entry.Size;
+	}
+
+	// Writes pack
+	FILE *File = std::fopen(Arguments[1], "wb");
+	if (!File)
+	{
+		std::fprintf(stderr, "Failed to open output: %s\n", Arguments[1]);
+		return 1;
+	}
+
+	bool IsWritten = std::fwrite(&Header, sizeof(Header), 1, File) == 1;
+	for (const BakedAsset &Asset : Assets)
+	{
+		IsWritten = IsWritten && std::fwrite(&Asset.Entry, sizeof(AssetPackEntry), 1, File) == 1;
+	}
+
+	const unsigned char PADDING[ASSET_PACK_ALIGNMENT] = {};
+	for (const BakedAsset &Asset : Assets)
+	{
+		const long POSITION = std::ftell(File);
+		const size_t PADDING_SIZE = static_cast<size_t>(Asset.Entry.Offset) - static_cast<size_t>(POSITION);
+		IsWritten = IsWritten && std::fwrite(PADDING, 1, PADDING_SIZE, File) == PADDING_SIZE;
+		IsWritten = IsWritten && std::fwrite(Asset.Data.data(), 1, Asset.Data.size(), File) == Asset.Data.size();
+	}
+
+	if (std::fclose(File) != 0 || !IsWritten)
+	{
+		std::fprintf(stderr, "Failed to write output: %s\n", Arguments[1]);
+		std::remove(Arguments[1]);
+		return 1;
+	}
+
+	return 0;
+}
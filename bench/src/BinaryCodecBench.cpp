@@ -0,0 +1,110 @@
+#include "AllocationCounter.h"
+#include "ModelSchemas.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+constexpr int BINARY_CODEC_BENCH_DEFAULT_ITERATIONS_COUNT = 1000000;
+
+struct CodecStats
+{
+    double NanosecondsPerOperation = 0.0;
+    double AllocationsPerOperation = 0.0;
+};
+
+// NOTE: Sizes of a typical chat message, short ids and a sentence of text
+Message MakeMessage()
+{
+    Message BenchMessage = {};
+    BenchMessage.ID = "0f8fad5b-d9cb-469f-a165-70867728950e";
+    BenchMessage.ConversationID = "7c9e6679-7425-40de-944b-e07fc1f90ae7";
+    BenchMessage.SenderID = "6ba7b810-9dad-11d1-80b4-00c04fd430c8";
+    BenchMessage.SenderFirstName = "Olivier";
+    BenchMessage.SenderImageUrl = "https://cdn.example.com/avatars/6ba7b810.png";
+    BenchMessage.Text = "Are we still on for the design review tomorrow at ten?";
+    BenchMessage.CreatedAt = 1700000000;
+    BenchMessage.Nonce = 0x1234567800000001ull;
+    BenchMessage.Sequence = 42;
+    return BenchMessage;
+}
+
+// NOTE: Keeps the compiler from dropping work whose result is otherwise unused
+volatile size_t BenchSink = 0;
+
+template <typename Operation> CodecStats Measure(int IterationsCount, Operation&& Run)
+{
+    // Warms up caches and grows reused buffers to their steady-state size
+    for (int i = 0; i < 1000; i++)
+    {
+        Run();
+    }
+
+    const uint64_t START_ALLOCATION_COUNT = GetHeapAllocationCount();
+    const auto START_TIME = std::chrono::steady_clock::now();
+    for (int i = 0; i < IterationsCount; i++)
+    {
+        Run();
+    }
+    const std::chrono::duration<double, std::nano> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+    const uint64_t ALLOCATION_COUNT = GetHeapAllocationCount() - START_ALLOCATION_COUNT;
+
+    CodecStats Stats = {};
+    Stats.NanosecondsPerOperation = ELAPSED_TIME.count() / IterationsCount;
+    Stats.AllocationsPerOperation = static_cast<double>(ALLOCATION_COUNT) / IterationsCount;
+    return Stats;
+}
+
+// Usage: BinaryCodecBench [--iterations N]
+int main(int ArgumentsCount, char** Arguments)
+{
+    int IterationsCount = BINARY_CODEC_BENCH_DEFAULT_ITERATIONS_COUNT;
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--iterations") == 0 && i + 1 < ArgumentsCount)
+        {
+            IterationsCount = std::max(1, std::atoi(Arguments[++i]));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--iterations N]\n", Arguments[0]);
+        return 1;
+    }
+
+    const Message BENCH_MESSAGE = MakeMessage();
+    std::string Buffer;
+    EncodeBinary(BENCH_MESSAGE, Buffer);
+    const std::string ENCODED_MESSAGE = Buffer;
+
+    const CodecStats ENCODE_STATS = Measure(IterationsCount, [&Buffer, &BENCH_MESSAGE]() {
+        Buffer.clear();
+        EncodeBinary(BENCH_MESSAGE, Buffer);
+        BenchSink = BenchSink + Buffer.size();
+    });
+
+    // NOTE: Validates the record and reads every field the way the messages view does
+    const CodecStats VIEW_STATS = Measure(IterationsCount, [&ENCODED_MESSAGE]() {
+        const BinaryView<Message> VIEW(ENCODED_MESSAGE);
+        BenchSink = BenchSink + VIEW.Get<&Message::SenderFirstName>().size() + VIEW.Get<&Message::Text>().size() +
+                    VIEW.Get<&Message::SenderImageUrl>().size() + static_cast<size_t>(VIEW.Get<&Message::CreatedAt>());
+    });
+
+    // NOTE: Decodes into the same message every time so string capacity is reused, as a receive loop would
+    Message DecodedMessage = {};
+    const CodecStats DECODE_STATS = Measure(IterationsCount, [&ENCODED_MESSAGE, &DecodedMessage]() {
+        DecodeBinary(BinaryView<Message>(ENCODED_MESSAGE), DecodedMessage);
+        BenchSink = BenchSink + DecodedMessage.Text.size();
+    });
+
+    std::printf("Message record: %zu bytes, %d iterations\n", ENCODED_MESSAGE.size(), IterationsCount);
+    std::printf("%16s %12s %12s\n", "Operation", "ns/op", "allocs/op");
+    std::printf("%16s %12.1f %12.3f\n", "Encode", ENCODE_STATS.NanosecondsPerOperation, ENCODE_STATS.AllocationsPerOperation);
+    std::printf("%16s %12.1f %12.3f\n", "View", VIEW_STATS.NanosecondsPerOperation, VIEW_STATS.AllocationsPerOperation);
+    std::printf("%16s %12.1f %12.3f\n", "Decode", DECODE_STATS.NanosecondsPerOperation, DECODE_STATS.AllocationsPerOperation);
+
+    return 0;
+}
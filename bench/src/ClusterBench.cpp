@@ -0,0 +1,91 @@
+#include "ClusterNode.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+constexpr size_t CLUSTER_BENCH_DEFAULT_MESSAGES_COUNT = 200000;
+constexpr size_t CLUSTER_BENCH_NODES_COUNT = 4;
+
+// NOTE: One publishing node and the others subscribed, PublishesPerUpdate messages are published between two updates
+// so 1 sends a frame per message and node while larger values batch them
+double Measure(size_t MessagesCount, size_t PublishesPerUpdate)
+{
+    std::vector<std::unique_ptr<ClusterNode>> Nodes;
+    for (size_t i = 0; i < CLUSTER_BENCH_NODES_COUNT; i++)
+    {
+        Nodes.push_back(std::make_unique<ClusterNode>("Node" + std::to_string(i)));
+        if (!Nodes.back()->Listen(0)) return 0.0;
+    }
+    for (std::unique_ptr<ClusterNode>& Node : Nodes)
+    {
+        for (std::unique_ptr<ClusterNode>& Peer : Nodes) Node->AddPeer(ClusterPeer{Peer->GetNodeID(), "127.0.0.1", Peer->GetPort()});
+    }
+
+    size_t ReceivedCount = 0;
+    for (size_t i = 1; i < Nodes.size(); i++)
+    {
+        Nodes[i]->SetOnMessage([&ReceivedCount](const Message& ForwardedMessage, const std::string& FromNodeID) { ReceivedCount++; });
+        Nodes[i]->Subscribe("Conversation1");
+    }
+    auto UpdateAll = [&Nodes]() {
+        for (std::unique_ptr<ClusterNode>& Node : Nodes) Node->Update(0);
+    };
+    while (true)
+    {
+        bool IsReady = true;
+        for (size_t i = 1; i < Nodes.size(); i++) IsReady = IsReady && Nodes[0]->HasRemoteSubscriber(Nodes[i]->GetNodeID(), "Conversation1");
+        if (IsReady) break;
+        UpdateAll();
+    }
+
+    Message NewMessage = {};
+    NewMessage.ID = "Message";
+    NewMessage.ConversationID = "Conversation1";
+    NewMessage.SenderID = "User1";
+    NewMessage.Text = "A typical chat message of a few dozen bytes";
+
+    const size_t EXPECTED_COUNT = MessagesCount * (Nodes.size() - 1);
+    const auto START_TIME = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < MessagesCount; i++)
+    {
+        NewMessage.Sequence = i + 1;
+        Nodes[0]->Publish(NewMessage);
+        if ((i + 1) % PublishesPerUpdate == 0) UpdateAll();
+    }
+    while (ReceivedCount < EXPECTED_COUNT) UpdateAll();
+
+    const std::chrono::duration<double> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+    return MessagesCount / ELAPSED_TIME.count();
+}
+
+// Usage: ClusterBench [--messages N]
+int main(int ArgumentsCount, char** Arguments)
+{
+    size_t MessagesCount = CLUSTER_BENCH_DEFAULT_MESSAGES_COUNT;
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--messages") == 0 && i + 1 < ArgumentsCount)
+        {
+            MessagesCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--messages N]\n", Arguments[0]);
+        return 1;
+    }
+
+    std::printf("%zu messages published on one node, forwarded to %zu nodes over loopback\n", MessagesCount, CLUSTER_BENCH_NODES_COUNT - 1);
+    std::printf("%20s %14s\n", "Publishes/update", "msg/s");
+    for (const size_t PUBLISHES_PER_UPDATE : {1, 16, 256})
+    {
+        std::printf("%20zu %14.0f\n", PUBLISHES_PER_UPDATE, Measure(MessagesCount, PUBLISHES_PER_UPDATE));
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "MessageFilter.h"
+
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr size_t FILTER_BENCH_DEFAULT_MESSAGES_COUNT = 500000;
+constexpr size_t FILTER_BENCH_DEFAULT_CONVERSATIONS_COUNT = 200;
+constexpr size_t FILTER_BENCH_WORDS_PER_MESSAGE = 12;
+constexpr const char* FILTER_BENCH_WORDS[] = {
+    "Hello", "meeting", "tomorrow", "lunch", "project", "deadline", "Thanks", "review", "weekend", "call",
+    "coffee", "update", "release", "Monday", "budget", "design", "ticket", "merge", "travel", "dinner",
+};
+// NOTE: Typed one character at a time, every keystroke extends the previous query
+constexpr const char* FILTER_BENCH_TYPED_QUERY = "tomorrow lunch";
+
+double GetElapsedMilliseconds(std::chrono::steady_clock::time_point StartTime)
+{
+    const std::chrono::duration<double, std::milli> ELAPSED_TIME = std::chrono::steady_clock::now() - StartTime;
+    return ELAPSED_TIME.count();
+}
+
+// Usage: FilterBench [--messages N] [--conversations N]
+int main(int ArgumentsCount, char** Arguments)
+{
+    size_t MessagesCount = FILTER_BENCH_DEFAULT_MESSAGES_COUNT;
+    size_t ConversationsCount = FILTER_BENCH_DEFAULT_CONVERSATIONS_COUNT;
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--messages") == 0 && i + 1 < ArgumentsCount)
+        {
+            MessagesCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+        if (std::strcmp(Arguments[i], "--conversations") == 0 && i + 1 < ArgumentsCount)
+        {
+            ConversationsCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--messages N] [--conversations N]\n", Arguments[0]);
+        return 1;
+    }
+
+    std::mt19937 Random(42);
+    std::vector<Conversation> Conversations(ConversationsCount);
+    for (size_t i = 0; i < ConversationsCount; i++)
+    {
+        Conversations[i].ID = "Conversation" + std::to_string(i);
+    }
+    for (size_t i = 0; i < MessagesCount; i++)
+    {
+        Message BenchMessage = {};
+        for (size_t j = 0; j < FILTER_BENCH_WORDS_PER_MESSAGE; j++)
+        {
+            BenchMessage.Text += FILTER_BENCH_WORDS[Random() % std::size(FILTER_BENCH_WORDS)];
+            BenchMessage.Text += " ";
+        }
+        Conversations[i % ConversationsCount].Messages.push_back(std::move(BenchMessage));
+    }
+
+    MessageFilter Filter;
+    const auto INDEX_START_TIME = std::chrono::steady_clock::now();
+    for (const Conversation& BenchConversation : Conversations)
+    {
+        Filter.UpdateConversation(BenchConversation);
+    }
+    std::printf("Indexed %zu messages in %zu conversations in %.1f ms\n", Filter.GetMessagesCount(), ConversationsCount, GetElapsedMilliseconds(INDEX_START_TIME));
+
+    // NOTE: SetQuery is what the render thread pays per keystroke, the scan is the time until the result can be shown
+    std::printf("%-16s %14s %10s %10s\n", "Query", "SetQuery ms", "Scan ms", "Matches");
+    MessageFilterResult Result;
+    const std::string TYPED_QUERY = FILTER_BENCH_TYPED_QUERY;
+    for (size_t Size = 1; Size <= TYPED_QUERY.size(); Size++)
+    {
+        const auto START_TIME = std::chrono::steady_clock::now();
+        Filter.SetQuery(TYPED_QUERY.substr(0, Size));
+        const double SET_QUERY_TIME = GetElapsedMilliseconds(START_TIME);
+        while (!Filter.Poll(Result)) std::this_thread::yield();
+        const double SCAN_TIME = GetElapsedMilliseconds(START_TIME);
+
+        size_t MatchesCount = 0;
+        for (const auto& [ID, Match] : Result.MatchesByConversationID) MatchesCount += Match.MessageIndices.size();
+        std::printf("%-16s %14.3f %10.3f %10zu\n", ("\"" + Result.Query + "\"").c_str(), SET_QUERY_TIME, SCAN_TIME, MatchesCount);
+    }
+
+    // Appending a message only rebuilds the last chunk of its conversation
+    Message Appended = {};
+    Appended.Text = "See you tomorrow at lunch";
+    Conversations[0].Messages.push_back(Appended);
+    const auto APPEND_START_TIME = std::chrono::steady_clock::now();
+    Filter.UpdateConversation(Conversations[0]);
+    std::printf("Appended a message in %.3f ms\n", GetElapsedMilliseconds(APPEND_START_TIME));
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include "AllocationCounter.h"
+#include "Conversation.h"
+#include "Gui.h"
+#include "MessagesView.h"
+#include "Theme.h"
+
+#include <imgui/imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+constexpr int GUI_FRAME_BENCH_DEFAULT_FRAMES_COUNT = 120;
+constexpr int GUI_FRAME_BENCH_WARMUP_FRAMES_COUNT = 10;
+constexpr size_t GUI_FRAME_BENCH_DEFAULT_MESSAGES_COUNTS[] = { 10, 100, 1000, 10000, 100000 };
+const Vector2 GUI_FRAME_BENCH_DISPLAY_SIZE = Vector2(1280.0f, 720.0f);
+
+struct FrameStats
+{
+    double MillisecondsPerFrame = 0.0;
+    double AllocationsPerFrame = 0.0;
+    int VerticesCount = 0;
+    int IndicesCount = 0;
+    int DrawListsCount = 0;
+};
+
+// NOTE: Deterministic so runs can be compared, text lengths vary to exercise wrapping
+Conversation MakeConversation(size_t MessagesCount)
+{
+    static const char* WORDS[] = { "hello", "how", "are", "you", "doing", "today", "the", "build", "is", "green", "again", "ship", "it" };
+    constexpr size_t WORDS_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+    Conversation SyntheticConversation = {};
+    SyntheticConversation.ID = "BenchConversation";
+    SyntheticConversation.Messages.reserve(MessagesCount);
+
+    for (size_t i = 0; i < MessagesCount; i++)
+    {
+        Message SyntheticMessage = {};
+        SyntheticMessage.ID = std::to_string(i);
+        SyntheticMessage.ConversationID = SyntheticConversation.ID;
+        SyntheticMessage.SenderID = std::to_string(i % 7);
+        SyntheticMessage.SenderFirstName = "User" + SyntheticMessage.SenderID;
+        SyntheticMessage.SenderImageUrl = "avatar" + SyntheticMessage.SenderID;
+        SyntheticMessage.CreatedAt = static_cast<std::time_t>(1700000000 + i * 60);
+
+        const size_t WORDS_PER_MESSAGE = 3 + (i * 7) % 40;
+        for (size_t j = 0; j < WORDS_PER_MESSAGE; j++)
+        {
+            if (j > 0) SyntheticMessage.Text += ' ';
+            SyntheticMessage.Text += WORDS[(i + j) % WORDS_COUNT];
+        }
+
+        SyntheticConversation.Messages.push_back(std::move(SyntheticMessage));
+    }
+
+    return SyntheticConversation;
+}
+
+void DrawFrame(const Gui& BenchGui, const Conversation& SelectedConversation)
+{
+    BenchGui.Clear();
+
+    Window MainWindow = {};
+    MainWindow.Name = "MainWindow";
+    MainWindow.Size = GUI_FRAME_BENCH_DISPLAY_SIZE;
+    MainWindow.Style = &THEME_WINDOW_STYLE;
+    MainWindow.DrawContent = [&BenchGui, &SelectedConversation]() {
+        Container MessagesContainer = {};
+        MessagesContainer.ID = "MessagesContainer";
+        MessagesContainer.Size = BenchGui.GetAvailableSpace();
+        MessagesContainer.Style = &THEME_SECTION_STYLE;
+        MessagesContainer.DrawContent = [&BenchGui, &SelectedConversation](const ContainerState& State) {
+            // NOTE: Every sender shares the same fake texture, the cost measured is the one of building the frame
+            DrawMessages(BenchGui, SelectedConversation, [](const std::string& ImageUrl) {
+                return TextureRegion(1);
+            });
+        };
+        BenchGui.DrawContainer(MessagesContainer);
+    };
+    BenchGui.DrawWindow(MainWindow);
+
+    BenchGui.Render();
+}
+
+FrameStats RunBenchmark(const Gui& BenchGui, size_t MessagesCount, int FramesCount)
+{
+    const Conversation SELECTED_CONVERSATION = MakeConversation(MessagesCount);
+
+    // Warms up font atlas, window state and arena capacity so only steady-state frames are timed
+    for (int i = 0; i < GUI_FRAME_BENCH_WARMUP_FRAMES_COUNT; i++)
+    {
+        DrawFrame(BenchGui, SELECTED_CONVERSATION);
+    }
+
+    const uint64_t START_ALLOCATION_COUNT = GetHeapAllocationCount();
+    const auto START_TIME = std::chrono::steady_clock::now();
+    for (int i = 0; i < FramesCount; i++)
+    {
+        DrawFrame(BenchGui, SELECTED_CONVERSATION);
+    }
+    const std::chrono::duration<double, std::milli> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+    const uint64_t ALLOCATION_COUNT = GetHeapAllocationCount() - START_ALLOCATION_COUNT;
+
+    FrameStats Stats = {};
+    Stats.MillisecondsPerFrame = ELAPSED_TIME.count() / FramesCount;
+    Stats.AllocationsPerFrame = static_cast<double>(ALLOCATION_COUNT) / FramesCount;
+
+    // NOTE: Draw data of the last frame stays valid until the next NewFrame
+    const ImDrawData* DRAW_DATA = ImGui::GetDrawData();
+    if (DRAW_DATA)
+    {
+        Stats.VerticesCount = DRAW_DATA->TotalVtxCount;
+        Stats.IndicesCount = DRAW_DATA->TotalIdxCount;
+        Stats.DrawListsCount = DRAW_DATA->CmdListsCount;
+    }
+
+    return Stats;
+}
+
+// Usage: GuiFrameBench [--frames N] [MessagesCount...]
+int main(int ArgumentsCount, char** Arguments)
+{
+    int FramesCount = GUI_FRAME_BENCH_DEFAULT_FRAMES_COUNT;
+    std::vector<size_t> MessagesCounts;
+
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--frames") == 0 && i + 1 < ArgumentsCount)
+        {
+            FramesCount = std::max(1, std::atoi(Arguments[++i]));
+            continue;
+        }
+
+        const long long MESSAGES_COUNT = std::atoll(Arguments[i]);
+        if (MESSAGES_COUNT <= 0)
+        {
+            std::fprintf(stderr, "Usage: %s [--frames N] [MessagesCount...]\n", Arguments[0]);
+            return 1;
+        }
+        MessagesCounts.push_back(static_cast<size_t>(MESSAGES_COUNT));
+    }
+
+    if (MessagesCounts.empty())
+    {
+        MessagesCounts.assign(std::begin(GUI_FRAME_BENCH_DEFAULT_MESSAGES_COUNTS), std::end(GUI_FRAME_BENCH_DEFAULT_MESSAGES_COUNTS));
+    }
+
+    Gui BenchGui = {};
+    BenchGui.InitHeadless(GUI_FRAME_BENCH_DISPLAY_SIZE);
+
+    std::printf("%10s %12s %14s %12s %12s %10s\n", "Messages", "ms/frame", "allocs/frame", "vertices", "indices", "drawlists");
+    for (const size_t MESSAGES_COUNT : MessagesCounts)
+    {
+        const FrameStats STATS = RunBenchmark(BenchGui, MESSAGES_COUNT, FramesCount);
+        std::printf("%10zu %12.3f %14.1f %12d %12d %10d\n", MESSAGES_COUNT, STATS.MillisecondsPerFrame,
+                    STATS.AllocationsPerFrame, STATS.VerticesCount, STATS.IndicesCount, STATS.DrawListsCount);
+    }
+
+    BenchGui.Destroy();
+
+    return 0;
+}
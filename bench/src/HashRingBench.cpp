@@ -0,0 +1,94 @@
+#include "ConsistentHashRing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+constexpr size_t HASH_RING_BENCH_DEFAULT_CONVERSATIONS_COUNT = 200000;
+constexpr size_t HASH_RING_BENCH_DEFAULT_NODES_COUNT = 8;
+
+std::string GetNodeID(size_t Index)
+{
+    return "Node" + std::to_string(Index);
+}
+
+// NOTE: Busiest node over the average one, 1.0 is a perfect spread
+double GetImbalance(const std::vector<std::string>& Owners, size_t NodesCount)
+{
+    std::unordered_map<std::string, size_t> CountsByNodeID;
+    for (const std::string& Owner : Owners) CountsByNodeID[Owner]++;
+
+    size_t MaxCount = 0;
+    for (const auto& [NodeID, Count] : CountsByNodeID) MaxCount = std::max(MaxCount, Count);
+    return MaxCount / (static_cast<double>(Owners.size()) / NodesCount);
+}
+
+// Usage: HashRingBench [--conversations N] [--nodes N]
+int main(int ArgumentsCount, char** Arguments)
+{
+    size_t ConversationsCount = HASH_RING_BENCH_DEFAULT_CONVERSATIONS_COUNT;
+    size_t NodesCount = HASH_RING_BENCH_DEFAULT_NODES_COUNT;
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--conversations") == 0 && i + 1 < ArgumentsCount)
+        {
+            ConversationsCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+        if (std::strcmp(Arguments[i], "--nodes") == 0 && i + 1 < ArgumentsCount)
+        {
+            NodesCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--conversations N] [--nodes N]\n", Arguments[0]);
+        return 1;
+    }
+
+    std::vector<std::string> ConversationIDs;
+    for (size_t i = 0; i < ConversationsCount; i++) ConversationIDs.push_back("Conversation" + std::to_string(i));
+
+    std::printf("%zu conversations over %zu nodes, then one more node joins\n", ConversationsCount, NodesCount);
+    std::printf("%-22s %10s %10s %12s\n", "", "Imbalance", "Moved %", "Lookup ns");
+
+    // NOTE: Baseline, the owner is the hash modulo the node count so nearly every conversation moves on a join
+    {
+        std::vector<std::string> Owners;
+        size_t MovedCount = 0;
+        for (const std::string& ConversationID : ConversationIDs)
+        {
+            const size_t HASH = std::hash<std::string>()(ConversationID);
+            Owners.push_back(GetNodeID(HASH % NodesCount));
+            MovedCount += HASH % NodesCount != HASH % (NodesCount + 1) ? 1 : 0;
+        }
+        std::printf("%-22s %10.3f %10.1f\n", "Modulo", GetImbalance(Owners, NodesCount), 100.0 * MovedCount / ConversationsCount);
+    }
+
+    for (const size_t VIRTUAL_NODES_COUNT : {1, 10, 40, 160, 640})
+    {
+        ConsistentHashRing Ring(VIRTUAL_NODES_COUNT);
+        for (size_t i = 0; i < NodesCount; i++) Ring.AddNode(GetNodeID(i));
+
+        std::vector<std::string> Owners;
+        Owners.reserve(ConversationsCount);
+        const auto START_TIME = std::chrono::steady_clock::now();
+        for (const std::string& ConversationID : ConversationIDs) Owners.push_back(Ring.GetOwner(ConversationID));
+        const std::chrono::duration<double, std::nano> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+
+        ConsistentHashRing JoinedRing = Ring;
+        JoinedRing.AddNode(GetNodeID(NodesCount));
+        const size_t MOVED_COUNT = Ring.GetMoves(JoinedRing, ConversationIDs).size();
+
+        char Name[32];
+        std::snprintf(Name, sizeof(Name), "Ring, %zu virtual", VIRTUAL_NODES_COUNT);
+        std::printf("%-22s %10.3f %10.1f %12.1f\n", Name, GetImbalance(Owners, NodesCount), 100.0 * MOVED_COUNT / ConversationsCount, ELAPSED_TIME.count() / ConversationsCount);
+    }
+
+    return 0;
+}
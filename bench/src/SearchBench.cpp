@@ -0,0 +1,135 @@
+#include "MessageSearchIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr size_t SEARCH_BENCH_DEFAULT_MESSAGES_COUNT = 10000000;
+constexpr size_t SEARCH_BENCH_DEFAULT_CONVERSATIONS_COUNT = 10;
+constexpr size_t SEARCH_BENCH_VOCABULARY_SIZE = 50000;
+constexpr size_t SEARCH_BENCH_WORDS_PER_MESSAGE = 12;
+constexpr int SEARCH_BENCH_QUERIES_COUNT = 200;
+
+// NOTE: Word ranks follow a Zipf distribution like natural text, so queries mix very common and rare terms
+class ZipfSampler
+{
+  public:
+    explicit ZipfSampler(size_t Size)
+    {
+        m_Cumulative.resize(Size);
+        double Total = 0.0;
+        for (size_t i = 0; i < Size; i++)
+        {
+            Total += 1.0 / static_cast<double>(i + 1);
+            m_Cumulative[i] = Total;
+        }
+        for (double& Value : m_Cumulative) Value /= Total;
+    }
+
+    size_t Sample(std::mt19937& Random) const
+    {
+        const double VALUE = std::uniform_real_distribution<double>(0.0, 1.0)(Random);
+        return static_cast<size_t>(std::lower_bound(m_Cumulative.begin(), m_Cumulative.end(), VALUE) - m_Cumulative.begin());
+    }
+
+  private:
+    std::vector<double> m_Cumulative;
+};
+
+std::string GetWord(size_t Rank)
+{
+    return "w" + std::to_string(Rank);
+}
+
+// NOTE: Returns the p50 and p99 latency in milliseconds of queries made of TermsCount words drawn from the ranks
+void MeasureQueries(const MessageSearchIndex& Index, size_t ConversationsCount, size_t TermsCount, size_t MinRank, size_t MaxRank, std::mt19937& Random)
+{
+    std::vector<double> Latencies;
+    std::vector<std::string> MessageIDs;
+    size_t TotalResultsCount = 0;
+
+    for (int i = 0; i < SEARCH_BENCH_QUERIES_COUNT; i++)
+    {
+        std::string Query;
+        for (size_t j = 0; j < TermsCount; j++)
+        {
+            Query += GetWord(MinRank + Random() % (MaxRank - MinRank)) + " ";
+        }
+        const std::string CONVERSATION_ID = "Conversation" + std::to_string(Random() % ConversationsCount);
+
+        const auto START_TIME = std::chrono::steady_clock::now();
+        Index.Search(CONVERSATION_ID, Query, 50, MessageIDs);
+        const std::chrono::duration<double, std::milli> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+
+        Latencies.push_back(ELAPSED_TIME.count());
+        TotalResultsCount += MessageIDs.size();
+    }
+
+    std::sort(Latencies.begin(), Latencies.end());
+    std::printf("%6zu %10zu-%-8zu %10.3f %10.3f %12.1f\n", TermsCount, MinRank, MaxRank, Latencies[Latencies.size() / 2],
+                Latencies[Latencies.size() * 99 / 100], static_cast<double>(TotalResultsCount) / SEARCH_BENCH_QUERIES_COUNT);
+}
+
+// Usage: SearchBench [--messages N] [--conversations N]
+int main(int ArgumentsCount, char** Arguments)
+{
+    size_t MessagesCount = SEARCH_BENCH_DEFAULT_MESSAGES_COUNT;
+    size_t ConversationsCount = SEARCH_BENCH_DEFAULT_CONVERSATIONS_COUNT;
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--messages") == 0 && i + 1 < ArgumentsCount)
+        {
+            MessagesCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+        if (std::strcmp(Arguments[i], "--conversations") == 0 && i + 1 < ArgumentsCount)
+        {
+            ConversationsCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--messages N] [--conversations N]\n", Arguments[0]);
+        return 1;
+    }
+
+    std::mt19937 Random(42);
+    const ZipfSampler WORDS(SEARCH_BENCH_VOCABULARY_SIZE);
+    MessageSearchIndex Index;
+
+    const auto BUILD_START_TIME = std::chrono::steady_clock::now();
+    Message BenchMessage = {};
+    for (size_t i = 0; i < MessagesCount; i++)
+    {
+        const size_t CONVERSATION = i % ConversationsCount;
+        BenchMessage.ConversationID = "Conversation" + std::to_string(CONVERSATION);
+        BenchMessage.ID = std::to_string(i);
+        BenchMessage.Sequence = i / ConversationsCount + 1;
+        BenchMessage.Text.clear();
+        for (size_t j = 0; j < SEARCH_BENCH_WORDS_PER_MESSAGE; j++)
+        {
+            BenchMessage.Text += GetWord(WORDS.Sample(Random)) + " ";
+        }
+        Index.Add(BenchMessage);
+    }
+    const std::chrono::duration<double> BUILD_TIME = std::chrono::steady_clock::now() - BUILD_START_TIME;
+
+    std::printf("Indexed %zu messages in %zu conversations in %.1f s (%.0f messages/s), postings %.1f MB\n", MessagesCount,
+                ConversationsCount, BUILD_TIME.count(), MessagesCount / BUILD_TIME.count(),
+                static_cast<double>(Index.GetPostingsSizeInBytes()) / (1024.0 * 1024.0));
+
+    std::printf("%6s %19s %10s %10s %12s\n", "Terms", "Word ranks", "p50 ms", "p99 ms", "results");
+    MeasureQueries(Index, ConversationsCount, 1, 0, 10, Random);
+    MeasureQueries(Index, ConversationsCount, 1, 1000, 50000, Random);
+    MeasureQueries(Index, ConversationsCount, 2, 0, 10, Random);
+    MeasureQueries(Index, ConversationsCount, 2, 0, 1000, Random);
+    MeasureQueries(Index, ConversationsCount, 3, 0, 100, Random);
+    MeasureQueries(Index, ConversationsCount, 3, 0, 50000, Random);
+
+    return 0;
+}
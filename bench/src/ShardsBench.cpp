@@ -0,0 +1,142 @@
+#include "ConversationShards.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+constexpr size_t SHARDS_BENCH_DEFAULT_MESSAGES_COUNT = 400000;
+constexpr size_t SHARDS_BENCH_CONVERSATIONS_COUNT = 8;
+constexpr size_t SHARDS_BENCH_MEMBERS_COUNT = 50;
+
+std::string GetConversationID(size_t Index)
+{
+    return "Conversation" + std::to_string(Index);
+}
+
+std::string GetUserID(size_t Index)
+{
+    return "User" + std::to_string(Index);
+}
+
+// NOTE: What reactors would do without shards, every append and fan-out of every conversation under one lock
+double MeasureLocked(size_t ReactorsCount, size_t MessagesCount)
+{
+    std::mutex Mutex;
+    std::unordered_map<std::string, ShardConversationState> Conversations;
+    std::unordered_map<std::string, uint32_t> ReactorsByUserID;
+    for (size_t i = 0; i < SHARDS_BENCH_CONVERSATIONS_COUNT; i++)
+    {
+        ShardConversationState& State = Conversations[GetConversationID(i)];
+        for (size_t j = 0; j < SHARDS_BENCH_MEMBERS_COUNT; j++) State.MemberIDs.push_back(GetUserID(j));
+    }
+    for (size_t j = 0; j < SHARDS_BENCH_MEMBERS_COUNT; j++) ReactorsByUserID[GetUserID(j)] = static_cast<uint32_t>(j % ReactorsCount);
+
+    const auto START_TIME = std::chrono::steady_clock::now();
+    std::vector<std::thread> Reactors;
+    for (size_t Reactor = 0; Reactor < ReactorsCount; Reactor++)
+    {
+        Reactors.emplace_back([&, Reactor]() {
+            std::vector<std::vector<std::string>> Recipients(ReactorsCount);
+            for (size_t i = Reactor; i < MessagesCount; i += ReactorsCount)
+            {
+                Message NewMessage = {};
+                NewMessage.ConversationID = GetConversationID(i % SHARDS_BENCH_CONVERSATIONS_COUNT);
+                NewMessage.SenderID = GetUserID(i % SHARDS_BENCH_MEMBERS_COUNT);
+
+                std::lock_guard<std::mutex> Lock(Mutex);
+                ShardConversationState& State = Conversations[NewMessage.ConversationID];
+                NewMessage.Sequence = ++State.LastSequence;
+                for (const std::string& MemberID : State.MemberIDs)
+                {
+                    if (MemberID != NewMessage.SenderID) Recipients[ReactorsByUserID[MemberID]].push_back(MemberID);
+                }
+                for (std::vector<std::string>& ReactorRecipients : Recipients) ReactorRecipients.clear();
+            }
+        });
+    }
+    for (std::thread& Reactor : Reactors) Reactor.join();
+
+    const std::chrono::duration<double> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+    return MessagesCount / ELAPSED_TIME.count();
+}
+
+double MeasureSharded(size_t ShardsCount, size_t ReactorsCount, size_t MessagesCount)
+{
+    ConversationShards Shards(ShardsCount, ReactorsCount, [](const std::string& ConversationID, ShardConversationState& State) {
+        for (size_t j = 0; j < SHARDS_BENCH_MEMBERS_COUNT; j++) State.MemberIDs.push_back(GetUserID(j));
+        return true;
+    }, [](Message& NewMessage) {
+        return true;
+    });
+    for (size_t j = 0; j < SHARDS_BENCH_MEMBERS_COUNT; j++) Shards.Connect(GetUserID(j), j % ReactorsCount);
+
+    // NOTE: Every append is acknowledged to the reactor it came from, the run ends once each reactor got its own back
+    const auto START_TIME = std::chrono::steady_clock::now();
+    std::vector<std::thread> Reactors;
+    for (size_t Reactor = 0; Reactor < ReactorsCount; Reactor++)
+    {
+        Reactors.emplace_back([&, Reactor]() {
+            size_t SentCount = 0;
+            size_t AcknowledgedCount = 0;
+            ShardDelivery Delivery;
+            for (size_t i = Reactor; i < MessagesCount; i += ReactorsCount)
+            {
+                Message NewMessage = {};
+                NewMessage.ConversationID = GetConversationID(i % SHARDS_BENCH_CONVERSATIONS_COUNT);
+                NewMessage.SenderID = GetUserID(i % SHARDS_BENCH_MEMBERS_COUNT);
+                Shards.Append(std::move(NewMessage), Reactor);
+                SentCount++;
+
+                while (Shards.Poll(Reactor, Delivery)) AcknowledgedCount += Delivery.IsAcknowledgement ? 1 : 0;
+            }
+            while (AcknowledgedCount < SentCount)
+            {
+                if (Shards.Poll(Reactor, Delivery)) AcknowledgedCount += Delivery.IsAcknowledgement ? 1 : 0;
+                else std::this_thread::yield();
+            }
+        });
+    }
+    for (std::thread& Reactor : Reactors) Reactor.join();
+
+    const std::chrono::duration<double> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+    return MessagesCount / ELAPSED_TIME.count();
+}
+
+// Usage: ShardsBench [--messages N]
+int main(int ArgumentsCount, char** Arguments)
+{
+    size_t MessagesCount = SHARDS_BENCH_DEFAULT_MESSAGES_COUNT;
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--messages") == 0 && i + 1 < ArgumentsCount)
+        {
+            MessagesCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--messages N]\n", Arguments[0]);
+        return 1;
+    }
+
+    // NOTE: A few hot group chats, every message fans out to every reactor
+    const size_t CORES_COUNT = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%zu messages over %zu conversations of %zu members, %zu cores\n", MessagesCount, SHARDS_BENCH_CONVERSATIONS_COUNT, SHARDS_BENCH_MEMBERS_COUNT, CORES_COUNT);
+    std::printf("%8s %14s %14s\n", "Threads", "Locked msg/s", "Sharded msg/s");
+    for (size_t ThreadsCount = 1; ThreadsCount <= std::max<size_t>(CORES_COUNT, 2); ThreadsCount *= 2)
+    {
+        // NOTE: Half of the threads are reactors and half are shards for the sharded run
+        const size_t SHARDS_COUNT = std::max<size_t>(ThreadsCount / 2, 1);
+        const size_t REACTORS_COUNT = std::max<size_t>(ThreadsCount - ThreadsCount / 2, 1);
+        std::printf("%8zu %14.0f %14.0f\n", ThreadsCount, MeasureLocked(ThreadsCount, MessagesCount), MeasureSharded(SHARDS_COUNT, REACTORS_COUNT, MessagesCount));
+    }
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+constexpr size_t TASK_SCHEDULER_BENCH_DEFAULT_TASKS_COUNT = 20000;
+// NOTE: Skewed load, most tasks are short and a few are a hundred times longer
+constexpr double TASK_SCHEDULER_BENCH_SHORT_TASK_MICROSECONDS = 5.0;
+constexpr double TASK_SCHEDULER_BENCH_LONG_TASK_MICROSECONDS = 500.0;
+constexpr int TASK_SCHEDULER_BENCH_LONG_TASK_PERCENT = 1;
+constexpr int TASK_SCHEDULER_BENCH_PROBES_COUNT = 200;
+
+using Clock = std::chrono::steady_clock;
+
+void Spin(double Microseconds)
+{
+    const auto END_TIME = Clock::now() + std::chrono::duration<double, std::micro>(Microseconds);
+    while (Clock::now() < END_TIME)
+    {
+    }
+}
+
+double GetElapsedMilliseconds(Clock::time_point StartTime)
+{
+    const std::chrono::duration<double, std::milli> ELAPSED_TIME = Clock::now() - StartTime;
+    return ELAPSED_TIME.count();
+}
+
+// NOTE: Baseline, every worker takes tasks from one locked FIFO queue
+class GlobalQueuePool
+{
+public:
+    explicit GlobalQueuePool(size_t WorkersCount)
+    {
+        for (size_t i = 0; i < WorkersCount; i++) m_Workers.emplace_back(&GlobalQueuePool::RunWorker, this);
+    }
+
+    ~GlobalQueuePool()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            m_IsStopping = true;
+        }
+        m_Condition.notify_all();
+        for (std::thread& Worker : m_Workers) Worker.join();
+    }
+
+    void Submit(std::function<void()> Function)
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            m_Tasks.push_back(std::move(Function));
+            m_PendingCount++;
+        }
+        m_Condition.notify_one();
+    }
+
+    void WaitIdle()
+    {
+        std::unique_lock<std::mutex> Lock(m_Mutex);
+        m_IdleCondition.wait(Lock, [this]() { return m_PendingCount == 0; });
+    }
+
+private:
+    std::mutex m_Mutex;
+    std::condition_variable m_Condition;
+    std::condition_variable m_IdleCondition;
+    std::deque<std::function<void()>> m_Tasks;
+    size_t m_PendingCount = 0;
+    bool m_IsStopping = false;
+    std::vector<std::thread> m_Workers;
+
+    void RunWorker()
+    {
+        while (true)
+        {
+            std::function<void()> Function;
+            {
+                std::unique_lock<std::mutex> Lock(m_Mutex);
+                m_Condition.wait(Lock, [this]() { return m_IsStopping || !m_Tasks.empty(); });
+                if (m_Tasks.empty()) return;
+
+                Function = std::move(m_Tasks.front());
+                m_Tasks.pop_front();
+            }
+            Function();
+
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (--m_PendingCount == 0) m_IdleCondition.notify_all();
+        }
+    }
+};
+
+std::vector<double> MakeTaskDurations(size_t TasksCount)
+{
+    std::mt19937 Random(42);
+    std::vector<double> Durations(TasksCount);
+    for (double& Duration : Durations)
+    {
+        Duration = static_cast<int>(Random() % 100) < TASK_SCHEDULER_BENCH_LONG_TASK_PERCENT ? TASK_SCHEDULER_BENCH_LONG_TASK_MICROSECONDS : TASK_SCHEDULER_BENCH_SHORT_TASK_MICROSECONDS;
+    }
+    return Durations;
+}
+
+// NOTE: Probes are short tasks submitted while the pool is flooded, their latency is the time until they start running
+void PrintLatencies(const char* Name, double TotalMilliseconds, std::vector<double>& Latencies)
+{
+    std::sort(Latencies.begin(), Latencies.end());
+    std::printf("%-34s %10.1f %12.3f %12.3f\n", Name, TotalMilliseconds, Latencies[Latencies.size() / 2], Latencies[Latencies.size() * 99 / 100]);
+}
+
+// Usage: TaskSchedulerBench [--tasks N] [--workers N]
+int main(int ArgumentsCount, char** Arguments)
+{
+    size_t TasksCount = TASK_SCHEDULER_BENCH_DEFAULT_TASKS_COUNT;
+    size_t WorkersCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--tasks") == 0 && i + 1 < ArgumentsCount)
+        {
+            TasksCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+        if (std::strcmp(Arguments[i], "--workers") == 0 && i + 1 < ArgumentsCount)
+        {
+            WorkersCount = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--tasks N] [--workers N]\n", Arguments[0]);
+        return 1;
+    }
+
+    const std::vector<double> DURATIONS = MakeTaskDurations(TasksCount);
+    std::printf("%zu tasks, %d%% of them %.0f us and the rest %.0f us, %zu workers\n", TasksCount, TASK_SCHEDULER_BENCH_LONG_TASK_PERCENT, TASK_SCHEDULER_BENCH_LONG_TASK_MICROSECONDS, TASK_SCHEDULER_BENCH_SHORT_TASK_MICROSECONDS, WorkersCount);
+    std::printf("%-34s %10s %12s %12s\n", "", "Total ms", "Probe p50 ms", "Probe p99 ms");
+
+    // FLOOD FROM A SINGLE PRODUCER
+    // NOTE: Like a reactor handing off the work of a burst of frames, probes are what a latency sensitive subsystem submits meanwhile
+    {
+        std::vector<double> Latencies;
+        GlobalQueuePool Pool(WorkersCount);
+        const auto START_TIME = Clock::now();
+        for (size_t i = 0; i < TasksCount; i++)
+        {
+            const double DURATION = DURATIONS[i];
+            Pool.Submit([DURATION]() { Spin(DURATION); });
+        }
+        std::mutex Mutex;
+        for (int i = 0; i < TASK_SCHEDULER_BENCH_PROBES_COUNT; i++)
+        {
+            const auto SUBMITTED_AT = Clock::now();
+            Pool.Submit([SUBMITTED_AT, &Latencies, &Mutex]() {
+                std::lock_guard<std::mutex> Lock(Mutex);
+                Latencies.push_back(GetElapsedMilliseconds(SUBMITTED_AT));
+            });
+        }
+        Pool.WaitIdle();
+        PrintLatencies("Global queue", GetElapsedMilliseconds(START_TIME), Latencies);
+    }
+
+    {
+        std::vector<double> Latencies;
+        TaskScheduler Scheduler(WorkersCount);
+        const auto START_TIME = Clock::now();
+        for (size_t i = 0; i < TasksCount; i++)
+        {
+            const double DURATION = DURATIONS[i];
+            Scheduler.Submit([DURATION]() { Spin(DURATION); }, TaskPriority::Low);
+        }
+        std::mutex Mutex;
+        for (int i = 0; i < TASK_SCHEDULER_BENCH_PROBES_COUNT; i++)
+        {
+            const auto SUBMITTED_AT = Clock::now();
+            Scheduler.Submit([SUBMITTED_AT, &Latencies, &Mutex]() {
+                std::lock_guard<std::mutex> Lock(Mutex);
+                Latencies.push_back(GetElapsedMilliseconds(SUBMITTED_AT));
+            }, TaskPriority::High);
+        }
+        Scheduler.WaitIdle();
+        PrintLatencies("Work stealing, probes High", GetElapsedMilliseconds(START_TIME), Latencies);
+    }
+
+    // FAN OUT FROM ONE WORKER
+    // NOTE: A single task spawns the whole load, every other worker only gets work by taking it from that one
+    {
+        GlobalQueuePool Pool(WorkersCount);
+        const auto START_TIME = Clock::now();
+        Pool.Submit([&Pool, &DURATIONS]() {
+            for (const double DURATION : DURATIONS) Pool.Submit([DURATION]() { Spin(DURATION); });
+        });
+        Pool.WaitIdle();
+        std::printf("%-34s %10.1f\n", "Global queue, fan out", GetElapsedMilliseconds(START_TIME));
+    }
+
+    {
+        TaskScheduler Scheduler(WorkersCount);
+        const auto START_TIME = Clock::now();
+        Scheduler.Submit([&Scheduler, &DURATIONS]() {
+            for (const double DURATION : DURATIONS) Scheduler.Submit([DURATION]() { Spin(DURATION); });
+        });
+        Scheduler.WaitIdle();
+        std::printf("%-34s %10.1f   stolen %llu\n", "Work stealing, fan out", GetElapsedMilliseconds(START_TIME), static_cast<unsigned long long>(Scheduler.GetStolenCount()));
+    }
+
+    return 0;
+}
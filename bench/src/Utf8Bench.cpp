@@ -0,0 +1,107 @@
+#include "Utf8.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+constexpr size_t UTF8_BENCH_DEFAULT_TEXT_SIZE = 4 * 1024 * 1024;
+constexpr int UTF8_BENCH_REPETITIONS_COUNT = 20;
+
+struct Utf8BenchInput
+{
+    const char* Name;
+    // NOTE: Repeated until the text reaches the requested size
+    const char* Pattern;
+};
+
+// NOTE: Large pastes are mostly ASCII, the other inputs show the cost once every block holds multi-byte characters
+const Utf8BenchInput UTF8_BENCH_INPUTS[] = {
+    { "ascii", "The quick brown fox jumps over the lazy dog. " },
+    { "latin", "Caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9""e, na\xC3\xAFve fa\xC3\xA7""ade. " },
+    { "cjk", "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE6\x96\x87\xE7\xAB\xA0\xE3\x80\x82" },
+    { "emoji", "ok \xF0\x9F\x98\x80\xF0\x9F\x8E\x89\xF0\x9F\x91\x8D " },
+};
+
+const char* GetKernelName(Utf8Kernel Kernel)
+{
+    switch (Kernel)
+    {
+        case Utf8Kernel::Sse2: return "sse2";
+        case Utf8Kernel::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+std::string MakeText(const char* Pattern, size_t Size)
+{
+    std::string Text;
+    Text.reserve(Size + std::strlen(Pattern));
+    while (Text.size() < Size) Text += Pattern;
+
+    // NOTE: Cut at a character boundary so the text stays valid
+    size_t End = Size;
+    while (End > 0 && (static_cast<unsigned char>(Text[End]) & 0xC0) == 0x80) End--;
+    Text.resize(End);
+    return Text;
+}
+
+// NOTE: Best of the repetitions, the text fits in the last level cache so memory bandwidth is not what is measured
+double MeasureGigabytesPerSecond(const std::string& Text, Utf8Kernel Kernel)
+{
+    double BestSeconds = 1.0e9;
+    for (int i = 0; i < UTF8_BENCH_REPETITIONS_COUNT; i++)
+    {
+        const auto START_TIME = std::chrono::steady_clock::now();
+        const bool IS_VALID = IsValidUtf8(Text, Kernel);
+        const std::chrono::duration<double> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+        if (!IS_VALID)
+        {
+            std::fprintf(stderr, "%s rejected valid text\n", GetKernelName(Kernel));
+            std::exit(1);
+        }
+        BestSeconds = std::min(BestSeconds, ELAPSED_TIME.count());
+    }
+
+    return static_cast<double>(Text.size()) / BestSeconds / 1.0e9;
+}
+
+// Usage: Utf8Bench [--size Bytes]
+int main(int ArgumentsCount, char** Arguments)
+{
+    size_t TextSize = UTF8_BENCH_DEFAULT_TEXT_SIZE;
+    for (int i = 1; i < ArgumentsCount; i++)
+    {
+        if (std::strcmp(Arguments[i], "--size") == 0 && i + 1 < ArgumentsCount)
+        {
+            TextSize = static_cast<size_t>(std::max(1LL, std::atoll(Arguments[++i])));
+            continue;
+        }
+
+        std::fprintf(stderr, "Usage: %s [--size Bytes]\n", Arguments[0]);
+        return 1;
+    }
+
+    const Utf8Kernel KERNELS[] = { Utf8Kernel::Scalar, Utf8Kernel::Sse2, Utf8Kernel::Avx2 };
+
+    std::printf("Text size: %zu bytes, best kernel: %s\n", TextSize, GetKernelName(GetBestUtf8Kernel()));
+    std::printf("%8s", "Input");
+    for (const Utf8Kernel KERNEL : KERNELS) std::printf(" %12s", GetKernelName(KERNEL));
+    std::printf("   (GB/s)\n");
+
+    for (const Utf8BenchInput& INPUT : UTF8_BENCH_INPUTS)
+    {
+        const std::string TEXT = MakeText(INPUT.Pattern, TextSize);
+        std::printf("%8s", INPUT.Name);
+        for (const Utf8Kernel KERNEL : KERNELS)
+        {
+            if (IsUtf8KernelSupported(KERNEL)) std::printf(" %12.2f", MeasureGigabytesPerSecond(TEXT, KERNEL));
+            else std::printf(" %12s", "-");
+        }
+        std::printf("\n");
+    }
+
+    return 0;
+}
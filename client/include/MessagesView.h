@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Conversation.h"
+#include "Gui.h"
+#include "TextureAtlas.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// NOTE: Returns the texture drawn as a sender avatar, keeps the view independent from GL textures so it can be drawn
+// by the headless frame benchmark
+using AvatarResolver = std::function<TextureRegion(const std::string& ImageUrl)>;
+
+// NOTE: Draws every message of the conversation into the current container and keeps it scrolled to the bottom
+// Only the messages at MessageIndices are drawn when given, used to show the matches of the search box
+void DrawMessages(const Gui& ClientGui, const Conversation& SelectedConversation, const AvatarResolver& ResolveAvatar, const std::vector<uint32_t>* MessageIndices = nullptr);
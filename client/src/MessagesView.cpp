@@ -0,0 +1,99 @@
+#include "MessagesView.h"
+
+#include "Theme.h"
+
+#include <imgui/imgui.h>
+
+#include <ctime>
+
+void DrawMessages(const Gui& ClientGui, const Conversation& SelectedConversation, const AvatarResolver& ResolveAvatar, const std::vector<uint32_t>* MessageIndices)
+{
+    const Vector2 MESSAGES_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
+
+    const size_t MESSAGES_COUNT = MessageIndices ? MessageIndices->size() : SelectedConversation.Messages.size();
+    for (size_t j = 0; j < MESSAGES_COUNT; j++)
+    {
+        const size_t i = MessageIndices ? (*MessageIndices)[j] : j;
+        // NOTE: Matches can point past messages replaced since the search completed
+        if (i >= SelectedConversation.Messages.size()) continue;
+
+        // MESSAGE CONTAINER
+        const Message& MESSAGE = SelectedConversation.Messages[i];
+        // NOTE: Transient strings and callbacks are allocated from the frame arena instead of the heap
+        FrameArena& Arena = ClientGui.GetFrameArena();
+
+        Container MessageContainer = {};
+        MessageContainer.ID = Arena.Format("MessageContainer%zu", i);
+        MessageContainer.Size = Vector2(MESSAGES_CONTAINER_AVAILABLE_SPACE.X, 0.0f);
+        MessageContainer.Style = &THEME_MESSAGE_STYLE;
+        MessageContainer.IsAutoResizableY = true;
+        MessageContainer.DrawContent = Arena.Bind([&ClientGui, &ResolveAvatar, &MESSAGE](const ContainerState& State) {
+            const Vector2 MESSAGE_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
+
+            // MESSAGE SENDER IMAGE
+            // NOTE: Images are drawn directly over elements so anything that needs to go beside will have to be postioned manually
+            Image MessageSenderImage = {};
+            const TextureRegion MESSAGE_SENDER_IMAGE_REGION = ResolveAvatar(MESSAGE.SenderImageUrl);
+            MessageSenderImage.TextureID = MESSAGE_SENDER_IMAGE_REGION.TextureID;
+            MessageSenderImage.UvMin = MESSAGE_SENDER_IMAGE_REGION.UvMin;
+            MessageSenderImage.UvMax = MESSAGE_SENDER_IMAGE_REGION.UvMax;
+            MessageSenderImage.Size = Vector2(MESSAGE_CONTAINER_AVAILABLE_SPACE.X * 0.05f, MESSAGE_CONTAINER_AVAILABLE_SPACE.X * 0.05f);
+            MessageSenderImage.CornerRounding = THEME_CORNER_ROUNDING;
+            ClientGui.DrawImage(MessageSenderImage);
+
+            // MESSAGE DETAILS CONTAINER
+            ImGuiStyle& Style = ImGui::GetStyle();
+
+            Container MessageDetailsContainer = {};
+            MessageDetailsContainer.ID = "MessageDetailsContainer";
+            MessageDetailsContainer.Size = Vector2(MESSAGE_CONTAINER_AVAILABLE_SPACE.X - MessageSenderImage.Size.X, 0.0f);
+            MessageDetailsContainer.Padding = Vector2(Style.WindowPadding.x / 1.5f, 0.0f);
+            MessageDetailsContainer.BgColor = THEME_TRANSPARENT_COLOR;
+            MessageDetailsContainer.IsAutoResizableY = true;
+            MessageDetailsContainer.DrawContent = [&ClientGui, &MESSAGE](const ContainerState& State) {
+                // MESSAGE SENDER FIRSTNAME TEXT
+                Text MessageSenderFirstNameText = {};
+                MessageSenderFirstNameText.Value = MESSAGE.SenderFirstName;
+                ClientGui.DrawText(MessageSenderFirstNameText);
+
+                // MESSAGE PENDING TEXT
+                // NOTE: Shown until the server acknowledges the message
+                if (MESSAGE.IsPending())
+                {
+                    Text MessagePendingText = {};
+                    MessagePendingText.Value = "Sending...";
+                    ClientGui.DisplayInline();
+                    ClientGui.DrawText(MessagePendingText);
+                }
+
+                // MESSAGE CREATED AT TEXT
+                std::tm* MessageCreatedAtDate = std::localtime(&MESSAGE.CreatedAt);
+                const char* MESSAGE_CREATED_AT_STRING_DATE = std::asctime(MessageCreatedAtDate);
+
+                Text MessageCreatedAtText = {};
+                MessageCreatedAtText.Value = MESSAGE_CREATED_AT_STRING_DATE;
+                ClientGui.DisplayInline();
+                ClientGui.DrawText(MessageCreatedAtText);
+
+                // MESSAGE TEXT
+                Text MessageText = {};
+                MessageText.Value = MESSAGE.Text;
+                ClientGui.DrawTextWrapped(MessageText);
+            };
+
+            ClientGui.SetPositionX(MessageSenderImage.Size.X + 10.0f);
+            ClientGui.DrawContainer(MessageDetailsContainer);
+        });
+
+        ClientGui.DrawContainer(MessageContainer);
+    }
+
+    // Before drawing content, check if we are already at the bottom
+    const bool IsAtBottom = ClientGui.GetScrollPositionY() >= ClientGui.GetMaxScrollPositionY();
+    // Auto-scroll logic: only scroll if the user hasn't moved away from the bottom
+    if (IsAtBottom)
+    {
+        // Scrolls to the end
+        ClientGui.ScrollToY(1.0f);
+    }
+}
@@ -1,6 +1,22 @@
+#include "AllocationCounter.h"
+#include "AssetPack.h"
+#include "Conversation.h"
+#include "ConversationStore.h"
+#include "FlexLayout.h"
+#include "FrameScheduler.h"
 #include "Gui.h"
+#include "HistoryPrefetcher.h"
+#include "Message.h"
+#include "MessageCache.h"
+#include "MessageFilter.h"
+#include "MessagesView.h"
+#include "OutboundQueue.h"
 #include "SocketClient.h"
 #include "Texture.h"
+#include "TextureCache.h"
+#include "Theme.h"
+#include "User.h"
+#include "WidgetTree.h"
 
 #include <GLAD/glad.h>
 #include <GLFW/glfw3.h>
@@ -9,42 +25,38 @@
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
 
+#include <algorithm>
 #include <arpa/inet.h>
 #include <ctime>
 #include <iostream>
-#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <unistd.h>
+#include <variant>
 #include <vector>
 
 constexpr int SERVER_PORT =  5000;
-
-struct User
-{
-    std::string ID;
-    std::string FirstName;
-    std::string ImageUrl;
-};
-
-struct Message
-{
-    std::string ID;
-    std::string ConversationID;
-    std::string SenderID;
-    std::string SenderFirstName;
-    std::string SenderImageUrl;
-    std::string Text;
-    std::time_t CreatedAt;
-};
-
-struct Conversation
-{
-    std::string ID;
-    std::vector<Message> Messages;
-    std::vector<User> Users;
-    std::time_t CreatedAt;
-};
+// NOTE: Time per frame spent uploading decoded avatars to the GPU
+constexpr double TEXTURE_UPLOAD_TIME_BUDGET = 0.002;
+constexpr size_t AVATAR_TEXTURE_CACHE_BUDGET_BYTES = 32 * 1024 * 1024;
+// NOTE: There are no accounts yet, every launch shares the same cache
+constexpr const char* MESSAGE_CACHE_DIRECTORY_PATH = "Cache";
+constexpr const char* MESSAGE_CACHE_ACCOUNT_ID = "LocalAccount";
+// NOTE: Loaded at startup, older messages stay on disk until the conversation is hovered or selected
+constexpr size_t MESSAGE_CACHE_CONVERSATIONS_COUNT = 50;
+constexpr size_t MESSAGE_CACHE_PRELOADED_CONVERSATIONS_COUNT = 5;
+constexpr size_t MESSAGE_CACHE_MESSAGES_COUNT = 100;
+// NOTE: Caps speculative history loading, pages that are never opened are dropped past the memory budget
+constexpr size_t HISTORY_PREFETCH_MEMORY_BUDGET_BYTES = 8 * 1024 * 1024;
+constexpr size_t HISTORY_PREFETCH_BANDWIDTH_BYTES_PER_SECOND = 512 * 1024;
+// NOTE: Written next to the executable when F4 is pressed
+constexpr const char* FRAME_TRACE_FILE_PATH = "FrameTrace.json";
+// NOTE: Audiowide only covers Latin, the fonts listed in FALLBACK_FONT_FILES when baking are packed as FallbackFont0,
+// FallbackFont1... and merged in for other scripts and symbols, there are none when no listed file was found
+constexpr std::string_view FALLBACK_FONT_ASSET_NAME_PREFIX = "FallbackFont";
 
 void framebuffer_size_callback(GLFWwindow* Window, int width, int height)
 {
@@ -52,12 +64,20 @@ void framebuffer_size_callback(GLFWwindow* Window, int width, int height)
 }
 
 
+// NOTE: Set by the key callback, handled at the start of the next frame
+static bool IsFrameProfilerToggleRequested = false;
+static bool IsFrameTraceDumpRequested = false;
+
 void myKeyCallback(GLFWwindow* Window, int key, int scancode, int action, int mods)
 {
     if (key == GLFW_KEY_E && action == GLFW_PRESS)
     {
         printf("You pressed the e key!\n");
     }
+
+    // F3 shows the frame profiler overlay, F4 dumps the recorded frames as a Chrome trace
+    if (key == GLFW_KEY_F3 && action == GLFW_PRESS) IsFrameProfilerToggleRequested = true;
+    if (key == GLFW_KEY_F4 && action == GLFW_PRESS) IsFrameTraceDumpRequested = true;
 }
 
 int main()
@@ -105,16 +125,47 @@ int main()
 
     glfwSetFramebufferSizeCallback(GlfwWindow, framebuffer_size_callback);
 
+    // NOTE: Assets are baked at build time, the source assets are decoded instead when the pack is missing
+    AssetPack ClientAssetPack = {};
+    ClientAssetPack.Open("../assets/Assets.pack");
+
+    auto LoadAssetTexture = [&ClientAssetPack](Texture& AssetTexture, std::string_view Name, const std::string& FallbackFilePath, unsigned int Unit) {
+        const AssetPackEntry* ENTRY = ClientAssetPack.Find(Name);
+        if (ENTRY && ENTRY->Type == AssetType::Image)
+        {
+            AssetTexture.LoadFromPixels(ClientAssetPack.GetData(*ENTRY), static_cast<int>(ENTRY->Width), static_cast<int>(ENTRY->Height), static_cast<int>(ENTRY->ChannelsCount), Unit);
+            return;
+        }
+        AssetTexture.Load(FallbackFilePath, Unit);
+    };
+
     Texture BlankImageTexture = {};
-    BlankImageTexture.Load("../../assets/Blank.jpg", 0);
+    LoadAssetTexture(BlankImageTexture, "Blank", "../../assets/blank.jpg", 0);
     BlankImageTexture.Bind();
 
     Texture ClosableImageTexture = {};
-    ClosableImageTexture.Load("../../assets/Closable.png", 1);
+    LoadAssetTexture(ClosableImageTexture, "Closable", "../../assets/Closable.png", 1);
     ClosableImageTexture.Bind();
 
     Gui ClientGui = {};
-    ClientGui.Init(GlfwWindow);
+    const AssetPackEntry* FONT_ENTRY = ClientAssetPack.Find("Audiowide-Regular");
+    std::string_view FontData = {};
+    if (FONT_ENTRY && FONT_ENTRY->Type == AssetType::Font) FontData = std::string_view(reinterpret_cast<const char*>(ClientAssetPack.GetData(*FONT_ENTRY)), static_cast<size_t>(FONT_ENTRY->Size));
+    ClientGui.Init(GlfwWindow, FontData);
+    for (int FallbackFontIndex = 0;; FallbackFontIndex++)
+    {
+        const AssetPackEntry* FALLBACK_FONT_ENTRY = ClientAssetPack.Find(std::string(FALLBACK_FONT_ASSET_NAME_PREFIX) + std::to_string(FallbackFontIndex));
+        if (!FALLBACK_FONT_ENTRY) break;
+        if (FALLBACK_FONT_ENTRY->Type == AssetType::Font) ClientGui.AddFallbackFont(std::string_view(reinterpret_cast<const char*>(ClientAssetPack.GetData(*FALLBACK_FONT_ENTRY)), static_cast<size_t>(FALLBACK_FONT_ENTRY->Size)));
+    }
+
+    // NOTE: Only redraws on input, FrameScheduler::Wake calls or scheduled redraws so an idle window sleeps
+    FrameScheduler ClientFrameScheduler;
+
+    // NOTE: Avatars are decoded off the render thread, BlankImageTexture is drawn until they are uploaded
+    // Avatars are shared by URL and evicted when not drawn for a while so memory stays flat
+    TextureCache AvatarTextureCache(AVATAR_TEXTURE_CACHE_BUDGET_BYTES);
+    AvatarTextureCache.SetOnDecoded(FrameScheduler::Wake);
 
     // Fake Users
     User User1 = {};
@@ -145,11 +196,327 @@ int main()
     Conversation2.Messages = {};
     Conversation2.CreatedAt = std::time(0);
 
-    static std::vector<std::shared_ptr<Conversation>> Conversations = {
-        std::make_shared<Conversation>(Conversation1),
-        std::make_shared<Conversation>(Conversation2)
+    static ConversationStore Conversations = {};
+
+    // NOTE: Cached conversations are shown before the network connects
+    static MessageCache ClientMessageCache = {};
+    // Conversations whose newest page of messages is in memory, the others are loaded when hovered or selected
+    static std::unordered_set<std::string> LoadedHistoryConversationIDs = {};
+    if (ClientMessageCache.Open(MESSAGE_CACHE_DIRECTORY_PATH, MESSAGE_CACHE_ACCOUNT_ID))
+    {
+        // NOTE: Only the most recent conversations come with their messages, the rest of the list is loaded without
+        for (Conversation& CachedConversation : ClientMessageCache.LoadRecent(MESSAGE_CACHE_PRELOADED_CONVERSATIONS_COUNT, MESSAGE_CACHE_MESSAGES_COUNT))
+        {
+            LoadedHistoryConversationIDs.insert(CachedConversation.ID);
+            Conversations.Add(std::move(CachedConversation));
+        }
+        for (Conversation& CachedConversation : ClientMessageCache.LoadRecent(MESSAGE_CACHE_CONVERSATIONS_COUNT, 0))
+        {
+            if (!Conversations.Find(CachedConversation.ID).IsValid()) Conversations.Add(std::move(CachedConversation));
+        }
+    }
+
+    // NOTE: Fake conversations are only written once, later launches read them back with their messages from the cache
+    for (const Conversation& FakeConversation : { Conversation2, Conversation1 })
+    {
+        if (Conversations.Find(FakeConversation.ID).IsValid()) continue;
+
+        Conversations.Add(FakeConversation);
+        ClientMessageCache.AppendConversation(FakeConversation);
+        LoadedHistoryConversationIDs.insert(FakeConversation.ID);
+    }
+    static ConversationHandle SelectedConversationHandle = Conversations.GetMostRecent();
+
+    // NOTE: Sent messages are shown right away and written to the cache as pending, then again once acknowledged
+    // Nothing is sent until a server connection sets the transport, OutboundQueue::Resend is called on reconnect
+    static OutboundQueue Outbound;
+    // NOTE: The server connection passes the payload of Acknowledgements frames to OutboundQueue::ReadAcknowledgements
+    Outbound.SetOnAcknowledged([](const Message& AcknowledgedMessage) {
+        // NOTE: Pending messages are the newest ones so they are searched from the back
+        Conversation* AcknowledgedConversation = Conversations.Get(Conversations.Find(AcknowledgedMessage.ConversationID));
+        if (AcknowledgedConversation)
+        {
+            for (auto Iterator = AcknowledgedConversation->Messages.rbegin(); Iterator != AcknowledgedConversation->Messages.rend(); Iterator++)
+            {
+                if (Iterator->Nonce != AcknowledgedMessage.Nonce) continue;
+
+                Iterator->ID = AcknowledgedMessage.ID;
+                Iterator->Sequence = AcknowledgedMessage.Sequence;
+                break;
+            }
+        }
+        ClientMessageCache.AppendMessage(AcknowledgedMessage);
+        FrameScheduler::Wake();
+    });
+    // NOTE: Messages still pending when the client last stopped are sent again with their nonce
+    for (const Message& PendingMessage : ClientMessageCache.LoadPendingMessages()) Outbound.Requeue(PendingMessage, glfwGetTime());
+
+    // NOTE: Loads the newest page of hovered conversations and their neighbours so selecting one shows its messages
+    // right away, pages come from the cache until a server sync exists
+    HistoryPrefetcherLimits HistoryPrefetchLimits = {};
+    HistoryPrefetchLimits.PageMessagesCount = MESSAGE_CACHE_MESSAGES_COUNT;
+    HistoryPrefetchLimits.MemoryBudgetBytes = HISTORY_PREFETCH_MEMORY_BUDGET_BYTES;
+    HistoryPrefetchLimits.BandwidthBytesPerSecond = HISTORY_PREFETCH_BANDWIDTH_BYTES_PER_SECOND;
+    static HistoryPrefetcher ConversationHistoryPrefetcher([](const std::string& ConversationID, size_t MessagesCount) {
+        return ClientMessageCache.LoadMessages(ConversationID, MessagesCount);
+    }, HistoryPrefetchLimits);
+    ConversationHistoryPrefetcher.SetOnLoaded(FrameScheduler::Wake);
+
+    // NOTE: Conversations and their loaded messages are filtered on a worker as the search box is typed in, rows and
+    // messages keep showing the previous result until the new one completes
+    static MessageFilter ConversationFilter;
+    ConversationFilter.SetOnCompleted(FrameScheduler::Wake);
+    static std::string SearchText = "";
+    static MessageFilterResult ConversationFilterResult = {};
+    static uint64_t ConversationFilterVersion = UINT64_MAX;
+    // NOTE: Messages count of every conversation when it was last indexed, only conversations whose count changed are
+    // indexed again
+    static std::unordered_map<ConversationHandle, size_t, ConversationHandleHash> ConversationFilterMessagesCounts = {};
+    // NOTE: Deletions are deferred to the end of the frame so the conversations list is never mutated while iterated
+    static ConversationHandle PendingRemovalConversationHandle = {};
+
+    // CONVERSATION ROWS
+    static WidgetTree ConversationWidgets = {};
+    static const WidgetHandle ConversationRowsRoot = ConversationWidgets.AddContainer({}, Container{});
+    static std::unordered_map<ConversationHandle, WidgetHandle, ConversationHandleHash> ConversationRows = {};
+    static std::vector<WidgetHandle> ConversationRowsOrder = {};
+    static uint64_t ConversationRowsVersion = UINT64_MAX;
+    static ConversationHandle ConversationRowsSelectedHandle = {};
+    // NOTE: Same order as ConversationRowsOrder, used to find the neighbours of a hovered row
+    static std::vector<ConversationHandle> ConversationRowsHandles = {};
+    // NOTE: Index of every handle in ConversationRowsHandles so hovering a row does not search the list every frame
+    static std::unordered_map<ConversationHandle, size_t, ConversationHandleHash> ConversationRowsIndices = {};
+
+    auto PrefetchConversationHistory = [](ConversationHandle Handle) {
+        const auto Iterator = ConversationRowsIndices.find(Handle);
+        if (Iterator == ConversationRowsIndices.end()) return;
+
+        // NOTE: Neighbours first since the latest request is loaded first
+        const size_t INDEX = Iterator->second;
+        const ConversationHandle CANDIDATES[] = {
+            INDEX + 1 < ConversationRowsHandles.size() ? ConversationRowsHandles[INDEX + 1] : ConversationHandle{},
+            INDEX > 0 ? ConversationRowsHandles[INDEX - 1] : ConversationHandle{},
+            Handle,
+        };
+        for (const ConversationHandle CANDIDATE : CANDIDATES)
+        {
+            const Conversation* CandidateConversation = Conversations.Get(CANDIDATE);
+            if (CandidateConversation && !LoadedHistoryConversationIDs.count(CandidateConversation->ID)) ConversationHistoryPrefetcher.Prefetch(CandidateConversation->ID);
+        }
     };
-    static std::shared_ptr<Conversation> SelectedConversation = Conversations[0];
+
+    // NOTE: Uses the prefetched page when there is one, reads the cache on the render thread otherwise
+    auto LoadConversationHistory = [](ConversationHandle Handle) {
+        Conversation* SelectedConversation = Conversations.Get(Handle);
+        if (!SelectedConversation || LoadedHistoryConversationIDs.count(SelectedConversation->ID)) return;
+
+        std::vector<Message> Page;
+        if (!ConversationHistoryPrefetcher.Take(SelectedConversation->ID, Page)) Page = ClientMessageCache.LoadMessages(SelectedConversation->ID, MESSAGE_CACHE_MESSAGES_COUNT);
+        // NOTE: Sent messages are appended to the cache too so the page already holds them, an acknowledgement received
+        // after a prefetched page was read is applied to it again
+        for (Message& PageMessage : Page)
+        {
+            if (!PageMessage.IsPending()) continue;
+            for (const Message& ShownMessage : SelectedConversation->Messages)
+            {
+                if (ShownMessage.Nonce == PageMessage.Nonce) PageMessage = ShownMessage;
+            }
+        }
+        if (Page.size() >= SelectedConversation->Messages.size()) SelectedConversation->Messages = std::move(Page);
+        LoadedHistoryConversationIDs.insert(SelectedConversation->ID);
+
+        // NOTE: Messages were replaced instead of appended so the conversation is indexed again
+        ConversationFilter.RemoveConversation(SelectedConversation->ID);
+        ConversationFilter.UpdateConversation(*SelectedConversation);
+        ConversationFilterMessagesCounts[Handle] = SelectedConversation->Messages.size();
+    };
+
+    auto AddConversationRow = [&BlankImageTexture, &ClosableImageTexture, &PrefetchConversationHistory, &LoadConversationHistory](ConversationHandle Handle) {
+        const Conversation* Conversation = Conversations.Get(Handle);
+
+        // NOTE: Copied into the widget tree, only needs to live until added
+        const std::string CONVERSATION_CONTAINER_ID = "ConversationContainer" + Conversation->ID;
+        const std::string CLOSE_CONVERSATION_IMAGE_BUTTON_CONTAINER_ID = "CloseConversationImageButtonContainer" + Conversation->ID;
+        const std::string CLOSE_CONVERSATION_IMAGE_BUTTON_ID = "CloseConversationImageButton" + Conversation->ID;
+
+        // CONVERSATION CONTAINER
+        Container ConversationContainer = {};
+        ConversationContainer.ID = CONVERSATION_CONTAINER_ID;
+        ConversationContainer.Style = &THEME_PANEL_STYLE;
+        ConversationContainer.BgColorHovered = THEME_SURFACE_HOVERED_COLOR;
+        ConversationContainer.IsAutoResizableY = true;
+        ConversationContainer.OnHover = [Handle, &PrefetchConversationHistory]() {
+            PrefetchConversationHistory(Handle);
+        };
+
+        const WidgetHandle ROW = ConversationWidgets.AddContainer(ConversationRowsRoot, ConversationContainer);
+        ConversationWidgets.Edit(ROW)->OnLayout = [](Widget& Widget, const Vector2& AvailableSpace) {
+            std::get<Container>(Widget.Content).Size = Vector2(AvailableSpace.X, AvailableSpace.Y * 0.05f);
+        };
+
+        // CONVERSATION IMAGE
+        Image ConversationImage = {};
+        ConversationImage.TextureID = BlankImageTexture.GetID();
+        ConversationImage.CornerRounding = THEME_CORNER_ROUNDING;
+
+        const WidgetHandle CONVERSATION_IMAGE = ConversationWidgets.AddImage(ROW, ConversationImage);
+        ConversationWidgets.Edit(CONVERSATION_IMAGE)->OnLayout = [](Widget& Widget, const Vector2& AvailableSpace) {
+            std::get<Image>(Widget.Content).Size = Vector2(AvailableSpace.Y, AvailableSpace.Y);
+        };
+
+        // SELECT CONVERSATION BUTTON
+        Button SelectConversationButton = {};
+        SelectConversationButton.Label = Conversation->ID;
+        SelectConversationButton.Style = &THEME_GHOST_BUTTON_STYLE;
+        SelectConversationButton.OnClick = [Handle, &LoadConversationHistory]() {
+            LoadConversationHistory(Handle);
+            SelectedConversationHandle = Handle;
+            std::cout << "SELECTED CONVERSATION ID: " << Conversations.Get(Handle)->ID << std::endl;
+        };
+
+        const WidgetHandle SELECT_CONVERSATION_BUTTON = ConversationWidgets.AddButton(ROW, SelectConversationButton);
+        ConversationWidgets.Edit(SELECT_CONVERSATION_BUTTON)->OnLayout = [](Widget& Widget, const Vector2& AvailableSpace) {
+            // NOTE: Leaves room for the image on the left and the close button on the right
+            std::get<Button>(Widget.Content).Size = Vector2(AvailableSpace.X - (AvailableSpace.Y * 2), AvailableSpace.Y);
+            Widget.Position.X = AvailableSpace.Y;
+        };
+
+        // CLOSE CONVERSATION IMAGE BUTTON CONTAINER
+        Container CloseConversationImageButtonContainer = {};
+        CloseConversationImageButtonContainer.ID = CLOSE_CONVERSATION_IMAGE_BUTTON_CONTAINER_ID;
+        CloseConversationImageButtonContainer.Padding = Vector2(5.0f, 5.0f);
+        CloseConversationImageButtonContainer.BgColor = THEME_TRANSPARENT_COLOR;
+
+        const WidgetHandle CLOSE_CONVERSATION_IMAGE_BUTTON_CONTAINER = ConversationWidgets.AddContainer(ROW, CloseConversationImageButtonContainer);
+        Widget* CloseConversationImageButtonContainerWidget = ConversationWidgets.Edit(CLOSE_CONVERSATION_IMAGE_BUTTON_CONTAINER);
+        CloseConversationImageButtonContainerWidget->IsInline = true;
+        CloseConversationImageButtonContainerWidget->IsVisibleOnParentHover = true;
+        CloseConversationImageButtonContainerWidget->OnLayout = [](Widget& Widget, const Vector2& AvailableSpace) {
+            std::get<Container>(Widget.Content).Size = Vector2(AvailableSpace.Y, AvailableSpace.Y);
+            Widget.Position.X = AvailableSpace.X - AvailableSpace.Y;
+        };
+
+        // CLOSE CONVERSATION IMAGE BUTTON
+        Image CloseConversationImageButtonImage = {};
+        CloseConversationImageButtonImage.TextureID = ClosableImageTexture.GetID();
+        CloseConversationImageButtonImage.TintColor = THEME_TEXT_COLOR;
+        CloseConversationImageButtonImage.CornerRounding = 0.0f;
+
+        ImageButton CloseConversationImageButton = {};
+        CloseConversationImageButton.ID = CLOSE_CONVERSATION_IMAGE_BUTTON_ID;
+        CloseConversationImageButton.Image = CloseConversationImageButtonImage;
+        CloseConversationImageButton.TintColorHovered = THEME_HIGHLIGHT_COLOR;
+        CloseConversationImageButton.OnClick = [Handle]() {
+            PendingRemovalConversationHandle = Handle;
+        };
+
+        const WidgetHandle CLOSE_CONVERSATION_IMAGE_BUTTON = ConversationWidgets.AddImageButton(CLOSE_CONVERSATION_IMAGE_BUTTON_CONTAINER, CloseConversationImageButton);
+        ConversationWidgets.Edit(CLOSE_CONVERSATION_IMAGE_BUTTON)->OnLayout = [](Widget& Widget, const Vector2& AvailableSpace) {
+            std::get<ImageButton>(Widget.Content).Image.Size = AvailableSpace;
+        };
+
+        return ROW;
+    };
+
+    // NOTE: Updates retained rows only when the conversations or the selection changed since the last frame
+    auto SyncConversationRows = [&AddConversationRow]() {
+        const bool HAVE_CONVERSATIONS_CHANGED = Conversations.GetVersion() != ConversationRowsVersion;
+        const bool HAS_SELECTION_CHANGED = SelectedConversationHandle != ConversationRowsSelectedHandle;
+        if (!HAVE_CONVERSATIONS_CHANGED && !HAS_SELECTION_CHANGED) return;
+
+        if (HAVE_CONVERSATIONS_CHANGED)
+        {
+            // Removes rows of deleted conversations
+            for (auto Iterator = ConversationRows.begin(); Iterator != ConversationRows.end();)
+            {
+                if (Conversations.Get(Iterator->first))
+                {
+                    Iterator++;
+                    continue;
+                }
+
+                ConversationWidgets.Remove(Iterator->second);
+                Iterator = ConversationRows.erase(Iterator);
+            }
+
+            // Adds rows of new conversations and orders rows by last activity
+            ConversationRowsOrder.clear();
+            ConversationRowsHandles.clear();
+            ConversationRowsIndices.clear();
+            for (const ConversationActivity& Activity : Conversations)
+            {
+                auto Iterator = ConversationRows.find(Activity.Handle);
+                if (Iterator == ConversationRows.end()) Iterator = ConversationRows.emplace(Activity.Handle, AddConversationRow(Activity.Handle)).first;
+
+                ConversationRowsOrder.push_back(Iterator->second);
+                ConversationRowsIndices[Activity.Handle] = ConversationRowsHandles.size();
+                ConversationRowsHandles.push_back(Activity.Handle);
+            }
+            ConversationWidgets.SetChildren(ConversationRowsRoot, ConversationRowsOrder);
+            ConversationRowsVersion = Conversations.GetVersion();
+        }
+
+        // Swaps style of previously and newly selected rows
+        auto PreviousSelectedRow = ConversationRows.find(ConversationRowsSelectedHandle);
+        if (PreviousSelectedRow != ConversationRows.end()) std::get<Container>(ConversationWidgets.Edit(PreviousSelectedRow->second)->Content).Style = &THEME_PANEL_STYLE;
+
+        auto SelectedRow = ConversationRows.find(SelectedConversationHandle);
+        if (SelectedRow != ConversationRows.end()) std::get<Container>(ConversationWidgets.Edit(SelectedRow->second)->Content).Style = &THEME_PANEL_SELECTED_STYLE;
+
+        ConversationRowsSelectedHandle = SelectedConversationHandle;
+    };
+
+    // NOTE: Hides rows of conversations the last completed search did not match, only rows whose visibility changed
+    // are edited
+    auto ApplyConversationFilter = []() {
+        for (const auto& [Handle, Row] : ConversationRows)
+        {
+            const bool IS_MATCH = ConversationFilterResult.Query.empty() || ConversationFilterResult.MatchesByConversationID.count(Conversations.Get(Handle)->ID) > 0;
+            if (ConversationWidgets.Get(Row)->IsVisible != IS_MATCH) ConversationWidgets.Edit(Row)->IsVisible = IS_MATCH;
+        }
+    };
+
+    // NOTE: Only indexes messages appended since the last sync, the scan itself runs on the filter worker
+    auto SyncConversationFilter = [&ApplyConversationFilter]() {
+        const bool HAVE_CONVERSATIONS_CHANGED = Conversations.GetVersion() != ConversationFilterVersion;
+        if (HAVE_CONVERSATIONS_CHANGED)
+        {
+            for (const ConversationActivity& Activity : Conversations)
+            {
+                const Conversation* ChangedConversation = Conversations.Get(Activity.Handle);
+                auto [Iterator, IsNew] = ConversationFilterMessagesCounts.try_emplace(Activity.Handle, 0);
+                if (!IsNew && Iterator->second == ChangedConversation->Messages.size()) continue;
+
+                ConversationFilter.UpdateConversation(*ChangedConversation);
+                Iterator->second = ChangedConversation->Messages.size();
+            }
+            ConversationFilterVersion = Conversations.GetVersion();
+        }
+        // NOTE: Does nothing unless the search text or the conversations changed
+        ConversationFilter.SetQuery(SearchText);
+
+        if (ConversationFilter.Poll(ConversationFilterResult) || HAVE_CONVERSATIONS_CHANGED) ApplyConversationFilter();
+    };
+
+    // LAYOUT
+    // NOTE: Grow ratios are shares of the parent and sum to 1 for every parent, solved once and cached until the window
+    // size changes. Nested shares are the window fractions of the fixed layout divided by their parent's fraction
+    auto MakeFlexNode = [](FlexDirection Direction, float Grow) {
+        FlexNode Node = {};
+        Node.Direction = Direction;
+        Node.Grow = Grow;
+        return Node;
+    };
+
+    FlexLayout MainLayout = {};
+    const FlexNodeIndex NAVBAR_NODE = MainLayout.Add(FLEX_LAYOUT_ROOT, MakeFlexNode(FlexDirection::Column, 0.15f));
+    const FlexNodeIndex BODY_NODE = MainLayout.Add(FLEX_LAYOUT_ROOT, MakeFlexNode(FlexDirection::Row, 0.85f));
+    const FlexNodeIndex CHATS_NODE = MainLayout.Add(BODY_NODE, MakeFlexNode(FlexDirection::Column, 0.25f));
+    const FlexNodeIndex CONVERSATION_NODE = MainLayout.Add(BODY_NODE, MakeFlexNode(FlexDirection::Column, 0.75f));
+    const FlexNodeIndex SELECTED_CONVERSATION_NODE = MainLayout.Add(CONVERSATION_NODE, MakeFlexNode(FlexDirection::Column, 0.70f / 0.85f));
+    const FlexNodeIndex COMPOSER_NODE = MainLayout.Add(CONVERSATION_NODE, MakeFlexNode(FlexDirection::Row, 0.15f / 0.85f));
+    const FlexNodeIndex MESSAGE_TEXT_INPUT_NODE = MainLayout.Add(COMPOSER_NODE, MakeFlexNode(FlexDirection::Column, 0.60f / 0.75f));
+    const FlexNodeIndex SEND_BUTTON_NODE = MainLayout.Add(COMPOSER_NODE, MakeFlexNode(FlexDirection::Column, 0.15f / 0.75f));
 
     // SocketClient socket_client;
     // socket_client.Connect(SERVER_PORT, "127.0.0.1");
@@ -160,30 +527,60 @@ int main()
     // socket_client.Send(message);
     // socket_client.Close();
 
+    FrameProfiler& ClientFrameProfiler = ClientGui.GetFrameProfiler();
+
     while(!glfwWindowShouldClose(GlfwWindow))
     {
+        if (IsFrameProfilerToggleRequested)
+        {
+            ClientFrameProfiler.SetEnabled(!ClientFrameProfiler.IsEnabled());
+            IsFrameProfilerToggleRequested = false;
+        }
+        ClientFrameProfiler.BeginFrame();
+
         // Clears screen
         glClearColor(250.0f / 255.0f, 119.0f / 255.0f, 110.0f / 255.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
+        // Uploads decoded avatars, keeps rendering while some are left for the next frames
+        {
+            ScopeTimer TextureUploadTimer(ClientFrameProfiler, "TextureUpload");
+            if (AvatarTextureCache.Upload(TEXTURE_UPLOAD_TIME_BUDGET)) ClientFrameScheduler.RequestRedraw();
+        }
+
          // Clears ImGui state
         ClientGui.Clear();
 
+        {
+            ScopeTimer SyncConversationRowsTimer(ClientFrameProfiler, "SyncConversationRows");
+            SyncConversationRows();
+            SyncConversationFilter();
+        }
+
+        // Starts decoding avatars of prefetched pages so they are ready when the conversation is opened
+        ConversationHistoryPrefetcher.Poll([&AvatarTextureCache, &BlankImageTexture](const std::string& ConversationID, const std::vector<Message>& Messages) {
+            for (const Message& PrefetchedMessage : Messages)
+            {
+                AvatarTextureCache.Get(PrefetchedMessage.SenderImageUrl, TextureRegion(BlankImageTexture.GetID()));
+            }
+        });
+
         // WINDOW
         Window MainWindow = {};
         MainWindow.Name = "MainWindow";
         MainWindow.Size = Vector2(WINDOW_WIDTH, WINDOW_HEIGHT);
-        MainWindow.BgColor = Rgba(26, 30, 67, 255);
-        MainWindow.DrawContent = [&ClientGui, &BlankImageTexture, &ClosableImageTexture]() {
+        MainWindow.Style = &THEME_WINDOW_STYLE;
+        MainWindow.DrawContent = [&ClientGui, &BlankImageTexture, &AvatarTextureCache, &MainLayout, NAVBAR_NODE, CHATS_NODE, SELECTED_CONVERSATION_NODE, MESSAGE_TEXT_INPUT_NODE, SEND_BUTTON_NODE]() {
             const Vector2 MAIN_WINDOW_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
+            const Vector2 MAIN_WINDOW_ORIGIN = ClientGui.GetPosition();
+            // NOTE: Does nothing unless the window was resized
+            MainLayout.Solve(MAIN_WINDOW_AVAILABLE_SPACE);
 
             // NAVBAR CONTAINER
             Container NavbarContainer = {};
             NavbarContainer.ID = "NavbarContainer";
-            NavbarContainer.Size = Vector2(MAIN_WINDOW_AVAILABLE_SPACE.X, MAIN_WINDOW_AVAILABLE_SPACE.Y * 0.15f);
-            NavbarContainer.Padding = Vector2(15.0f, 15.0f);
-            // NOTE: Transparent background
-            NavbarContainer.BgColor = Rgba(0, 0, 0, 0);
+            NavbarContainer.Size = MainLayout.GetRect(NAVBAR_NODE).Size;
+            NavbarContainer.Style = &THEME_SECTION_STYLE;
             NavbarContainer.DrawContent = [&ClientGui](const ContainerState& State) {
                 const Vector2 NAVBAR_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
 
@@ -191,128 +588,56 @@ int main()
                 Container Navbar = {};
                 Navbar.ID = "Navbar";
                 Navbar.Size = Vector2(NAVBAR_CONTAINER_AVAILABLE_SPACE);
-                Navbar.CornerRounding = 10.f;
-                Navbar.BgColor = Rgba(50, 56, 102, 255);
-                Navbar.DrawContent = [&ClientGui](const ContainerState& State) {};
+                Navbar.Style = &THEME_PANEL_STYLE;
+                Navbar.DrawContent = [&ClientGui](const ContainerState& State) {
+                    // HEAP ALLOCATIONS TEXT
+                    // NOTE: Without GUI_COUNT_ALLOCATIONS operator new is not hooked, only ImGui's allocations are counted
+                    Text HeapAllocationsText = {};
+                    HeapAllocationsText.Value = ClientGui.GetFrameArena().Format(
+                        "%s allocations per frame: %llu",
+                        IsOperatorNewCounted() ? "Heap" : "ImGui",
+                        static_cast<unsigned long long>(ClientGui.GetFrameAllocationCount())
+                    );
+                    ClientGui.DrawText(HeapAllocationsText);
+                };
 
                 ClientGui.DrawContainer(Navbar);
             };
 
+            ClientGui.SetPosition(MAIN_WINDOW_ORIGIN + MainLayout.GetRect(NAVBAR_NODE).Position);
             ClientGui.DrawContainer(NavbarContainer);
 
             // CHATS CONTAINER
             Container ChatsContainer = {};
             ChatsContainer.ID = "ChatsContainer";
-            ChatsContainer.Size = Vector2(MAIN_WINDOW_AVAILABLE_SPACE.X * 0.25f, MAIN_WINDOW_AVAILABLE_SPACE.Y - NavbarContainer.Size.Y);
-            ChatsContainer.Padding = Vector2(15.0f, 15.0f);
-            // NOTE: Transparent background
-            ChatsContainer.BgColor = Rgba(0, 0, 0, 0);
-            ChatsContainer.DrawContent = [&ClientGui, &BlankImageTexture, &ClosableImageTexture](const ContainerState& State) {
+            ChatsContainer.Size = MainLayout.GetRect(CHATS_NODE).Size;
+            ChatsContainer.Style = &THEME_SECTION_STYLE;
+            ChatsContainer.DrawContent = [&ClientGui](const ContainerState& State) {
                 const Vector2 CHATS_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
 
+                // SEARCH TEXT INPUT
+                TextInput SearchTextInput = {};
+                SearchTextInput.ID = "SearchTextInput";
+                SearchTextInput.Placeholder = "Search...";
+                SearchTextInput.Size = Vector2(CHATS_CONTAINER_AVAILABLE_SPACE.X, 0.0f);
+                SearchTextInput.Style = &THEME_TEXT_INPUT_STYLE;
+                SearchTextInput.PlaceholderColor = THEME_PLACEHOLDER_COLOR;
+
+                // NOTE: Only starts the search, its result is applied by SyncConversationFilter on a later frame
+                if (ClientGui.DrawTextInput(SearchText, SearchTextInput)) ConversationFilter.SetQuery(SearchText);
+
                 // CONVERSATIONS CONTAINER
                 Container ConversationsContainer = {};
                 ConversationsContainer.ID = "ConversationsContainer";
-                ConversationsContainer.Size = Vector2(CHATS_CONTAINER_AVAILABLE_SPACE);
-                ConversationsContainer.CornerRounding = 10.f;
-                ConversationsContainer.BgColor = Rgba(50, 56, 102, 255);
-                ConversationsContainer.DrawContent = [&ClientGui, &BlankImageTexture, &ClosableImageTexture](const ContainerState& State) {
-                    const Vector2 CONVERSATIONS_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
-
+                ConversationsContainer.Size = Vector2(CHATS_CONTAINER_AVAILABLE_SPACE.X, CHATS_CONTAINER_AVAILABLE_SPACE.Y - ImGui::GetFrameHeightWithSpacing());
+                ConversationsContainer.Style = &THEME_PANEL_STYLE;
+                ConversationsContainer.DrawContent = [&ClientGui](const ContainerState& State) {
                     // CONVERSATIONS NODE
                     Node ConversationsNode = {};
                     ConversationsNode.Name = "Conversations";
-                    ConversationsNode.DrawContent = [&ClientGui, &BlankImageTexture, &ClosableImageTexture]() {
-                        const Vector2 CONVERSATIONS_NODE_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
-
-                        for (int i = 0; i < Conversations.size(); i++)
-                        {
-                            const std::shared_ptr<Conversation> Conversation = Conversations[i];
-
-                            // CONVERSATION CONTAINER
-                            Rgba BgColor = Rgba(50, 56, 102, 255);
-                            if (Conversation->ID == SelectedConversation->ID) BgColor = Rgba(100, 100, 100, 255);
-
-                            Container ConversationContainer = {};
-                            ConversationContainer.ID = "ConversationContainer" + Conversation->ID;;
-                            ConversationContainer.Size = Vector2(CONVERSATIONS_NODE_AVAILABLE_SPACE.X, CONVERSATIONS_NODE_AVAILABLE_SPACE.Y * 0.05f);
-                            ConversationContainer.CornerRounding = 10.f;
-                            ConversationContainer.BgColor = BgColor;
-                            ConversationContainer.BgColorHovered = Rgba(0, 0, 0, 255);
-                            ConversationContainer.IsAutoResizableY = true;
-                            ConversationContainer.DrawContent = [&ClientGui, &BlankImageTexture, &ClosableImageTexture, &Conversation, i](const ContainerState& State) {
-                                const Vector2 CONVERSATION_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
-
-                                // CONVERSATION IMAGE
-                                Image ConversationImage = {};
-                                ConversationImage.TextureID = BlankImageTexture.GetID();
-                                ConversationImage.Size = Vector2(CONVERSATION_CONTAINER_AVAILABLE_SPACE.Y, CONVERSATION_CONTAINER_AVAILABLE_SPACE.Y);
-                                ConversationImage.CornerRounding = 10.0f;
-                                ClientGui.DrawImage(ConversationImage);
-
-                                // SELECT CONVERSATION BUTTON
-                                Button SelectConversationButton = {};
-                                SelectConversationButton.Label = Conversation->ID;
-                                SelectConversationButton.Size = Vector2(
-                                    CONVERSATION_CONTAINER_AVAILABLE_SPACE.X - (ConversationImage.Size.X * 2),
-                                    CONVERSATION_CONTAINER_AVAILABLE_SPACE.Y
-                                );
-                                // NOTE: Transparent background
-                                SelectConversationButton.BgColor = Rgba(0, 0, 0, 0);
-                                // NOTE: Transparent background
-                                SelectConversationButton.BgColorActive = Rgba(0, 0, 0, 0);
-                                // NOTE: Transparent background
-                                SelectConversationButton.BgColorHovered = Rgba(0, 0, 0, 0);
-                                SelectConversationButton.OnClick = [&Conversation]() {
-                                    SelectedConversation = Conversation;
-                                    std::cout << "SELECTED CONVERSATION ID: " << SelectedConversation->ID << std::endl;
-                                };
-
-                                ClientGui.SetPositionX(ConversationImage.Size.X);
-                                ClientGui.DrawButton(SelectConversationButton);
-
-                                // CLOSE CONVERSATION IMAGE BUTTON CONTAINER
-                                if (!State.IsHovered) return;
-
-                                Container CloseConversationImageButtonContainer = {};
-                                CloseConversationImageButtonContainer.ID = "CloseConversationImageButtonContainer" + Conversation->ID;
-                                CloseConversationImageButtonContainer.Size = ConversationImage.Size;
-                                CloseConversationImageButtonContainer.Padding = Vector2(5.0f, 5.0f);
-                                // NOTE: Transparent background
-                                CloseConversationImageButtonContainer.BgColor = Rgba(0, 0, 0, 0);
-                                CloseConversationImageButtonContainer.DrawContent = [&ClientGui, &ClosableImageTexture, &Conversation, i](const ContainerState& State) {
-                                    // CLOSE CONVERSATION IMAGE BUTTON
-                                    Image CloseConversationImageButtonImage = {};
-                                    CloseConversationImageButtonImage.TextureID = ClosableImageTexture.GetID();
-                                    CloseConversationImageButtonImage.Size = ClientGui.GetAvailableSpace();
-                                    CloseConversationImageButtonImage.TintColor = Rgba(255, 255, 255, 255);
-                                    CloseConversationImageButtonImage.CornerRounding = 0.0f;
-
-                                    ImageButton CloseConversationImageButton = {};
-                                    CloseConversationImageButton.ID = "CloseConversationImageButton" + Conversation->ID;
-                                    CloseConversationImageButton.Image = CloseConversationImageButtonImage;
-                                    CloseConversationImageButton.TintColorHovered = Rgba(200, 200, 0, 255);
-                                    CloseConversationImageButton.OnClick = [i]() {
-                                        const std::string& ID = Conversations[i]->ID;
-
-                                        // Deletes conversation
-                                        Conversations.erase(Conversations.begin() + i);
-                                        // Selects first conversation if deleted conversation is the selected one
-                                        if (SelectedConversation->ID == ID) SelectedConversation = Conversations[0];
-
-                                        std::cout << "DELETED CONVERSATION ID: " << ID << std::endl;
-                                    };
-
-                                    ClientGui.DrawImageButton(CloseConversationImageButton);
-                                };
-
-                                ClientGui.DisplayInline();
-                                ClientGui.SetPositionX(ConversationImage.Size.X + SelectConversationButton.Size.X);
-                                ClientGui.DrawContainer(CloseConversationImageButtonContainer);
-                            };
-
-                            ClientGui.DrawContainer(ConversationContainer);
-                        }
+                    ConversationsNode.DrawContent = [&ClientGui]() {
+                        // NOTE: Rows are retained widgets, only rebuilt by SyncConversationRows when conversations change
+                        ConversationWidgets.DrawChildren(ClientGui, ConversationRowsRoot);
                     };
 
                     ClientGui.DrawNode(ConversationsNode);
@@ -321,106 +646,48 @@ int main()
                 ClientGui.DrawContainer(ConversationsContainer);
             };
 
+            ClientGui.SetPosition(MAIN_WINDOW_ORIGIN + MainLayout.GetRect(CHATS_NODE).Position);
             ClientGui.DrawContainer(ChatsContainer);
 
             // SELECTED CONVERSATION CONTAINER
             Container SelectedConversationContainer = {};
             SelectedConversationContainer.ID = "SelectedConversationContainer";
-            SelectedConversationContainer.Size = Vector2(MAIN_WINDOW_AVAILABLE_SPACE.X * 0.75f, MAIN_WINDOW_AVAILABLE_SPACE.Y * 0.70f);
-            SelectedConversationContainer.Padding = Vector2(15.0f, 15.0f);
-            // NOTE: Transparent background
-            SelectedConversationContainer.BgColor = Rgba(0, 0, 0, 0);
-            SelectedConversationContainer.DrawContent = [&ClientGui, &BlankImageTexture](const ContainerState& State) {
+            SelectedConversationContainer.Size = MainLayout.GetRect(SELECTED_CONVERSATION_NODE).Size;
+            SelectedConversationContainer.Style = &THEME_SECTION_STYLE;
+            SelectedConversationContainer.DrawContent = [&ClientGui, &BlankImageTexture, &AvatarTextureCache](const ContainerState& State) {
                 const Vector2 SELECTED_CONVERSATION_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
 
                 // MESSSAGES CONTAINER
                 Container MessagesContainer = {};
                 MessagesContainer.ID = "MessagesContainer";
                 MessagesContainer.Size = Vector2(SELECTED_CONVERSATION_CONTAINER_AVAILABLE_SPACE);
-                MessagesContainer.CornerRounding = 10.f;
-                MessagesContainer.BgColor = Rgba(50, 56, 102, 255);
-                MessagesContainer.DrawContent = [&ClientGui, &BlankImageTexture](const ContainerState& State) {
-                    const Vector2 MESSAGES_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
-
-                    for (int i = 0; i < SelectedConversation->Messages.size(); i++)
+                MessagesContainer.Style = &THEME_PANEL_STYLE;
+                MessagesContainer.DrawContent = [&ClientGui, &BlankImageTexture, &AvatarTextureCache](const ContainerState& State) {
+                    const Conversation* SelectedConversation = Conversations.Get(SelectedConversationHandle);
+                    if (!SelectedConversation) return;
+
+                    // NOTE: Only the matching messages are shown while searching, all of them when only the title matched
+                    static const std::vector<uint32_t> NO_MESSAGE_INDICES = {};
+                    const std::vector<uint32_t>* MessageIndices = nullptr;
+                    const auto Match = ConversationFilterResult.MatchesByConversationID.find(SelectedConversation->ID);
+                    if (Match != ConversationFilterResult.MatchesByConversationID.end())
                     {
-                        // MESSAGE CONTAINER
-                        const Message& MESSAGE = SelectedConversation->Messages[i];
-                        const std::string& ID = "MessageContainer" + std::to_string(i);
-
-                        Container MessageContainer = {};
-                        MessageContainer.ID = ID;
-                        MessageContainer.Size = Vector2(MESSAGES_CONTAINER_AVAILABLE_SPACE.X, 0.0f);
-                        MessageContainer.Padding = Vector2(10.0f, 10.0f);
-                        // NOTE: Transparent background
-                        MessageContainer.BgColor = Rgba(0, 0, 0, 0);
-                        MessageContainer.IsAutoResizableY = true;
-                        MessageContainer.DrawContent = [&ClientGui, &BlankImageTexture, &MESSAGE](const ContainerState& State) {
-                            const Vector2 MESSAGE_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
-
-                            // MESSAGE SENDER IMAGE
-                            // NOTE: Images are drawn directly over elements so anything that needs to go beside will have to be postioned manually
-                            Image MessageSenderImage = {};
-                            MessageSenderImage.TextureID = BlankImageTexture.GetID();
-                            MessageSenderImage.Size = Vector2(MESSAGE_CONTAINER_AVAILABLE_SPACE.X * 0.05f, MESSAGE_CONTAINER_AVAILABLE_SPACE.X * 0.05f);
-                            MessageSenderImage.CornerRounding = 10.0f;
-                            ClientGui.DrawImage(MessageSenderImage);
-
-                            // MESSAGE DETAILS CONTAINER
-                            ImGuiStyle& Style = ImGui::GetStyle();
-
-                            Container MessageDetailsContainer = {};
-                            MessageDetailsContainer.ID = "MessageDetailsContainer";
-                            MessageDetailsContainer.Size = Vector2(MESSAGE_CONTAINER_AVAILABLE_SPACE.X - MessageSenderImage.Size.X, 0.0f);
-                            MessageDetailsContainer.Padding = Vector2(Style.WindowPadding.x / 1.5f, 0.0f);
-                            // NOTE: Transparent background
-                            MessageDetailsContainer.BgColor = Rgba(0, 0, 0, 0);
-                            MessageDetailsContainer.IsAutoResizableY = true;
-                            MessageDetailsContainer.DrawContent = [&ClientGui, &MESSAGE](const ContainerState& State) {
-                                // MESSAGE SENDER FIRSTNAME TEXT
-                                Text MessageSenderFirstNameText = {};
-                                MessageSenderFirstNameText.Value = MESSAGE.SenderFirstName;
-                                ClientGui.DrawText(MessageSenderFirstNameText);
-
-                                // MESSAGE CREATED AT TEXT
-                                std::tm* MessageCreatedAtDate = std::localtime(&MESSAGE.CreatedAt);
-                                const std::string& MESSAGE_CREATED_AT_STRING_DATE = asctime(MessageCreatedAtDate);
-
-                                Text MessageCreatedAtText = {};
-                                MessageCreatedAtText.Value = MESSAGE_CREATED_AT_STRING_DATE;
-                                ClientGui.DisplayInline();
-                                ClientGui.DrawText(MessageCreatedAtText);
-
-                                // MESSAGE TEXT
-                                Text MessageText = {};
-                                MessageText.Value = MESSAGE.Text;
-                                ClientGui.DrawTextWrapped(MessageText);
-
-                            };
-
-                            ClientGui.SetPositionX(MessageSenderImage.Size.X + 10.0f);
-                            ClientGui.DrawContainer(MessageDetailsContainer);
-
-                        };
-
-                        ClientGui.DrawContainer(MessageContainer);
+                        if (!Match->second.MessageIndices.empty()) MessageIndices = &Match->second.MessageIndices;
                     }
-
-                    // Before drawing content, check if we are already at the bottom
-                    const bool IsAtBottom = ClientGui.GetScrollPositionY() >= ClientGui.GetMaxScrollPositionY();
-                    // Auto-scroll logic: only scroll if the user hasn't moved away from the bottom
-                    if (IsAtBottom)
+                    else if (!ConversationFilterResult.Query.empty())
                     {
-                        // Scrolls to the end
-                        ClientGui.ScrollToY(1.0f);
+                        MessageIndices = &NO_MESSAGE_INDICES;
                     }
+
+                    DrawMessages(ClientGui, *SelectedConversation, [&BlankImageTexture, &AvatarTextureCache](const std::string& ImageUrl) {
+                        return AvatarTextureCache.Get(ImageUrl, TextureRegion(BlankImageTexture.GetID()));
+                    }, MessageIndices);
                 };
 
                 ClientGui.DrawContainer(MessagesContainer);
             };
 
-            ClientGui.DisplayInline();
-            ClientGui.SetPositionX(MAIN_WINDOW_AVAILABLE_SPACE.X * 0.25f);
+            ClientGui.SetPosition(MAIN_WINDOW_ORIGIN + MainLayout.GetRect(SELECTED_CONVERSATION_NODE).Position);
             ClientGui.DrawContainer(SelectedConversationContainer);
 
             // MESSAGE TEXT INPUT CONTAINER
@@ -428,10 +695,8 @@ int main()
 
             Container MessageTextInputContainer = {};
             MessageTextInputContainer.ID = "TextInputContainer";
-            MessageTextInputContainer.Size = Vector2(MAIN_WINDOW_AVAILABLE_SPACE.X * 0.60f, MAIN_WINDOW_AVAILABLE_SPACE.Y * 0.15f);
-            MessageTextInputContainer.Padding = Vector2(15.0f, 15.0f);
-            // NOTE: Transparent background
-            MessageTextInputContainer.BgColor = Rgba(0, 0, 0, 0);
+            MessageTextInputContainer.Size = MainLayout.GetRect(MESSAGE_TEXT_INPUT_NODE).Size;
+            MessageTextInputContainer.Style = &THEME_SECTION_STYLE;
             MessageTextInputContainer.DrawContent = [&ClientGui](const ContainerState& State) {
                 const Vector2 MESSAGE_TEXTINPUT_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
 
@@ -440,25 +705,20 @@ int main()
                 MessageTextInput.ID = "MessageTextInput";
                 MessageTextInput.Placeholder = "Enter message here...";
                 MessageTextInput.Size = Vector2(MESSAGE_TEXTINPUT_CONTAINER_AVAILABLE_SPACE);
-                MessageTextInput.Padding = Vector2(15.0f, 15.0f);
-                MessageTextInput.CornerRounding = 10.f;
-                MessageTextInput.BgColor = Rgba(43, 50, 94, 255);
-                MessageTextInput.PlaceholderColor = Rgba(120, 125, 172, 255);
+                MessageTextInput.Style = &THEME_TEXT_INPUT_STYLE;
+                MessageTextInput.PlaceholderColor = THEME_PLACEHOLDER_COLOR;
 
                 ClientGui.DrawTextInputMultiline(MessageText, MessageTextInput);
             };
 
-            ClientGui.SetPositionX(MAIN_WINDOW_AVAILABLE_SPACE.X * 0.25f);
-            ClientGui.SetPositionY(MAIN_WINDOW_AVAILABLE_SPACE.Y * 0.85f);
+            ClientGui.SetPosition(MAIN_WINDOW_ORIGIN + MainLayout.GetRect(MESSAGE_TEXT_INPUT_NODE).Position);
             ClientGui.DrawContainer(MessageTextInputContainer);
 
             // SEND BUTTON CONTAINER
             Container SendButtonContainer = {};
             SendButtonContainer.ID = "SendButtonContainer";
-            SendButtonContainer.Size = Vector2(MAIN_WINDOW_AVAILABLE_SPACE.X * 0.15f, MAIN_WINDOW_AVAILABLE_SPACE.Y * 0.15f);
-            SendButtonContainer.Padding = Vector2(15.0f, 15.0f);
-            // NOTE: Transparent background
-            SendButtonContainer.BgColor = Rgba(0, 0, 0, 0);
+            SendButtonContainer.Size = MainLayout.GetRect(SEND_BUTTON_NODE).Size;
+            SendButtonContainer.Style = &THEME_SECTION_STYLE;
             SendButtonContainer.DrawContent = [&ClientGui](const ContainerState& State) {
                 const Vector2 SEND_BUTTON_CONTAINER_AVAILABLE_SPACE = ClientGui.GetAvailableSpace();
 
@@ -466,24 +726,24 @@ int main()
                 Button SendButton = {};
                 SendButton.Label = "Send";
                 SendButton.Size = Vector2(SEND_BUTTON_CONTAINER_AVAILABLE_SPACE.X * 0.70f, SEND_BUTTON_CONTAINER_AVAILABLE_SPACE.Y * 0.40f);
-                SendButton.BgColor = Rgba(200, 30, 30, 255); // Red button
-                SendButton.BgColorActive = Rgba(150, 0, 0, 255); // Darker red when active
-                SendButton.BgColorHovered = Rgba(255, 100, 100, 255); // Lighter red on hover
-                SendButton.CornerRounding = 10.0f;
-                SendButton.IsDisabled  = MessageText.empty();
+                SendButton.Style = &THEME_ACCENT_BUTTON_STYLE;
+                SendButton.IsDisabled  = MessageText.empty() || !Conversations.Get(SelectedConversationHandle);
                 SendButton.OnClick = []() {
+                    // NOTE: ID stays empty until the server acknowledges the message
                     Message NewMessage = {};
-                    NewMessage.ID = "FakeID";
-                    NewMessage.ConversationID = SelectedConversation->ID;
+                    NewMessage.ConversationID = Conversations.Get(SelectedConversationHandle)->ID;
                     NewMessage.SenderID = "FakeSenderID";
                     NewMessage.SenderFirstName = "Olivier";
                     NewMessage.SenderImageUrl = "https://fakeimageurl.com";
                     NewMessage.Text = MessageText;
                     NewMessage.CreatedAt = std::time(0);
 
-                    // TODO: Server call to persist message will go there
-
-                    SelectedConversation->Messages.push_back(NewMessage);
+                    // NOTE: Batched with messages sent in the same few milliseconds and retried until acknowledged
+                    Outbound.Enqueue(NewMessage, glfwGetTime());
+                    // NOTE: Persisted as pending so it is sent again if the client stops before it is acknowledged
+                    ClientMessageCache.AppendMessage(NewMessage);
+                    // NOTE: Also moves the conversation to the top of the conversations list
+                    Conversations.AddMessage(SelectedConversationHandle, NewMessage);
                     std::cout << "SENT: " << MessageText << std::endl;
                 };
 
@@ -491,20 +751,67 @@ int main()
                 ClientGui.DrawButton(SendButton);
             };
 
-            ClientGui.DisplayInline();
-            ClientGui.SetPositionX(MAIN_WINDOW_AVAILABLE_SPACE.X * 0.85f);
+            ClientGui.SetPosition(MAIN_WINDOW_ORIGIN + MainLayout.GetRect(SEND_BUTTON_NODE).Position);
             ClientGui.DrawContainer(SendButtonContainer);
         };
 
         ClientGui.DrawWindow(MainWindow);
 
+        // Deletes conversation
+        const Conversation* PendingRemovalConversation = Conversations.Get(PendingRemovalConversationHandle);
+        if (PendingRemovalConversation)
+        {
+            const std::string ID = PendingRemovalConversation->ID;
+            Conversations.Remove(PendingRemovalConversationHandle);
+            ClientMessageCache.RemoveConversation(ID);
+            ConversationFilter.RemoveConversation(ID);
+            ConversationFilterMessagesCounts.erase(PendingRemovalConversationHandle);
+            LoadedHistoryConversationIDs.erase(ID);
+            // Selects most recent conversation if deleted conversation is the selected one
+            if (PendingRemovalConversationHandle == SelectedConversationHandle)
+            {
+                SelectedConversationHandle = Conversations.GetMostRecent();
+                LoadConversationHistory(SelectedConversationHandle);
+            }
+
+            std::cout << "DELETED CONVERSATION ID: " << ID << std::endl;
+        }
+        PendingRemovalConversationHandle = {};
+
+        ClientFrameProfiler.DrawOverlay();
+
         // Rendering
         ClientGui.Render();
 
-        glfwSwapBuffers(GlfwWindow);
-        glfwPollEvents();
+        // Evicts avatars that were not drawn this frame once over budget
+        {
+            ScopeTimer TextureTrimTimer(ClientFrameProfiler, "TextureTrim");
+            AvatarTextureCache.Trim();
+        }
+
+        {
+            ScopeTimer SwapBuffersTimer(ClientFrameProfiler, "SwapBuffers");
+            glfwSwapBuffers(GlfwWindow);
+        }
+        // NOTE: Ended before waiting so idle time is not counted in the frame
+        ClientFrameProfiler.EndFrame();
+
+        // Sends messages queued this frame once their batch window is over and retries unacknowledged ones
+        const double NEXT_OUTBOUND_UPDATE_TIME = Outbound.Update(glfwGetTime());
+        if (NEXT_OUTBOUND_UPDATE_TIME >= 0.0) ClientFrameScheduler.RequestRedrawAt(NEXT_OUTBOUND_UPDATE_TIME);
+
+        if (IsFrameTraceDumpRequested)
+        {
+            if (ClientFrameProfiler.WriteChromeTrace(FRAME_TRACE_FILE_PATH)) std::cout << "FRAME TRACE WRITTEN: " << FRAME_TRACE_FILE_PATH << std::endl;
+            IsFrameTraceDumpRequested = false;
+        }
+
+        ClientFrameScheduler.WaitForEvents();
     }
 
+    // NOTE: Writes the index so the next launch does not have to replay the log
+    ClientMessageCache.Close();
+    AvatarTextureCache.Destroy();
     BlankImageTexture.Destroy();
     ClosableImageTexture.Destroy();
     ClientGui.Destroy();
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// NOTE: "CAPK" read as a little endian integer
+constexpr uint32_t ASSET_PACK_MAGIC = 0x4B504143;
+constexpr uint32_t ASSET_PACK_VERSION = 1;
+constexpr size_t ASSET_PACK_NAME_SIZE = 48;
+// NOTE: Every asset starts on this alignment so pixels can be handed to the GPU straight from the mapping
+constexpr size_t ASSET_PACK_ALIGNMENT = 16;
+
+enum class AssetType : uint32_t
+{
+	// NOTE: Decoded pixels, rows are tightly packed with ChannelsCount bytes per pixel
+	Image = 0,
+	// NOTE: Raw TrueType data, glyphs are rasterized on demand by ImGui
+	Font = 1
+};
+
+// NOTE: Layout of a pack is the header, then EntriesCount entries, then the aligned asset data
+struct AssetPackHeader
+{
+  public:
+	uint32_t Magic = ASSET_PACK_MAGIC;
+	uint32_t Version = ASSET_PACK_VERSION;
+	uint32_t EntriesCount = 0;
+	uint32_t Reserved = 0;
+};
+
+struct AssetPackEntry
+{
+  public:
+	char Name[ASSET_PACK_NAME_SIZE] = {};
+	AssetType Type = AssetType::Image;
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+	uint32_t ChannelsCount = 0;
+	// NOTE: From the start of the pack
+	uint64_t Offset = 0;
+	uint64_t Size = 0;
+};
+
+static_assert(sizeof(AssetPackHeader) == 16, "AssetPackHeader layout is part of the pack format");
+static_assert(sizeof(AssetPackEntry) == 80, "AssetPackEntry layout is part of the pack format");
+
+// NOTE: Read-only view of a pack baked by the AssetBaker tool, the file is memory mapped so assets are paged in
+// lazily and never copied, pointers returned by GetData stay valid until Close
+class AssetPack
+{
+  public:
+	AssetPack() = default;
+	~AssetPack();
+	AssetPack(const AssetPack &) = delete;
+	AssetPack &operator=(const AssetPack &) = delete;
+
+	// Getters
+	[[nodiscard]] bool IsOpen() const;
+	[[nodiscard]] const AssetPackEntry *Find(std::string_view Name) const;
+	[[nodiscard]] const unsigned char *GetData(const AssetPackEntry &Entry) const;
+
+	// NOTE: Returns false when the file is missing or is not a valid pack of this version, including when an image's
+	// dimensions do not fit in its data
+	bool Open(const std::string &FilePath);
+	void Close();
+
+  private:
+	const unsigned char *m_Data = nullptr;
+	size_t m_Size = 0;
+	const AssetPackEntry *m_Entries = nullptr;
+	uint32_t m_EntriesCount = 0;
+};
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// NOTE: Layout of a record is the header, then one slot per field in schema order, then the string and list data the
+// slots point to
+// Scalars are stored in their slot, strings and lists store the offset of their data from the start of the record and
+// its length or count
+constexpr size_t BINARY_RECORD_SLOT_SIZE = 8;
+
+struct BinaryRecordHeader
+{
+  public:
+	// NOTE: Size of the whole record, header included, so records can be stepped over without reading them
+	uint32_t Size = 0;
+	uint16_t Version = 0;
+	uint16_t FieldsCount = 0;
+};
+
+static_assert(sizeof(BinaryRecordHeader) == 8, "BinaryRecordHeader layout is part of the record format");
+
+// NOTE: Specialized for every encoded type with a VERSION and FIELDS, a tuple of member pointers in encoding order
+// Fields are only ever appended, a reader reads fields past the FieldsCount of an older record as their default value
+// and ignores fields of a newer record it does not know, VERSION is bumped when the meaning of a field changes
+template <typename Type> struct BinarySchema;
+
+template <typename Type, typename = void> struct HasBinarySchema : std::false_type
+{
+};
+template <typename Type>
+struct HasBinarySchema<Type, std::void_t<decltype(BinarySchema<Type>::FIELDS)>> : std::true_type
+{
+};
+
+template <typename Type> class BinaryView;
+
+// NOTE: Iterates the records of a list field without decoding them
+template <typename Element> class BinaryListView
+{
+  public:
+	class Iterator
+	{
+	  public:
+		Iterator() = default;
+		Iterator(const char *Data, size_t Size, uint32_t RemainingCount)
+		    : m_Data(Data), m_Size(Size), m_RemainingCount(RemainingCount)
+		{
+		}
+
+		BinaryView<Element> operator*() const
+		{
+			return BinaryView<Element>(std::string_view(m_Data, m_Size));
+		}
+
+		Iterator &operator++()
+		{
+			const size_t RECORD_SIZE = BinaryView<Element>(std::string_view(m_Data, m_Size)).GetSize();
+			m_Data += RECORD_SIZE;
+			m_Size -= RECORD_SIZE;
+			m_RemainingCount--;
+			return *this;
+		}
+
+		bool operator!=(const Iterator &Other) const
+		{
+			return m_RemainingCount != Other.m_RemainingCount;
+		}
+
+	  private:
+		const char *m_Data = nullptr;
+		size_t m_Size = 0;
+		uint32_t m_RemainingCount = 0;
+	};
+
+	BinaryListView() = default;
+	BinaryListView(const char *Data, size_t Size, uint32_t Count) : m_Data(Data), m_Size(Size), m_Count(Count)
+	{
+	}
+
+	[[nodiscard]] size_t size() const
+	{
+		return m_Count;
+	}
+
+	[[nodiscard]] bool empty() const
+	{
+		return m_Count == 0;
+	}
+
+	[[nodiscard]] Iterator begin() const
+	{
+		return Iterator(m_Data, m_Size, m_Count);
+	}
+
+	[[nodiscard]] Iterator end() const
+	{
+		return Iterator(nullptr, 0, 0);
+	}
+
+  private:
+	const char *m_Data = nullptr;
+	size_t m_Size = 0;
+	uint32_t m_Count = 0;
+};
+
+namespace BinaryCodecDetail
+{
+template <typename Type> struct IsList : std::false_type
+{
+};
+template <typename Element> struct IsList<std::vector<Element>> : HasBinarySchema<Element>
+{
+};
+
+template <typename Member> struct MemberTraits;
+template <typename Owner, typename Field> struct MemberTraits<Field Owner::*>
+{
+	using FieldType = Field;
+};
+
+template <typename Type> constexpr size_t GetFieldsCount()
+{
+	return std::tuple_size_v<std::decay_t<decltype(BinarySchema<Type>::FIELDS)>>;
+}
+
+template <typename Type, size_t Index>
+using FieldType = typename MemberTraits<std::tuple_element_t<Index, std::decay_t<decltype(BinarySchema<Type>::FIELDS)>>>::FieldType;
+
+template <auto Member, typename Candidate> constexpr bool IsSameMember(Candidate CandidateMember)
+{
+	if constexpr (std::is_same_v<decltype(Member), Candidate>)
+		return Member == CandidateMember;
+	else
+		return false;
+}
+
+template <typename Type, auto Member, size_t... Indices> constexpr size_t FindFieldIndex(std::index_sequence<Indices...>)
+{
+	size_t FieldIndex = SIZE_MAX;
+	((FieldIndex == SIZE_MAX && IsSameMember<Member>(std::get<Indices>(BinarySchema<Type>::FIELDS)) ? (FieldIndex = Indices) : 0), ...);
+	return FieldIndex;
+}
+
+inline void WriteSlot(char *Record, size_t Index, uint32_t Low, uint32_t High)
+{
+	char *Slot = Record + sizeof(BinaryRecordHeader) + Index * BINARY_RECORD_SLOT_SIZE;
+	std::memcpy(Slot, &Low, sizeof(Low));
+	std::memcpy(Slot + sizeof(Low), &High, sizeof(High));
+}
+
+template <typename Type> size_t GetEncodedSize(const Type &Value);
+template <typename Type> size_t WriteRecord(const Type &Value, char *Record);
+
+template <typename Type, size_t Index> size_t GetFieldDataSize(const Type &Value)
+{
+	using Field = FieldType<Type, Index>;
+	const Field &FIELD = Value.*std::get<Index>(BinarySchema<Type>::FIELDS);
+
+	if constexpr (std::is_same_v<Field, std::string>)
+	{
+		return FIELD.size();
+	}
+	else if constexpr (IsList<Field>::value)
+	{
+		size_t DataSize = 0;
+		for (const auto &Element : FIELD)
+		{
+			DataSize += GetEncodedSize(Element);
+		}
+		return DataSize;
+	}
+	else
+	{
+		static_assert(std::is_trivially_copyable_v<Field> && sizeof(Field) <= BINARY_RECORD_SLOT_SIZE,
+		              "Only strings, lists of schema types and scalars fitting a slot can be encoded");
+		return 0;
+	}
+}
+
+template <typename Type, size_t Index> void WriteField(const Type &Value, char *Record, size_t &DataOffset)
+{
+	using Field = FieldType<Type, Index>;
+	const Field &FIELD = Value.*std::get<Index>(BinarySchema<Type>::FIELDS);
+	const uint32_t FIELD_DATA_OFFSET = static_cast<uint32_t>(DataOffset);
+
+	if constexpr (std::is_same_v<Field, std::string>)
+	{
+		std::memcpy(Record + DataOffset, FIELD.data(), FIELD.size());
+		DataOffset += FIELD.size();
+		WriteSlot(Record, Index, FIELD_DATA_OFFSET, static_cast<uint32_t>(FIELD.size()));
+	}
+	else if constexpr (IsList<Field>::value)
+	{
+		for (const auto &Element : FIELD)
+		{
+			DataOffset += WriteRecord(Element, Record + DataOffset);
+		}
+		WriteSlot(Record, Index, FIELD_DATA_OFFSET, static_cast<uint32_t>(FIELD.size()));
+	}
+	else
+	{
+		// NOTE: Zeroed first so unused bytes of small scalars are deterministic
+		std::memset(Record + sizeof(BinaryRecordHeader) + Index * BINARY_RECORD_SLOT_SIZE, 0, BINARY_RECORD_SLOT_SIZE);
+		std::memcpy(Record + sizeof(BinaryRecordHeader) + Index * BINARY_RECORD_SLOT_SIZE, &FIELD, sizeof(Field));
+	}
+}
+
+template <typename Type, size_t... Indices> size_t GetEncodedSize(const Type &Value, std::index_sequence<Indices...>)
+{
+	return sizeof(BinaryRecordHeader) + sizeof...(Indices) * BINARY_RECORD_SLOT_SIZE +
+	       (GetFieldDataSize<Type, Indices>(Value) + ... + 0);
+}
+
+template <typename Type> size_t GetEncodedSize(const Type &Value)
+{
+	return GetEncodedSize(Value, std::make_index_sequence<GetFieldsCount<Type>()>{});
+}
+
+template <typename Type, size_t... Indices> size_t WriteRecord(const Type &Value, char *Record, std::index_sequence<Indices...>)
+{
+	size_t DataOffset = sizeof(BinaryRecordHeader) + sizeof...(Indices) * BINARY_RECORD_SLOT_SIZE;
+	(WriteField<Type, Indices>(Value, Record, DataOffset), ...);
+
+	BinaryRecordHeader Header = {};
+	Header.Size = static_cast<uint32_t>(DataOffset);
+	Header.Version = BinarySchema<Type>::VERSION;
+	Header.FieldsCount = static_cast<uint16_t>(sizeof...(Indices));
+	std::memcpy(Record, &Header, sizeof(Header));
+	return DataOffset;
+}
+
+// NOTE: Record has to hold GetEncodedSize bytes, returns the size written
+template <typename Type> size_t WriteRecord(const Type &Value, char *Record)
+{
+	return WriteRecord(Value, Record, std::make_index_sequence<GetFieldsCount<Type>()>{});
+}
+} // namespace BinaryCodecDetail
+
+// NOTE: Appends the record to Buffer, sized once up front so there is no allocation once the buffer has grown to the
+// size of the records it holds
+// Records are limited to 4 GB
+template <typename Type> void EncodeBinary(const Type &Value, std::string &Buffer)
+{
+	const size_t RECORD_OFFSET = Buffer.size();
+	Buffer.resize(RECORD_OFFSET + BinaryCodecDetail::GetEncodedSize(Value));
+	BinaryCodecDetail::WriteRecord(Value, &Buffer[RECORD_OFFSET]);
+}
+
+// NOTE: Reads fields straight from the encoded bytes, strings are views into them so the view is only valid as long
+// as the bytes are
+// The whole record, nested records included, is bounds checked once on construction, fields are then read without
+// further checks
+template <typename Type> class BinaryView
+{
+  public:
+	BinaryView() = default;
+	// NOTE: Bytes can extend past the record, only the size given by its header is read
+	explicit BinaryView(std::string_view Bytes)
+	{
+		BinaryRecordHeader Header = {};
+		if (Bytes.size() < sizeof(Header))
+			return;
+
+		std::memcpy(&Header, Bytes.data(), sizeof(Header));
+		const size_t SLOTS_SIZE = static_cast<size_t>(Header.FieldsCount) * BINARY_RECORD_SLOT_SIZE;
+		if (Header.Size > Bytes.size() || Header.Size < sizeof(Header) + SLOTS_SIZE)
+		{
+			// Handles truncated record error
+			return;
+		}
+
+		m_Data = Bytes.data();
+		m_Size = Header.Size;
+		m_Version = Header.Version;
+		m_FieldsCount = Header.FieldsCount;
+		if (!ValidateFields(std::make_index_sequence<BinaryCodecDetail::GetFieldsCount<Type>()>{}))
+		{
+			// Handles out of bounds field error
+			m_Data = nullptr;
+		}
+	}
+
+	[[nodiscard]] bool IsValid() const
+	{
+		return m_Data != nullptr;
+	}
+
+	[[nodiscard]] uint16_t GetVersion() const
+	{
+		return m_Version;
+	}
+
+	// NOTE: Size of the record, header included, 0 when invalid
+	[[nodiscard]] size_t GetSize() const
+	{
+		return IsValid() ? m_Size : 0;
+	}
+
+	// NOTE: Strings are read as std::string_view, lists as BinaryListView and scalars by value
+	template <auto Member> auto Get() const
+	{
+		constexpr size_t FIELD_INDEX = BinaryCodecDetail::FindFieldIndex<Type, Member>(
+		    std::make_index_sequence<BinaryCodecDetail::GetFieldsCount<Type>()>{});
+		static_assert(FIELD_INDEX != SIZE_MAX, "Member is not part of the schema");
+
+		return GetField<FIELD_INDEX>();
+	}
+
+	template <size_t Index> auto GetField() const
+	{
+		using Field = BinaryCodecDetail::FieldType<Type, Index>;
+		const bool IS_PRESENT = IsValid() && Index < m_FieldsCount;
+
+		uint32_t Offset = 0;
+		uint32_t Length = 0;
+		if (IS_PRESENT)
+			ReadSlot(Index, Offset, Length);
+
+		if constexpr (std::is_same_v<Field, std::string>)
+		{
+			return IS_PRESENT ? std::string_view(m_Data + Offset, Length) : std::string_view();
+		}
+		else if constexpr (BinaryCodecDetail::IsList<Field>::value)
+		{
+			using Element = typename Field::value_type;
+			return IS_PRESENT ? BinaryListView<Element>(m_Data + Offset, m_Size - Offset, Length) : BinaryListView<Element>();
+		}
+		else
+		{
+			Field Value = {};
+			if (IS_PRESENT)
+				std::memcpy(&Value, m_Data + sizeof(BinaryRecordHeader) + Index * BINARY_RECORD_SLOT_SIZE, sizeof(Field));
+			return Value;
+		}
+	}
+
+  private:
+	const char *m_Data = nullptr;
+	uint32_t m_Size = 0;
+	uint16_t m_Version = 0;
+	uint16_t m_FieldsCount = 0;
+
+	void ReadSlot(size_t Index, uint32_t &Low, uint32_t &High) const
+	{
+		const char *SLOT = m_Data + sizeof(BinaryRecordHeader) + Index * BINARY_RECORD_SLOT_SIZE;
+		std::memcpy(&Low, SLOT, sizeof(Low));
+		std::memcpy(&High, SLOT + sizeof(Low), sizeof(High));
+	}
+
+	template <size_t Index> bool ValidateField() const
+	{
+		using Field = BinaryCodecDetail::FieldType<Type, Index>;
+		if constexpr (std::is_same_v<Field, std::string> || BinaryCodecDetail::IsList<Field>::value)
+		{
+			if (Index >= m_FieldsCount)
+				return true;
+
+			uint32_t Offset = 0;
+			uint32_t Length = 0;
+			ReadSlot(Index, Offset, Length);
+			if (Offset > m_Size)
+				return false;
+
+			if constexpr (std::is_same_v<Field, std::string>)
+			{
+				return Length <= m_Size - Offset;
+			}
+			else
+			{
+				// NOTE: Every element is validated here so iterating the list never reads out of bounds
+				using Element = typename Field::value_type;
+				std::string_view Remaining(m_Data + Offset, m_Size - Offset);
+				for (uint32_t i = 0; i < Length; i++)
+				{
+					const BinaryView<Element> ELEMENT(Remaining);
+					if (!ELEMENT.IsValid())
+						return false;
+					Remaining.remove_prefix(ELEMENT.GetSize());
+				}
+				return true;
+			}
+		}
+		else
+		{
+			return true;
+		}
+	}
+
+	template <size_t... Indices> bool ValidateFields(std::index_sequence<Indices...>) const
+	{
+		return (ValidateField<Indices>() && ...);
+	}
+};
+
+namespace BinaryCodecDetail
+{
+template <typename Type, size_t Index> void DecodeField(const BinaryView<Type> &View, Type &Value)
+{
+	using Field = FieldType<Type, Index>;
+	Field &FIELD = Value.*std::get<Index>(BinarySchema<Type>::FIELDS);
+
+	if constexpr (std::is_same_v<Field, std::string>)
+	{
+		FIELD.assign(View.template GetField<Index>());
+	}
+	else if constexpr (IsList<Field>::value)
+	{
+		const auto LIST = View.template GetField<Index>();
+		FIELD.clear();
+		FIELD.reserve(LIST.size());
+		for (const auto ELEMENT : LIST)
+		{
+			DecodeBinary(ELEMENT, FIELD.emplace_back());
+		}
+	}
+	else
+	{
+		FIELD = View.template GetField<Index>();
+	}
+}
+
+template <typename Type, size_t... Indices>
+void DecodeFields(const BinaryView<Type> &View, Type &Value, std::index_sequence<Indices...>)
+{
+	(DecodeField<Type, Indices>(View, Value), ...);
+}
+} // namespace BinaryCodecDetail
+
+// NOTE: Copies the record into an owning value, fields missing from an older record are reset to their default
+template <typename Type> bool DecodeBinary(const BinaryView<Type> &View, Type &Value)
+{
+	if (!View.IsValid())
+	{
+		// Handles invalid record error
+		return false;
+	}
+
+	BinaryCodecDetail::DecodeFields(View, Value, std::make_index_sequence<BinaryCodecDetail::GetFieldsCount<Type>()>{});
+	return true;
+}
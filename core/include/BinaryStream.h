@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// NOTE: Values are written in host byte order, every machine the client and server run on is little endian
+template <typename Type> void WriteBinaryValue(std::string &Buffer, Type Value)
+{
+	static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable values can be written as bytes");
+	Buffer.append(reinterpret_cast<const char *>(&Value), sizeof(Value));
+}
+
+// NOTE: Length prefixed with a uint32_t
+inline void WriteBinaryString(std::string &Buffer, std::string_view Value)
+{
+	WriteBinaryValue<uint32_t>(Buffer, static_cast<uint32_t>(Value.size()));
+	Buffer.append(Value.data(), Value.size());
+}
+
+// NOTE: Reads fail once past the end of the data instead of reading out of bounds, IsValid is checked once at the end
+struct BinaryReader
+{
+  public:
+	const unsigned char *Data = nullptr;
+	size_t Size = 0;
+	size_t Offset = 0;
+	bool IsValid = true;
+
+	BinaryReader() = default;
+	BinaryReader(const unsigned char *Data, size_t Size) : Data(Data), Size(Size)
+	{
+	}
+	explicit BinaryReader(std::string_view Bytes)
+	    : Data(reinterpret_cast<const unsigned char *>(Bytes.data())), Size(Bytes.size())
+	{
+	}
+
+	[[nodiscard]] bool IsAtEnd() const
+	{
+		return Offset == Size;
+	}
+
+	template <typename Type> Type ReadValue()
+	{
+		static_assert(std::is_trivially_copyable_v<Type>, "Only trivially copyable values can be read as bytes");
+		Type Value = {};
+		if (!IsValid || Size - Offset < sizeof(Type))
+		{
+			IsValid = false;
+			return Value;
+		}
+		std::memcpy(&Value, Data + Offset, sizeof(Type));
+		Offset += sizeof(Type);
+		return Value;
+	}
+
+	// NOTE: Points into the read data, only valid as long as it is
+	std::string_view ReadStringView()
+	{
+		const uint32_t LENGTH = ReadValue<uint32_t>();
+		if (!IsValid || Size - Offset < LENGTH)
+		{
+			IsValid = false;
+			return {};
+		}
+		std::string_view Value(reinterpret_cast<const char *>(Data + Offset), LENGTH);
+		Offset += LENGTH;
+		return Value;
+	}
+
+	std::string ReadString()
+	{
+		return std::string(ReadStringView());
+	}
+};
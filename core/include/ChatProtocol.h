@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Message.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// NOTE: Frames larger than this are rejected so a corrupted length can not make a peer buffer gigabytes
+constexpr uint32_t CHAT_FRAME_MAX_PAYLOAD_SIZE = 16 * 1024 * 1024;
+
+enum class ChatFrameType : uint32_t
+{
+	// NOTE: Client to server, a batch of messages identified by their nonce
+	SendMessages = 1,
+	// NOTE: Server to client, one acknowledgement per received message including duplicates
+	Acknowledgements = 2,
+	// NOTE: Client to server, answered with a SearchResults frame carrying the same RequestID
+	SearchMessages = 3,
+	SearchResults = 4,
+	// NOTE: Node to node, the first frame each side of a cluster link sends
+	ClusterHello = 5,
+	// NOTE: Node to node, conversations the sending node starts or stops having local members connected in
+	ClusterSubscriptions = 6,
+	// NOTE: Node to node, a batch of stored messages for conversations the receiving node subscribed to
+	ClusterMessages = 7
+};
+
+// NOTE: Every frame on the stream is this header followed by Size bytes of payload
+struct ChatFrameHeader
+{
+  public:
+	uint32_t Size = 0;
+	ChatFrameType Type = ChatFrameType::SendMessages;
+};
+
+static_assert(sizeof(ChatFrameHeader) == 8, "ChatFrameHeader layout is part of the protocol");
+
+struct MessageAcknowledgement
+{
+  public:
+	uint64_t Nonce = 0;
+	uint64_t Sequence = 0;
+	std::string MessageID;
+};
+
+struct SearchMessagesRequest
+{
+  public:
+	// NOTE: Chosen by the client to match results with their request
+	uint32_t RequestID = 0;
+	std::string ConversationID;
+	std::string Query;
+	uint32_t MaxResultsCount = 0;
+};
+
+struct SearchMessagesResults
+{
+  public:
+	uint32_t RequestID = 0;
+	// NOTE: Newest message first
+	std::vector<std::string> MessageIDs;
+};
+
+// NOTE: Appends a whole frame, header included, so several frames can be written into one buffer and sent at once
+void EncodeSendMessagesFrame(const std::vector<const Message *> &Messages, std::string &Buffer);
+void EncodeAcknowledgementsFrame(const std::vector<MessageAcknowledgement> &Acknowledgements, std::string &Buffer);
+void EncodeSearchMessagesFrame(const SearchMessagesRequest &Request, std::string &Buffer);
+void EncodeSearchResultsFrame(const SearchMessagesResults &Results, std::string &Buffer);
+void EncodeClusterHelloFrame(std::string_view NodeID, std::string &Buffer);
+void EncodeClusterSubscriptionsFrame(bool IsSubscribed, const std::vector<std::string> &ConversationIDs,
+                                     std::string &Buffer);
+// NOTE: Messages are written as BinarySchema<Message> records
+void EncodeClusterMessagesFrame(const std::vector<const Message *> &Messages, std::string &Buffer);
+
+// NOTE: Payload is the frame without its header, returns false when it is malformed
+bool DecodeSendMessagesFrame(std::string_view Payload, std::vector<Message> &Messages);
+bool DecodeAcknowledgementsFrame(std::string_view Payload, std::vector<MessageAcknowledgement> &Acknowledgements);
+bool DecodeSearchMessagesFrame(std::string_view Payload, SearchMessagesRequest &Request);
+bool DecodeSearchResultsFrame(std::string_view Payload, SearchMessagesResults &Results);
+bool DecodeClusterHelloFrame(std::string_view Payload, std::string &NodeID);
+bool DecodeClusterSubscriptionsFrame(std::string_view Payload, bool &IsSubscribed,
+                                     std::vector<std::string> &ConversationIDs);
+bool DecodeClusterMessagesFrame(std::string_view Payload, std::vector<Message> &Messages);
+
+// NOTE: Returns the size of the first complete frame of the stream buffer, 0 while it is incomplete
+// Sets IsValid to false when the stream is corrupted and the connection has to be dropped
+size_t ReadChatFrame(std::string_view Buffer, ChatFrameHeader &Header, std::string_view &Payload, bool &IsValid);
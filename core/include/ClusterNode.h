@@ -0,0 +1,128 @@
+#pragma once
+
+#include "ChatProtocol.h"
+#include "Message.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// NOTE: Messages forwarded to a node in a single ClusterMessages frame at most, a longer burst is split over several
+constexpr size_t CLUSTER_BATCH_MAX_MESSAGES = 256;
+constexpr double CLUSTER_RECONNECT_DELAY_SECONDS = 0.5;
+// NOTE: Bytes read ahead of the frames handled per link at most, a whole frame always fits so a full buffer holds at
+// least one frame
+constexpr size_t CLUSTER_READ_BUFFER_MAX_SIZE = sizeof(ChatFrameHeader) + CHAT_FRAME_MAX_PAYLOAD_SIZE;
+
+struct ClusterPeer
+{
+  public:
+	std::string NodeID;
+	std::string Host;
+	uint16_t Port = 0;
+};
+
+// NOTE: Called from Update for every message a peer forwarded, FromNodeID is the node its sender is connected to
+// The message is only fanned out to local members, publishing it again would send it back
+using ClusterMessageHandler = std::function<void(const Message &ForwardedMessage, const std::string &FromNodeID)>;
+// NOTE: Called from Update once a link to the node is established and once it drops, conversation owners do not
+// change with it since they come from the configured nodes
+using ClusterMembershipHandler = std::function<void(const std::string &NodeID, bool IsJoined)>;
+
+// NOTE: Inter-node pub/sub for conversations, every node keeps one persistent link to every other node and tells them
+// which conversations have members connected to it. A published message is forwarded once to each node subscribed to
+// its conversation however many of its members are connected there, that node fans it out to them
+// Messages published between two updates are batched into one frame per link and links never wait for an
+// acknowledgement, so a burst costs one write per node. Delivery is at most once, a message in flight when a link
+// drops is lost and clients catch up from the store by sequence
+// Only the node with the smaller ID connects, the other one accepts, so both never open a link at the same time
+// Single threaded, every method is called from the thread running Update
+class ClusterNode
+{
+  public:
+	explicit ClusterNode(std::string NodeID);
+	~ClusterNode();
+	ClusterNode(const ClusterNode &) = delete;
+	ClusterNode &operator=(const ClusterNode &) = delete;
+
+	// Getters
+	[[nodiscard]] const std::string &GetNodeID() const;
+	// NOTE: Port actually bound, useful once listening on port 0
+	[[nodiscard]] uint16_t GetPort() const;
+	// NOTE: True once both nodes exchanged their ID over the link
+	[[nodiscard]] bool IsConnected(const std::string &NodeID) const;
+	[[nodiscard]] bool HasRemoteSubscriber(const std::string &NodeID, const std::string &ConversationID) const;
+	// NOTE: Copies of messages queued to other nodes, one per message and subscribed node
+	[[nodiscard]] uint64_t GetForwardedCount() const;
+
+	// NOTE: 0 binds an ephemeral port, returns false when the port could not be bound
+	bool Listen(uint16_t Port);
+	void AddPeer(ClusterPeer Peer);
+	void SetOnMessage(ClusterMessageHandler OnMessage);
+	void SetOnMembershipChanged(ClusterMembershipHandler OnMembershipChanged);
+
+	// NOTE: Called when the first member of the conversation connects to this node and when the last one leaves
+	void Subscribe(const std::string &ConversationID);
+	void Unsubscribe(const std::string &ConversationID);
+	// NOTE: Queues the stored message to every node subscribed to its conversation, sent on the next update
+	void Publish(const Message &StoredMessage);
+
+	// NOTE: Flushes queued messages, then waits up to TimeoutMilliseconds for links to be readable or writable and
+	// handles them, accepting and reconnecting links as needed
+	void Update(int TimeoutMilliseconds);
+
+  private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Link
+	{
+		int Socket = -1;
+		// NOTE: Known up front for links this node opened, set from the peer's hello otherwise
+		std::string NodeID;
+		bool IsConnecting = false;
+		bool IsEstablished = false;
+		bool IsClosed = false;
+		std::string ReadBuffer;
+		std::string WriteBuffer;
+		size_t WriteOffset = 0;
+		std::unordered_set<std::string> RemoteSubscriptions;
+		// NOTE: Shared with the batches of the other links the message is forwarded to
+		std::vector<std::shared_ptr<const Message>> Batch;
+	};
+
+	struct PeerState
+	{
+		ClusterPeer Peer;
+		Clock::time_point NextConnectTime;
+	};
+
+	std::string m_NodeID;
+	int m_ListenSocket = -1;
+	uint16_t m_Port = 0;
+	std::vector<PeerState> m_Peers;
+	std::vector<std::unique_ptr<Link>> m_Links;
+	std::unordered_set<std::string> m_Subscriptions;
+	ClusterMessageHandler m_OnMessage;
+	ClusterMembershipHandler m_OnMembershipChanged;
+	uint64_t m_ForwardedCount = 0;
+
+	[[nodiscard]] Link *FindLink(const std::string &NodeID) const;
+
+	void ConnectPeers(Clock::time_point Now);
+	void Accept();
+	void AddLink(int Socket, std::string NodeID, bool IsConnecting);
+	void CloseLink(Link &ClosedLink);
+	void RemoveClosedLinks(Clock::time_point Now);
+
+	void FlushBatch(Link &CurrentLink);
+	void FlushLinks();
+	void Write(Link &CurrentLink);
+	void Read(Link &CurrentLink);
+	void HandleFrame(Link &CurrentLink, const ChatFrameHeader &Header, std::string_view Payload);
+};
@@ -3,38 +3,61 @@
 #include "Vector.h"
 
 #include <algorithm>
+#include <cstdint>
 
-const int RGBA_EMPTY_VALUE = -1;
 const int RGBA_MIN_VALUE = 0;
 const int RGBA_MAX_VALUE = 255;
 
+// NOTE: Packed once when constructed, constexpr so theme colors are packed at compile time
 struct Rgba
 {
   public:
-	int R = RGBA_EMPTY_VALUE;
-	int G = RGBA_EMPTY_VALUE;
-	int B = RGBA_EMPTY_VALUE;
-	int A = RGBA_EMPTY_VALUE;
+	// NOTE: 0xAABBGGRR, the same layout as ImGui's IM_COL32 so it can be handed to ImGui as an ImU32
+	uint32_t Packed = 0;
+	bool IsSet = false;
 
-	Rgba() = default;
-	Rgba(int R, int G, int B, int A) : R(Clamp(R)), G(Clamp(G)), B(Clamp(B)), A(Clamp(A))
+	constexpr Rgba() = default;
+	constexpr Rgba(int R, int G, int B, int A)
+	    : Packed(static_cast<uint32_t>(Clamp(R)) | (static_cast<uint32_t>(Clamp(G)) << 8) |
+	             (static_cast<uint32_t>(Clamp(B)) << 16) | (static_cast<uint32_t>(Clamp(A)) << 24)),
+	      IsSet(true)
 	{
 	}
 
-	bool IsEmpty()
+	[[nodiscard]] constexpr int GetR() const
 	{
-		return R <= RGBA_EMPTY_VALUE && G <= RGBA_EMPTY_VALUE && B <= RGBA_EMPTY_VALUE && A <= RGBA_EMPTY_VALUE;
+		return static_cast<int>(Packed & 0xFF);
 	}
 
-	Vector4 ToVector4()
+	[[nodiscard]] constexpr int GetG() const
+	{
+		return static_cast<int>((Packed >> 8) & 0xFF);
+	}
+
+	[[nodiscard]] constexpr int GetB() const
+	{
+		return static_cast<int>((Packed >> 16) & 0xFF);
+	}
+
+	[[nodiscard]] constexpr int GetA() const
+	{
+		return static_cast<int>((Packed >> 24) & 0xFF);
+	}
+
+	[[nodiscard]] constexpr bool IsEmpty() const
+	{
+		return !IsSet;
+	}
+
+	[[nodiscard]] constexpr Vector4 ToVector4() const
 	{
 		const float RGBA_MAX_VALUE_FLOAT = static_cast<float>(RGBA_MAX_VALUE);
-		return Vector4(static_cast<float>(R) / RGBA_MAX_VALUE_FLOAT, static_cast<float>(G) / RGBA_MAX_VALUE_FLOAT,
-		               static_cast<float>(B) / RGBA_MAX_VALUE_FLOAT, static_cast<float>(A) / RGBA_MAX_VALUE_FLOAT);
+		return Vector4(static_cast<float>(GetR()) / RGBA_MAX_VALUE_FLOAT, static_cast<float>(GetG()) / RGBA_MAX_VALUE_FLOAT,
+		               static_cast<float>(GetB()) / RGBA_MAX_VALUE_FLOAT, static_cast<float>(GetA()) / RGBA_MAX_VALUE_FLOAT);
 	}
 
   private:
-	int Clamp(int Value)
+	static constexpr int Clamp(int Value)
 	{
 		return std::clamp(Value, RGBA_MIN_VALUE, RGBA_MAX_VALUE);
 	}
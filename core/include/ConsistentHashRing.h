@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// NOTE: Points each node gets on the ring, with 160 the busiest node of a small cluster owns about 10% more
+// conversations than the average one
+constexpr size_t CONSISTENT_HASH_RING_DEFAULT_VIRTUAL_NODES = 160;
+
+// NOTE: A conversation whose owner differs between two rings, FromNodeID is empty when the previous ring had no node
+struct ConversationMove
+{
+  public:
+	std::string ConversationID;
+	std::string FromNodeID;
+	std::string ToNodeID;
+};
+
+// NOTE: Maps conversation IDs to the node owning their sequence numbering, log and hot cache
+// Every node is hashed to VirtualNodesCount points of a 64 bit ring and a conversation belongs to the node of the first
+// point at or after its own hash, so adding or removing a node only moves the conversations between its points and the
+// ones before them, about 1 / NodesCount of them, and every other conversation keeps its owner and its warm cache
+// Hashes only depend on the IDs, every node computes the same owners from the same members whatever order they joined
+class ConsistentHashRing
+{
+  public:
+	explicit ConsistentHashRing(size_t VirtualNodesCount = CONSISTENT_HASH_RING_DEFAULT_VIRTUAL_NODES);
+
+	// Getters
+	[[nodiscard]] size_t GetNodesCount() const;
+	[[nodiscard]] const std::vector<std::string> &GetNodeIDs() const;
+	[[nodiscard]] bool HasNode(const std::string &NodeID) const;
+	// NOTE: Empty while the ring has no node
+	[[nodiscard]] const std::string &GetOwner(std::string_view ConversationID) const;
+
+	// NOTE: Return false when the node already is, or is not, on the ring
+	bool AddNode(const std::string &NodeID);
+	bool RemoveNode(const std::string &NodeID);
+
+	// NOTE: The conversations among ConversationIDs owned by another node on Next, used to plan a change of the
+	// configured nodes: a node warms the ones moving to it and evicts the ones moving away, the others are left alone
+	[[nodiscard]] std::vector<ConversationMove> GetMoves(const ConsistentHashRing &Next,
+	                                                     const std::vector<std::string> &ConversationIDs) const;
+
+  private:
+	struct Point
+	{
+		uint64_t Hash = 0;
+		uint32_t NodeIndex = 0;
+	};
+
+	size_t m_VirtualNodesCount = CONSISTENT_HASH_RING_DEFAULT_VIRTUAL_NODES;
+	std::vector<std::string> m_NodeIDs;
+	// NOTE: Sorted by hash, rebuilt whenever a node joins or leaves which is rare next to lookups
+	std::vector<Point> m_Points;
+
+	void BuildPoints();
+};
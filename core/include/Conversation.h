@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Message.h"
+#include "User.h"
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+struct Conversation
+{
+  public:
+	std::string ID;
+	std::vector<Message> Messages;
+	std::vector<User> Users;
+	std::time_t CreatedAt = 0;
+	// NOTE: Maintained by ConversationStore, used to order the conversations list
+	std::time_t LastActivityAt = 0;
+};
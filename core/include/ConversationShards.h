@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Message.h"
+#include "MpscQueue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// NOTE: Tasks a shard runs before waking the reactors it handed deliveries to
+constexpr size_t CONVERSATION_SHARD_BATCH_SIZE = 256;
+
+// NOTE: Owned by the shard of the conversation, only read and written from its thread
+struct ShardConversationState
+{
+  public:
+	uint64_t LastSequence = 0;
+	std::vector<std::string> MemberIDs;
+};
+
+// NOTE: Called on the shard thread the first time one of its conversations is used, returns false when the
+// conversation does not exist
+using ShardConversationLoader = std::function<bool(const std::string &ConversationID, ShardConversationState &State)>;
+// NOTE: Called on the shard thread owning the conversation once Sequence is assigned, stores the message and sets its
+// ID, returns false when it could not be stored so it is not acknowledged and the client retries it
+// Every shard calls it concurrently, each with messages of its own conversations
+using ShardMessagePersister = std::function<bool(Message &NewMessage)>;
+
+// NOTE: Fan-out work handed back to a reactor, the message is shared by the deliveries of every reactor
+struct ShardDelivery
+{
+  public:
+	std::shared_ptr<const Message> StoredMessage;
+	// NOTE: Members connected to the reactor, the sender is never one of them
+	std::vector<std::string> RecipientIDs;
+	// NOTE: Only set on the delivery to the reactor the message was received on, the sender is acknowledged with it
+	bool IsAcknowledgement = false;
+};
+
+// NOTE: Partitions conversation state by ID hash across single threaded shards, so appending to and fanning out of a
+// conversation never takes a lock however many reactors receive its messages
+// Reactors hand work to the owning shard and get deliveries back through MpscQueues, a reactor only pops its own
+// deliveries. Presence is sent to every shard since any of them may hold a conversation of the user
+class ConversationShards
+{
+  public:
+	ConversationShards(size_t ShardsCount, size_t ReactorsCount, ShardConversationLoader Loader,
+	                   ShardMessagePersister Persister);
+	~ConversationShards();
+	ConversationShards(const ConversationShards &) = delete;
+	ConversationShards &operator=(const ConversationShards &) = delete;
+
+	// Getters
+	[[nodiscard]] size_t GetShardsCount() const;
+	[[nodiscard]] size_t GetReactorsCount() const;
+	[[nodiscard]] size_t GetShardIndex(const std::string &ConversationID) const;
+
+	// NOTE: Called from a shard thread once it handed deliveries to the reactor, used to wake its event loop
+	// Has to be set before any message is appended
+	void SetOnDelivery(std::function<void(size_t ReactorIndex)> OnDelivery);
+
+	// NOTE: Any reactor thread, the SenderID of the message has to be set
+	void Append(Message NewMessage, size_t ReactorIndex);
+	void SetMembers(const std::string &ConversationID, std::vector<std::string> MemberIDs);
+	// NOTE: Loads the conversation ahead of its first message, called for the conversations a rebalance moves to this
+	// node so their first messages do not wait for the store
+	void Warm(const std::string &ConversationID);
+	// NOTE: Drops the state of a conversation moved to another node, only that conversation is evicted
+	void Evict(const std::string &ConversationID);
+	// NOTE: Counted per reactor, a user connected twice to the same reactor stays connected until both disconnect
+	void Connect(const std::string &UserID, size_t ReactorIndex);
+	void Disconnect(const std::string &UserID, size_t ReactorIndex);
+
+	// NOTE: Reactor thread of ReactorIndex only, returns false once its deliveries are drained
+	bool Poll(size_t ReactorIndex, ShardDelivery &Delivery);
+
+  private:
+	enum class TaskType
+	{
+		Append,
+		SetMembers,
+		Warm,
+		Evict,
+		Connect,
+		Disconnect
+	};
+
+	struct Task
+	{
+		TaskType Type = TaskType::Append;
+		Message NewMessage;
+		std::string ID;
+		std::vector<std::string> MemberIDs;
+		uint32_t ReactorIndex = 0;
+	};
+
+	struct alignas(64) Shard
+	{
+		MpscQueue<Task> Tasks;
+		// NOTE: Only taken to sleep and to wake a sleeping shard, pushing does not lock
+		std::mutex Mutex;
+		std::condition_variable Condition;
+		std::atomic<bool> IsSleeping = false;
+
+		// NOTE: Only touched by the shard thread
+		std::unordered_map<std::string, ShardConversationState> Conversations;
+		// NOTE: Reactor of every connection of the user, once per connection
+		std::unordered_map<std::string, std::vector<uint32_t>> ReactorsByUserID;
+		std::vector<ShardDelivery> Deliveries;
+		std::vector<bool> HaveDeliveries;
+
+		std::thread Worker;
+	};
+
+	ShardConversationLoader m_Loader;
+	ShardMessagePersister m_Persister;
+	std::function<void(size_t ReactorIndex)> m_OnDelivery;
+	std::vector<std::unique_ptr<Shard>> m_Shards;
+	std::vector<std::unique_ptr<MpscQueue<ShardDelivery>>> m_Outboxes;
+	std::atomic<bool> m_IsStopping = false;
+
+	void Post(Shard &Target, Task NewTask);
+	void Broadcast(const Task &NewTask);
+	void RunShard(Shard &Owner);
+	void RunTask(Shard &Owner, Task &CurrentTask);
+	ShardConversationState *Load(Shard &Owner, const std::string &ConversationID);
+	void Deliver(Shard &Owner, Task &AppendTask, ShardConversationState &State);
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Conversation.h"
+#include "Message.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+constexpr uint32_t CONVERSATION_HANDLE_INVALID_INDEX = UINT32_MAX;
+
+// NOTE: Stays valid across insertions and deletions of other conversations, a removed conversation's handle never
+// resolves again because its slot generation is bumped
+struct ConversationHandle
+{
+  public:
+	uint32_t Index = CONVERSATION_HANDLE_INVALID_INDEX;
+	uint32_t Generation = 0;
+
+	[[nodiscard]] bool IsValid() const
+	{
+		return Index != CONVERSATION_HANDLE_INVALID_INDEX;
+	}
+
+	bool operator==(ConversationHandle Other) const
+	{
+		return Index == Other.Index && Generation == Other.Generation;
+	}
+
+	bool operator!=(ConversationHandle Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+struct ConversationHandleHash
+{
+  public:
+	size_t operator()(ConversationHandle Handle) const
+	{
+		return std::hash<uint64_t>()((static_cast<uint64_t>(Handle.Index) << 32) | Handle.Generation);
+	}
+};
+
+struct ConversationActivity
+{
+  public:
+	std::time_t LastActivityAt = 0;
+	// NOTE: Breaks ties between conversations active at the same second, most recently touched first
+	uint64_t Sequence = 0;
+	ConversationHandle Handle;
+
+	// NOTE: Most recent activity first
+	bool operator<(const ConversationActivity &Other) const
+	{
+		if (LastActivityAt != Other.LastActivityAt)
+			return LastActivityAt > Other.LastActivityAt;
+		return Sequence > Other.Sequence;
+	}
+};
+
+class ConversationStore
+{
+  public:
+	using ActivityIndex = std::set<ConversationActivity>;
+
+	ConversationStore() = default;
+
+	// Getters
+	[[nodiscard]] Conversation *Get(ConversationHandle Handle);
+	[[nodiscard]] const Conversation *Get(ConversationHandle Handle) const;
+	[[nodiscard]] ConversationHandle Find(const std::string &ID) const;
+	[[nodiscard]] ConversationHandle GetMostRecent() const;
+	[[nodiscard]] size_t GetSize() const;
+	[[nodiscard]] bool IsEmpty() const;
+	// NOTE: Incremented on every mutation so views can tell when they need to be rebuilt
+	[[nodiscard]] uint64_t GetVersion() const;
+
+	// NOTE: Iterates conversations from most to least recently active
+	[[nodiscard]] ActivityIndex::const_iterator begin() const;
+	[[nodiscard]] ActivityIndex::const_iterator end() const;
+
+	ConversationHandle Add(Conversation NewConversation);
+	bool Remove(ConversationHandle Handle);
+	void AddMessage(ConversationHandle Handle, Message NewMessage);
+	void Touch(ConversationHandle Handle, std::time_t ActivityAt);
+	void Clear();
+
+  private:
+	struct Slot
+	{
+		Conversation Value;
+		ConversationActivity Activity;
+		uint32_t Generation = 0;
+		bool IsOccupied = false;
+	};
+
+	std::vector<Slot> m_Slots;
+	std::vector<uint32_t> m_FreeIndices;
+	std::unordered_map<std::string, uint32_t> m_IndicesByID;
+	ActivityIndex m_ActivityIndex;
+	uint64_t m_NextSequence = 0;
+	uint64_t m_Version = 0;
+
+	Slot *GetSlot(ConversationHandle Handle);
+	const Slot *GetSlot(ConversationHandle Handle) const;
+};
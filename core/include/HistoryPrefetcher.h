@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Message.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// NOTE: Hovering moves quickly over the list, only the conversations hovered last are still worth loading
+constexpr size_t HISTORY_PREFETCHER_MAX_PENDING_COUNT = 4;
+
+// NOTE: Called on the prefetch worker, returns at most MessagesCount of the newest messages in chronological order
+using HistoryPageLoader = std::function<std::vector<Message>(const std::string &ConversationID, size_t MessagesCount)>;
+
+struct HistoryPrefetcherLimits
+{
+  public:
+	size_t PageMessagesCount = 50;
+	// NOTE: Pages not taken are evicted least recently prefetched first past this size
+	size_t MemoryBudgetBytes = 8 * 1024 * 1024;
+	// NOTE: Loading pauses once pages loaded in the last second exceed this, 0 disables the limit
+	size_t BandwidthBytesPerSecond = 1024 * 1024;
+};
+
+// NOTE: Speculatively loads the newest page of conversations the user is likely to open next on a low priority
+// worker, so opening them does not wait on the loader
+class HistoryPrefetcher
+{
+  public:
+	explicit HistoryPrefetcher(HistoryPageLoader Loader, HistoryPrefetcherLimits Limits = {});
+	~HistoryPrefetcher();
+	HistoryPrefetcher(const HistoryPrefetcher &) = delete;
+	HistoryPrefetcher &operator=(const HistoryPrefetcher &) = delete;
+
+	// Getters
+	[[nodiscard]] const HistoryPrefetcherLimits &GetLimits() const;
+	[[nodiscard]] bool IsReady(const std::string &ConversationID) const;
+	[[nodiscard]] size_t GetUsedBytes() const;
+
+	// NOTE: Called from the worker every time a page is loaded, used to wake the render loop
+	void SetOnLoaded(std::function<void()> OnLoaded);
+
+	// NOTE: Does nothing when the page is already loaded or queued, the latest request is loaded first
+	void Prefetch(const std::string &ConversationID);
+	// NOTE: Moves the loaded page out, returns false when it is not loaded yet
+	bool Take(const std::string &ConversationID, std::vector<Message> &Messages);
+	// NOTE: Calls OnReady for every page loaded since the last call, the page stays available to Take
+	// OnReady is called with the pages locked so it must not call back into the prefetcher
+	void Poll(const std::function<void(const std::string &ConversationID, const std::vector<Message> &Messages)> &OnReady);
+
+  private:
+	struct Page
+	{
+		std::string ConversationID;
+		std::vector<Message> Messages;
+		size_t SizeInBytes = 0;
+	};
+
+	HistoryPageLoader m_Loader;
+	HistoryPrefetcherLimits m_Limits;
+
+	mutable std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::deque<std::string> m_Pending;
+	// NOTE: Pending or being loaded, keeps a conversation from being queued twice
+	std::unordered_set<std::string> m_Requested;
+	// NOTE: Most recently loaded first
+	std::list<Page> m_Pages;
+	std::unordered_map<std::string, std::list<Page>::iterator> m_PagesByConversationID;
+	std::vector<std::string> m_LoadedConversationIDs;
+	// NOTE: Reused by Poll
+	std::vector<std::string> m_PolledConversationIDs;
+	size_t m_UsedBytes = 0;
+	bool m_IsStopping = false;
+	std::function<void()> m_OnLoaded;
+
+	// NOTE: Only touched by the worker
+	double m_AvailableBytes = 0.0;
+	std::chrono::steady_clock::time_point m_RefilledAt;
+
+	std::thread m_Worker;
+
+	void RunWorker();
+	// NOTE: Returns false when stopping while waiting for the bandwidth budget
+	bool WaitForBandwidth(std::unique_lock<std::mutex> &Lock);
+	void Evict();
+};
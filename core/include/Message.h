@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+struct Message
+{
+  public:
+	// NOTE: Assigned by the server, empty until the message is acknowledged
+	std::string ID;
+	std::string ConversationID;
+	std::string SenderID;
+	std::string SenderFirstName;
+	std::string SenderImageUrl;
+	std::string Text;
+	std::time_t CreatedAt = 0;
+	// NOTE: Generated by the sending client, lets the server recognize a retried send
+	uint64_t Nonce = 0;
+	// NOTE: Order of the message in its conversation assigned by the server, 0 until acknowledged
+	uint64_t Sequence = 0;
+
+	[[nodiscard]] bool IsPending() const
+	{
+		return Nonce != 0 && Sequence == 0;
+	}
+};
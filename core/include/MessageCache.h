@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Conversation.h"
+#include "Message.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// NOTE: "CMLG" and "CMIX" read as little endian integers
+constexpr uint32_t MESSAGE_CACHE_LOG_MAGIC = 0x474C4D43;
+constexpr uint32_t MESSAGE_CACHE_INDEX_MAGIC = 0x58494D43;
+constexpr uint32_t MESSAGE_CACHE_VERSION = 2;
+// NOTE: The log is rewritten with only its live records once this many bytes, and at least half of it, are dead
+constexpr size_t MESSAGE_CACHE_COMPACTION_MIN_DEAD_BYTES = 1024 * 1024;
+// NOTE: The mapping covers at least this much and doubles when the log outgrows it, appends do not remap it
+constexpr size_t MESSAGE_CACHE_MIN_MAPPING_SIZE = 1024 * 1024;
+
+enum class MessageCacheRecordType : uint32_t
+{
+	Conversation = 0,
+	Message = 1,
+	ConversationRemoved = 2
+};
+
+// NOTE: Layout of a log is the header, then records appended one after the other, each record is its header
+// followed by Size bytes of payload
+struct MessageCacheLogHeader
+{
+  public:
+	uint32_t Magic = MESSAGE_CACHE_LOG_MAGIC;
+	uint32_t Version = MESSAGE_CACHE_VERSION;
+	uint64_t Reserved = 0;
+};
+
+struct MessageCacheRecordHeader
+{
+  public:
+	uint32_t Size = 0;
+	// NOTE: FNV-1a of the payload, a record torn by a crash fails it and is cut from the log on the next Open
+	uint32_t Checksum = 0;
+	MessageCacheRecordType Type = MessageCacheRecordType::Message;
+	uint32_t Reserved = 0;
+};
+
+// NOTE: Layout of an index is the header, then ConversationsCount entries
+struct MessageCacheIndexHeader
+{
+  public:
+	uint32_t Magic = MESSAGE_CACHE_INDEX_MAGIC;
+	uint32_t Version = MESSAGE_CACHE_VERSION;
+	uint32_t ConversationsCount = 0;
+	// NOTE: Bytes of records replaced or removed since the log was last compacted, an estimate
+	uint32_t DeadBytes = 0;
+	// NOTE: Records past this size were appended after the index was written and are replayed on Open
+	uint64_t LogSize = 0;
+};
+
+struct MessageCacheIndexEntry
+{
+  public:
+	// NOTE: Offsets of records in the log, 0 when there is none
+	uint64_t ConversationOffset = 0;
+	// NOTE: Every message record links to the previous message of its conversation, so the newest messages are read
+	// by walking back from this one without scanning the log
+	uint64_t LastMessageOffset = 0;
+	int64_t LastActivityAt = 0;
+	int64_t LastMessageCreatedAt = 0;
+	uint32_t MessagesCount = 0;
+	// NOTE: Messages appended while pending that were not appended again acknowledged yet
+	uint32_t PendingMessagesCount = 0;
+};
+
+static_assert(sizeof(MessageCacheLogHeader) == 16, "MessageCacheLogHeader layout is part of the log format");
+static_assert(sizeof(MessageCacheRecordHeader) == 16, "MessageCacheRecordHeader layout is part of the log format");
+static_assert(sizeof(MessageCacheIndexHeader) == 24, "MessageCacheIndexHeader layout is part of the index format");
+static_assert(sizeof(MessageCacheIndexEntry) == 40, "MessageCacheIndexEntry layout is part of the index format");
+
+// NOTE: Local copy of an account's conversations so they can be shown before the network connects
+// Writes are appended to the log, the index is only rewritten by Flush and Close so a crash at most costs a replay
+// of the records appended since the last flush
+// Replaced conversation details, acknowledged pending messages and removed conversations leave dead records behind,
+// Open and Flush compact the log once enough of it is dead
+// Thread safe, history is read by the prefetch worker while the render thread appends
+class MessageCache
+{
+  public:
+	MessageCache() = default;
+	~MessageCache();
+	MessageCache(const MessageCache &) = delete;
+	MessageCache &operator=(const MessageCache &) = delete;
+
+	// Getters
+	[[nodiscard]] bool IsOpen() const;
+	[[nodiscard]] bool HasConversation(const std::string &ID) const;
+	[[nodiscard]] size_t GetConversationsCount() const;
+	[[nodiscard]] size_t GetLogSize() const;
+	[[nodiscard]] size_t GetDeadBytes() const;
+
+	// NOTE: Creates DirectoryPath/AccountID.log and its index when missing, a log that is not a valid log of this
+	// version is discarded since everything in it can be downloaded again
+	bool Open(const std::string &DirectoryPath, const std::string &AccountID);
+	// NOTE: Most recently active conversations first, each with at most MessagesCount of its newest messages in
+	// chronological order
+	std::vector<Conversation> LoadRecent(size_t ConversationsCount, size_t MessagesCount);
+	// NOTE: At most MessagesCount of the newest messages of the conversation in chronological order
+	std::vector<Message> LoadMessages(const std::string &ConversationID, size_t MessagesCount);
+	// NOTE: Pending messages left by a previous run, oldest first, so they can be sent again
+	std::vector<Message> LoadPendingMessages();
+	// NOTE: Only the conversation details are written, messages are appended one by one with AppendMessage
+	bool AppendConversation(const Conversation &NewConversation);
+	// NOTE: Sent messages are appended pending, then again once acknowledged, the acknowledged copy replaces the pending
+	// one when loading since both have the same nonce
+	bool AppendMessage(const Message &NewMessage);
+	bool RemoveConversation(const std::string &ID);
+	// NOTE: Rewrites the index, it is replaced atomically so a crash never leaves a half written one
+	// Compacts the log first when enough of it is dead
+	bool Flush();
+	void Close();
+
+  private:
+	struct Entry
+	{
+		MessageCacheIndexEntry Index;
+	};
+
+	mutable std::mutex m_Mutex;
+	int m_LogFileDescriptor = -1;
+	std::string m_LogFilePath;
+	std::string m_IndexFilePath;
+	// NOTE: Read-only mapping of the log and of the space it grows into, only bytes below m_LogSize are read
+	const unsigned char *m_Data = nullptr;
+	size_t m_MappedSize = 0;
+	size_t m_LogSize = 0;
+	size_t m_DeadBytes = 0;
+	std::unordered_map<std::string, Entry> m_Entries;
+	bool m_IsIndexDirty = false;
+
+	// NOTE: Private functions expect m_Mutex to be locked
+	bool WriteIndex();
+	void Reset();
+	// NOTE: Remaps only when the log outgrew the mapping
+	bool Map();
+	void Unmap();
+	[[nodiscard]] bool IsCompactionNeeded() const;
+	// NOTE: Writes the live records to a new log that replaces the current one, superseded pending copies are dropped
+	bool Compact();
+	// NOTE: Returns the log offset records have to be replayed from, the start of the log when there is no usable index
+	size_t LoadIndex();
+	void Replay(size_t Offset);
+	bool ReadRecord(uint64_t Offset, MessageCacheRecordType Type, const unsigned char *&Payload, size_t &Size) const;
+	void Apply(MessageCacheRecordType Type, uint64_t Offset, const unsigned char *Payload, size_t Size);
+	bool Append(MessageCacheRecordType Type, const std::string &Payload);
+	bool ReadConversation(uint64_t Offset, Conversation &CachedConversation) const;
+	bool ReadMessage(uint64_t Offset, Message &CachedMessage, uint64_t &PreviousMessageOffset) const;
+	void ReadNewestMessages(const Entry &CachedEntry, size_t MessagesCount, std::vector<Message> &Messages) const;
+	// NOTE: Offsets of the messages of the entry that are still shown, newest first
+	void ReadLiveMessageOffsets(const Entry &CachedEntry, std::vector<uint64_t> &MessageOffsets) const;
+	size_t GetRecordBytes(uint64_t Offset, MessageCacheRecordType Type) const;
+	size_t GetConversationBytes(const Entry &CachedEntry) const;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Conversation.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// NOTE: Messages are lowercased into arenas of this many messages, appending to a conversation only rebuilds its last
+// arena so the others are shared between filter snapshots
+constexpr size_t MESSAGE_FILTER_CHUNK_MESSAGES_COUNT = 1024;
+
+// NOTE: Offset of the first occurrence of Needle in Text, std::string_view::npos when there is none
+size_t FindSubstring(std::string_view Text, std::string_view Needle);
+
+struct MessageFilterMatch
+{
+  public:
+	// NOTE: The ID or the first name of one of the users contains the query
+	bool IsTitleMatch = false;
+	// NOTE: Indices in Conversation::Messages, ascending
+	std::vector<uint32_t> MessageIndices;
+};
+
+struct MessageFilterResult
+{
+  public:
+	// NOTE: Lowercased, empty when nothing is filtered
+	std::string Query;
+	// NOTE: Only holds conversations that match
+	std::unordered_map<std::string, MessageFilterMatch> MatchesByConversationID;
+};
+
+// NOTE: Filters the local conversations and their loaded messages by a case insensitive substring on a worker, so
+// typing never waits on the scan
+// A query containing the previous one only checks the messages the previous one matched, a newer query cancels the
+// scan in progress
+// Only ASCII is case folded, like TokenizeMessageText
+class MessageFilter
+{
+  public:
+	MessageFilter();
+	~MessageFilter();
+	MessageFilter(const MessageFilter &) = delete;
+	MessageFilter &operator=(const MessageFilter &) = delete;
+
+	// Getters
+	[[nodiscard]] const std::string &GetQuery() const;
+	[[nodiscard]] size_t GetMessagesCount() const;
+
+	// NOTE: Called from the worker every time a scan completes, used to wake the render loop
+	void SetOnCompleted(std::function<void()> OnCompleted);
+
+	// NOTE: Only indexes the messages appended since the last call, call RemoveConversation first when the messages
+	// of the conversation were replaced
+	void UpdateConversation(const Conversation &UpdatedConversation);
+	void RemoveConversation(const std::string &ConversationID);
+	// NOTE: Does nothing when the query and the conversations did not change since the last call
+	void SetQuery(std::string_view Query);
+	// NOTE: Moves the result of the latest query out once its scan completed, returns false until then
+	bool Poll(MessageFilterResult &Result);
+
+  private:
+	// NOTE: Lowercased text of consecutive messages separated by '\0', so a match never spans two messages
+	struct Chunk
+	{
+		std::string Text;
+		// NOTE: Offset of each message in Text
+		std::vector<uint32_t> Offsets;
+	};
+
+	struct Entry
+	{
+		std::string ConversationID;
+		// NOTE: Lowercased ID and user first names separated by '\0'
+		std::string Title;
+		std::vector<std::shared_ptr<const Chunk>> Chunks;
+		size_t MessagesCount = 0;
+		size_t UsersCount = 0;
+	};
+
+	using Snapshot = std::vector<std::shared_ptr<const Entry>>;
+
+	// NOTE: Matched messages of a chunk for the last completed query, indices are relative to the chunk
+	struct ChunkMatches
+	{
+		// NOTE: Keeps the chunk alive so its address is not reused by another one
+		std::shared_ptr<const Chunk> Source;
+		std::vector<uint32_t> MessageIndices;
+	};
+
+	// NOTE: Only touched by the main thread
+	std::unordered_map<std::string, std::shared_ptr<const Entry>> m_Entries;
+	std::string m_Query;
+	size_t m_MessagesCount = 0;
+	// NOTE: Reset whenever an entry changes, rebuilt by the next SetQuery
+	std::shared_ptr<const Snapshot> m_Snapshot;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	// NOTE: Bumped by every SetQuery, the worker gives up on a scan once it changed
+	std::atomic<uint64_t> m_Generation = 0;
+	std::shared_ptr<const Snapshot> m_PendingSnapshot;
+	std::string m_PendingQuery;
+	bool m_IsPending = false;
+	MessageFilterResult m_Result;
+	bool m_IsResultReady = false;
+	bool m_IsStopping = false;
+	std::function<void()> m_OnCompleted;
+
+	// NOTE: Only touched by the worker
+	std::string m_CompletedQuery;
+	std::unordered_map<const Chunk *, ChunkMatches> m_CompletedChunkMatches;
+
+	std::thread m_Worker;
+
+	void RunWorker();
+	// NOTE: Returns false when cancelled by a newer query
+	bool Scan(const Snapshot &Entries, const std::string &Query, uint64_t Generation, MessageFilterResult &Result,
+	          std::unordered_map<const Chunk *, ChunkMatches> &ChunkMatchesByChunk) const;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ChatProtocol.h"
+#include "Message.h"
+#include "NonceDeduplicator.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// NOTE: Stores a new message and sets its ID and Sequence, returns false when it could not be stored so it is not
+// acknowledged and the client retries it
+using MessagePersister = std::function<bool(Message &ReceivedMessage)>;
+// NOTE: Delivers a stored message to the other users of its conversation
+using MessageFanOut = std::function<void(const Message &StoredMessage)>;
+
+// NOTE: Server side of OutboundQueue, stores the messages of SendMessages frames and acknowledges them
+// Malformed UTF-8 in message text is replaced with U+FFFD before the message is stored
+// Clients resend every unacknowledged message after a reconnect, nonces received from the same user recently are
+// acknowledged again without storing or delivering the message a second time, messages without a nonce (0) are always
+// stored
+class MessageReceiver
+{
+  public:
+	MessageReceiver(MessagePersister Persister, MessageFanOut FanOut);
+
+	// Getters
+	[[nodiscard]] size_t GetUsersCount() const;
+
+	// NOTE: UserID is the user of the connection the frame was read from, it overrides the sender of the messages
+	// Appends an Acknowledgements frame to Response, returns false when the payload is malformed
+	bool Receive(const std::string &UserID, std::string_view Payload, double Now, std::string &Response);
+	// NOTE: Drops the nonces of users who did not send anything for the whole deduplication window
+	void Expire(double Now);
+
+  private:
+	MessagePersister m_Persister;
+	MessageFanOut m_FanOut;
+	std::unordered_map<std::string, NonceDeduplicator> m_DeduplicatorsByUserID;
+
+	// NOTE: Reused by Receive
+	std::vector<Message> m_Messages;
+	std::vector<MessageAcknowledgement> m_Acknowledgements;
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ChatProtocol.h"
+#include "Message.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// NOTE: Postings are split in blocks so intersecting a long list with a short one only decodes the blocks the short
+// list lands in
+constexpr size_t MESSAGE_SEARCH_BLOCK_SIZE = 128;
+// NOTE: Longer tokens are cut, pasted blobs would otherwise make huge unique terms
+constexpr size_t MESSAGE_SEARCH_MAX_TOKEN_SIZE = 32;
+constexpr size_t MESSAGE_SEARCH_MAX_QUERY_TERMS_COUNT = 8;
+constexpr size_t MESSAGE_SEARCH_MAX_RESULTS_COUNT = 1000;
+
+// NOTE: Splits text into lowercase terms, words are runs of ASCII letters and digits and of non-ASCII bytes, so
+// accented and non-Latin words are kept whole but only ASCII is case folded
+void TokenizeMessageText(std::string_view Text, std::vector<std::string> &Tokens);
+
+// NOTE: Server side full-text index of message text, sharded by conversation since searches are scoped to one
+// Messages are numbered in the order they are added to their conversation, posting lists store the delta between
+// consecutive numbers as varints
+// Fed from the persist step so it grows with every stored message, not thread safe
+class MessageSearchIndex
+{
+  public:
+	// Getters
+	[[nodiscard]] size_t GetMessagesCount() const;
+	[[nodiscard]] size_t GetPostingsSizeInBytes() const;
+
+	// NOTE: Messages of a conversation have to be added in Sequence order, older ones are already indexed and skipped
+	bool Add(const Message &StoredMessage);
+	// NOTE: IDs of the newest messages holding every term of the query, newest first
+	void Search(const std::string &ConversationID, std::string_view Query, size_t MaxResultsCount,
+	            std::vector<std::string> &MessageIDs) const;
+	// NOTE: Answers the payload of a SearchMessages frame by appending a SearchResults frame to Response
+	bool Respond(std::string_view Payload, std::string &Response) const;
+
+  private:
+	struct PostingBlock
+	{
+		uint32_t FirstDocument = 0;
+		uint32_t ByteOffset = 0;
+	};
+
+	// NOTE: The first document of a block is only stored in its PostingBlock so every block decodes on its own
+	struct PostingList
+	{
+		std::string Bytes;
+		std::vector<PostingBlock> Blocks;
+		uint32_t LastDocument = 0;
+		uint32_t Count = 0;
+	};
+
+	struct Shard
+	{
+		// NOTE: Indexed by document number
+		std::vector<std::string> MessageIDs;
+		std::unordered_map<std::string, PostingList> Postings;
+		uint64_t LastSequence = 0;
+	};
+
+	std::unordered_map<std::string, Shard> m_Shards;
+	size_t m_MessagesCount = 0;
+	size_t m_PostingsSizeInBytes = 0;
+
+	// NOTE: Reused by Add
+	std::vector<std::string> m_Tokens;
+
+	static void Append(PostingList &List, uint32_t Document);
+	static size_t DecodeBlock(const PostingList &List, size_t BlockIndex, uint32_t *Documents);
+	// NOTE: Keeps the candidates found in List, candidates have to be sorted and not empty
+	static void Intersect(const PostingList &List, std::vector<uint32_t> &Candidates);
+};
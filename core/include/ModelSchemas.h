@@ -0,0 +1,30 @@
+#pragma once
+
+#include "BinaryCodec.h"
+#include "Conversation.h"
+#include "Message.h"
+#include "User.h"
+
+#include <tuple>
+
+// NOTE: New fields are appended at the end of FIELDS, see BinarySchema
+template <> struct BinarySchema<User>
+{
+	static constexpr uint16_t VERSION = 1;
+	static constexpr auto FIELDS = std::make_tuple(&User::ID, &User::FirstName, &User::ImageUrl);
+};
+
+template <> struct BinarySchema<Message>
+{
+	static constexpr uint16_t VERSION = 1;
+	static constexpr auto FIELDS =
+	    std::make_tuple(&Message::ID, &Message::ConversationID, &Message::SenderID, &Message::SenderFirstName,
+	                    &Message::SenderImageUrl, &Message::Text, &Message::CreatedAt, &Message::Nonce, &Message::Sequence);
+};
+
+template <> struct BinarySchema<Conversation>
+{
+	static constexpr uint16_t VERSION = 1;
+	static constexpr auto FIELDS = std::make_tuple(&Conversation::ID, &Conversation::Messages, &Conversation::Users,
+	                                               &Conversation::CreatedAt, &Conversation::LastActivityAt);
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+// NOTE: Unbounded queue any number of threads push to without locks and a single thread pops from, see Dmitry
+// Vyukov's "Non-intrusive MPSC node-based queue"
+// Push is one exchange, so producers never wait on each other or on the consumer. A value pushed while another
+// producer is between its exchange and its link is only visible once that producer links, TryPop returns false until
+// then, Type has to be default constructible
+template <typename Type> class MpscQueue
+{
+  public:
+	MpscQueue() : m_Head(&m_Stub), m_Tail(&m_Stub)
+	{
+	}
+
+	~MpscQueue()
+	{
+		Type Value;
+		while (TryPop(Value))
+		{
+		}
+	}
+
+	MpscQueue(const MpscQueue &) = delete;
+	MpscQueue &operator=(const MpscQueue &) = delete;
+
+	// NOTE: Any thread
+	void Push(Type Value)
+	{
+		Node *NewNode = new Node(std::move(Value));
+		Node *Previous = m_Head.exchange(NewNode, std::memory_order_acq_rel);
+		Previous->Next.store(NewNode, std::memory_order_release);
+	}
+
+	// NOTE: Consumer thread only
+	bool TryPop(Type &Value)
+	{
+		Node *Tail = m_Tail;
+		Node *Next = Tail->Next.load(std::memory_order_acquire);
+		if (Tail == &m_Stub)
+		{
+			if (!Next)
+				return false;
+
+			// Skips the stub, it is pushed back once the queue is about to run empty
+			m_Tail = Next;
+			Tail = Next;
+			Next = Next->Next.load(std::memory_order_acquire);
+		}
+
+		if (!Next)
+		{
+			// NOTE: The last node can only be taken once a node is linked after it, the stub is that node
+			if (Tail != m_Head.load(std::memory_order_acquire))
+				return false;
+
+			m_Stub.Next.store(nullptr, std::memory_order_relaxed);
+			Node *Previous = m_Head.exchange(&m_Stub, std::memory_order_acq_rel);
+			Previous->Next.store(&m_Stub, std::memory_order_release);
+
+			Next = Tail->Next.load(std::memory_order_acquire);
+			if (!Next)
+				return false;
+		}
+
+		Value = std::move(Tail->Value);
+		m_Tail = Next;
+		delete Tail;
+		return true;
+	}
+
+	// NOTE: Consumer thread only, compares the head against the tail so a push that did its exchange but did not link
+	// its node yet already makes the queue not empty, even though TryPop cannot take it yet
+	[[nodiscard]] bool IsEmpty() const
+	{
+		return m_Tail == &m_Stub && m_Head.load(std::memory_order_acquire) == &m_Stub;
+	}
+
+  private:
+	struct Node
+	{
+		std::atomic<Node *> Next{nullptr};
+		Type Value;
+
+		Node() = default;
+		explicit Node(Type Value) : Value(std::move(Value))
+		{
+		}
+	};
+
+	// NOTE: Kept apart so producers pushing do not invalidate the line the consumer reads
+	alignas(64) std::atomic<Node *> m_Head;
+	alignas(64) Node *m_Tail;
+	Node m_Stub;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ChatProtocol.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// NOTE: Nonces are remembered for BUCKETS_COUNT * BUCKET_DURATION, a client retrying later than that sends a duplicate
+constexpr double NONCE_DEDUPLICATOR_BUCKET_DURATION = 600.0;
+constexpr size_t NONCE_DEDUPLICATOR_BUCKETS_COUNT = 6;
+// NOTE: A bucket receiving more nonces than this is rotated early, so a flooding sender shortens its own window
+// instead of growing the memory used for it
+constexpr size_t NONCE_DEDUPLICATOR_BUCKET_CAPACITY = 256;
+// NOTE: Twice the capacity so insertions into the cuckoo filter practically never fail
+constexpr size_t NONCE_DEDUPLICATOR_FILTER_BUCKETS_COUNT = NONCE_DEDUPLICATOR_BUCKET_CAPACITY / 2;
+constexpr size_t NONCE_DEDUPLICATOR_FILTER_SLOTS_COUNT = 4;
+constexpr size_t NONCE_DEDUPLICATOR_MAX_KICKS_COUNT = 64;
+
+static_assert((NONCE_DEDUPLICATOR_FILTER_BUCKETS_COUNT & (NONCE_DEDUPLICATOR_FILTER_BUCKETS_COUNT - 1)) == 0,
+              "Filter buckets count must be a power of two");
+
+// NOTE: Recently received nonces of one sender with the acknowledgement they were given, so a retried send is
+// acknowledged again instead of being stored twice
+// Every time bucket has a cuckoo filter in front of its exact set, new nonces, the common case, are rejected by the
+// filters without touching the sets
+class NonceDeduplicator
+{
+  public:
+	// Getters
+	[[nodiscard]] size_t GetNoncesCount() const;
+	// NOTE: True once every nonce has expired, the deduplicator can then be dropped
+	[[nodiscard]] bool IsExpired(double Now) const;
+
+	// NOTE: Returns the acknowledgement the nonce was given, nullptr when it was not received recently
+	// Only valid until the next Insert
+	const MessageAcknowledgement *Find(uint64_t Nonce, double Now) const;
+	void Insert(const MessageAcknowledgement &Acknowledgement, double Now);
+
+  private:
+	struct Bucket
+	{
+		// NOTE: Negative while unused
+		double StartedAt = -1.0;
+		// NOTE: 0 marks an empty slot, fingerprints are never 0
+		std::array<std::array<uint16_t, NONCE_DEDUPLICATOR_FILTER_SLOTS_COUNT>, NONCE_DEDUPLICATOR_FILTER_BUCKETS_COUNT> Filter = {};
+		std::unordered_map<uint64_t, MessageAcknowledgement> Acknowledgements;
+	};
+
+	std::array<Bucket, NONCE_DEDUPLICATOR_BUCKETS_COUNT> m_Buckets;
+	size_t m_CurrentBucket = 0;
+
+	bool IsLive(const Bucket &CheckedBucket, double Now) const;
+	void Rotate(double Now);
+	bool MayContain(const Bucket &CheckedBucket, uint64_t Hash) const;
+	bool AddToFilter(Bucket &UpdatedBucket, uint64_t Hash);
+};
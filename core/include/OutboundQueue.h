@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ChatProtocol.h"
+#include "Message.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// NOTE: Messages sent within this window go out in the same frame
+constexpr double OUTBOUND_QUEUE_BATCH_WINDOW = 0.005;
+constexpr size_t OUTBOUND_QUEUE_MAX_BATCH_SIZE = 64;
+// NOTE: Unacknowledged messages are sent again after this, doubled on every attempt up to the max
+constexpr double OUTBOUND_QUEUE_RETRY_INTERVAL = 1.0;
+constexpr double OUTBOUND_QUEUE_MAX_RETRY_INTERVAL = 30.0;
+
+// NOTE: Writes a frame to the connection, returns false when it could not be sent so it is retried later
+using OutboundTransport = std::function<bool(std::string_view Frame)>;
+
+// NOTE: Holds sent messages until the server acknowledges them, messages are shown as pending as soon as they are
+// queued so the UI never waits on the round trip
+// Retries reuse the nonce of the first attempt so the server can drop duplicates
+class OutboundQueue
+{
+  public:
+	// NOTE: 0 picks a random seed, nonces of two clients must not collide
+	explicit OutboundQueue(uint64_t NonceSeed = 0);
+
+	// Getters
+	[[nodiscard]] size_t GetPendingCount() const;
+	[[nodiscard]] bool IsPending(uint64_t Nonce) const;
+
+	// NOTE: Nothing is sent while there is no transport, queued messages go out once one is set
+	void SetTransport(OutboundTransport Transport);
+	// NOTE: Called by ReadAcknowledgements with the sent message, its ID and Sequence set from the acknowledgement
+	void SetOnAcknowledged(std::function<void(const Message &AcknowledgedMessage)> OnAcknowledged);
+
+	// NOTE: Assigns the nonce of the message, the caller shows the message with it right away
+	uint64_t Enqueue(Message &NewMessage, double Now);
+	// NOTE: Queues a message left pending by a previous run with its nonce, the server drops it if that send got through
+	void Requeue(const Message &PendingMessage, double Now);
+	// NOTE: Sends new messages once their batch window is over and retries the ones due
+	// Returns the time of the next send or retry, negative when nothing is queued
+	double Update(double Now);
+	// NOTE: Sends every unacknowledged message with the next Update, called after reconnecting
+	void Resend();
+	// NOTE: Returns false for unknown nonces, an acknowledgement of a retry that was already acknowledged
+	bool Acknowledge(const MessageAcknowledgement &Acknowledgement, Message &AcknowledgedMessage);
+	// NOTE: Acknowledges every message of an Acknowledgements frame payload, returns false when it is malformed
+	bool ReadAcknowledgements(std::string_view Payload);
+
+  private:
+	struct Entry
+	{
+		Message Value;
+		double QueuedAt = 0.0;
+		// NOTE: Negative until sent once
+		double SentAt = -1.0;
+		double RetryInterval = OUTBOUND_QUEUE_RETRY_INTERVAL;
+	};
+
+	// NOTE: Nonces are increasing so the map keeps messages in the order they were sent
+	std::map<uint64_t, Entry> m_Entries;
+	uint64_t m_NextNonce = 0;
+	OutboundTransport m_Transport;
+	std::function<void(const Message &AcknowledgedMessage)> m_OnAcknowledged;
+	// NOTE: Set when the transport fails, keeps a dead connection from being written to every frame
+	double m_BlockedUntil = 0.0;
+
+	// NOTE: Reused by Update
+	std::vector<const Message *> m_Batch;
+	std::vector<Entry *> m_BatchEntries;
+	std::string m_Frame;
+	// NOTE: Reused by ReadAcknowledgements
+	std::vector<MessageAcknowledgement> m_Acknowledgements;
+
+	double GetDueAt(const Entry &QueuedEntry) const;
+	bool SendBatch(double Now);
+};
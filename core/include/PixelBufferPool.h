@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+constexpr size_t PIXEL_BUFFER_POOL_MAX_BUFFERS_COUNT = 16;
+// NOTE: Smaller blocks are stb's scratch buffers, they go straight to malloc so they never take a block sized for pixels
+constexpr size_t PIXEL_BUFFER_POOL_MIN_BUFFER_SIZE = 64 * 1024;
+
+// NOTE: Recycles the buffers images are decoded into so steady-state decoding does not allocate
+// Texture.cpp builds stb_image with STBI_MALLOC, STBI_REALLOC and STBI_FREE routed here, so stb decodes straight into
+// pooled memory and the pixels it returns are uploaded as is, stbi_image_free hands them back to the pool
+class PixelBufferPool
+{
+  public:
+	// NOTE: stb's allocation hooks are global, so every decoding thread shares this pool
+	static PixelBufferPool &GetInstance();
+
+	PixelBufferPool() = default;
+	~PixelBufferPool();
+	PixelBufferPool(const PixelBufferPool &) = delete;
+	PixelBufferPool &operator=(const PixelBufferPool &) = delete;
+
+	// Getters
+	[[nodiscard]] size_t GetFreeBuffersCount() const;
+
+	// NOTE: Same contracts as malloc, realloc and free, from any thread
+	void *Allocate(size_t Size);
+	void *Reallocate(void *Buffer, size_t Size);
+	void Free(void *Buffer);
+
+  private:
+	// NOTE: Placed in front of every block, its alignment keeps the returned memory aligned like malloc's
+	struct alignas(16) BufferHeader
+	{
+		size_t Capacity = 0;
+	};
+
+	mutable std::mutex m_Mutex;
+	std::vector<BufferHeader *> m_FreeBuffers;
+};
+
+struct PixelBufferDeleter
+{
+  public:
+	void operator()(unsigned char *Pixels) const
+	{
+		PixelBufferPool::GetInstance().Free(Pixels);
+	}
+};
+
+// NOTE: Pixels decoded by stb_image, owned until they are handed back to the pool
+using PooledPixels = std::unique_ptr<unsigned char, PixelBufferDeleter>;
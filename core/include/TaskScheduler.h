@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using TaskFunction = std::function<void()>;
+
+// NOTE: Lanes are tried from first to last, a task only runs once no task of a lane before it is queued anywhere
+enum class TaskPriority
+{
+	High,
+	Normal,
+	Low
+};
+
+constexpr size_t TASK_PRIORITIES_COUNT = 3;
+
+struct TaskState;
+
+struct TaskContinuation
+{
+  public:
+	std::shared_ptr<TaskState> State;
+	TaskFunction Function;
+	TaskPriority Priority = TaskPriority::Normal;
+};
+
+// NOTE: Only touched through TaskHandle and TaskScheduler
+struct TaskState
+{
+  public:
+	std::mutex Mutex;
+	std::condition_variable Condition;
+	bool IsDone = false;
+	// NOTE: Submitted by the worker that runs the task once it is done
+	std::vector<TaskContinuation> Continuations;
+};
+
+// NOTE: Copies refer to the same task
+class TaskHandle
+{
+  public:
+	TaskHandle() = default;
+
+	// Getters
+	[[nodiscard]] bool IsValid() const;
+	// NOTE: True for an invalid handle
+	[[nodiscard]] bool IsDone() const;
+
+	// NOTE: Blocks until the task ran, never call it from a task since it would hold its worker, use Then instead
+	// Returns right away for an invalid handle
+	void Wait() const;
+
+  private:
+	friend class TaskScheduler;
+
+	std::shared_ptr<TaskState> m_State;
+};
+
+// NOTE: Runs CPU work off the network event loops, encoding, compression, indexing and validation are submitted to it
+// Every worker owns a deque per priority, tasks submitted from a worker go to the back of its own deque and run
+// newest first while their data is still in cache, idle workers steal the oldest task of another worker
+// Tasks submitted from other threads are spread over the workers round robin
+class TaskScheduler
+{
+  public:
+	// NOTE: 0 uses one worker per hardware thread
+	explicit TaskScheduler(size_t WorkersCount = 0);
+	~TaskScheduler();
+	TaskScheduler(const TaskScheduler &) = delete;
+	TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+	// Getters
+	[[nodiscard]] size_t GetWorkersCount() const;
+	// NOTE: Tasks taken from another worker's deque since the scheduler started
+	[[nodiscard]] uint64_t GetStolenCount() const;
+
+	TaskHandle Submit(TaskFunction Function, TaskPriority Priority = TaskPriority::Normal);
+	// NOTE: Submits Function once Previous ran, right away when it already did or is invalid
+	TaskHandle Then(const TaskHandle &Previous, TaskFunction Function, TaskPriority Priority = TaskPriority::Normal);
+	// NOTE: Blocks until every task submitted so far and their continuations ran
+	void WaitIdle();
+
+  private:
+	struct Task
+	{
+		std::shared_ptr<TaskState> State;
+		TaskFunction Function;
+	};
+
+	struct alignas(64) Worker
+	{
+		// NOTE: Locked by the owner for each push and pop and by thieves, rarely contended since thieves only come
+		// once their own deques are empty
+		std::mutex Mutex;
+		std::deque<Task> Lanes[TASK_PRIORITIES_COUNT];
+		std::thread Thread;
+	};
+
+	std::vector<std::unique_ptr<Worker>> m_Workers;
+	std::atomic<size_t> m_NextWorker = 0;
+	std::atomic<uint64_t> m_StolenCount = 0;
+	// NOTE: Queued tasks of each lane, lets workers skip empty lanes without locking every deque and only sleep once
+	// every lane is empty
+	std::atomic<size_t> m_QueuedCounts[TASK_PRIORITIES_COUNT] = {};
+	// NOTE: Queued, waiting on a previous task or running, WaitIdle returns once it is 0
+	std::atomic<size_t> m_PendingCount = 0;
+
+	std::mutex m_SleepMutex;
+	std::condition_variable m_SleepCondition;
+	std::condition_variable m_IdleCondition;
+	std::atomic<size_t> m_SleepingCount = 0;
+	bool m_IsStopping = false;
+
+	[[nodiscard]] size_t GetQueuedCount() const;
+
+	void Push(Task NewTask, TaskPriority Priority);
+	bool Pop(size_t WorkerIndex, Task &NextTask);
+	void Run(Task &CurrentTask);
+	void RunWorker(size_t WorkerIndex);
+};
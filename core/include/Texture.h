@@ -11,6 +11,8 @@ class Texture
 	[[nodiscard]] unsigned int GetUnit() const;
 
 	void Load(const std::string &FilePath, const unsigned int Unit);
+	// NOTE: Uploads already decoded pixels, rows are tightly packed with ChannelsCount bytes per pixel
+	void LoadFromPixels(const unsigned char *Pixels, int Width, int Height, int ChannelsCount, const unsigned int Unit);
 	void Destroy() const;
 	void Bind() const;
 	void Unbind() const;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Vector.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+constexpr int TEXTURE_ATLAS_PAGE_SIZE = 1024;
+// NOTE: Images bigger than this on either side get their own texture instead of being packed
+constexpr int TEXTURE_ATLAS_MAX_IMAGE_SIZE = 256;
+// NOTE: Transparent border around every packed image to keep neighbours from bleeding when filtered
+constexpr int TEXTURE_ATLAS_PADDING = 1;
+
+// NOTE: Part of a texture drawn by an Image, the whole texture by default
+struct TextureRegion
+{
+  public:
+	unsigned int TextureID = 0;
+	Vector2 UvMin = Vector2(0.0f, 0.0f);
+	Vector2 UvMax = Vector2(1.0f, 1.0f);
+
+	TextureRegion() = default;
+	explicit TextureRegion(unsigned int TextureID) : TextureID(TextureID)
+	{
+	}
+};
+
+// NOTE: Packs many small RGBA images into a few large textures so ImGui can draw them in a single batch
+// Images are packed tightly by stb_rect_pack, whose skyline only grows, so the space of removed images is kept in a free
+// list per page and reused first
+// Must be used from the thread owning the GL context
+class TextureAtlas
+{
+  public:
+	explicit TextureAtlas(int PageSize = TEXTURE_ATLAS_PAGE_SIZE);
+	~TextureAtlas();
+	TextureAtlas(const TextureAtlas &) = delete;
+	TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+	// Getters
+	[[nodiscard]] int GetPageSize() const;
+	[[nodiscard]] size_t GetPagesCount() const;
+	// NOTE: GPU memory of every page, whatever the number of images packed in them
+	[[nodiscard]] size_t GetUsedBytes() const;
+
+	// NOTE: Returns false when the image does not fit in a page
+	bool Add(const unsigned char *RgbaPixels, int Width, int Height, TextureRegion &Region);
+	// NOTE: The page is destroyed once its last image is removed
+	void Remove(const TextureRegion &Region);
+	void Destroy();
+
+  private:
+	struct Page;
+	// NOTE: Padded rectangle of a page
+	struct Rect;
+
+	int m_PageSize = TEXTURE_ATLAS_PAGE_SIZE;
+	std::vector<std::unique_ptr<Page>> m_Pages;
+	// NOTE: Uploaded over removed images so free space stays transparent
+	std::vector<unsigned char> m_TransparentPixels;
+
+	Page *AddPage();
+	void AddToPage(Page &AtlasPage, const Rect &PageRect, const unsigned char *RgbaPixels, int Width, int Height,
+	               TextureRegion &Region);
+	bool TakeFreeRect(Page &AtlasPage, int Width, int Height, Rect &PageRect);
+	void AddFreeRect(Page &AtlasPage, Rect PageRect);
+};
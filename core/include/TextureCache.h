@@ -0,0 +1,68 @@
+#pragma once
+
+#include "TextureAtlas.h"
+#include "TextureLoader.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+constexpr size_t TEXTURE_CACHE_DEFAULT_BUDGET_BYTES = 64 * 1024 * 1024;
+constexpr double TEXTURE_CACHE_RETRY_MIN_DELAY_SECONDS = 1.0;
+constexpr double TEXTURE_CACHE_RETRY_MAX_DELAY_SECONDS = 60.0;
+
+// NOTE: Textures keyed by image URL, loaded once and shared by every widget drawing them
+// Least recently drawn textures are evicted by Trim when the GPU memory budget is exceeded
+// Failed loads keep showing the placeholder and are retried with a doubling delay, Trim evicts them once they are not
+// drawn and their delay is spent
+// Must be used from the thread owning the GL context
+class TextureCache
+{
+  public:
+	explicit TextureCache(size_t BudgetBytes = TEXTURE_CACHE_DEFAULT_BUDGET_BYTES, unsigned int WorkersCount = 0,
+	                      TextureFetcher Fetcher = nullptr);
+	TextureCache(const TextureCache &) = delete;
+	TextureCache &operator=(const TextureCache &) = delete;
+
+	// Getters
+	[[nodiscard]] size_t GetBudgetBytes() const;
+	[[nodiscard]] size_t GetUsedBytes() const;
+	[[nodiscard]] size_t GetSize() const;
+
+	void SetBudgetBytes(size_t BudgetBytes);
+	void SetOnDecoded(std::function<void()> OnDecoded);
+
+	// NOTE: Starts loading the texture on first use and marks it as drawn this frame
+	// Returns the placeholder until the texture is uploaded or while it failed to load
+	TextureRegion Get(const std::string &Url, const TextureRegion &PlaceholderRegion);
+	// NOTE: Uploads decoded images until the time budget is spent, returns true when decoded images are left
+	bool Upload(double TimeBudgetSeconds);
+	// NOTE: Called once per frame after drawing, textures drawn during the frame are never evicted
+	void Trim();
+	void Destroy();
+
+  private:
+	struct Entry
+	{
+		std::string Url;
+		TextureRequestID RequestID = TEXTURE_REQUEST_INVALID_ID;
+		uint64_t LastDrawnFrame = 0;
+		uint32_t FailuresCount = 0;
+		// NOTE: Set once a failure is seen, the failed request is kept until then so it is not decoded every frame
+		std::chrono::steady_clock::time_point RetryTime;
+	};
+
+	size_t m_BudgetBytes = TEXTURE_CACHE_DEFAULT_BUDGET_BYTES;
+	uint64_t m_Frame = 0;
+
+	// NOTE: Most recently drawn first
+	std::list<Entry> m_Entries;
+	std::unordered_map<std::string, std::list<Entry>::iterator> m_EntriesByUrl;
+
+	TextureAtlas m_Atlas;
+	TextureLoader m_Loader;
+};
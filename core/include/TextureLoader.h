@@ -0,0 +1,125 @@
+#pragma once
+
+#include "PixelBufferPool.h"
+#include "Texture.h"
+#include "TextureAtlas.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using TextureRequestID = uint32_t;
+
+constexpr TextureRequestID TEXTURE_REQUEST_INVALID_ID = UINT32_MAX;
+// NOTE: Decoded images are always expanded to RGBA so they can be uploaded and packed the same way
+constexpr int TEXTURE_LOADER_CHANNELS_COUNT = 4;
+
+// NOTE: Reads the encoded bytes of an image URL, called from worker threads, returns false when the URL can not be
+// fetched. File paths and file:// URLs are read from disk when none is given
+using TextureFetcher = std::function<bool(const std::string &Url, std::vector<unsigned char> &Bytes)>;
+
+enum class TextureRequestState
+{
+	Decoding,
+	Decoded,
+	Ready,
+	Failed,
+	Released
+};
+
+// NOTE: Fetches and decodes images on worker threads, Upload must be called from the thread owning the GL context
+class TextureLoader
+{
+  public:
+	// NOTE: 0 picks a workers count from the hardware concurrency
+	explicit TextureLoader(unsigned int WorkersCount = 0, TextureFetcher Fetcher = nullptr);
+	~TextureLoader();
+	TextureLoader(const TextureLoader &) = delete;
+	TextureLoader &operator=(const TextureLoader &) = delete;
+
+	// Getters
+	[[nodiscard]] TextureRequestState GetState(TextureRequestID ID) const;
+	// NOTE: Returns the placeholder until the texture is uploaded, or forever if it failed to load
+	[[nodiscard]] unsigned int GetTextureID(TextureRequestID ID, unsigned int PlaceholderTextureID) const;
+	[[nodiscard]] TextureRegion GetTextureRegion(TextureRequestID ID, const TextureRegion &PlaceholderRegion) const;
+	// NOTE: GPU memory used by standalone textures and by every atlas page, however full
+	[[nodiscard]] size_t GetUsedBytes() const;
+	// NOTE: Requests that failed to load and were not released yet
+	[[nodiscard]] size_t GetFailedCount() const;
+
+	// NOTE: Images small enough are packed into the atlas instead of getting their own texture
+	void SetAtlas(TextureAtlas *Atlas);
+
+	// NOTE: Called from a worker thread every time an image is decoded, used to wake the render loop
+	void SetOnDecoded(std::function<void()> OnDecoded);
+
+	// NOTE: Requesting the same URL twice returns the same request
+	TextureRequestID Request(const std::string &Url);
+	// NOTE: Uploads decoded images until the time budget is spent, returns true when decoded images are left
+	bool Upload(double TimeBudgetSeconds);
+	// NOTE: Frees the texture of a ready or failed request, its ID may be returned by a later Request
+	// Returns false for requests still decoding since a worker would write the result into a reused ID
+	bool Release(TextureRequestID ID);
+	// NOTE: Drops every request, images still decoding are discarded by Upload once they are done
+	void Destroy();
+
+  private:
+	struct Entry
+	{
+		std::string Url;
+		Texture LoadedTexture;
+		TextureRegion Region;
+		size_t SizeInBytes = 0;
+		TextureRequestState State = TextureRequestState::Decoding;
+	};
+
+	struct Job
+	{
+		TextureRequestID ID = TEXTURE_REQUEST_INVALID_ID;
+		uint32_t Generation = 0;
+		std::string Url;
+	};
+
+	struct DecodedImage
+	{
+		TextureRequestID ID = TEXTURE_REQUEST_INVALID_ID;
+		uint32_t Generation = 0;
+		// NOTE: Decoded straight into pooled memory, returned to the pool once uploaded
+		PooledPixels Pixels;
+		int Width = 0;
+		int Height = 0;
+		bool IsValid = false;
+	};
+
+	// NOTE: Only touched by the GL thread
+	std::vector<Entry> m_Entries;
+	std::unordered_map<std::string, TextureRequestID> m_IDsByUrl;
+	std::vector<TextureRequestID> m_FreeIDs;
+	TextureAtlas *m_Atlas = nullptr;
+	size_t m_UsedBytes = 0;
+	size_t m_FailedCount = 0;
+	// NOTE: Bumped by Destroy, images decoded for an older generation belong to entries that no longer exist
+	uint32_t m_Generation = 0;
+
+	// NOTE: Set before the workers start and never changed
+	TextureFetcher m_Fetcher;
+	std::vector<std::thread> m_Workers;
+	std::mutex m_JobsMutex;
+	std::condition_variable m_JobsCondition;
+	std::deque<Job> m_Jobs;
+	bool m_IsStopping = false;
+
+	std::mutex m_DecodedImagesMutex;
+	std::deque<DecodedImage> m_DecodedImages;
+	std::function<void()> m_OnDecoded;
+
+	void RunWorker();
+	DecodedImage Decode(const Job &DecodeJob, std::vector<unsigned char> &ImageBytes);
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+struct User
+{
+  public:
+	std::string ID;
+	std::string FirstName;
+	std::string ImageUrl;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+enum class Utf8Kernel
+{
+	// NOTE: Byte by byte, always available
+	Scalar = 0,
+	// NOTE: Skips 16 bytes of ASCII at a time, other characters are checked by the scalar path
+	Sse2 = 1,
+	// NOTE: Checks 32 bytes at a time whatever they hold
+	Avx2 = 2
+};
+
+// NOTE: Fastest kernel supported by the CPU, checked once
+Utf8Kernel GetBestUtf8Kernel();
+[[nodiscard]] bool IsUtf8KernelSupported(Utf8Kernel Kernel);
+
+// NOTE: Rejects overlong encodings, surrogates, code points past U+10FFFF and truncated sequences
+[[nodiscard]] bool IsValidUtf8(std::string_view Text);
+// NOTE: Kernel has to be supported, used by tests and benchmarks to compare kernels
+[[nodiscard]] bool IsValidUtf8(std::string_view Text, Utf8Kernel Kernel);
+
+// NOTE: Replaces every byte that is not part of a valid sequence with U+FFFD, returns false when nothing was replaced
+bool SanitizeUtf8(std::string &Text);
@@ -7,7 +7,7 @@ struct Vector2
 	float Y;
 
 	Vector2() = default;
-	Vector2(float X, float Y) : X(X), Y(Y)
+	constexpr Vector2(float X, float Y) : X(X), Y(Y)
 	{
 	}
 
@@ -51,7 +51,7 @@ struct Vector4
 	float W;
 
 	Vector4() = default;
-	Vector4(float X, float Y, float Z, float W) : X(X), Y(Y), Z(Z), W(W)
+	constexpr Vector4(float X, float Y, float Z, float W) : X(X), Y(Y), Z(Z), W(W)
 	{
 	}
 
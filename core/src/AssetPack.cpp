@@ -0,0 +1,135 @@
+#include "AssetPack.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+// NOTE: Pixels are uploaded straight from the mapping, so an image has to fit in its entry's bytes, overflow of the
+// multiplication is checked first since a corrupt pack can hold any dimensions
+bool IsImageEntryValid(const AssetPackEntry &Entry)
+{
+	if (Entry.ChannelsCount == 0 || Entry.ChannelsCount > 4)
+		return false;
+
+	const uint64_t WIDTH = Entry.Width;
+	const uint64_t HEIGHT = Entry.Height;
+	const uint64_t CHANNELS_COUNT = Entry.ChannelsCount;
+	if (HEIGHT != 0 && WIDTH > UINT64_MAX / HEIGHT)
+		return false;
+	if (WIDTH * HEIGHT > UINT64_MAX / CHANNELS_COUNT)
+		return false;
+
+	return WIDTH * HEIGHT * CHANNELS_COUNT <= Entry.Size;
+}
+} // namespace
+
+AssetPack::~AssetPack()
+{
+	Close();
+}
+
+// ***********
+// * GETTERS *
+// ***********
+bool AssetPack::IsOpen() const
+{
+	return m_Data != nullptr;
+}
+
+const AssetPackEntry *AssetPack::Find(std::string_view Name) const
+{
+	// NOTE: Linear search, packs only hold a handful of assets
+	for (uint32_t i = 0; i < m_EntriesCount; i++)
+	{
+		const AssetPackEntry &Entry = m_Entries[i];
+		const size_t NAME_LENGTH = strnlen(Entry.Name, ASSET_PACK_NAME_SIZE);
+		if (std::string_view(Entry.Name, NAME_LENGTH) == Name)
+			return &Entry;
+	}
+
+	return nullptr;
+}
+
+const unsigned char *AssetPack::GetData(const AssetPackEntry &Entry) const
+{
+	return m_Data + Entry.Offset;
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool AssetPack::Open(const std::string &FilePath)
+{
+	Close();
+
+	const int FILE_DESCRIPTOR = open(FilePath.c_str(), O_RDONLY);
+	if (FILE_DESCRIPTOR < 0)
+	{
+		// Handles file open failure error
+		return false;
+	}
+
+	struct stat FileStat = {};
+	if (fstat(FILE_DESCRIPTOR, &FileStat) < 0 || FileStat.st_size < static_cast<off_t>(sizeof(AssetPackHeader)))
+	{
+		// Handles file too small error
+		close(FILE_DESCRIPTOR);
+		return false;
+	}
+
+	const size_t SIZE = static_cast<size_t>(FileStat.st_size);
+	void *Mapping = mmap(nullptr, SIZE, PROT_READ, MAP_PRIVATE, FILE_DESCRIPTOR, 0);
+	// NOTE: The mapping stays valid after the file descriptor is closed
+	close(FILE_DESCRIPTOR);
+	if (Mapping == MAP_FAILED)
+	{
+		// Handles mmap failure error
+		return false;
+	}
+
+	const unsigned char *Data = static_cast<const unsigned char *>(Mapping);
+
+	// Validates header and entries so a truncated or stale pack is rejected instead of read out of bounds
+	AssetPackHeader Header = {};
+	std::memcpy(&Header, Data, sizeof(Header));
+	const size_t ENTRIES_END = sizeof(AssetPackHeader) + static_cast<size_t>(Header.EntriesCount) * sizeof(AssetPackEntry);
+	bool IsValid = Header.Magic == ASSET_PACK_MAGIC && Header.Version == ASSET_PACK_VERSION && ENTRIES_END <= SIZE;
+
+	const AssetPackEntry *Entries = reinterpret_cast<const AssetPackEntry *>(Data + sizeof(AssetPackHeader));
+	for (uint32_t i = 0; IsValid && i < Header.EntriesCount; i++)
+	{
+		const AssetPackEntry &Entry = Entries[i];
+		IsValid = Entry.Offset >= ENTRIES_END && Entry.Offset <= SIZE && Entry.Size <= SIZE - Entry.Offset &&
+		          (Entry.Type != AssetType::Image || IsImageEntryValid(Entry));
+	}
+
+	if (!IsValid)
+	{
+		// Handles invalid pack error
+		munmap(Mapping, SIZE);
+		return false;
+	}
+
+	m_Data = Data;
+	m_Size = SIZE;
+	m_Entries = Entries;
+	m_EntriesCount = Header.EntriesCount;
+
+	return true;
+}
+
+void AssetPack::Close()
+{
+	if (!m_Data)
+		return;
+
+	munmap(const_cast<unsigned char *>(m_Data), m_Size);
+	m_Data = nullptr;
+	m_Size = 0;
+	m_Entries = nullptr;
+	m_EntriesCount = 0;
+}
@@ -0,0 +1,257 @@
+#include "ChatProtocol.h"
+#include "BinaryStream.h"
+#include "ModelSchemas.h"
+
+#include <cstring>
+
+namespace
+{
+// NOTE: Writes the header once the payload size is known
+size_t BeginFrame(std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = Buffer.size();
+	Buffer.resize(Buffer.size() + sizeof(ChatFrameHeader));
+	return HEADER_OFFSET;
+}
+
+void EndFrame(std::string &Buffer, size_t HeaderOffset, ChatFrameType Type)
+{
+	ChatFrameHeader Header = {};
+	Header.Size = static_cast<uint32_t>(Buffer.size() - HeaderOffset - sizeof(ChatFrameHeader));
+	Header.Type = Type;
+	std::memcpy(&Buffer[HeaderOffset], &Header, sizeof(Header));
+}
+} // namespace
+
+void EncodeSendMessagesFrame(const std::vector<const Message *> &Messages, std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = BeginFrame(Buffer);
+
+	WriteBinaryValue<uint32_t>(Buffer, static_cast<uint32_t>(Messages.size()));
+	for (const Message *SentMessage : Messages)
+	{
+		WriteBinaryValue<uint64_t>(Buffer, SentMessage->Nonce);
+		WriteBinaryValue<int64_t>(Buffer, static_cast<int64_t>(SentMessage->CreatedAt));
+		WriteBinaryString(Buffer, SentMessage->ConversationID);
+		WriteBinaryString(Buffer, SentMessage->SenderID);
+		WriteBinaryString(Buffer, SentMessage->SenderFirstName);
+		WriteBinaryString(Buffer, SentMessage->SenderImageUrl);
+		WriteBinaryString(Buffer, SentMessage->Text);
+	}
+
+	EndFrame(Buffer, HEADER_OFFSET, ChatFrameType::SendMessages);
+}
+
+void EncodeAcknowledgementsFrame(const std::vector<MessageAcknowledgement> &Acknowledgements, std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = BeginFrame(Buffer);
+
+	WriteBinaryValue<uint32_t>(Buffer, static_cast<uint32_t>(Acknowledgements.size()));
+	for (const MessageAcknowledgement &Acknowledgement : Acknowledgements)
+	{
+		WriteBinaryValue<uint64_t>(Buffer, Acknowledgement.Nonce);
+		WriteBinaryValue<uint64_t>(Buffer, Acknowledgement.Sequence);
+		WriteBinaryString(Buffer, Acknowledgement.MessageID);
+	}
+
+	EndFrame(Buffer, HEADER_OFFSET, ChatFrameType::Acknowledgements);
+}
+
+void EncodeSearchMessagesFrame(const SearchMessagesRequest &Request, std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = BeginFrame(Buffer);
+
+	WriteBinaryValue<uint32_t>(Buffer, Request.RequestID);
+	WriteBinaryString(Buffer, Request.ConversationID);
+	WriteBinaryString(Buffer, Request.Query);
+	WriteBinaryValue<uint32_t>(Buffer, Request.MaxResultsCount);
+
+	EndFrame(Buffer, HEADER_OFFSET, ChatFrameType::SearchMessages);
+}
+
+void EncodeSearchResultsFrame(const SearchMessagesResults &Results, std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = BeginFrame(Buffer);
+
+	WriteBinaryValue<uint32_t>(Buffer, Results.RequestID);
+	WriteBinaryValue<uint32_t>(Buffer, static_cast<uint32_t>(Results.MessageIDs.size()));
+	for (const std::string &MessageID : Results.MessageIDs)
+	{
+		WriteBinaryString(Buffer, MessageID);
+	}
+
+	EndFrame(Buffer, HEADER_OFFSET, ChatFrameType::SearchResults);
+}
+
+void EncodeClusterHelloFrame(std::string_view NodeID, std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = BeginFrame(Buffer);
+
+	WriteBinaryString(Buffer, NodeID);
+
+	EndFrame(Buffer, HEADER_OFFSET, ChatFrameType::ClusterHello);
+}
+
+void EncodeClusterSubscriptionsFrame(bool IsSubscribed, const std::vector<std::string> &ConversationIDs,
+                                     std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = BeginFrame(Buffer);
+
+	WriteBinaryValue<uint8_t>(Buffer, IsSubscribed ? 1 : 0);
+	WriteBinaryValue<uint32_t>(Buffer, static_cast<uint32_t>(ConversationIDs.size()));
+	for (const std::string &ConversationID : ConversationIDs)
+	{
+		WriteBinaryString(Buffer, ConversationID);
+	}
+
+	EndFrame(Buffer, HEADER_OFFSET, ChatFrameType::ClusterSubscriptions);
+}
+
+void EncodeClusterMessagesFrame(const std::vector<const Message *> &Messages, std::string &Buffer)
+{
+	const size_t HEADER_OFFSET = BeginFrame(Buffer);
+
+	// NOTE: Records carry their own size so they are written back to back
+	WriteBinaryValue<uint32_t>(Buffer, static_cast<uint32_t>(Messages.size()));
+	for (const Message *ForwardedMessage : Messages)
+	{
+		EncodeBinary(*ForwardedMessage, Buffer);
+	}
+
+	EndFrame(Buffer, HEADER_OFFSET, ChatFrameType::ClusterMessages);
+}
+
+bool DecodeSendMessagesFrame(std::string_view Payload, std::vector<Message> &Messages)
+{
+	BinaryReader Reader(Payload);
+	const uint32_t MESSAGES_COUNT = Reader.ReadValue<uint32_t>();
+
+	Messages.clear();
+	for (uint32_t i = 0; i < MESSAGES_COUNT && Reader.IsValid; i++)
+	{
+		Message ReceivedMessage = {};
+		ReceivedMessage.Nonce = Reader.ReadValue<uint64_t>();
+		ReceivedMessage.CreatedAt = static_cast<std::time_t>(Reader.ReadValue<int64_t>());
+		ReceivedMessage.ConversationID = Reader.ReadString();
+		ReceivedMessage.SenderID = Reader.ReadString();
+		ReceivedMessage.SenderFirstName = Reader.ReadString();
+		ReceivedMessage.SenderImageUrl = Reader.ReadString();
+		ReceivedMessage.Text = Reader.ReadString();
+		Messages.push_back(std::move(ReceivedMessage));
+	}
+
+	return Reader.IsValid && Reader.IsAtEnd();
+}
+
+bool DecodeAcknowledgementsFrame(std::string_view Payload, std::vector<MessageAcknowledgement> &Acknowledgements)
+{
+	BinaryReader Reader(Payload);
+	const uint32_t ACKNOWLEDGEMENTS_COUNT = Reader.ReadValue<uint32_t>();
+
+	Acknowledgements.clear();
+	for (uint32_t i = 0; i < ACKNOWLEDGEMENTS_COUNT && Reader.IsValid; i++)
+	{
+		MessageAcknowledgement Acknowledgement = {};
+		Acknowledgement.Nonce = Reader.ReadValue<uint64_t>();
+		Acknowledgement.Sequence = Reader.ReadValue<uint64_t>();
+		Acknowledgement.MessageID = Reader.ReadString();
+		Acknowledgements.push_back(std::move(Acknowledgement));
+	}
+
+	return Reader.IsValid && Reader.IsAtEnd();
+}
+
+bool DecodeSearchMessagesFrame(std::string_view Payload, SearchMessagesRequest &Request)
+{
+	BinaryReader Reader(Payload);
+	Request.RequestID = Reader.ReadValue<uint32_t>();
+	Request.ConversationID = Reader.ReadString();
+	Request.Query = Reader.ReadString();
+	Request.MaxResultsCount = Reader.ReadValue<uint32_t>();
+
+	return Reader.IsValid && Reader.IsAtEnd();
+}
+
+bool DecodeSearchResultsFrame(std::string_view Payload, SearchMessagesResults &Results)
+{
+	BinaryReader Reader(Payload);
+	Results.RequestID = Reader.ReadValue<uint32_t>();
+	const uint32_t MESSAGE_IDS_COUNT = Reader.ReadValue<uint32_t>();
+
+	Results.MessageIDs.clear();
+	for (uint32_t i = 0; i < MESSAGE_IDS_COUNT && Reader.IsValid; i++)
+	{
+		Results.MessageIDs.push_back(Reader.ReadString());
+	}
+
+	return Reader.IsValid && Reader.IsAtEnd();
+}
+
+size_t ReadChatFrame(std::string_view Buffer, ChatFrameHeader &Header, std::string_view &Payload, bool &IsValid)
+{
+	IsValid = true;
+	if (Buffer.size() < sizeof(ChatFrameHeader))
+		return 0;
+
+	std::memcpy(&Header, Buffer.data(), sizeof(Header));
+	if (Header.Size > CHAT_FRAME_MAX_PAYLOAD_SIZE)
+	{
+		// Handles corrupted stream error
+		IsValid = false;
+		return 0;
+	}
+
+	const size_t FRAME_SIZE = sizeof(ChatFrameHeader) + Header.Size;
+	if (Buffer.size() < FRAME_SIZE)
+		return 0;
+
+	Payload = Buffer.substr(sizeof(ChatFrameHeader), Header.Size);
+	return FRAME_SIZE;
+}
+
+bool DecodeClusterHelloFrame(std::string_view Payload, std::string &NodeID)
+{
+	BinaryReader Reader(Payload);
+	NodeID = Reader.ReadString();
+
+	return Reader.IsValid && Reader.IsAtEnd() && !NodeID.empty();
+}
+
+bool DecodeClusterSubscriptionsFrame(std::string_view Payload, bool &IsSubscribed,
+                                     std::vector<std::string> &ConversationIDs)
+{
+	BinaryReader Reader(Payload);
+	IsSubscribed = Reader.ReadValue<uint8_t>() != 0;
+	const uint32_t CONVERSATION_IDS_COUNT = Reader.ReadValue<uint32_t>();
+
+	ConversationIDs.clear();
+	for (uint32_t i = 0; i < CONVERSATION_IDS_COUNT && Reader.IsValid; i++)
+	{
+		ConversationIDs.push_back(Reader.ReadString());
+	}
+
+	return Reader.IsValid && Reader.IsAtEnd();
+}
+
+bool DecodeClusterMessagesFrame(std::string_view Payload, std::vector<Message> &Messages)
+{
+	BinaryReader Reader(Payload);
+	const uint32_t MESSAGES_COUNT = Reader.ReadValue<uint32_t>();
+	if (!Reader.IsValid)
+		return false;
+
+	Messages.clear();
+	std::string_view Records = Payload.substr(Reader.Offset);
+	for (uint32_t i = 0; i < MESSAGES_COUNT; i++)
+	{
+		const BinaryView<Message> RECORD(Records);
+		if (!DecodeBinary(RECORD, Messages.emplace_back()))
+		{
+			// Handles malformed record error
+			return false;
+		}
+		Records.remove_prefix(RECORD.GetSize());
+	}
+
+	return Records.empty();
+}
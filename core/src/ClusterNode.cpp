@@ -0,0 +1,541 @@
+#include "ClusterNode.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+namespace
+{
+constexpr size_t CLUSTER_READ_SIZE = 64 * 1024;
+
+// NOTE: A peer closing its end must not raise SIGPIPE, macOS has no MSG_NOSIGNAL and sets SO_NOSIGPIPE instead
+#ifdef MSG_NOSIGNAL
+constexpr int CLUSTER_SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int CLUSTER_SEND_FLAGS = 0;
+#endif
+
+bool ConfigureSocket(int Socket)
+{
+	const int FLAGS = fcntl(Socket, F_GETFL, 0);
+	if (FLAGS < 0 || fcntl(Socket, F_SETFL, FLAGS | O_NONBLOCK) < 0)
+		return false;
+
+	// NOTE: Batching is done before writing, waiting for more bytes would only delay the batch
+	const int IS_ENABLED = 1;
+	setsockopt(Socket, IPPROTO_TCP, TCP_NODELAY, &IS_ENABLED, sizeof(IS_ENABLED));
+#ifdef SO_NOSIGPIPE
+	setsockopt(Socket, SOL_SOCKET, SO_NOSIGPIPE, &IS_ENABLED, sizeof(IS_ENABLED));
+#endif
+	return true;
+}
+} // namespace
+
+ClusterNode::ClusterNode(std::string NodeID) : m_NodeID(std::move(NodeID))
+{
+}
+
+ClusterNode::~ClusterNode()
+{
+	// NOTE: Links closed on destruction are not reported
+	m_OnMembershipChanged = nullptr;
+	for (std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		CloseLink(*CurrentLink);
+	}
+	if (m_ListenSocket >= 0)
+		close(m_ListenSocket);
+}
+
+// ***********
+// * GETTERS *
+// ***********
+const std::string &ClusterNode::GetNodeID() const
+{
+	return m_NodeID;
+}
+
+uint16_t ClusterNode::GetPort() const
+{
+	return m_Port;
+}
+
+bool ClusterNode::IsConnected(const std::string &NodeID) const
+{
+	const Link *FoundLink = FindLink(NodeID);
+	return FoundLink != nullptr && FoundLink->IsEstablished;
+}
+
+bool ClusterNode::HasRemoteSubscriber(const std::string &NodeID, const std::string &ConversationID) const
+{
+	const Link *FoundLink = FindLink(NodeID);
+	return FoundLink != nullptr && FoundLink->RemoteSubscriptions.count(ConversationID) > 0;
+}
+
+uint64_t ClusterNode::GetForwardedCount() const
+{
+	return m_ForwardedCount;
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool ClusterNode::Listen(uint16_t Port)
+{
+	m_ListenSocket = socket(AF_INET, SOCK_STREAM, 0);
+	if (m_ListenSocket < 0)
+		return false;
+
+	const int IS_ENABLED = 1;
+	setsockopt(m_ListenSocket, SOL_SOCKET, SO_REUSEADDR, &IS_ENABLED, sizeof(IS_ENABLED));
+
+	sockaddr_in Address = {};
+	Address.sin_family = AF_INET;
+	Address.sin_addr.s_addr = htonl(INADDR_ANY);
+	Address.sin_port = htons(Port);
+	socklen_t AddressLength = sizeof(Address);
+	if (bind(m_ListenSocket, reinterpret_cast<sockaddr *>(&Address), sizeof(Address)) < 0 ||
+	    listen(m_ListenSocket, SOMAXCONN) < 0 || !ConfigureSocket(m_ListenSocket) ||
+	    getsockname(m_ListenSocket, reinterpret_cast<sockaddr *>(&Address), &AddressLength) < 0)
+	{
+		// Handles port already in use error
+		close(m_ListenSocket);
+		m_ListenSocket = -1;
+		return false;
+	}
+
+	m_Port = ntohs(Address.sin_port);
+	return true;
+}
+
+void ClusterNode::AddPeer(ClusterPeer Peer)
+{
+	if (Peer.NodeID == m_NodeID)
+		return;
+
+	m_Peers.push_back(PeerState{std::move(Peer), Clock::time_point()});
+}
+
+void ClusterNode::SetOnMessage(ClusterMessageHandler OnMessage)
+{
+	m_OnMessage = std::move(OnMessage);
+}
+
+void ClusterNode::SetOnMembershipChanged(ClusterMembershipHandler OnMembershipChanged)
+{
+	m_OnMembershipChanged = std::move(OnMembershipChanged);
+}
+
+void ClusterNode::Subscribe(const std::string &ConversationID)
+{
+	if (!m_Subscriptions.insert(ConversationID).second)
+		return;
+
+	// NOTE: Sent to links still waiting for the peer's hello too, they were given the subscriptions before this one
+	for (std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		if (!CurrentLink->IsClosed)
+			EncodeClusterSubscriptionsFrame(true, {ConversationID}, CurrentLink->WriteBuffer);
+	}
+}
+
+void ClusterNode::Unsubscribe(const std::string &ConversationID)
+{
+	if (m_Subscriptions.erase(ConversationID) == 0)
+		return;
+
+	for (std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		if (!CurrentLink->IsClosed)
+			EncodeClusterSubscriptionsFrame(false, {ConversationID}, CurrentLink->WriteBuffer);
+	}
+}
+
+void ClusterNode::Publish(const Message &StoredMessage)
+{
+	// NOTE: Copied once however many nodes it is forwarded to, and not at all when no node is subscribed
+	std::shared_ptr<const Message> SharedMessage;
+	for (std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		if (!CurrentLink->IsEstablished || CurrentLink->IsClosed ||
+		    CurrentLink->RemoteSubscriptions.count(StoredMessage.ConversationID) == 0)
+			continue;
+
+		if (!SharedMessage)
+			SharedMessage = std::make_shared<const Message>(StoredMessage);
+
+		CurrentLink->Batch.push_back(SharedMessage);
+		m_ForwardedCount++;
+		if (CurrentLink->Batch.size() >= CLUSTER_BATCH_MAX_MESSAGES)
+			FlushBatch(*CurrentLink);
+	}
+}
+
+void ClusterNode::Update(int TimeoutMilliseconds)
+{
+	ConnectPeers(Clock::now());
+	FlushLinks();
+
+	std::vector<pollfd> PollSockets;
+	std::vector<Link *> PolledLinks;
+	if (m_ListenSocket >= 0)
+		PollSockets.push_back(pollfd{m_ListenSocket, POLLIN, 0});
+	for (std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		if (CurrentLink->IsClosed)
+			continue;
+
+		const bool IS_WRITE_PENDING = CurrentLink->IsConnecting || CurrentLink->WriteOffset < CurrentLink->WriteBuffer.size();
+		PollSockets.push_back(pollfd{CurrentLink->Socket, static_cast<short>(POLLIN | (IS_WRITE_PENDING ? POLLOUT : 0)), 0});
+		PolledLinks.push_back(CurrentLink.get());
+	}
+
+	if (poll(PollSockets.data(), PollSockets.size(), TimeoutMilliseconds) > 0)
+	{
+		const size_t FIRST_LINK_INDEX = m_ListenSocket >= 0 ? 1 : 0;
+		for (size_t i = 0; i < PolledLinks.size(); i++)
+		{
+			Link &CurrentLink = *PolledLinks[i];
+			const short EVENTS = PollSockets[FIRST_LINK_INDEX + i].revents;
+			if (EVENTS == 0 || CurrentLink.IsClosed)
+				continue;
+
+			if (CurrentLink.IsConnecting)
+			{
+				int Error = 0;
+				socklen_t ErrorLength = sizeof(Error);
+				if (getsockopt(CurrentLink.Socket, SOL_SOCKET, SO_ERROR, &Error, &ErrorLength) < 0 || Error != 0)
+				{
+					// Handles peer not listening yet error
+					CloseLink(CurrentLink);
+					continue;
+				}
+				CurrentLink.IsConnecting = false;
+			}
+
+			if ((EVENTS & (POLLIN | POLLHUP | POLLERR)) != 0)
+				Read(CurrentLink);
+			if ((EVENTS & POLLOUT) != 0 && !CurrentLink.IsClosed)
+				Write(CurrentLink);
+		}
+
+		// NOTE: Accepted last so the links polled above still match their poll entries
+		if (m_ListenSocket >= 0 && (PollSockets[0].revents & POLLIN) != 0)
+			Accept();
+	}
+
+	// NOTE: Sends what the message handler published right away instead of on the next update
+	FlushLinks();
+	RemoveClosedLinks(Clock::now());
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+ClusterNode::Link *ClusterNode::FindLink(const std::string &NodeID) const
+{
+	for (const std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		if (!CurrentLink->IsClosed && CurrentLink->NodeID == NodeID)
+			return CurrentLink.get();
+	}
+	return nullptr;
+}
+
+void ClusterNode::ConnectPeers(Clock::time_point Now)
+{
+	for (PeerState &CurrentPeer : m_Peers)
+	{
+		if (m_NodeID > CurrentPeer.Peer.NodeID || Now < CurrentPeer.NextConnectTime ||
+		    FindLink(CurrentPeer.Peer.NodeID) != nullptr)
+			continue;
+
+		CurrentPeer.NextConnectTime = Now + std::chrono::duration_cast<Clock::duration>(
+		                                        std::chrono::duration<double>(CLUSTER_RECONNECT_DELAY_SECONDS));
+
+		addrinfo Hints = {};
+		Hints.ai_family = AF_INET;
+		Hints.ai_socktype = SOCK_STREAM;
+		addrinfo *Addresses = nullptr;
+		if (getaddrinfo(CurrentPeer.Peer.Host.c_str(), std::to_string(CurrentPeer.Peer.Port).c_str(), &Hints,
+		                &Addresses) != 0)
+		{
+			// Handles unresolved host error
+			continue;
+		}
+
+		const int SOCKET = socket(AF_INET, SOCK_STREAM, 0);
+		if (SOCKET < 0 || !ConfigureSocket(SOCKET))
+		{
+			// Handles socket creation error
+			if (SOCKET >= 0)
+				close(SOCKET);
+			freeaddrinfo(Addresses);
+			continue;
+		}
+
+		const int CONNECT_RESULT = connect(SOCKET, Addresses->ai_addr, Addresses->ai_addrlen);
+		freeaddrinfo(Addresses);
+		if (CONNECT_RESULT < 0 && errno != EINPROGRESS)
+		{
+			// Handles refused connection error
+			close(SOCKET);
+			continue;
+		}
+
+		AddLink(SOCKET, CurrentPeer.Peer.NodeID, CONNECT_RESULT < 0);
+	}
+}
+
+void ClusterNode::Accept()
+{
+	while (true)
+	{
+		const int SOCKET = accept(m_ListenSocket, nullptr, nullptr);
+		if (SOCKET < 0)
+			return;
+
+		if (!ConfigureSocket(SOCKET))
+		{
+			close(SOCKET);
+			continue;
+		}
+		AddLink(SOCKET, std::string(), false);
+	}
+}
+
+void ClusterNode::AddLink(int Socket, std::string NodeID, bool IsConnecting)
+{
+	std::unique_ptr<Link> NewLink = std::make_unique<Link>();
+	NewLink->Socket = Socket;
+	NewLink->NodeID = std::move(NodeID);
+	NewLink->IsConnecting = IsConnecting;
+
+	// NOTE: The whole subscription set follows the hello, only changes are sent afterwards
+	EncodeClusterHelloFrame(m_NodeID, NewLink->WriteBuffer);
+	if (!m_Subscriptions.empty())
+	{
+		const std::vector<std::string> SUBSCRIPTIONS(m_Subscriptions.begin(), m_Subscriptions.end());
+		EncodeClusterSubscriptionsFrame(true, SUBSCRIPTIONS, NewLink->WriteBuffer);
+	}
+
+	m_Links.push_back(std::move(NewLink));
+}
+
+void ClusterNode::CloseLink(Link &ClosedLink)
+{
+	if (ClosedLink.IsClosed)
+		return;
+
+	close(ClosedLink.Socket);
+	ClosedLink.IsClosed = true;
+	if (!ClosedLink.IsEstablished)
+		return;
+
+	ClosedLink.IsEstablished = false;
+	if (m_OnMembershipChanged)
+		m_OnMembershipChanged(ClosedLink.NodeID, false);
+}
+
+void ClusterNode::RemoveClosedLinks(Clock::time_point Now)
+{
+	for (const std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		if (!CurrentLink->IsClosed)
+			continue;
+
+		// NOTE: Waits before reconnecting so a peer that is down is not retried on every update
+		for (PeerState &CurrentPeer : m_Peers)
+		{
+			if (CurrentPeer.Peer.NodeID == CurrentLink->NodeID)
+				CurrentPeer.NextConnectTime =
+				    std::max(CurrentPeer.NextConnectTime,
+				             Now + std::chrono::duration_cast<Clock::duration>(
+				                       std::chrono::duration<double>(CLUSTER_RECONNECT_DELAY_SECONDS)));
+		}
+	}
+
+	m_Links.erase(std::remove_if(m_Links.begin(), m_Links.end(),
+	                             [](const std::unique_ptr<Link> &CurrentLink) { return CurrentLink->IsClosed; }),
+	              m_Links.end());
+}
+
+void ClusterNode::FlushBatch(Link &CurrentLink)
+{
+	std::vector<const Message *> Messages;
+	for (size_t Offset = 0; Offset < CurrentLink.Batch.size(); Offset += CLUSTER_BATCH_MAX_MESSAGES)
+	{
+		const size_t END = std::min(Offset + CLUSTER_BATCH_MAX_MESSAGES, CurrentLink.Batch.size());
+		Messages.clear();
+		for (size_t i = Offset; i < END; i++)
+		{
+			Messages.push_back(CurrentLink.Batch[i].get());
+		}
+		EncodeClusterMessagesFrame(Messages, CurrentLink.WriteBuffer);
+	}
+	CurrentLink.Batch.clear();
+}
+
+void ClusterNode::FlushLinks()
+{
+	for (std::unique_ptr<Link> &CurrentLink : m_Links)
+	{
+		if (CurrentLink->IsClosed)
+			continue;
+
+		if (!CurrentLink->Batch.empty())
+			FlushBatch(*CurrentLink);
+		// NOTE: Written without waiting for poll, the socket is usually writable and the batch leaves a loop earlier
+		if (!CurrentLink->IsConnecting && CurrentLink->WriteOffset < CurrentLink->WriteBuffer.size())
+			Write(*CurrentLink);
+	}
+}
+
+void ClusterNode::Write(Link &CurrentLink)
+{
+	while (CurrentLink.WriteOffset < CurrentLink.WriteBuffer.size())
+	{
+		const ssize_t SENT_SIZE =
+		    send(CurrentLink.Socket, CurrentLink.WriteBuffer.data() + CurrentLink.WriteOffset,
+		         CurrentLink.WriteBuffer.size() - CurrentLink.WriteOffset, CLUSTER_SEND_FLAGS);
+		if (SENT_SIZE < 0)
+		{
+			// Handles full socket buffer, the rest is written once poll reports it writable
+			if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+				return;
+
+			// Handles broken link error
+			CloseLink(CurrentLink);
+			return;
+		}
+		CurrentLink.WriteOffset += static_cast<size_t>(SENT_SIZE);
+	}
+
+	CurrentLink.WriteBuffer.clear();
+	CurrentLink.WriteOffset = 0;
+}
+
+void ClusterNode::Read(Link &CurrentLink)
+{
+	// NOTE: Stops at the cap, poll keeps reporting the link readable and the rest is read once frames are handled
+	while (CurrentLink.ReadBuffer.size() < CLUSTER_READ_BUFFER_MAX_SIZE)
+	{
+		const size_t PREVIOUS_SIZE = CurrentLink.ReadBuffer.size();
+		const size_t READ_CAPACITY = std::min(CLUSTER_READ_SIZE, CLUSTER_READ_BUFFER_MAX_SIZE - PREVIOUS_SIZE);
+		CurrentLink.ReadBuffer.resize(PREVIOUS_SIZE + READ_CAPACITY);
+		const ssize_t READ_SIZE = recv(CurrentLink.Socket, CurrentLink.ReadBuffer.data() + PREVIOUS_SIZE, READ_CAPACITY, 0);
+		CurrentLink.ReadBuffer.resize(PREVIOUS_SIZE + std::max<ssize_t>(READ_SIZE, 0));
+		if (READ_SIZE > 0)
+			continue;
+
+		if (READ_SIZE < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+			break;
+
+		// Handles peer closed link error
+		CloseLink(CurrentLink);
+		return;
+	}
+
+	size_t Offset = 0;
+	while (!CurrentLink.IsClosed)
+	{
+		ChatFrameHeader Header;
+		std::string_view Payload;
+		bool IsValid = true;
+		const size_t FRAME_SIZE =
+		    ReadChatFrame(std::string_view(CurrentLink.ReadBuffer).substr(Offset), Header, Payload, IsValid);
+		if (!IsValid)
+		{
+			// Handles corrupted stream error
+			CloseLink(CurrentLink);
+			return;
+		}
+		if (FRAME_SIZE == 0)
+			break;
+
+		HandleFrame(CurrentLink, Header, Payload);
+		Offset += FRAME_SIZE;
+	}
+	CurrentLink.ReadBuffer.erase(0, Offset);
+}
+
+void ClusterNode::HandleFrame(Link &CurrentLink, const ChatFrameHeader &Header, std::string_view Payload)
+{
+	if (!CurrentLink.IsEstablished)
+	{
+		std::string NodeID;
+		if (Header.Type != ChatFrameType::ClusterHello || !DecodeClusterHelloFrame(Payload, NodeID) ||
+		    NodeID == m_NodeID || (!CurrentLink.NodeID.empty() && NodeID != CurrentLink.NodeID))
+		{
+			// Handles unexpected peer error
+			CloseLink(CurrentLink);
+			return;
+		}
+
+		// NOTE: Only happens when both nodes list each other with mismatched IDs, the link already there is kept
+		for (const std::unique_ptr<Link> &OtherLink : m_Links)
+		{
+			if (OtherLink.get() != &CurrentLink && OtherLink->IsEstablished && OtherLink->NodeID == NodeID)
+			{
+				CloseLink(CurrentLink);
+				return;
+			}
+		}
+
+		CurrentLink.NodeID = std::move(NodeID);
+		CurrentLink.IsEstablished = true;
+		if (m_OnMembershipChanged)
+			m_OnMembershipChanged(CurrentLink.NodeID, true);
+		return;
+	}
+
+	switch (Header.Type)
+	{
+	case ChatFrameType::ClusterSubscriptions: {
+		bool IsSubscribed = false;
+		std::vector<std::string> ConversationIDs;
+		if (!DecodeClusterSubscriptionsFrame(Payload, IsSubscribed, ConversationIDs))
+		{
+			CloseLink(CurrentLink);
+			return;
+		}
+
+		for (std::string &ConversationID : ConversationIDs)
+		{
+			if (IsSubscribed)
+				CurrentLink.RemoteSubscriptions.insert(std::move(ConversationID));
+			else
+				CurrentLink.RemoteSubscriptions.erase(ConversationID);
+		}
+		return;
+	}
+	case ChatFrameType::ClusterMessages: {
+		std::vector<Message> Messages;
+		if (!DecodeClusterMessagesFrame(Payload, Messages))
+		{
+			CloseLink(CurrentLink);
+			return;
+		}
+
+		if (!m_OnMessage)
+			return;
+		for (const Message &ForwardedMessage : Messages)
+		{
+			m_OnMessage(ForwardedMessage, CurrentLink.NodeID);
+		}
+		return;
+	}
+	default:
+		// Handles client frame sent to the cluster port error
+		CloseLink(CurrentLink);
+		return;
+	}
+}
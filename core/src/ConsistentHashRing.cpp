@@ -0,0 +1,125 @@
+#include "ConsistentHashRing.h"
+
+#include <algorithm>
+
+namespace
+{
+// NOTE: FNV-1a followed by a finalizer, std::hash may differ between the builds of two nodes and FNV-1a alone leaves
+// IDs that only differ in their last characters close to each other on the ring
+uint64_t HashID(std::string_view ID, uint64_t Seed)
+{
+	uint64_t Hash = 14695981039346656037ull ^ Seed;
+	for (const char CHARACTER : ID)
+	{
+		Hash ^= static_cast<unsigned char>(CHARACTER);
+		Hash *= 1099511628211ull;
+	}
+
+	Hash ^= Hash >> 33;
+	Hash *= 0xFF51AFD7ED558CCDull;
+	Hash ^= Hash >> 33;
+	Hash *= 0xC4CEB9FE1A85EC53ull;
+	Hash ^= Hash >> 33;
+	return Hash;
+}
+
+const std::string EMPTY_NODE_ID;
+} // namespace
+
+ConsistentHashRing::ConsistentHashRing(size_t VirtualNodesCount) : m_VirtualNodesCount(std::max<size_t>(VirtualNodesCount, 1))
+{
+}
+
+// ***********
+// * GETTERS *
+// ***********
+size_t ConsistentHashRing::GetNodesCount() const
+{
+	return m_NodeIDs.size();
+}
+
+const std::vector<std::string> &ConsistentHashRing::GetNodeIDs() const
+{
+	return m_NodeIDs;
+}
+
+bool ConsistentHashRing::HasNode(const std::string &NodeID) const
+{
+	return std::binary_search(m_NodeIDs.begin(), m_NodeIDs.end(), NodeID);
+}
+
+const std::string &ConsistentHashRing::GetOwner(std::string_view ConversationID) const
+{
+	if (m_Points.empty())
+		return EMPTY_NODE_ID;
+
+	const uint64_t HASH = HashID(ConversationID, 0);
+	auto Iterator = std::lower_bound(m_Points.begin(), m_Points.end(), HASH,
+	                                 [](const Point &CurrentPoint, uint64_t Hash) { return CurrentPoint.Hash < Hash; });
+	// Wraps around past the last point
+	if (Iterator == m_Points.end())
+		Iterator = m_Points.begin();
+
+	return m_NodeIDs[Iterator->NodeIndex];
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool ConsistentHashRing::AddNode(const std::string &NodeID)
+{
+	auto Iterator = std::lower_bound(m_NodeIDs.begin(), m_NodeIDs.end(), NodeID);
+	if (Iterator != m_NodeIDs.end() && *Iterator == NodeID)
+		return false;
+
+	m_NodeIDs.insert(Iterator, NodeID);
+	BuildPoints();
+	return true;
+}
+
+bool ConsistentHashRing::RemoveNode(const std::string &NodeID)
+{
+	auto Iterator = std::lower_bound(m_NodeIDs.begin(), m_NodeIDs.end(), NodeID);
+	if (Iterator == m_NodeIDs.end() || *Iterator != NodeID)
+		return false;
+
+	m_NodeIDs.erase(Iterator);
+	BuildPoints();
+	return true;
+}
+
+std::vector<ConversationMove> ConsistentHashRing::GetMoves(const ConsistentHashRing &Next,
+                                                           const std::vector<std::string> &ConversationIDs) const
+{
+	std::vector<ConversationMove> Moves;
+	for (const std::string &ConversationID : ConversationIDs)
+	{
+		const std::string &PREVIOUS_OWNER = GetOwner(ConversationID);
+		const std::string &NEXT_OWNER = Next.GetOwner(ConversationID);
+		if (PREVIOUS_OWNER != NEXT_OWNER)
+			Moves.push_back(ConversationMove{ConversationID, PREVIOUS_OWNER, NEXT_OWNER});
+	}
+	return Moves;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void ConsistentHashRing::BuildPoints()
+{
+	m_Points.clear();
+	m_Points.reserve(m_NodeIDs.size() * m_VirtualNodesCount);
+	for (size_t i = 0; i < m_NodeIDs.size(); i++)
+	{
+		for (size_t j = 0; j < m_VirtualNodesCount; j++)
+		{
+			m_Points.push_back(Point{HashID(m_NodeIDs[i], j + 1), static_cast<uint32_t>(i)});
+		}
+	}
+
+	// NOTE: Ties are broken by node ID, node indices follow the sorted IDs, so colliding points resolve the same way
+	// on every node
+	std::sort(m_Points.begin(), m_Points.end(), [](const Point &First, const Point &Second) {
+		return First.Hash != Second.Hash ? First.Hash < Second.Hash : First.NodeIndex < Second.NodeIndex;
+	});
+}
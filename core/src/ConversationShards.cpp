@@ -0,0 +1,299 @@
+#include "ConversationShards.h"
+
+#include <algorithm>
+#include <utility>
+
+ConversationShards::ConversationShards(size_t ShardsCount, size_t ReactorsCount, ShardConversationLoader Loader,
+                                       ShardMessagePersister Persister)
+    : m_Loader(std::move(Loader)), m_Persister(std::move(Persister))
+{
+	for (size_t i = 0; i < std::max<size_t>(ReactorsCount, 1); i++)
+	{
+		m_Outboxes.push_back(std::make_unique<MpscQueue<ShardDelivery>>());
+	}
+
+	for (size_t i = 0; i < std::max<size_t>(ShardsCount, 1); i++)
+	{
+		m_Shards.push_back(std::make_unique<Shard>());
+		m_Shards.back()->Deliveries.resize(m_Outboxes.size());
+		m_Shards.back()->HaveDeliveries.resize(m_Outboxes.size(), false);
+	}
+	// NOTE: Started once every shard exists since the deliveries of one go to every reactor
+	for (std::unique_ptr<Shard> &Owner : m_Shards)
+	{
+		Owner->Worker = std::thread(&ConversationShards::RunShard, this, std::ref(*Owner));
+	}
+}
+
+ConversationShards::~ConversationShards()
+{
+	m_IsStopping = true;
+	for (std::unique_ptr<Shard> &Owner : m_Shards)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Owner->Mutex);
+			Owner->IsSleeping = false;
+		}
+		Owner->Condition.notify_one();
+		Owner->Worker.join();
+	}
+}
+
+// ***********
+// * GETTERS *
+// ***********
+size_t ConversationShards::GetShardsCount() const
+{
+	return m_Shards.size();
+}
+
+size_t ConversationShards::GetReactorsCount() const
+{
+	return m_Outboxes.size();
+}
+
+size_t ConversationShards::GetShardIndex(const std::string &ConversationID) const
+{
+	return std::hash<std::string>()(ConversationID) % m_Shards.size();
+}
+
+// **********
+// * PUBLIC *
+// **********
+void ConversationShards::SetOnDelivery(std::function<void(size_t ReactorIndex)> OnDelivery)
+{
+	m_OnDelivery = std::move(OnDelivery);
+}
+
+void ConversationShards::Append(Message NewMessage, size_t ReactorIndex)
+{
+	Task NewTask = {};
+	NewTask.Type = TaskType::Append;
+	NewTask.ReactorIndex = static_cast<uint32_t>(ReactorIndex);
+	Shard &Owner = *m_Shards[GetShardIndex(NewMessage.ConversationID)];
+	NewTask.NewMessage = std::move(NewMessage);
+	Post(Owner, std::move(NewTask));
+}
+
+void ConversationShards::SetMembers(const std::string &ConversationID, std::vector<std::string> MemberIDs)
+{
+	Task NewTask = {};
+	NewTask.Type = TaskType::SetMembers;
+	NewTask.ID = ConversationID;
+	NewTask.MemberIDs = std::move(MemberIDs);
+	Post(*m_Shards[GetShardIndex(ConversationID)], std::move(NewTask));
+}
+
+void ConversationShards::Warm(const std::string &ConversationID)
+{
+	Task NewTask = {};
+	NewTask.Type = TaskType::Warm;
+	NewTask.ID = ConversationID;
+	Post(*m_Shards[GetShardIndex(ConversationID)], std::move(NewTask));
+}
+
+void ConversationShards::Evict(const std::string &ConversationID)
+{
+	Task NewTask = {};
+	NewTask.Type = TaskType::Evict;
+	NewTask.ID = ConversationID;
+	Post(*m_Shards[GetShardIndex(ConversationID)], std::move(NewTask));
+}
+
+void ConversationShards::Connect(const std::string &UserID, size_t ReactorIndex)
+{
+	Task NewTask = {};
+	NewTask.Type = TaskType::Connect;
+	NewTask.ID = UserID;
+	NewTask.ReactorIndex = static_cast<uint32_t>(ReactorIndex);
+	Broadcast(NewTask);
+}
+
+void ConversationShards::Disconnect(const std::string &UserID, size_t ReactorIndex)
+{
+	Task NewTask = {};
+	NewTask.Type = TaskType::Disconnect;
+	NewTask.ID = UserID;
+	NewTask.ReactorIndex = static_cast<uint32_t>(ReactorIndex);
+	Broadcast(NewTask);
+}
+
+bool ConversationShards::Poll(size_t ReactorIndex, ShardDelivery &Delivery)
+{
+	return m_Outboxes[ReactorIndex]->TryPop(Delivery);
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void ConversationShards::Post(Shard &Target, Task NewTask)
+{
+	Target.Tasks.Push(std::move(NewTask));
+
+	// NOTE: Only locks when the shard went to sleep, it checks its queue again after setting IsSleeping so a task
+	// pushed meanwhile is either seen by that check or wakes it here
+	if (Target.IsSleeping.exchange(false))
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Target.Mutex);
+		}
+		Target.Condition.notify_one();
+	}
+}
+
+void ConversationShards::Broadcast(const Task &NewTask)
+{
+	for (std::unique_ptr<Shard> &Target : m_Shards)
+	{
+		Post(*Target, NewTask);
+	}
+}
+
+void ConversationShards::RunShard(Shard &Owner)
+{
+	Task CurrentTask;
+	while (!m_IsStopping)
+	{
+		size_t TasksCount = 0;
+		while (TasksCount < CONVERSATION_SHARD_BATCH_SIZE && Owner.Tasks.TryPop(CurrentTask))
+		{
+			RunTask(Owner, CurrentTask);
+			TasksCount++;
+		}
+
+		// Wakes every reactor handed deliveries by the batch once
+		for (size_t i = 0; i < Owner.HaveDeliveries.size(); i++)
+		{
+			if (!Owner.HaveDeliveries[i])
+				continue;
+
+			Owner.HaveDeliveries[i] = false;
+			if (m_OnDelivery)
+				m_OnDelivery(i);
+		}
+
+		if (TasksCount > 0)
+			continue;
+
+		// NOTE: IsEmpty sees a push in progress that TryPop cannot take yet and keeps popping. Not missing a wake up
+		// does not rely on it though, Post exchanges IsSleeping after pushing so it either sees the flag set here and
+		// wakes the shard or the shard sees its task in this check
+		Owner.IsSleeping = true;
+		if (!Owner.Tasks.IsEmpty())
+		{
+			Owner.IsSleeping = false;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> Lock(Owner.Mutex);
+		Owner.Condition.wait(Lock, [this, &Owner]() { return !Owner.IsSleeping || m_IsStopping; });
+	}
+}
+
+void ConversationShards::RunTask(Shard &Owner, Task &CurrentTask)
+{
+	switch (CurrentTask.Type)
+	{
+	case TaskType::Append: {
+		ShardConversationState *LoadedState = Load(Owner, CurrentTask.NewMessage.ConversationID);
+		if (LoadedState == nullptr)
+		{
+			// Handles unknown conversation error, left unacknowledged
+			return;
+		}
+
+		ShardConversationState &State = *LoadedState;
+		CurrentTask.NewMessage.Sequence = State.LastSequence + 1;
+		if (!m_Persister(CurrentTask.NewMessage))
+		{
+			// Handles persist failure error, the sequence is reused by the retry
+			return;
+		}
+		State.LastSequence = CurrentTask.NewMessage.Sequence;
+
+		Deliver(Owner, CurrentTask, State);
+		return;
+	}
+	case TaskType::SetMembers: {
+		ShardConversationState *State = Load(Owner, CurrentTask.ID);
+		if (State != nullptr)
+			State->MemberIDs = std::move(CurrentTask.MemberIDs);
+		return;
+	}
+	case TaskType::Warm: {
+		Load(Owner, CurrentTask.ID);
+		return;
+	}
+	case TaskType::Evict: {
+		Owner.Conversations.erase(CurrentTask.ID);
+		return;
+	}
+	case TaskType::Connect: {
+		Owner.ReactorsByUserID[CurrentTask.ID].push_back(CurrentTask.ReactorIndex);
+		return;
+	}
+	case TaskType::Disconnect: {
+		auto Iterator = Owner.ReactorsByUserID.find(CurrentTask.ID);
+		if (Iterator == Owner.ReactorsByUserID.end())
+			return;
+
+		std::vector<uint32_t> &Reactors = Iterator->second;
+		auto Reactor = std::find(Reactors.begin(), Reactors.end(), CurrentTask.ReactorIndex);
+		if (Reactor != Reactors.end())
+			Reactors.erase(Reactor);
+		if (Reactors.empty())
+			Owner.ReactorsByUserID.erase(Iterator);
+		return;
+	}
+	}
+}
+
+ShardConversationState *ConversationShards::Load(Shard &Owner, const std::string &ConversationID)
+{
+	auto Iterator = Owner.Conversations.find(ConversationID);
+	if (Iterator != Owner.Conversations.end())
+		return &Iterator->second;
+
+	ShardConversationState State = {};
+	if (!m_Loader || !m_Loader(ConversationID, State))
+		return nullptr;
+
+	return &Owner.Conversations.emplace(ConversationID, std::move(State)).first->second;
+}
+
+void ConversationShards::Deliver(Shard &Owner, Task &AppendTask, ShardConversationState &State)
+{
+	auto StoredMessage = std::make_shared<const Message>(std::move(AppendTask.NewMessage));
+
+	// Groups connected members by reactor so each reactor gets one delivery of the message
+	for (const std::string &MemberID : State.MemberIDs)
+	{
+		if (MemberID == StoredMessage->SenderID)
+			continue;
+
+		auto Iterator = Owner.ReactorsByUserID.find(MemberID);
+		if (Iterator == Owner.ReactorsByUserID.end())
+			continue;
+
+		for (const uint32_t REACTOR : Iterator->second)
+		{
+			// NOTE: Members are added one at a time so a second connection on the same reactor is always the last one
+			std::vector<std::string> &Recipients = Owner.Deliveries[REACTOR].RecipientIDs;
+			if (Recipients.empty() || Recipients.back() != MemberID)
+				Recipients.push_back(MemberID);
+		}
+	}
+
+	Owner.Deliveries[AppendTask.ReactorIndex].IsAcknowledgement = true;
+	for (size_t i = 0; i < Owner.Deliveries.size(); i++)
+	{
+		ShardDelivery &Delivery = Owner.Deliveries[i];
+		if (!Delivery.IsAcknowledgement && Delivery.RecipientIDs.empty())
+			continue;
+
+		Delivery.StoredMessage = StoredMessage;
+		m_Outboxes[i]->Push(std::move(Delivery));
+		Delivery = {};
+		Owner.HaveDeliveries[i] = true;
+	}
+}
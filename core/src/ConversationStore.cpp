@@ -0,0 +1,188 @@
+#include "ConversationStore.h"
+
+#include <algorithm>
+#include <utility>
+
+// ***********
+// * GETTERS *
+// ***********
+Conversation *ConversationStore::Get(ConversationHandle Handle)
+{
+	Slot *HandleSlot = GetSlot(Handle);
+	return HandleSlot ? &HandleSlot->Value : nullptr;
+}
+
+const Conversation *ConversationStore::Get(ConversationHandle Handle) const
+{
+	const Slot *HandleSlot = GetSlot(Handle);
+	return HandleSlot ? &HandleSlot->Value : nullptr;
+}
+
+ConversationHandle ConversationStore::Find(const std::string &ID) const
+{
+	auto Iterator = m_IndicesByID.find(ID);
+	if (Iterator == m_IndicesByID.end())
+		return {};
+
+	return m_Slots[Iterator->second].Activity.Handle;
+}
+
+ConversationHandle ConversationStore::GetMostRecent() const
+{
+	if (m_ActivityIndex.empty())
+		return {};
+
+	return m_ActivityIndex.begin()->Handle;
+}
+
+size_t ConversationStore::GetSize() const
+{
+	return m_IndicesByID.size();
+}
+
+bool ConversationStore::IsEmpty() const
+{
+	return m_IndicesByID.empty();
+}
+
+uint64_t ConversationStore::GetVersion() const
+{
+	return m_Version;
+}
+
+ConversationStore::ActivityIndex::const_iterator ConversationStore::begin() const
+{
+	return m_ActivityIndex.begin();
+}
+
+ConversationStore::ActivityIndex::const_iterator ConversationStore::end() const
+{
+	return m_ActivityIndex.end();
+}
+
+// **********
+// * PUBLIC *
+// **********
+ConversationHandle ConversationStore::Add(Conversation NewConversation)
+{
+	// Replaces the existing conversation instead of indexing the same ID twice
+	ConversationHandle ExistingHandle = Find(NewConversation.ID);
+	if (ExistingHandle.IsValid())
+		Remove(ExistingHandle);
+
+	uint32_t Index = 0;
+	if (!m_FreeIndices.empty())
+	{
+		Index = m_FreeIndices.back();
+		m_FreeIndices.pop_back();
+	}
+	else
+	{
+		Index = static_cast<uint32_t>(m_Slots.size());
+		m_Slots.emplace_back();
+	}
+
+	Slot &NewSlot = m_Slots[Index];
+	NewSlot.Value = std::move(NewConversation);
+	NewSlot.IsOccupied = true;
+
+	// Derives last activity from the newest known message
+	std::time_t LastActivityAt = std::max(NewSlot.Value.CreatedAt, NewSlot.Value.LastActivityAt);
+	for (const Message &ConversationMessage : NewSlot.Value.Messages)
+	{
+		LastActivityAt = std::max(LastActivityAt, ConversationMessage.CreatedAt);
+	}
+	NewSlot.Value.LastActivityAt = LastActivityAt;
+
+	NewSlot.Activity.LastActivityAt = LastActivityAt;
+	NewSlot.Activity.Sequence = m_NextSequence++;
+	NewSlot.Activity.Handle = ConversationHandle{Index, NewSlot.Generation};
+
+	m_IndicesByID.emplace(NewSlot.Value.ID, Index);
+	m_ActivityIndex.insert(NewSlot.Activity);
+	m_Version++;
+
+	return NewSlot.Activity.Handle;
+}
+
+bool ConversationStore::Remove(ConversationHandle Handle)
+{
+	Slot *HandleSlot = GetSlot(Handle);
+	if (!HandleSlot)
+		return false;
+
+	m_ActivityIndex.erase(HandleSlot->Activity);
+	m_IndicesByID.erase(HandleSlot->Value.ID);
+
+	// NOTE: Bumping the generation invalidates every handle still pointing at this slot
+	HandleSlot->Value = {};
+	HandleSlot->Activity = {};
+	HandleSlot->Generation++;
+	HandleSlot->IsOccupied = false;
+	m_FreeIndices.push_back(Handle.Index);
+	m_Version++;
+
+	return true;
+}
+
+void ConversationStore::AddMessage(ConversationHandle Handle, Message NewMessage)
+{
+	Slot *HandleSlot = GetSlot(Handle);
+	if (!HandleSlot)
+		return;
+
+	const std::time_t CREATED_AT = NewMessage.CreatedAt;
+	HandleSlot->Value.Messages.push_back(std::move(NewMessage));
+	Touch(Handle, CREATED_AT);
+}
+
+void ConversationStore::Touch(ConversationHandle Handle, std::time_t ActivityAt)
+{
+	Slot *HandleSlot = GetSlot(Handle);
+	if (!HandleSlot)
+		return;
+
+	// Re-keys the conversation in the activity index in O(log n)
+	m_ActivityIndex.erase(HandleSlot->Activity);
+	HandleSlot->Activity.LastActivityAt = std::max(HandleSlot->Activity.LastActivityAt, ActivityAt);
+	HandleSlot->Activity.Sequence = m_NextSequence++;
+	HandleSlot->Value.LastActivityAt = HandleSlot->Activity.LastActivityAt;
+	m_ActivityIndex.insert(HandleSlot->Activity);
+	m_Version++;
+}
+
+void ConversationStore::Clear()
+{
+	// NOTE: Removes slot by slot instead of clearing so that outstanding handles cannot alias reused slots
+	while (!m_ActivityIndex.empty())
+	{
+		Remove(m_ActivityIndex.begin()->Handle);
+	}
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+ConversationStore::Slot *ConversationStore::GetSlot(ConversationHandle Handle)
+{
+	if (Handle.Index >= m_Slots.size())
+		return nullptr;
+
+	Slot &HandleSlot = m_Slots[Handle.Index];
+	if (!HandleSlot.IsOccupied || HandleSlot.Generation != Handle.Generation)
+		return nullptr;
+
+	return &HandleSlot;
+}
+
+const ConversationStore::Slot *ConversationStore::GetSlot(ConversationHandle Handle) const
+{
+	if (Handle.Index >= m_Slots.size())
+		return nullptr;
+
+	const Slot &HandleSlot = m_Slots[Handle.Index];
+	if (!HandleSlot.IsOccupied || HandleSlot.Generation != Handle.Generation)
+		return nullptr;
+
+	return &HandleSlot;
+}
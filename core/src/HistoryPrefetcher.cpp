@@ -0,0 +1,223 @@
+#include "HistoryPrefetcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#endif
+
+namespace
+{
+size_t EstimateSizeInBytes(const std::vector<Message> &Messages)
+{
+	size_t SizeInBytes = Messages.capacity() * sizeof(Message);
+	for (const Message &PageMessage : Messages)
+	{
+		SizeInBytes += PageMessage.ID.capacity() + PageMessage.ConversationID.capacity() + PageMessage.SenderID.capacity() +
+		               PageMessage.SenderFirstName.capacity() + PageMessage.SenderImageUrl.capacity() +
+		               PageMessage.Text.capacity();
+	}
+	return SizeInBytes;
+}
+
+// NOTE: Lets the worker only run on cores the render and network threads leave idle
+void LowerCurrentThreadPriority()
+{
+#if defined(__linux__)
+	sched_param Parameters = {};
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &Parameters);
+#elif defined(__APPLE__)
+	pthread_set_qos_class_self_np(QOS_CLASS_BACKGROUND, 0);
+#endif
+}
+} // namespace
+
+HistoryPrefetcher::HistoryPrefetcher(HistoryPageLoader Loader, HistoryPrefetcherLimits Limits)
+    : m_Loader(std::move(Loader)), m_Limits(Limits), m_AvailableBytes(static_cast<double>(Limits.BandwidthBytesPerSecond)),
+      m_RefilledAt(std::chrono::steady_clock::now()), m_Worker(&HistoryPrefetcher::RunWorker, this)
+{
+}
+
+HistoryPrefetcher::~HistoryPrefetcher()
+{
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_IsStopping = true;
+	}
+	m_Condition.notify_all();
+
+	m_Worker.join();
+}
+
+// ***********
+// * GETTERS *
+// ***********
+const HistoryPrefetcherLimits &HistoryPrefetcher::GetLimits() const
+{
+	return m_Limits;
+}
+
+bool HistoryPrefetcher::IsReady(const std::string &ConversationID) const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_PagesByConversationID.find(ConversationID) != m_PagesByConversationID.end();
+}
+
+size_t HistoryPrefetcher::GetUsedBytes() const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_UsedBytes;
+}
+
+// **********
+// * PUBLIC *
+// **********
+void HistoryPrefetcher::SetOnLoaded(std::function<void()> OnLoaded)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_OnLoaded = std::move(OnLoaded);
+}
+
+void HistoryPrefetcher::Prefetch(const std::string &ConversationID)
+{
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		if (m_PagesByConversationID.count(ConversationID) > 0 || m_Requested.count(ConversationID) > 0)
+			return;
+
+		m_Pending.push_front(ConversationID);
+		m_Requested.insert(ConversationID);
+
+		// Drops the oldest request, the pointer has moved on since
+		if (m_Pending.size() > HISTORY_PREFETCHER_MAX_PENDING_COUNT)
+		{
+			m_Requested.erase(m_Pending.back());
+			m_Pending.pop_back();
+		}
+	}
+	m_Condition.notify_one();
+}
+
+bool HistoryPrefetcher::Take(const std::string &ConversationID, std::vector<Message> &Messages)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	auto Iterator = m_PagesByConversationID.find(ConversationID);
+	if (Iterator == m_PagesByConversationID.end())
+		return false;
+
+	Messages = std::move(Iterator->second->Messages);
+	m_UsedBytes -= Iterator->second->SizeInBytes;
+	m_Pages.erase(Iterator->second);
+	m_PagesByConversationID.erase(Iterator);
+
+	return true;
+}
+
+void HistoryPrefetcher::Poll(
+    const std::function<void(const std::string &ConversationID, const std::vector<Message> &Messages)> &OnReady)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	m_PolledConversationIDs.clear();
+	m_PolledConversationIDs.swap(m_LoadedConversationIDs);
+
+	for (const std::string &ConversationID : m_PolledConversationIDs)
+	{
+		// NOTE: Skips pages already taken or evicted
+		auto Iterator = m_PagesByConversationID.find(ConversationID);
+		if (Iterator != m_PagesByConversationID.end())
+			OnReady(ConversationID, Iterator->second->Messages);
+	}
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void HistoryPrefetcher::RunWorker()
+{
+	LowerCurrentThreadPriority();
+
+	while (true)
+	{
+		std::string ConversationID;
+		{
+			std::unique_lock<std::mutex> Lock(m_Mutex);
+			m_Condition.wait(Lock, [this]() {
+				return m_IsStopping || !m_Pending.empty();
+			});
+			if (m_IsStopping || !WaitForBandwidth(Lock))
+				return;
+			// NOTE: Requests may have been dropped while waiting for bandwidth
+			if (m_Pending.empty())
+				continue;
+
+			ConversationID = std::move(m_Pending.front());
+			m_Pending.pop_front();
+		}
+
+		Page LoadedPage = {};
+		LoadedPage.ConversationID = ConversationID;
+		LoadedPage.Messages = m_Loader(ConversationID, m_Limits.PageMessagesCount);
+		LoadedPage.SizeInBytes = EstimateSizeInBytes(LoadedPage.Messages);
+
+		std::function<void()> OnLoaded;
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			m_Requested.erase(ConversationID);
+			m_AvailableBytes -= static_cast<double>(LoadedPage.SizeInBytes);
+
+			m_UsedBytes += LoadedPage.SizeInBytes;
+			m_Pages.push_front(std::move(LoadedPage));
+			m_PagesByConversationID[ConversationID] = m_Pages.begin();
+			m_LoadedConversationIDs.push_back(std::move(ConversationID));
+			Evict();
+
+			OnLoaded = m_OnLoaded;
+		}
+
+		if (OnLoaded)
+			OnLoaded();
+	}
+}
+
+bool HistoryPrefetcher::WaitForBandwidth(std::unique_lock<std::mutex> &Lock)
+{
+	if (m_Limits.BandwidthBytesPerSecond == 0)
+		return true;
+
+	const double BYTES_PER_SECOND = static_cast<double>(m_Limits.BandwidthBytesPerSecond);
+	while (true)
+	{
+		// Refills the budget, at most a second worth of bytes can be spent in a burst
+		const auto NOW = std::chrono::steady_clock::now();
+		const std::chrono::duration<double> ELAPSED_TIME = NOW - m_RefilledAt;
+		m_AvailableBytes = std::min(BYTES_PER_SECOND, m_AvailableBytes + ELAPSED_TIME.count() * BYTES_PER_SECOND);
+		m_RefilledAt = NOW;
+
+		if (m_AvailableBytes >= 0.0)
+			return true;
+
+		const std::chrono::duration<double> WAIT_TIME(-m_AvailableBytes / BYTES_PER_SECOND);
+		if (m_Condition.wait_for(Lock, WAIT_TIME, [this]() {
+			    return m_IsStopping;
+		    }))
+			return false;
+	}
+}
+
+void HistoryPrefetcher::Evict()
+{
+	while (m_UsedBytes > m_Limits.MemoryBudgetBytes && !m_Pages.empty())
+	{
+		const Page &EvictedPage = m_Pages.back();
+		m_UsedBytes -= EvictedPage.SizeInBytes;
+		m_PagesByConversationID.erase(EvictedPage.ConversationID);
+		m_Pages.pop_back();
+	}
+}
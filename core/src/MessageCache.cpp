@@ -0,0 +1,855 @@
+#include "MessageCache.h"
+#include "BinaryStream.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+uint32_t ComputeChecksum(const unsigned char *Data, size_t Size)
+{
+	uint32_t Hash = 2166136261u;
+	for (size_t i = 0; i < Size; i++)
+	{
+		Hash ^= Data[i];
+		Hash *= 16777619u;
+	}
+	return Hash;
+}
+
+bool WriteAll(int FileDescriptor, const char *Data, size_t Size, off_t Offset)
+{
+	while (Size > 0)
+	{
+		const ssize_t WRITTEN_SIZE = pwrite(FileDescriptor, Data, Size, Offset);
+		if (WRITTEN_SIZE <= 0)
+			return false;
+		Data += WRITTEN_SIZE;
+		Size -= static_cast<size_t>(WRITTEN_SIZE);
+		Offset += WRITTEN_SIZE;
+	}
+	return true;
+}
+
+// Appends the record header and its payload
+void WriteRecord(std::string &Buffer, MessageCacheRecordType Type, const unsigned char *Payload, size_t Size)
+{
+	MessageCacheRecordHeader Header = {};
+	Header.Size = static_cast<uint32_t>(Size);
+	Header.Checksum = ComputeChecksum(Payload, Size);
+	Header.Type = Type;
+
+	WriteBinaryValue(Buffer, Header);
+	Buffer.append(reinterpret_cast<const char *>(Payload), Size);
+}
+} // namespace
+
+MessageCache::~MessageCache()
+{
+	Close();
+}
+
+// ***********
+// * GETTERS *
+// ***********
+bool MessageCache::IsOpen() const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_LogFileDescriptor >= 0;
+}
+
+bool MessageCache::HasConversation(const std::string &ID) const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_Entries.find(ID) != m_Entries.end();
+}
+
+size_t MessageCache::GetConversationsCount() const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_Entries.size();
+}
+
+size_t MessageCache::GetLogSize() const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_LogSize;
+}
+
+size_t MessageCache::GetDeadBytes() const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_DeadBytes;
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool MessageCache::Open(const std::string &DirectoryPath, const std::string &AccountID)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	Reset();
+
+	// NOTE: Fails when it already exists, which is the common case
+	mkdir(DirectoryPath.c_str(), 0755);
+
+	const std::string LOG_FILE_PATH = DirectoryPath + "/" + AccountID + ".log";
+	const int FILE_DESCRIPTOR = open(LOG_FILE_PATH.c_str(), O_RDWR | O_CREAT, 0644);
+	if (FILE_DESCRIPTOR < 0)
+	{
+		// Handles file open failure error
+		return false;
+	}
+
+	struct stat FileStat = {};
+	if (fstat(FILE_DESCRIPTOR, &FileStat) < 0)
+	{
+		// Handles file stat failure error
+		close(FILE_DESCRIPTOR);
+		return false;
+	}
+
+	MessageCacheLogHeader Header = {};
+	bool IsValid = FileStat.st_size >= static_cast<off_t>(sizeof(Header)) &&
+	               pread(FILE_DESCRIPTOR, &Header, sizeof(Header), 0) == static_cast<ssize_t>(sizeof(Header)) &&
+	               Header.Magic == MESSAGE_CACHE_LOG_MAGIC && Header.Version == MESSAGE_CACHE_VERSION;
+	if (!IsValid)
+	{
+		// Starts a new log, also replaces logs of older versions
+		Header = MessageCacheLogHeader{};
+		if (ftruncate(FILE_DESCRIPTOR, 0) < 0 ||
+		    !WriteAll(FILE_DESCRIPTOR, reinterpret_cast<const char *>(&Header), sizeof(Header), 0))
+		{
+			// Handles log creation failure error
+			close(FILE_DESCRIPTOR);
+			return false;
+		}
+		FileStat.st_size = sizeof(Header);
+	}
+
+	m_LogFileDescriptor = FILE_DESCRIPTOR;
+	m_LogFilePath = LOG_FILE_PATH;
+	m_IndexFilePath = DirectoryPath + "/" + AccountID + ".index";
+	m_LogSize = static_cast<size_t>(FileStat.st_size);
+	if (!Map())
+	{
+		// Handles mmap failure error
+		Reset();
+		return false;
+	}
+
+	Replay(LoadIndex());
+	if (IsCompactionNeeded())
+		Compact();
+
+	return true;
+}
+
+std::vector<Conversation> MessageCache::LoadRecent(size_t ConversationsCount, size_t MessagesCount)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	std::vector<Conversation> Conversations;
+	if (m_LogFileDescriptor < 0 || !Map())
+		return Conversations;
+
+	std::vector<std::pair<const std::string *, const Entry *>> RecentEntries;
+	RecentEntries.reserve(m_Entries.size());
+	for (const auto &[ID, CachedEntry] : m_Entries)
+	{
+		RecentEntries.emplace_back(&ID, &CachedEntry);
+	}
+
+	const size_t RECENT_COUNT = std::min(ConversationsCount, RecentEntries.size());
+	std::partial_sort(RecentEntries.begin(), RecentEntries.begin() + RECENT_COUNT, RecentEntries.end(),
+	                  [](const auto &A, const auto &B) {
+		                  if (A.second->Index.LastActivityAt != B.second->Index.LastActivityAt)
+			                  return A.second->Index.LastActivityAt > B.second->Index.LastActivityAt;
+		                  return *A.first < *B.first;
+	                  });
+
+	Conversations.reserve(RECENT_COUNT);
+	for (size_t i = 0; i < RECENT_COUNT; i++)
+	{
+		const Entry &CachedEntry = *RecentEntries[i].second;
+
+		Conversation CachedConversation = {};
+		if (CachedEntry.Index.ConversationOffset == 0 ||
+		    !ReadConversation(CachedEntry.Index.ConversationOffset, CachedConversation))
+		{
+			// NOTE: Messages arrived before the conversation details, they are filled in by the next sync
+			CachedConversation = Conversation{};
+			CachedConversation.ID = *RecentEntries[i].first;
+		}
+		CachedConversation.LastActivityAt = static_cast<std::time_t>(CachedEntry.Index.LastActivityAt);
+
+		ReadNewestMessages(CachedEntry, MessagesCount, CachedConversation.Messages);
+
+		Conversations.push_back(std::move(CachedConversation));
+	}
+
+	return Conversations;
+}
+
+std::vector<Message> MessageCache::LoadMessages(const std::string &ConversationID, size_t MessagesCount)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	std::vector<Message> Messages;
+	auto Iterator = m_Entries.find(ConversationID);
+	if (Iterator == m_Entries.end() || !Map())
+		return Messages;
+
+	ReadNewestMessages(Iterator->second, MessagesCount, Messages);
+	return Messages;
+}
+
+std::vector<Message> MessageCache::LoadPendingMessages()
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	std::vector<Message> PendingMessages;
+	if (m_LogFileDescriptor < 0 || !Map())
+		return PendingMessages;
+
+	for (const auto &[ID, CachedEntry] : m_Entries)
+	{
+		// Walks back until every pending message of the conversation is found, they are among the newest
+		std::vector<uint64_t> AcknowledgedNonces;
+		size_t FoundCount = 0;
+		uint64_t MessageOffset = CachedEntry.Index.LastMessageOffset;
+		while (MessageOffset != 0 && FoundCount < CachedEntry.Index.PendingMessagesCount)
+		{
+			Message CachedMessage = {};
+			if (!ReadMessage(MessageOffset, CachedMessage, MessageOffset))
+				break;
+
+			if (!CachedMessage.IsPending())
+			{
+				if (CachedMessage.Nonce != 0)
+					AcknowledgedNonces.push_back(CachedMessage.Nonce);
+				continue;
+			}
+			if (std::find(AcknowledgedNonces.begin(), AcknowledgedNonces.end(), CachedMessage.Nonce) !=
+			    AcknowledgedNonces.end())
+				continue;
+
+			PendingMessages.push_back(std::move(CachedMessage));
+			FoundCount++;
+		}
+	}
+
+	// NOTE: Nonces tell apart messages sent within the same second
+	std::sort(PendingMessages.begin(), PendingMessages.end(), [](const Message &A, const Message &B) {
+		return A.CreatedAt != B.CreatedAt ? A.CreatedAt < B.CreatedAt : A.Nonce < B.Nonce;
+	});
+	return PendingMessages;
+}
+
+bool MessageCache::AppendConversation(const Conversation &NewConversation)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	// NOTE: Mapped so the size of the record it replaces can be counted as dead
+	if (m_LogFileDescriptor >= 0)
+		Map();
+
+	std::string Payload;
+	WriteBinaryValue<int64_t>(Payload, static_cast<int64_t>(NewConversation.CreatedAt));
+	WriteBinaryValue<int64_t>(Payload, static_cast<int64_t>(NewConversation.LastActivityAt));
+	WriteBinaryString(Payload, NewConversation.ID);
+	WriteBinaryValue<uint32_t>(Payload, static_cast<uint32_t>(NewConversation.Users.size()));
+	for (const User &ConversationUser : NewConversation.Users)
+	{
+		WriteBinaryString(Payload, ConversationUser.ID);
+		WriteBinaryString(Payload, ConversationUser.FirstName);
+		WriteBinaryString(Payload, ConversationUser.ImageUrl);
+	}
+
+	return Append(MessageCacheRecordType::Conversation, Payload);
+}
+
+bool MessageCache::AppendMessage(const Message &NewMessage)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	auto Iterator = m_Entries.find(NewMessage.ConversationID);
+	const uint64_t PREVIOUS_MESSAGE_OFFSET = Iterator != m_Entries.end() ? Iterator->second.Index.LastMessageOffset : 0;
+
+	std::string Payload;
+	WriteBinaryValue<uint64_t>(Payload, PREVIOUS_MESSAGE_OFFSET);
+	WriteBinaryValue<int64_t>(Payload, static_cast<int64_t>(NewMessage.CreatedAt));
+	WriteBinaryValue<uint64_t>(Payload, NewMessage.Nonce);
+	WriteBinaryValue<uint64_t>(Payload, NewMessage.Sequence);
+	WriteBinaryString(Payload, NewMessage.ConversationID);
+	WriteBinaryString(Payload, NewMessage.ID);
+	WriteBinaryString(Payload, NewMessage.SenderID);
+	WriteBinaryString(Payload, NewMessage.SenderFirstName);
+	WriteBinaryString(Payload, NewMessage.SenderImageUrl);
+	WriteBinaryString(Payload, NewMessage.Text);
+
+	return Append(MessageCacheRecordType::Message, Payload);
+}
+
+bool MessageCache::RemoveConversation(const std::string &ID)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	if (m_Entries.find(ID) == m_Entries.end() || !Map())
+		return false;
+
+	std::string Payload;
+	WriteBinaryString(Payload, ID);
+
+	return Append(MessageCacheRecordType::ConversationRemoved, Payload);
+}
+
+bool MessageCache::Flush()
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	if (IsCompactionNeeded())
+		Compact();
+	return WriteIndex();
+}
+
+void MessageCache::Close()
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	Reset();
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+bool MessageCache::WriteIndex()
+{
+	if (m_LogFileDescriptor < 0)
+		return false;
+	if (!m_IsIndexDirty)
+		return true;
+
+	MessageCacheIndexHeader Header = {};
+	Header.ConversationsCount = static_cast<uint32_t>(m_Entries.size());
+	Header.DeadBytes = static_cast<uint32_t>(std::min<size_t>(m_DeadBytes, UINT32_MAX));
+	Header.LogSize = m_LogSize;
+
+	std::string Index;
+	Index.reserve(sizeof(Header) + m_Entries.size() * sizeof(MessageCacheIndexEntry));
+	WriteBinaryValue(Index, Header);
+	for (const auto &[ID, CachedEntry] : m_Entries)
+	{
+		WriteBinaryValue(Index, CachedEntry.Index);
+	}
+
+	// NOTE: Records must reach the disk before an index pointing at them does
+	fsync(m_LogFileDescriptor);
+
+	const std::string TEMPORARY_FILE_PATH = m_IndexFilePath + ".tmp";
+	const int FILE_DESCRIPTOR = open(TEMPORARY_FILE_PATH.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (FILE_DESCRIPTOR < 0)
+	{
+		// Handles file open failure error
+		return false;
+	}
+
+	const bool IS_WRITTEN = WriteAll(FILE_DESCRIPTOR, Index.data(), Index.size(), 0) && fsync(FILE_DESCRIPTOR) == 0;
+	close(FILE_DESCRIPTOR);
+	if (!IS_WRITTEN || std::rename(TEMPORARY_FILE_PATH.c_str(), m_IndexFilePath.c_str()) != 0)
+	{
+		// Handles index write failure error, the previous index is kept and records past it are replayed
+		unlink(TEMPORARY_FILE_PATH.c_str());
+		return false;
+	}
+
+	m_IsIndexDirty = false;
+	return true;
+}
+
+void MessageCache::Reset()
+{
+	if (m_LogFileDescriptor < 0)
+		return;
+
+	WriteIndex();
+	Unmap();
+	close(m_LogFileDescriptor);
+	m_LogFileDescriptor = -1;
+	m_LogFilePath.clear();
+	m_IndexFilePath.clear();
+	m_LogSize = 0;
+	m_DeadBytes = 0;
+	m_Entries.clear();
+	m_IsIndexDirty = false;
+}
+
+bool MessageCache::Map()
+{
+	if (m_Data && m_MappedSize >= m_LogSize)
+		return true;
+
+	// NOTE: Appended records show up in a shared mapping, pages past the end of the file are never touched
+	const size_t MAPPING_SIZE = std::max({m_LogSize, m_MappedSize * 2, MESSAGE_CACHE_MIN_MAPPING_SIZE});
+	Unmap();
+
+	void *Mapping = mmap(nullptr, MAPPING_SIZE, PROT_READ, MAP_SHARED, m_LogFileDescriptor, 0);
+	if (Mapping == MAP_FAILED)
+	{
+		// Handles mmap failure error
+		return false;
+	}
+
+	m_Data = static_cast<const unsigned char *>(Mapping);
+	m_MappedSize = MAPPING_SIZE;
+	return true;
+}
+
+void MessageCache::Unmap()
+{
+	if (!m_Data)
+		return;
+
+	munmap(const_cast<unsigned char *>(m_Data), m_MappedSize);
+	m_Data = nullptr;
+	m_MappedSize = 0;
+}
+
+bool MessageCache::IsCompactionNeeded() const
+{
+	return m_LogFileDescriptor >= 0 && m_DeadBytes >= MESSAGE_CACHE_COMPACTION_MIN_DEAD_BYTES &&
+	       m_DeadBytes * 2 >= m_LogSize;
+}
+
+bool MessageCache::Compact()
+{
+	if (!Map())
+		return false;
+
+	const std::string TEMPORARY_FILE_PATH = m_LogFilePath + ".tmp";
+	const int FILE_DESCRIPTOR = open(TEMPORARY_FILE_PATH.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (FILE_DESCRIPTOR < 0)
+	{
+		// Handles file open failure error
+		return false;
+	}
+
+	// NOTE: Records are buffered and written in chunks, offsets are known before they reach the file
+	constexpr size_t WRITE_CHUNK_SIZE = 1024 * 1024;
+	std::string Buffer;
+	size_t WrittenSize = 0;
+	const MessageCacheLogHeader LOG_HEADER = {};
+	WriteBinaryValue(Buffer, LOG_HEADER);
+
+	std::unordered_map<std::string, Entry> CompactedEntries;
+	std::vector<uint64_t> MessageOffsets;
+	std::string MessagePayload;
+	bool IsWritten = true;
+	for (const auto &[ID, CachedEntry] : m_Entries)
+	{
+		Entry CompactedEntry = CachedEntry;
+
+		const unsigned char *Payload = nullptr;
+		size_t Size = 0;
+		if (CachedEntry.Index.ConversationOffset != 0 &&
+		    ReadRecord(CachedEntry.Index.ConversationOffset, MessageCacheRecordType::Conversation, Payload, Size))
+		{
+			CompactedEntry.Index.ConversationOffset = WrittenSize + Buffer.size();
+			WriteRecord(Buffer, MessageCacheRecordType::Conversation, Payload, Size);
+		}
+		else
+			CompactedEntry.Index.ConversationOffset = 0;
+
+		// Messages are copied oldest first, each one relinked to the new offset of the previous one
+		MessageOffsets.clear();
+		ReadLiveMessageOffsets(CachedEntry, MessageOffsets);
+		uint64_t PreviousMessageOffset = 0;
+		for (auto Iterator = MessageOffsets.rbegin(); Iterator != MessageOffsets.rend(); ++Iterator)
+		{
+			if (!ReadRecord(*Iterator, MessageCacheRecordType::Message, Payload, Size))
+				continue;
+
+			MessagePayload.assign(reinterpret_cast<const char *>(Payload), Size);
+			std::memcpy(MessagePayload.data(), &PreviousMessageOffset, sizeof(PreviousMessageOffset));
+			PreviousMessageOffset = WrittenSize + Buffer.size();
+			WriteRecord(Buffer, MessageCacheRecordType::Message,
+			            reinterpret_cast<const unsigned char *>(MessagePayload.data()), MessagePayload.size());
+		}
+		CompactedEntry.Index.LastMessageOffset = PreviousMessageOffset;
+
+		if (CompactedEntry.Index.ConversationOffset == 0 && CompactedEntry.Index.LastMessageOffset == 0)
+			continue;
+		CompactedEntries.emplace(ID, CompactedEntry);
+
+		if (Buffer.size() >= WRITE_CHUNK_SIZE)
+		{
+			IsWritten = WriteAll(FILE_DESCRIPTOR, Buffer.data(), Buffer.size(), static_cast<off_t>(WrittenSize));
+			WrittenSize += Buffer.size();
+			Buffer.clear();
+			if (!IsWritten)
+				break;
+		}
+	}
+
+	IsWritten = IsWritten && WriteAll(FILE_DESCRIPTOR, Buffer.data(), Buffer.size(), static_cast<off_t>(WrittenSize)) &&
+	            fsync(FILE_DESCRIPTOR) == 0;
+	WrittenSize += Buffer.size();
+
+	// NOTE: The index points into the old log, it is removed before the log is replaced so a crash in between replays
+	// the new log instead of trusting offsets that no longer match
+	if (!IsWritten || (unlink(m_IndexFilePath.c_str()) != 0 && errno != ENOENT) ||
+	    std::rename(TEMPORARY_FILE_PATH.c_str(), m_LogFilePath.c_str()) != 0)
+	{
+		// Handles log write failure error, the current log is kept
+		close(FILE_DESCRIPTOR);
+		unlink(TEMPORARY_FILE_PATH.c_str());
+		m_IsIndexDirty = true;
+		return false;
+	}
+
+	Unmap();
+	close(m_LogFileDescriptor);
+	m_LogFileDescriptor = FILE_DESCRIPTOR;
+	m_LogSize = WrittenSize;
+	m_Entries = std::move(CompactedEntries);
+	m_DeadBytes = 0;
+	m_IsIndexDirty = true;
+
+	return Map() && WriteIndex();
+}
+
+size_t MessageCache::LoadIndex()
+{
+	const int FILE_DESCRIPTOR = open(m_IndexFilePath.c_str(), O_RDONLY);
+	if (FILE_DESCRIPTOR < 0)
+	{
+		// Handles missing index, every record is replayed
+		return sizeof(MessageCacheLogHeader);
+	}
+
+	// NOTE: Entries are small and fixed size, the whole index is read at once
+	std::string Index;
+	char Buffer[16384];
+	ssize_t ReadSize = 0;
+	while ((ReadSize = read(FILE_DESCRIPTOR, Buffer, sizeof(Buffer))) > 0)
+	{
+		Index.append(Buffer, static_cast<size_t>(ReadSize));
+	}
+	close(FILE_DESCRIPTOR);
+
+	MessageCacheIndexHeader Header = {};
+	if (ReadSize < 0 || Index.size() < sizeof(Header))
+	{
+		// Handles index read failure error
+		return sizeof(MessageCacheLogHeader);
+	}
+	std::memcpy(&Header, Index.data(), sizeof(Header));
+
+	const bool IS_VALID = Header.Magic == MESSAGE_CACHE_INDEX_MAGIC && Header.Version == MESSAGE_CACHE_VERSION &&
+	                      Index.size() == sizeof(Header) + Header.ConversationsCount * sizeof(MessageCacheIndexEntry) &&
+	                      Header.LogSize >= sizeof(MessageCacheLogHeader) && Header.LogSize <= m_LogSize;
+	if (!IS_VALID)
+	{
+		// Handles stale or corrupted index error
+		return sizeof(MessageCacheLogHeader);
+	}
+
+	for (uint32_t i = 0; i < Header.ConversationsCount; i++)
+	{
+		Entry CachedEntry = {};
+		std::memcpy(&CachedEntry.Index, Index.data() + sizeof(Header) + i * sizeof(MessageCacheIndexEntry),
+		            sizeof(MessageCacheIndexEntry));
+
+		// NOTE: IDs are not stored in the index, they are read back from the records it points to
+		Conversation CachedConversation = {};
+		Message LastMessage = {};
+		uint64_t PreviousMessageOffset = 0;
+		const bool HAS_CONVERSATION = CachedEntry.Index.ConversationOffset != 0 &&
+		                              ReadConversation(CachedEntry.Index.ConversationOffset, CachedConversation);
+		const bool HAS_LAST_MESSAGE = CachedEntry.Index.LastMessageOffset != 0 &&
+		                              ReadMessage(CachedEntry.Index.LastMessageOffset, LastMessage, PreviousMessageOffset);
+		const bool IS_ENTRY_VALID = (CachedEntry.Index.ConversationOffset == 0 || HAS_CONVERSATION) &&
+		                            (CachedEntry.Index.LastMessageOffset == 0 || HAS_LAST_MESSAGE) &&
+		                            (HAS_CONVERSATION || HAS_LAST_MESSAGE);
+		if (!IS_ENTRY_VALID)
+		{
+			// Handles index pointing at records of another log, every record is replayed
+			m_Entries.clear();
+			return sizeof(MessageCacheLogHeader);
+		}
+
+		const std::string &ID = HAS_CONVERSATION ? CachedConversation.ID : LastMessage.ConversationID;
+		m_Entries.emplace(ID, std::move(CachedEntry));
+	}
+
+	m_DeadBytes = Header.DeadBytes;
+	return static_cast<size_t>(Header.LogSize);
+}
+
+void MessageCache::Replay(size_t Offset)
+{
+	while (m_LogSize - Offset >= sizeof(MessageCacheRecordHeader))
+	{
+		MessageCacheRecordHeader Header = {};
+		std::memcpy(&Header, m_Data + Offset, sizeof(Header));
+
+		const unsigned char *PAYLOAD = m_Data + Offset + sizeof(Header);
+		if (m_LogSize - Offset - sizeof(Header) < Header.Size || ComputeChecksum(PAYLOAD, Header.Size) != Header.Checksum)
+			break;
+
+		Apply(Header.Type, Offset, PAYLOAD, Header.Size);
+		Offset += sizeof(Header) + Header.Size;
+		m_IsIndexDirty = true;
+	}
+
+	// Cuts a record torn by a crash so the next ones are appended right after the last valid record
+	if (Offset != m_LogSize && ftruncate(m_LogFileDescriptor, static_cast<off_t>(Offset)) == 0)
+		m_LogSize = Offset;
+}
+
+bool MessageCache::ReadRecord(uint64_t Offset, MessageCacheRecordType Type, const unsigned char *&Payload,
+                              size_t &Size) const
+{
+	const size_t READABLE_SIZE = std::min(m_LogSize, m_MappedSize);
+	if (!m_Data || Offset < sizeof(MessageCacheLogHeader) || Offset > READABLE_SIZE ||
+	    READABLE_SIZE - Offset < sizeof(MessageCacheRecordHeader))
+		return false;
+
+	MessageCacheRecordHeader Header = {};
+	std::memcpy(&Header, m_Data + Offset, sizeof(Header));
+	if (Header.Type != Type || READABLE_SIZE - Offset - sizeof(Header) < Header.Size)
+		return false;
+
+	Payload = m_Data + Offset + sizeof(Header);
+	Size = Header.Size;
+	return ComputeChecksum(Payload, Size) == Header.Checksum;
+}
+
+void MessageCache::Apply(MessageCacheRecordType Type, uint64_t Offset, const unsigned char *Payload, size_t Size)
+{
+	BinaryReader Reader(Payload, Size);
+
+	if (Type == MessageCacheRecordType::Conversation)
+	{
+		const int64_t CREATED_AT = Reader.ReadValue<int64_t>();
+		const int64_t LAST_ACTIVITY_AT = Reader.ReadValue<int64_t>();
+		const std::string ID = Reader.ReadString();
+		if (!Reader.IsValid)
+			return;
+
+		Entry &CachedEntry = m_Entries[ID];
+		if (CachedEntry.Index.ConversationOffset != 0)
+			m_DeadBytes += GetRecordBytes(CachedEntry.Index.ConversationOffset, MessageCacheRecordType::Conversation);
+		CachedEntry.Index.ConversationOffset = Offset;
+		CachedEntry.Index.LastActivityAt = std::max({CachedEntry.Index.LastActivityAt, CREATED_AT, LAST_ACTIVITY_AT});
+	}
+	else if (Type == MessageCacheRecordType::Message)
+	{
+		Reader.ReadValue<uint64_t>();
+		const int64_t CREATED_AT = Reader.ReadValue<int64_t>();
+		const uint64_t NONCE = Reader.ReadValue<uint64_t>();
+		const uint64_t SEQUENCE = Reader.ReadValue<uint64_t>();
+		const std::string CONVERSATION_ID = Reader.ReadString();
+		if (!Reader.IsValid)
+			return;
+
+		Entry &CachedEntry = m_Entries[CONVERSATION_ID];
+		CachedEntry.Index.LastMessageOffset = Offset;
+		CachedEntry.Index.LastActivityAt = std::max(CachedEntry.Index.LastActivityAt, CREATED_AT);
+		if (NONCE != 0 && SEQUENCE == 0)
+		{
+			CachedEntry.Index.PendingMessagesCount++;
+			return;
+		}
+
+		// NOTE: A sent message is appended again once acknowledged, it is no longer pending and its pending copy is dead
+		// The copy only lacks the ID and sequence, its size is taken as the size of this record
+		if (NONCE != 0 && CachedEntry.Index.PendingMessagesCount > 0)
+		{
+			CachedEntry.Index.PendingMessagesCount--;
+			m_DeadBytes += sizeof(MessageCacheRecordHeader) + Size;
+		}
+		CachedEntry.Index.LastMessageCreatedAt = CREATED_AT;
+		CachedEntry.Index.MessagesCount++;
+	}
+	else if (Type == MessageCacheRecordType::ConversationRemoved)
+	{
+		const std::string ID = Reader.ReadString();
+		if (!Reader.IsValid)
+			return;
+
+		// NOTE: The removal record itself is dead too, nothing is left for it to remove once the log is compacted
+		auto Iterator = m_Entries.find(ID);
+		if (Iterator != m_Entries.end())
+			m_DeadBytes += GetConversationBytes(Iterator->second);
+		m_DeadBytes += sizeof(MessageCacheRecordHeader) + Size;
+		m_Entries.erase(ID);
+	}
+}
+
+bool MessageCache::Append(MessageCacheRecordType Type, const std::string &Payload)
+{
+	if (m_LogFileDescriptor < 0)
+		return false;
+
+	// NOTE: Header and payload go out in a single write so a record is never split by another process
+	std::string Record;
+	Record.reserve(sizeof(MessageCacheRecordHeader) + Payload.size());
+	WriteRecord(Record, Type, reinterpret_cast<const unsigned char *>(Payload.data()), Payload.size());
+
+	if (!WriteAll(m_LogFileDescriptor, Record.data(), Record.size(), static_cast<off_t>(m_LogSize)))
+	{
+		// Handles write failure error, drops whatever part of the record was written
+		ftruncate(m_LogFileDescriptor, static_cast<off_t>(m_LogSize));
+		return false;
+	}
+
+	Apply(Type, m_LogSize, reinterpret_cast<const unsigned char *>(Payload.data()), Payload.size());
+	m_LogSize += Record.size();
+	m_IsIndexDirty = true;
+
+	return true;
+}
+
+bool MessageCache::ReadConversation(uint64_t Offset, Conversation &CachedConversation) const
+{
+	const unsigned char *Payload = nullptr;
+	size_t Size = 0;
+	if (!ReadRecord(Offset, MessageCacheRecordType::Conversation, Payload, Size))
+		return false;
+
+	BinaryReader Reader(Payload, Size);
+
+	CachedConversation.CreatedAt = static_cast<std::time_t>(Reader.ReadValue<int64_t>());
+	CachedConversation.LastActivityAt = static_cast<std::time_t>(Reader.ReadValue<int64_t>());
+	CachedConversation.ID = Reader.ReadString();
+	const uint32_t USERS_COUNT = Reader.ReadValue<uint32_t>();
+	for (uint32_t i = 0; i < USERS_COUNT && Reader.IsValid; i++)
+	{
+		User ConversationUser = {};
+		ConversationUser.ID = Reader.ReadString();
+		ConversationUser.FirstName = Reader.ReadString();
+		ConversationUser.ImageUrl = Reader.ReadString();
+		CachedConversation.Users.push_back(std::move(ConversationUser));
+	}
+
+	return Reader.IsValid;
+}
+
+bool MessageCache::ReadMessage(uint64_t Offset, Message &CachedMessage, uint64_t &PreviousMessageOffset) const
+{
+	const unsigned char *Payload = nullptr;
+	size_t Size = 0;
+	if (!ReadRecord(Offset, MessageCacheRecordType::Message, Payload, Size))
+		return false;
+
+	BinaryReader Reader(Payload, Size);
+
+	const uint64_t PREVIOUS_MESSAGE_OFFSET = Reader.ReadValue<uint64_t>();
+	CachedMessage.CreatedAt = static_cast<std::time_t>(Reader.ReadValue<int64_t>());
+	CachedMessage.Nonce = Reader.ReadValue<uint64_t>();
+	CachedMessage.Sequence = Reader.ReadValue<uint64_t>();
+	CachedMessage.ConversationID = Reader.ReadString();
+	CachedMessage.ID = Reader.ReadString();
+	CachedMessage.SenderID = Reader.ReadString();
+	CachedMessage.SenderFirstName = Reader.ReadString();
+	CachedMessage.SenderImageUrl = Reader.ReadString();
+	CachedMessage.Text = Reader.ReadString();
+	if (!Reader.IsValid)
+		return false;
+
+	// NOTE: Links only point backwards, anything else is corruption and would loop forever
+	if (PREVIOUS_MESSAGE_OFFSET >= Offset)
+		return false;
+
+	PreviousMessageOffset = PREVIOUS_MESSAGE_OFFSET;
+	return true;
+}
+
+void MessageCache::ReadNewestMessages(const Entry &CachedEntry, size_t MessagesCount, std::vector<Message> &Messages) const
+{
+	// Walks back from the newest message then restores chronological order
+	const size_t FIRST_MESSAGE_INDEX = Messages.size();
+	std::vector<uint64_t> AcknowledgedNonces;
+	uint64_t MessageOffset = CachedEntry.Index.LastMessageOffset;
+	while (MessageOffset != 0 && Messages.size() - FIRST_MESSAGE_INDEX < MessagesCount)
+	{
+		Message CachedMessage = {};
+		if (!ReadMessage(MessageOffset, CachedMessage, MessageOffset))
+			break;
+
+		// NOTE: The acknowledged copy of a sent message is always newer, its pending copy is skipped
+		if (CachedMessage.IsPending() && std::find(AcknowledgedNonces.begin(), AcknowledgedNonces.end(),
+		                                           CachedMessage.Nonce) != AcknowledgedNonces.end())
+			continue;
+		if (CachedMessage.Nonce != 0 && !CachedMessage.IsPending())
+			AcknowledgedNonces.push_back(CachedMessage.Nonce);
+
+		Messages.push_back(std::move(CachedMessage));
+	}
+	std::reverse(Messages.begin() + FIRST_MESSAGE_INDEX, Messages.end());
+}
+
+void MessageCache::ReadLiveMessageOffsets(const Entry &CachedEntry, std::vector<uint64_t> &MessageOffsets) const
+{
+	std::vector<uint64_t> AcknowledgedNonces;
+	uint64_t MessageOffset = CachedEntry.Index.LastMessageOffset;
+	while (MessageOffset != 0)
+	{
+		const uint64_t OFFSET = MessageOffset;
+		Message CachedMessage = {};
+		if (!ReadMessage(OFFSET, CachedMessage, MessageOffset))
+			break;
+
+		// NOTE: Same rule as ReadNewestMessages, the pending copy of an acknowledged message is never shown
+		if (CachedMessage.IsPending() && std::find(AcknowledgedNonces.begin(), AcknowledgedNonces.end(),
+		                                           CachedMessage.Nonce) != AcknowledgedNonces.end())
+			continue;
+		if (CachedMessage.Nonce != 0 && !CachedMessage.IsPending())
+			AcknowledgedNonces.push_back(CachedMessage.Nonce);
+
+		MessageOffsets.push_back(OFFSET);
+	}
+}
+
+size_t MessageCache::GetRecordBytes(uint64_t Offset, MessageCacheRecordType Type) const
+{
+	const unsigned char *Payload = nullptr;
+	size_t Size = 0;
+	if (!ReadRecord(Offset, Type, Payload, Size))
+		return 0;
+
+	return sizeof(MessageCacheRecordHeader) + Size;
+}
+
+size_t MessageCache::GetConversationBytes(const Entry &CachedEntry) const
+{
+	size_t Bytes = 0;
+	if (CachedEntry.Index.ConversationOffset != 0)
+		Bytes += GetRecordBytes(CachedEntry.Index.ConversationOffset, MessageCacheRecordType::Conversation);
+
+	// Walks every message of the conversation, pending copies already counted as dead are counted again
+	uint64_t MessageOffset = CachedEntry.Index.LastMessageOffset;
+	while (MessageOffset != 0)
+	{
+		const unsigned char *Payload = nullptr;
+		size_t Size = 0;
+		uint64_t PreviousMessageOffset = 0;
+		if (!ReadRecord(MessageOffset, MessageCacheRecordType::Message, Payload, Size) ||
+		    Size < sizeof(PreviousMessageOffset))
+			break;
+
+		std::memcpy(&PreviousMessageOffset, Payload, sizeof(PreviousMessageOffset));
+		if (PreviousMessageOffset >= MessageOffset)
+			break;
+
+		Bytes += sizeof(MessageCacheRecordHeader) + Size;
+		MessageOffset = PreviousMessageOffset;
+	}
+
+	return Bytes;
+}
@@ -0,0 +1,337 @@
+#include "MessageFilter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+void AppendLowercase(std::string &Buffer, std::string_view Value)
+{
+	for (const char Character : Value)
+	{
+		Buffer.push_back(Character >= 'A' && Character <= 'Z' ? static_cast<char>(Character - 'A' + 'a') : Character);
+	}
+}
+
+// NOTE: Text of the message ends before its '\0' separator
+std::string_view GetChunkMessageText(const std::string &Text, const std::vector<uint32_t> &Offsets, size_t Index)
+{
+	const size_t END = Index + 1 < Offsets.size() ? Offsets[Index + 1] - 1 : Text.size() - 1;
+	return std::string_view(Text).substr(Offsets[Index], END - Offsets[Index]);
+}
+} // namespace
+
+// NOTE: Compares the first and last bytes of the needle against 16 positions at once and only compares the rest where
+// both match, see Wojciech Muła's "SIMD-friendly algorithms for substring searching"
+size_t FindSubstring(std::string_view Text, std::string_view Needle)
+{
+	const size_t NEEDLE_SIZE = Needle.size();
+	if (NEEDLE_SIZE == 0)
+		return 0;
+	if (NEEDLE_SIZE > Text.size())
+		return std::string_view::npos;
+	if (NEEDLE_SIZE == 1)
+	{
+		const void *Found = std::memchr(Text.data(), Needle[0], Text.size());
+		return Found ? static_cast<size_t>(static_cast<const char *>(Found) - Text.data()) : std::string_view::npos;
+	}
+
+	size_t Position = 0;
+#if defined(__SSE2__)
+	const __m128i FIRST = _mm_set1_epi8(Needle[0]);
+	const __m128i LAST = _mm_set1_epi8(Needle[NEEDLE_SIZE - 1]);
+	for (; Position + NEEDLE_SIZE - 1 + 16 <= Text.size(); Position += 16)
+	{
+		const __m128i FIRST_BLOCK = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Text.data() + Position));
+		const __m128i LAST_BLOCK =
+		    _mm_loadu_si128(reinterpret_cast<const __m128i *>(Text.data() + Position + NEEDLE_SIZE - 1));
+		uint32_t Mask = static_cast<uint32_t>(
+		    _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(FIRST_BLOCK, FIRST), _mm_cmpeq_epi8(LAST_BLOCK, LAST))));
+		while (Mask != 0)
+		{
+			const size_t CANDIDATE = Position + static_cast<size_t>(__builtin_ctz(Mask));
+			if (std::memcmp(Text.data() + CANDIDATE + 1, Needle.data() + 1, NEEDLE_SIZE - 2) == 0)
+				return CANDIDATE;
+			Mask &= Mask - 1;
+		}
+	}
+#endif
+
+	// Checks the positions left past the last full block
+	for (; Position + NEEDLE_SIZE <= Text.size(); Position++)
+	{
+		if (Text[Position] == Needle[0] && std::memcmp(Text.data() + Position + 1, Needle.data() + 1, NEEDLE_SIZE - 1) == 0)
+			return Position;
+	}
+	return std::string_view::npos;
+}
+
+MessageFilter::MessageFilter() : m_Worker(&MessageFilter::RunWorker, this)
+{
+}
+
+MessageFilter::~MessageFilter()
+{
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_IsStopping = true;
+	}
+	m_Condition.notify_all();
+
+	m_Worker.join();
+}
+
+// ***********
+// * GETTERS *
+// ***********
+const std::string &MessageFilter::GetQuery() const
+{
+	return m_Query;
+}
+
+size_t MessageFilter::GetMessagesCount() const
+{
+	return m_MessagesCount;
+}
+
+// **********
+// * PUBLIC *
+// **********
+void MessageFilter::SetOnCompleted(std::function<void()> OnCompleted)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	m_OnCompleted = std::move(OnCompleted);
+}
+
+void MessageFilter::UpdateConversation(const Conversation &UpdatedConversation)
+{
+	std::shared_ptr<const Entry> &Current = m_Entries[UpdatedConversation.ID];
+	if (Current && Current->MessagesCount >= UpdatedConversation.Messages.size() &&
+	    Current->UsersCount == UpdatedConversation.Users.size())
+		return;
+
+	// NOTE: Chunks are shared with the previous entry, only the last one is copied when messages are appended to it
+	auto Updated = std::make_shared<Entry>(Current ? *Current : Entry{});
+	Updated->ConversationID = UpdatedConversation.ID;
+	Updated->UsersCount = UpdatedConversation.Users.size();
+	Updated->Title.clear();
+	AppendLowercase(Updated->Title, UpdatedConversation.ID);
+	for (const User &ConversationUser : UpdatedConversation.Users)
+	{
+		Updated->Title.push_back('\0');
+		AppendLowercase(Updated->Title, ConversationUser.FirstName);
+	}
+
+	size_t Index = Updated->MessagesCount;
+	while (Index < UpdatedConversation.Messages.size())
+	{
+		std::shared_ptr<Chunk> Last;
+		if (!Updated->Chunks.empty() && Updated->Chunks.back()->Offsets.size() < MESSAGE_FILTER_CHUNK_MESSAGES_COUNT)
+		{
+			Last = std::make_shared<Chunk>(*Updated->Chunks.back());
+			Updated->Chunks.back() = Last;
+		}
+		else
+		{
+			Last = std::make_shared<Chunk>();
+			Updated->Chunks.push_back(Last);
+		}
+
+		for (; Index < UpdatedConversation.Messages.size() && Last->Offsets.size() < MESSAGE_FILTER_CHUNK_MESSAGES_COUNT;
+		     Index++)
+		{
+			Last->Offsets.push_back(static_cast<uint32_t>(Last->Text.size()));
+			AppendLowercase(Last->Text, UpdatedConversation.Messages[Index].Text);
+			Last->Text.push_back('\0');
+		}
+	}
+
+	m_MessagesCount += Index - Updated->MessagesCount;
+	Updated->MessagesCount = Index;
+	Current = std::move(Updated);
+	m_Snapshot.reset();
+}
+
+void MessageFilter::RemoveConversation(const std::string &ConversationID)
+{
+	auto Iterator = m_Entries.find(ConversationID);
+	if (Iterator == m_Entries.end())
+		return;
+
+	m_MessagesCount -= Iterator->second->MessagesCount;
+	m_Entries.erase(Iterator);
+	m_Snapshot.reset();
+}
+
+void MessageFilter::SetQuery(std::string_view Query)
+{
+	std::string LowercaseQuery;
+	AppendLowercase(LowercaseQuery, Query);
+	if (LowercaseQuery == m_Query && m_Snapshot)
+		return;
+
+	m_Query = std::move(LowercaseQuery);
+	if (!m_Snapshot)
+	{
+		auto Entries = std::make_shared<Snapshot>();
+		Entries->reserve(m_Entries.size());
+		for (const auto &[ID, CurrentEntry] : m_Entries)
+		{
+			Entries->push_back(CurrentEntry);
+		}
+		m_Snapshot = std::move(Entries);
+	}
+
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+		m_Generation++;
+
+		// NOTE: Nothing to scan, every conversation is shown again right away
+		if (m_Query.empty())
+		{
+			m_IsPending = false;
+			m_PendingSnapshot.reset();
+			m_Result = {};
+			m_IsResultReady = true;
+			return;
+		}
+
+		m_PendingSnapshot = m_Snapshot;
+		m_PendingQuery = m_Query;
+		m_IsPending = true;
+	}
+	m_Condition.notify_one();
+}
+
+bool MessageFilter::Poll(MessageFilterResult &Result)
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	if (!m_IsResultReady)
+		return false;
+
+	Result = std::move(m_Result);
+	m_Result = {};
+	m_IsResultReady = false;
+	return true;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void MessageFilter::RunWorker()
+{
+	while (true)
+	{
+		std::shared_ptr<const Snapshot> Entries;
+		std::string Query;
+		uint64_t Generation = 0;
+		{
+			std::unique_lock<std::mutex> Lock(m_Mutex);
+			m_Condition.wait(Lock, [this]() { return m_IsStopping || m_IsPending; });
+			if (m_IsStopping)
+				return;
+
+			Entries = std::move(m_PendingSnapshot);
+			Query = std::move(m_PendingQuery);
+			Generation = m_Generation.load();
+			m_IsPending = false;
+		}
+
+		MessageFilterResult Result = {};
+		Result.Query = Query;
+		std::unordered_map<const Chunk *, ChunkMatches> ChunkMatchesByChunk;
+		if (!Scan(*Entries, Query, Generation, Result, ChunkMatchesByChunk))
+			continue;
+
+		// NOTE: Kept even when the query changed meanwhile, the next query likely extends this one
+		m_CompletedQuery = std::move(Query);
+		m_CompletedChunkMatches = std::move(ChunkMatchesByChunk);
+
+		std::function<void()> OnCompleted;
+		{
+			std::lock_guard<std::mutex> Lock(m_Mutex);
+			if (Generation != m_Generation.load())
+				continue;
+
+			m_Result = std::move(Result);
+			m_IsResultReady = true;
+			OnCompleted = m_OnCompleted;
+		}
+		if (OnCompleted)
+			OnCompleted();
+	}
+}
+
+bool MessageFilter::Scan(const Snapshot &Entries, const std::string &Query, uint64_t Generation,
+                         MessageFilterResult &Result,
+                         std::unordered_map<const Chunk *, ChunkMatches> &ChunkMatchesByChunk) const
+{
+	// NOTE: Every message containing the query also contains any part of it, so only the previous matches are checked
+	const bool IS_REFINEMENT = !m_CompletedQuery.empty() && Query.find(m_CompletedQuery) != std::string::npos;
+
+	for (const std::shared_ptr<const Entry> &CurrentEntry : Entries)
+	{
+		MessageFilterMatch Match = {};
+		Match.IsTitleMatch = FindSubstring(CurrentEntry->Title, Query) != std::string_view::npos;
+
+		size_t FirstIndex = 0;
+		for (const std::shared_ptr<const Chunk> &CurrentChunk : CurrentEntry->Chunks)
+		{
+			// Cancels once a newer query was set
+			if (Generation != m_Generation.load(std::memory_order_relaxed))
+				return false;
+
+			ChunkMatches &Matches = ChunkMatchesByChunk[CurrentChunk.get()];
+			// NOTE: Chunks are shared between entries of different snapshots but never between conversations
+			if (!Matches.Source)
+			{
+				Matches.Source = CurrentChunk;
+
+				auto Previous = IS_REFINEMENT ? m_CompletedChunkMatches.find(CurrentChunk.get()) : m_CompletedChunkMatches.end();
+				if (Previous != m_CompletedChunkMatches.end())
+				{
+					for (const uint32_t INDEX : Previous->second.MessageIndices)
+					{
+						if (FindSubstring(GetChunkMessageText(CurrentChunk->Text, CurrentChunk->Offsets, INDEX), Query) !=
+						    std::string_view::npos)
+							Matches.MessageIndices.push_back(INDEX);
+					}
+				}
+				else
+				{
+					// NOTE: Scans the whole arena at once, a match is mapped back to its message which is then skipped
+					const std::string_view TEXT = CurrentChunk->Text;
+					size_t Position = 0;
+					while (Position < TEXT.size())
+					{
+						const size_t FOUND = FindSubstring(TEXT.substr(Position), Query);
+						if (FOUND == std::string_view::npos)
+							break;
+
+						const auto OFFSET = std::upper_bound(CurrentChunk->Offsets.begin(), CurrentChunk->Offsets.end(),
+						                                     static_cast<uint32_t>(Position + FOUND));
+						const uint32_t INDEX = static_cast<uint32_t>(OFFSET - CurrentChunk->Offsets.begin() - 1);
+						Matches.MessageIndices.push_back(INDEX);
+						Position = OFFSET != CurrentChunk->Offsets.end() ? *OFFSET : TEXT.size();
+					}
+				}
+			}
+
+			for (const uint32_t INDEX : Matches.MessageIndices)
+			{
+				Match.MessageIndices.push_back(static_cast<uint32_t>(FirstIndex + INDEX));
+			}
+			FirstIndex += CurrentChunk->Offsets.size();
+		}
+
+		if (Match.IsTitleMatch || !Match.MessageIndices.empty())
+			Result.MatchesByConversationID.emplace(CurrentEntry->ConversationID, std::move(Match));
+	}
+
+	return true;
+}
@@ -0,0 +1,80 @@
+#include "MessageReceiver.h"
+#include "Utf8.h"
+
+#include <utility>
+
+MessageReceiver::MessageReceiver(MessagePersister Persister, MessageFanOut FanOut)
+    : m_Persister(std::move(Persister)), m_FanOut(std::move(FanOut))
+{
+}
+
+// ***********
+// * GETTERS *
+// ***********
+size_t MessageReceiver::GetUsersCount() const
+{
+	return m_DeduplicatorsByUserID.size();
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool MessageReceiver::Receive(const std::string &UserID, std::string_view Payload, double Now, std::string &Response)
+{
+	if (!DecodeSendMessagesFrame(Payload, m_Messages))
+	{
+		// Handles malformed frame error
+		return false;
+	}
+
+	NonceDeduplicator &Deduplicator = m_DeduplicatorsByUserID[UserID];
+	m_Acknowledgements.clear();
+	for (Message &ReceivedMessage : m_Messages)
+	{
+		// NOTE: Nonce 0 means the sender did not set one, such messages are never treated as retries
+		const bool HAS_NONCE = ReceivedMessage.Nonce != 0;
+		const MessageAcknowledgement *PREVIOUS_ACKNOWLEDGEMENT =
+		    HAS_NONCE ? Deduplicator.Find(ReceivedMessage.Nonce, Now) : nullptr;
+		if (PREVIOUS_ACKNOWLEDGEMENT)
+		{
+			m_Acknowledgements.push_back(*PREVIOUS_ACKNOWLEDGEMENT);
+			continue;
+		}
+
+		ReceivedMessage.SenderID = UserID;
+		// NOTE: Text is shown as is by every client it is delivered to, malformed bytes are repaired before it is stored
+		SanitizeUtf8(ReceivedMessage.Text);
+		if (!m_Persister(ReceivedMessage))
+		{
+			// Handles persist failure error, left unacknowledged so the client retries it
+			continue;
+		}
+
+		MessageAcknowledgement Acknowledgement = {};
+		Acknowledgement.Nonce = ReceivedMessage.Nonce;
+		Acknowledgement.Sequence = ReceivedMessage.Sequence;
+		Acknowledgement.MessageID = ReceivedMessage.ID;
+		if (HAS_NONCE)
+			Deduplicator.Insert(Acknowledgement, Now);
+		m_Acknowledgements.push_back(std::move(Acknowledgement));
+
+		if (m_FanOut)
+			m_FanOut(ReceivedMessage);
+	}
+
+	if (!m_Acknowledgements.empty())
+		EncodeAcknowledgementsFrame(m_Acknowledgements, Response);
+
+	return true;
+}
+
+void MessageReceiver::Expire(double Now)
+{
+	for (auto Iterator = m_DeduplicatorsByUserID.begin(); Iterator != m_DeduplicatorsByUserID.end();)
+	{
+		if (Iterator->second.IsExpired(Now))
+			Iterator = m_DeduplicatorsByUserID.erase(Iterator);
+		else
+			Iterator++;
+	}
+}
@@ -0,0 +1,263 @@
+#include "MessageSearchIndex.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+bool IsWordByte(unsigned char Byte)
+{
+	return (Byte >= '0' && Byte <= '9') || (Byte >= 'a' && Byte <= 'z') || (Byte >= 'A' && Byte <= 'Z') || Byte >= 0x80;
+}
+
+void WriteVarint(std::string &Bytes, uint32_t Value)
+{
+	while (Value >= 0x80)
+	{
+		Bytes.push_back(static_cast<char>((Value & 0x7F) | 0x80));
+		Value >>= 7;
+	}
+	Bytes.push_back(static_cast<char>(Value));
+}
+
+uint32_t ReadVarint(const unsigned char *&Data)
+{
+	uint32_t Value = *Data & 0x7F;
+	int Shift = 7;
+	while (*Data++ & 0x80)
+	{
+		Value |= static_cast<uint32_t>(*Data & 0x7F) << Shift;
+		Shift += 7;
+	}
+	return Value;
+}
+
+// NOTE: Returns the position of the first document not below Value, starting at Position
+// Documents fit in 31 bits so the signed comparison of SSE2 is enough
+size_t AdvanceTo(const uint32_t *Documents, size_t Position, size_t Size, uint32_t Value)
+{
+#if defined(__SSE2__)
+	const __m128i VALUE = _mm_set1_epi32(static_cast<int>(Value));
+	for (; Position + 8 <= Size; Position += 8)
+	{
+		if (Documents[Position + 7] < Value)
+			continue;
+
+		// Sorted so the documents below Value are the lowest lanes, counting them gives the position
+		const __m128i LOW = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Documents + Position));
+		const __m128i HIGH = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Documents + Position + 4));
+		const int MASK = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(LOW, VALUE))) |
+		                 (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(HIGH, VALUE))) << 4);
+		return Position + static_cast<size_t>(__builtin_popcount(static_cast<unsigned int>(MASK)));
+	}
+#endif
+	while (Position < Size && Documents[Position] < Value)
+		Position++;
+	return Position;
+}
+} // namespace
+
+void TokenizeMessageText(std::string_view Text, std::vector<std::string> &Tokens)
+{
+	Tokens.clear();
+	size_t Offset = 0;
+	while (Offset < Text.size())
+	{
+		while (Offset < Text.size() && !IsWordByte(static_cast<unsigned char>(Text[Offset])))
+			Offset++;
+
+		const size_t START = Offset;
+		while (Offset < Text.size() && IsWordByte(static_cast<unsigned char>(Text[Offset])))
+			Offset++;
+		if (Offset == START)
+			continue;
+
+		// NOTE: Cutting may split a UTF-8 sequence, queries are cut the same way so they still match
+		std::string Token(Text.substr(START, std::min(Offset - START, MESSAGE_SEARCH_MAX_TOKEN_SIZE)));
+		for (char &Character : Token)
+		{
+			if (Character >= 'A' && Character <= 'Z')
+				Character = static_cast<char>(Character - 'A' + 'a');
+		}
+		Tokens.push_back(std::move(Token));
+	}
+}
+
+// ***********
+// * GETTERS *
+// ***********
+size_t MessageSearchIndex::GetMessagesCount() const
+{
+	return m_MessagesCount;
+}
+
+size_t MessageSearchIndex::GetPostingsSizeInBytes() const
+{
+	return m_PostingsSizeInBytes;
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool MessageSearchIndex::Add(const Message &StoredMessage)
+{
+	Shard &ConversationShard = m_Shards[StoredMessage.ConversationID];
+	if (StoredMessage.Sequence != 0 && StoredMessage.Sequence <= ConversationShard.LastSequence)
+	{
+		// Handles already indexed message error
+		return false;
+	}
+	ConversationShard.LastSequence = StoredMessage.Sequence;
+
+	const uint32_t DOCUMENT = static_cast<uint32_t>(ConversationShard.MessageIDs.size());
+	ConversationShard.MessageIDs.push_back(StoredMessage.ID);
+	m_MessagesCount++;
+
+	TokenizeMessageText(StoredMessage.Text, m_Tokens);
+	for (std::string &Token : m_Tokens)
+	{
+		PostingList &List = ConversationShard.Postings[std::move(Token)];
+		// NOTE: A term repeated in a message is only posted once
+		if (List.Count > 0 && List.LastDocument == DOCUMENT)
+			continue;
+
+		const size_t PREVIOUS_SIZE = List.Bytes.size() + List.Blocks.size() * sizeof(PostingBlock);
+		Append(List, DOCUMENT);
+		m_PostingsSizeInBytes += List.Bytes.size() + List.Blocks.size() * sizeof(PostingBlock) - PREVIOUS_SIZE;
+	}
+
+	return true;
+}
+
+void MessageSearchIndex::Search(const std::string &ConversationID, std::string_view Query, size_t MaxResultsCount,
+                                std::vector<std::string> &MessageIDs) const
+{
+	MessageIDs.clear();
+
+	const auto ShardIterator = m_Shards.find(ConversationID);
+	if (ShardIterator == m_Shards.end())
+		return;
+	const Shard &ConversationShard = ShardIterator->second;
+
+	std::vector<std::string> Terms;
+	TokenizeMessageText(Query, Terms);
+	if (Terms.empty())
+		return;
+	std::sort(Terms.begin(), Terms.end());
+	Terms.erase(std::unique(Terms.begin(), Terms.end()), Terms.end());
+	Terms.resize(std::min(Terms.size(), MESSAGE_SEARCH_MAX_QUERY_TERMS_COUNT));
+
+	std::vector<const PostingList *> Lists;
+	for (const std::string &Term : Terms)
+	{
+		const auto ListIterator = ConversationShard.Postings.find(Term);
+		if (ListIterator == ConversationShard.Postings.end())
+			return;
+		Lists.push_back(&ListIterator->second);
+	}
+
+	// Intersects from the rarest term so the candidates only shrink
+	std::sort(Lists.begin(), Lists.end(), [](const PostingList *Left, const PostingList *Right) { return Left->Count < Right->Count; });
+	const PostingList &RAREST_LIST = *Lists[0];
+	const size_t RESULTS_COUNT = std::min(MaxResultsCount, MESSAGE_SEARCH_MAX_RESULTS_COUNT);
+
+	// NOTE: Walks the rarest list back from its newest block and stops once enough matches are found, so common terms
+	// cost about as much as rare ones
+	std::vector<uint32_t> Candidates;
+	for (size_t BlockIndex = RAREST_LIST.Blocks.size(); BlockIndex-- > 0 && MessageIDs.size() < RESULTS_COUNT;)
+	{
+		Candidates.resize(MESSAGE_SEARCH_BLOCK_SIZE);
+		Candidates.resize(DecodeBlock(RAREST_LIST, BlockIndex, Candidates.data()));
+		for (size_t i = 1; i < Lists.size() && !Candidates.empty(); i++)
+		{
+			Intersect(*Lists[i], Candidates);
+		}
+
+		for (auto Iterator = Candidates.rbegin(); Iterator != Candidates.rend() && MessageIDs.size() < RESULTS_COUNT; Iterator++)
+		{
+			MessageIDs.push_back(ConversationShard.MessageIDs[*Iterator]);
+		}
+	}
+}
+
+bool MessageSearchIndex::Respond(std::string_view Payload, std::string &Response) const
+{
+	SearchMessagesRequest Request = {};
+	if (!DecodeSearchMessagesFrame(Payload, Request))
+	{
+		// Handles malformed frame error
+		return false;
+	}
+
+	SearchMessagesResults Results = {};
+	Results.RequestID = Request.RequestID;
+	Search(Request.ConversationID, Request.Query, Request.MaxResultsCount, Results.MessageIDs);
+	EncodeSearchResultsFrame(Results, Response);
+
+	return true;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void MessageSearchIndex::Append(PostingList &List, uint32_t Document)
+{
+	if (List.Count % MESSAGE_SEARCH_BLOCK_SIZE == 0)
+		List.Blocks.push_back(PostingBlock{Document, static_cast<uint32_t>(List.Bytes.size())});
+	else
+		WriteVarint(List.Bytes, Document - List.LastDocument);
+
+	List.LastDocument = Document;
+	List.Count++;
+}
+
+size_t MessageSearchIndex::DecodeBlock(const PostingList &List, size_t BlockIndex, uint32_t *Documents)
+{
+	const size_t COUNT = std::min(MESSAGE_SEARCH_BLOCK_SIZE, List.Count - BlockIndex * MESSAGE_SEARCH_BLOCK_SIZE);
+	const unsigned char *Data = reinterpret_cast<const unsigned char *>(List.Bytes.data()) + List.Blocks[BlockIndex].ByteOffset;
+
+	Documents[0] = List.Blocks[BlockIndex].FirstDocument;
+	for (size_t i = 1; i < COUNT; i++)
+	{
+		Documents[i] = Documents[i - 1] + ReadVarint(Data);
+	}
+	return COUNT;
+}
+
+void MessageSearchIndex::Intersect(const PostingList &List, std::vector<uint32_t> &Candidates)
+{
+	uint32_t Documents[MESSAGE_SEARCH_BLOCK_SIZE];
+	size_t DocumentsCount = 0;
+	size_t Position = 0;
+	size_t BlockIndex = SIZE_MAX;
+	size_t KeptCount = 0;
+
+	// Starts at the last block beginning before the first candidate
+	const auto FIRST_BLOCK = std::upper_bound(List.Blocks.begin(), List.Blocks.end(), Candidates.front(),
+	                                          [](uint32_t Document, const PostingBlock &Block) { return Document < Block.FirstDocument; });
+	const size_t FIRST_BLOCK_INDEX = FIRST_BLOCK == List.Blocks.begin() ? 0 : static_cast<size_t>(FIRST_BLOCK - List.Blocks.begin()) - 1;
+
+	for (const uint32_t CANDIDATE : Candidates)
+	{
+		// Skips blocks ending before the candidate without decoding them
+		size_t CandidateBlockIndex = BlockIndex == SIZE_MAX ? FIRST_BLOCK_INDEX : BlockIndex;
+		while (CandidateBlockIndex + 1 < List.Blocks.size() && List.Blocks[CandidateBlockIndex + 1].FirstDocument <= CANDIDATE)
+			CandidateBlockIndex++;
+
+		if (CandidateBlockIndex != BlockIndex)
+		{
+			BlockIndex = CandidateBlockIndex;
+			DocumentsCount = DecodeBlock(List, BlockIndex, Documents);
+			Position = 0;
+		}
+
+		Position = AdvanceTo(Documents, Position, DocumentsCount, CANDIDATE);
+		if (Position < DocumentsCount && Documents[Position] == CANDIDATE)
+			Candidates[KeptCount++] = CANDIDATE;
+	}
+
+	Candidates.resize(KeptCount);
+}
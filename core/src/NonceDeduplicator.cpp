@@ -0,0 +1,166 @@
+#include "NonceDeduplicator.h"
+
+#include <utility>
+
+namespace
+{
+// NOTE: Nonces are a random prefix plus a counter, mixed so consecutive ones spread over the filter
+uint64_t HashNonce(uint64_t Nonce)
+{
+	Nonce ^= Nonce >> 33;
+	Nonce *= 0xFF51AFD7ED558CCDull;
+	Nonce ^= Nonce >> 33;
+	Nonce *= 0xC4CEB9FE1A85EC53ull;
+	Nonce ^= Nonce >> 33;
+	return Nonce;
+}
+
+uint16_t GetFingerprint(uint64_t Hash)
+{
+	const uint16_t FINGERPRINT = static_cast<uint16_t>(Hash >> 48);
+	return FINGERPRINT != 0 ? FINGERPRINT : 1;
+}
+
+size_t GetFirstIndex(uint64_t Hash)
+{
+	return static_cast<size_t>(Hash) & (NONCE_DEDUPLICATOR_FILTER_BUCKETS_COUNT - 1);
+}
+
+// NOTE: Only depends on the fingerprint so a fingerprint moved out of either of its buckets finds the other one
+size_t GetAlternateIndex(size_t Index, uint16_t Fingerprint)
+{
+	return (Index ^ (Fingerprint * 0x5BD1E995u)) & (NONCE_DEDUPLICATOR_FILTER_BUCKETS_COUNT - 1);
+}
+} // namespace
+
+// ***********
+// * GETTERS *
+// ***********
+size_t NonceDeduplicator::GetNoncesCount() const
+{
+	size_t NoncesCount = 0;
+	for (const Bucket &CountedBucket : m_Buckets)
+	{
+		NoncesCount += CountedBucket.Acknowledgements.size();
+	}
+	return NoncesCount;
+}
+
+bool NonceDeduplicator::IsExpired(double Now) const
+{
+	return !IsLive(m_Buckets[m_CurrentBucket], Now);
+}
+
+// **********
+// * PUBLIC *
+// **********
+const MessageAcknowledgement *NonceDeduplicator::Find(uint64_t Nonce, double Now) const
+{
+	const uint64_t HASH = HashNonce(Nonce);
+	for (const Bucket &CheckedBucket : m_Buckets)
+	{
+		if (!IsLive(CheckedBucket, Now) || !MayContain(CheckedBucket, HASH))
+			continue;
+
+		// NOTE: Filter hits are confirmed since two nonces can share a fingerprint
+		const auto Iterator = CheckedBucket.Acknowledgements.find(Nonce);
+		if (Iterator != CheckedBucket.Acknowledgements.end())
+			return &Iterator->second;
+	}
+
+	return nullptr;
+}
+
+void NonceDeduplicator::Insert(const MessageAcknowledgement &Acknowledgement, double Now)
+{
+	Bucket *CurrentBucket = &m_Buckets[m_CurrentBucket];
+	if (CurrentBucket->StartedAt < 0.0 || Now - CurrentBucket->StartedAt >= NONCE_DEDUPLICATOR_BUCKET_DURATION ||
+	    CurrentBucket->Acknowledgements.size() >= NONCE_DEDUPLICATOR_BUCKET_CAPACITY)
+	{
+		Rotate(Now);
+		CurrentBucket = &m_Buckets[m_CurrentBucket];
+	}
+
+	const uint64_t HASH = HashNonce(Acknowledgement.Nonce);
+	if (!AddToFilter(*CurrentBucket, HASH))
+	{
+		// Handles full filter error, the nonce goes into a fresh bucket
+		Rotate(Now);
+		CurrentBucket = &m_Buckets[m_CurrentBucket];
+		AddToFilter(*CurrentBucket, HASH);
+	}
+	CurrentBucket->Acknowledgements[Acknowledgement.Nonce] = Acknowledgement;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+bool NonceDeduplicator::IsLive(const Bucket &CheckedBucket, double Now) const
+{
+	return CheckedBucket.StartedAt >= 0.0 &&
+	       Now - CheckedBucket.StartedAt < NONCE_DEDUPLICATOR_BUCKET_DURATION * NONCE_DEDUPLICATOR_BUCKETS_COUNT;
+}
+
+// NOTE: Reuses the oldest bucket, dropping its nonces
+void NonceDeduplicator::Rotate(double Now)
+{
+	m_CurrentBucket = (m_CurrentBucket + 1) % NONCE_DEDUPLICATOR_BUCKETS_COUNT;
+
+	Bucket &NewBucket = m_Buckets[m_CurrentBucket];
+	NewBucket.StartedAt = Now;
+	NewBucket.Filter = {};
+	NewBucket.Acknowledgements.clear();
+}
+
+bool NonceDeduplicator::MayContain(const Bucket &CheckedBucket, uint64_t Hash) const
+{
+	const uint16_t FINGERPRINT = GetFingerprint(Hash);
+	const size_t FIRST_INDEX = GetFirstIndex(Hash);
+	const size_t SECOND_INDEX = GetAlternateIndex(FIRST_INDEX, FINGERPRINT);
+
+	for (size_t i = 0; i < NONCE_DEDUPLICATOR_FILTER_SLOTS_COUNT; i++)
+	{
+		if (CheckedBucket.Filter[FIRST_INDEX][i] == FINGERPRINT || CheckedBucket.Filter[SECOND_INDEX][i] == FINGERPRINT)
+			return true;
+	}
+
+	return false;
+}
+
+bool NonceDeduplicator::AddToFilter(Bucket &UpdatedBucket, uint64_t Hash)
+{
+	uint16_t Fingerprint = GetFingerprint(Hash);
+	size_t Index = GetFirstIndex(Hash);
+	// NOTE: Slots swapped on the way, undone when the fingerprint finds no place so no other one is lost
+	std::array<uint16_t *, NONCE_DEDUPLICATOR_MAX_KICKS_COUNT> KickedSlots = {};
+
+	for (size_t Kick = 0; Kick < NONCE_DEDUPLICATOR_MAX_KICKS_COUNT; Kick++)
+	{
+		const size_t ALTERNATE_INDEX = GetAlternateIndex(Index, Fingerprint);
+		for (const size_t CANDIDATE_INDEX : {Index, ALTERNATE_INDEX})
+		{
+			for (uint16_t &Slot : UpdatedBucket.Filter[CANDIDATE_INDEX])
+			{
+				if (Slot != 0)
+					continue;
+
+				Slot = Fingerprint;
+				return true;
+			}
+		}
+
+		// Both buckets are full, moves a fingerprint out to its other bucket
+		// NOTE: Evicted slot varies with the kick so two fingerprints can not keep swapping each other
+		const size_t EVICTED_INDEX = (Kick & 1) ? Index : ALTERNATE_INDEX;
+		KickedSlots[Kick] = &UpdatedBucket.Filter[EVICTED_INDEX][Kick % NONCE_DEDUPLICATOR_FILTER_SLOTS_COUNT];
+		std::swap(Fingerprint, *KickedSlots[Kick]);
+		Index = GetAlternateIndex(EVICTED_INDEX, Fingerprint);
+	}
+
+	for (size_t Kick = NONCE_DEDUPLICATOR_MAX_KICKS_COUNT; Kick > 0; Kick--)
+	{
+		std::swap(Fingerprint, *KickedSlots[Kick - 1]);
+	}
+
+	return false;
+}
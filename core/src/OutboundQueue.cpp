@@ -0,0 +1,193 @@
+#include "OutboundQueue.h"
+
+#include <algorithm>
+#include <random>
+
+OutboundQueue::OutboundQueue(uint64_t NonceSeed)
+{
+	if (NonceSeed == 0)
+	{
+		std::random_device RandomDevice;
+		NonceSeed = (static_cast<uint64_t>(RandomDevice()) << 32) | RandomDevice();
+	}
+
+	// NOTE: Random high bits tell clients apart, low bits count messages sent by this one
+	m_NextNonce = (NonceSeed & 0xFFFFFFFF00000000ull) | 1;
+}
+
+// ***********
+// * GETTERS *
+// ***********
+size_t OutboundQueue::GetPendingCount() const
+{
+	return m_Entries.size();
+}
+
+bool OutboundQueue::IsPending(uint64_t Nonce) const
+{
+	return m_Entries.find(Nonce) != m_Entries.end();
+}
+
+// **********
+// * PUBLIC *
+// **********
+void OutboundQueue::SetTransport(OutboundTransport Transport)
+{
+	m_Transport = std::move(Transport);
+	m_BlockedUntil = 0.0;
+}
+
+void OutboundQueue::SetOnAcknowledged(std::function<void(const Message &AcknowledgedMessage)> OnAcknowledged)
+{
+	m_OnAcknowledged = std::move(OnAcknowledged);
+}
+
+uint64_t OutboundQueue::Enqueue(Message &NewMessage, double Now)
+{
+	NewMessage.Nonce = m_NextNonce++;
+	NewMessage.Sequence = 0;
+
+	Entry QueuedEntry = {};
+	QueuedEntry.Value = NewMessage;
+	QueuedEntry.QueuedAt = Now;
+	m_Entries.emplace(NewMessage.Nonce, std::move(QueuedEntry));
+
+	return NewMessage.Nonce;
+}
+
+void OutboundQueue::Requeue(const Message &PendingMessage, double Now)
+{
+	// NOTE: Nonces assigned from now on follow it so the map keeps the sending order
+	m_NextNonce = std::max(m_NextNonce, PendingMessage.Nonce + 1);
+
+	Entry QueuedEntry = {};
+	QueuedEntry.Value = PendingMessage;
+	QueuedEntry.QueuedAt = Now;
+	m_Entries.emplace(PendingMessage.Nonce, std::move(QueuedEntry));
+}
+
+double OutboundQueue::Update(double Now)
+{
+	// NOTE: Nothing can be sent before a transport is set, SetTransport is followed by an Update
+	if (m_Entries.empty() || !m_Transport)
+		return -1.0;
+
+	if (Now >= m_BlockedUntil)
+		SendBatch(Now);
+
+	double NextUpdateAt = -1.0;
+	for (const auto &[Nonce, QueuedEntry] : m_Entries)
+	{
+		const double DUE_AT = std::max(GetDueAt(QueuedEntry), m_BlockedUntil);
+		if (NextUpdateAt < 0.0 || DUE_AT < NextUpdateAt)
+			NextUpdateAt = DUE_AT;
+	}
+
+	return NextUpdateAt;
+}
+
+void OutboundQueue::Resend()
+{
+	for (auto &[Nonce, QueuedEntry] : m_Entries)
+	{
+		QueuedEntry.SentAt = -1.0;
+		QueuedEntry.QueuedAt = 0.0;
+		QueuedEntry.RetryInterval = OUTBOUND_QUEUE_RETRY_INTERVAL;
+	}
+	m_BlockedUntil = 0.0;
+}
+
+bool OutboundQueue::Acknowledge(const MessageAcknowledgement &Acknowledgement, Message &AcknowledgedMessage)
+{
+	auto Iterator = m_Entries.find(Acknowledgement.Nonce);
+	if (Iterator == m_Entries.end())
+		return false;
+
+	AcknowledgedMessage = std::move(Iterator->second.Value);
+	AcknowledgedMessage.ID = Acknowledgement.MessageID;
+	AcknowledgedMessage.Sequence = Acknowledgement.Sequence;
+	m_Entries.erase(Iterator);
+
+	return true;
+}
+
+bool OutboundQueue::ReadAcknowledgements(std::string_view Payload)
+{
+	if (!DecodeAcknowledgementsFrame(Payload, m_Acknowledgements))
+	{
+		// Handles malformed frame error
+		return false;
+	}
+
+	for (const MessageAcknowledgement &Acknowledgement : m_Acknowledgements)
+	{
+		Message AcknowledgedMessage = {};
+		if (Acknowledge(Acknowledgement, AcknowledgedMessage) && m_OnAcknowledged)
+			m_OnAcknowledged(AcknowledgedMessage);
+	}
+
+	return true;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+double OutboundQueue::GetDueAt(const Entry &QueuedEntry) const
+{
+	if (QueuedEntry.SentAt < 0.0)
+		return QueuedEntry.QueuedAt + OUTBOUND_QUEUE_BATCH_WINDOW;
+
+	return QueuedEntry.SentAt + QueuedEntry.RetryInterval;
+}
+
+bool OutboundQueue::SendBatch(double Now)
+{
+	// Waits for the batch window of the oldest new message unless a retry is due or the batch is already full
+	bool IsBatchDue = false;
+	size_t NewMessagesCount = 0;
+	for (const auto &[Nonce, QueuedEntry] : m_Entries)
+	{
+		if (QueuedEntry.SentAt < 0.0)
+			NewMessagesCount++;
+		if (GetDueAt(QueuedEntry) <= Now)
+			IsBatchDue = true;
+	}
+	if (!IsBatchDue && NewMessagesCount < OUTBOUND_QUEUE_MAX_BATCH_SIZE)
+		return true;
+
+	// NOTE: Messages not due yet ride along with the ones that are, they would be sent within the window anyway
+	m_Batch.clear();
+	m_BatchEntries.clear();
+	m_Frame.clear();
+	for (auto &[Nonce, QueuedEntry] : m_Entries)
+	{
+		if (QueuedEntry.SentAt >= 0.0 && GetDueAt(QueuedEntry) > Now)
+			continue;
+
+		m_Batch.push_back(&QueuedEntry.Value);
+		m_BatchEntries.push_back(&QueuedEntry);
+		if (m_Batch.size() == OUTBOUND_QUEUE_MAX_BATCH_SIZE)
+		{
+			EncodeSendMessagesFrame(m_Batch, m_Frame);
+			m_Batch.clear();
+		}
+	}
+	if (!m_Batch.empty())
+		EncodeSendMessagesFrame(m_Batch, m_Frame);
+
+	if (!m_Transport(m_Frame))
+	{
+		// Handles send failure error, everything is retried once the connection had time to recover
+		m_BlockedUntil = Now + OUTBOUND_QUEUE_RETRY_INTERVAL;
+		return false;
+	}
+
+	for (Entry *SentEntry : m_BatchEntries)
+	{
+		if (SentEntry->SentAt >= 0.0)
+			SentEntry->RetryInterval = std::min(SentEntry->RetryInterval * 2.0, OUTBOUND_QUEUE_MAX_RETRY_INTERVAL);
+		SentEntry->SentAt = Now;
+	}
+
+	return true;
+}
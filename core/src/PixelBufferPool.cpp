@@ -0,0 +1,116 @@
+#include "PixelBufferPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+PixelBufferPool &PixelBufferPool::GetInstance()
+{
+	static PixelBufferPool Instance;
+	return Instance;
+}
+
+PixelBufferPool::~PixelBufferPool()
+{
+	for (BufferHeader *Header : m_FreeBuffers)
+	{
+		std::free(Header);
+	}
+}
+
+// ***********
+// * GETTERS *
+// ***********
+size_t PixelBufferPool::GetFreeBuffersCount() const
+{
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+	return m_FreeBuffers.size();
+}
+
+// **********
+// * PUBLIC *
+// **********
+void *PixelBufferPool::Allocate(size_t Size)
+{
+	if (Size >= PIXEL_BUFFER_POOL_MIN_BUFFER_SIZE)
+	{
+		std::lock_guard<std::mutex> Lock(m_Mutex);
+
+		// Picks the smallest free buffer that is large enough
+		auto BestIterator = m_FreeBuffers.end();
+		for (auto Iterator = m_FreeBuffers.begin(); Iterator != m_FreeBuffers.end(); Iterator++)
+		{
+			if ((*Iterator)->Capacity < Size)
+				continue;
+			if (BestIterator == m_FreeBuffers.end() || (*Iterator)->Capacity < (*BestIterator)->Capacity)
+				BestIterator = Iterator;
+		}
+
+		if (BestIterator != m_FreeBuffers.end())
+		{
+			BufferHeader *Header = *BestIterator;
+			m_FreeBuffers.erase(BestIterator);
+			return Header + 1;
+		}
+	}
+
+	BufferHeader *Header = static_cast<BufferHeader *>(std::malloc(sizeof(BufferHeader) + Size));
+	if (!Header)
+	{
+		// Handles out of memory error, stb reports the decode as failed
+		return nullptr;
+	}
+
+	Header->Capacity = Size;
+	return Header + 1;
+}
+
+void *PixelBufferPool::Reallocate(void *Buffer, size_t Size)
+{
+	if (!Buffer)
+		return Allocate(Size);
+
+	const BufferHeader *Header = static_cast<BufferHeader *>(Buffer) - 1;
+	if (Header->Capacity >= Size)
+		return Buffer;
+
+	void *NewBuffer = Allocate(Size);
+	if (!NewBuffer)
+		return nullptr;
+
+	std::memcpy(NewBuffer, Buffer, Header->Capacity);
+	Free(Buffer);
+	return NewBuffer;
+}
+
+void PixelBufferPool::Free(void *Buffer)
+{
+	if (!Buffer)
+		return;
+
+	BufferHeader *Header = static_cast<BufferHeader *>(Buffer) - 1;
+	if (Header->Capacity < PIXEL_BUFFER_POOL_MIN_BUFFER_SIZE)
+	{
+		std::free(Header);
+		return;
+	}
+
+	std::lock_guard<std::mutex> Lock(m_Mutex);
+
+	// NOTE: Drops the smallest buffer when the pool is full to keep pooled memory bounded
+	if (m_FreeBuffers.size() >= PIXEL_BUFFER_POOL_MAX_BUFFERS_COUNT)
+	{
+		auto SmallestIterator = std::min_element(
+		    m_FreeBuffers.begin(), m_FreeBuffers.end(),
+		    [](const BufferHeader *First, const BufferHeader *Second) { return First->Capacity < Second->Capacity; });
+		if ((*SmallestIterator)->Capacity >= Header->Capacity)
+		{
+			std::free(Header);
+			return;
+		}
+		std::free(*SmallestIterator);
+		m_FreeBuffers.erase(SmallestIterator);
+	}
+
+	m_FreeBuffers.push_back(Header);
+}
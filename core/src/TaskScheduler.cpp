@@ -0,0 +1,250 @@
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+// NOTE: Set on worker threads, tells Push which deque is the caller's own
+thread_local const TaskScheduler *CurrentScheduler = nullptr;
+thread_local size_t CurrentWorkerIndex = 0;
+} // namespace
+
+TaskScheduler::TaskScheduler(size_t WorkersCount)
+{
+	if (WorkersCount == 0)
+		WorkersCount = std::max(1u, std::thread::hardware_concurrency());
+
+	for (size_t i = 0; i < WorkersCount; i++)
+	{
+		m_Workers.push_back(std::make_unique<Worker>());
+	}
+	// NOTE: Started once every worker exists since any of them may be stolen from
+	for (size_t i = 0; i < WorkersCount; i++)
+	{
+		m_Workers[i]->Thread = std::thread(&TaskScheduler::RunWorker, this, i);
+	}
+}
+
+// NOTE: Tasks still queued are run before the workers stop
+TaskScheduler::~TaskScheduler()
+{
+	{
+		std::lock_guard<std::mutex> Lock(m_SleepMutex);
+		m_IsStopping = true;
+	}
+	m_SleepCondition.notify_all();
+
+	for (std::unique_ptr<Worker> &CurrentWorker : m_Workers)
+	{
+		CurrentWorker->Thread.join();
+	}
+}
+
+// ***********
+// * GETTERS *
+// ***********
+bool TaskHandle::IsValid() const
+{
+	return m_State != nullptr;
+}
+
+// NOTE: An invalid handle refers to no task, so there is nothing left to run
+bool TaskHandle::IsDone() const
+{
+	if (!IsValid())
+		return true;
+
+	std::lock_guard<std::mutex> Lock(m_State->Mutex);
+	return m_State->IsDone;
+}
+
+size_t TaskScheduler::GetWorkersCount() const
+{
+	return m_Workers.size();
+}
+
+uint64_t TaskScheduler::GetStolenCount() const
+{
+	return m_StolenCount.load(std::memory_order_relaxed);
+}
+
+// **********
+// * PUBLIC *
+// **********
+void TaskHandle::Wait() const
+{
+	if (!IsValid())
+		return;
+
+	std::unique_lock<std::mutex> Lock(m_State->Mutex);
+	m_State->Condition.wait(Lock, [this]() { return m_State->IsDone; });
+}
+
+TaskHandle TaskScheduler::Submit(TaskFunction Function, TaskPriority Priority)
+{
+	TaskHandle Handle;
+	Handle.m_State = std::make_shared<TaskState>();
+	m_PendingCount++;
+
+	Push(Task{Handle.m_State, std::move(Function)}, Priority);
+	return Handle;
+}
+
+TaskHandle TaskScheduler::Then(const TaskHandle &Previous, TaskFunction Function, TaskPriority Priority)
+{
+	// Handles invalid previous handle, there is nothing to wait for
+	if (!Previous.IsValid())
+		return Submit(std::move(Function), Priority);
+
+	TaskHandle Handle;
+	Handle.m_State = std::make_shared<TaskState>();
+	m_PendingCount++;
+
+	{
+		std::lock_guard<std::mutex> Lock(Previous.m_State->Mutex);
+		if (!Previous.m_State->IsDone)
+		{
+			Previous.m_State->Continuations.push_back(TaskContinuation{Handle.m_State, std::move(Function), Priority});
+			return Handle;
+		}
+	}
+
+	Push(Task{Handle.m_State, std::move(Function)}, Priority);
+	return Handle;
+}
+
+void TaskScheduler::WaitIdle()
+{
+	std::unique_lock<std::mutex> Lock(m_SleepMutex);
+	m_IdleCondition.wait(Lock, [this]() { return m_PendingCount.load() == 0; });
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+size_t TaskScheduler::GetQueuedCount() const
+{
+	size_t QueuedCount = 0;
+	for (const std::atomic<size_t> &LaneQueuedCount : m_QueuedCounts)
+	{
+		QueuedCount += LaneQueuedCount.load();
+	}
+	return QueuedCount;
+}
+
+void TaskScheduler::Push(Task NewTask, TaskPriority Priority)
+{
+	const size_t WORKER_INDEX =
+	    CurrentScheduler == this ? CurrentWorkerIndex : m_NextWorker.fetch_add(1, std::memory_order_relaxed) % m_Workers.size();
+	const size_t LANE = static_cast<size_t>(Priority);
+
+	// NOTE: Counted before it is pushed so the count never goes below the tasks in the deques
+	m_QueuedCounts[LANE]++;
+	Worker &Owner = *m_Workers[WORKER_INDEX];
+	{
+		std::lock_guard<std::mutex> Lock(Owner.Mutex);
+		Owner.Lanes[LANE].push_back(std::move(NewTask));
+	}
+
+	// NOTE: Sleeping workers check the queued counts after counting themselves as sleeping, so either they see this
+	// task or this sees them
+	if (m_SleepingCount.load() > 0)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(m_SleepMutex);
+		}
+		m_SleepCondition.notify_one();
+	}
+}
+
+bool TaskScheduler::Pop(size_t WorkerIndex, Task &NextTask)
+{
+	for (size_t Lane = 0; Lane < TASK_PRIORITIES_COUNT; Lane++)
+	{
+		if (m_QueuedCounts[Lane].load(std::memory_order_relaxed) == 0)
+			continue;
+
+		// Takes the newest task of its own deque first
+		{
+			Worker &Owner = *m_Workers[WorkerIndex];
+			std::lock_guard<std::mutex> Lock(Owner.Mutex);
+			if (!Owner.Lanes[Lane].empty())
+			{
+				NextTask = std::move(Owner.Lanes[Lane].back());
+				Owner.Lanes[Lane].pop_back();
+				m_QueuedCounts[Lane]--;
+				return true;
+			}
+		}
+
+		// Steals the oldest task of the next worker that has one
+		for (size_t i = 1; i < m_Workers.size(); i++)
+		{
+			Worker &Victim = *m_Workers[(WorkerIndex + i) % m_Workers.size()];
+			std::lock_guard<std::mutex> Lock(Victim.Mutex);
+			if (Victim.Lanes[Lane].empty())
+				continue;
+
+			NextTask = std::move(Victim.Lanes[Lane].front());
+			Victim.Lanes[Lane].pop_front();
+			m_QueuedCounts[Lane]--;
+			m_StolenCount.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void TaskScheduler::Run(Task &CurrentTask)
+{
+	CurrentTask.Function();
+	CurrentTask.Function = nullptr;
+
+	std::vector<TaskContinuation> Continuations;
+	{
+		std::lock_guard<std::mutex> Lock(CurrentTask.State->Mutex);
+		CurrentTask.State->IsDone = true;
+		Continuations.swap(CurrentTask.State->Continuations);
+	}
+	CurrentTask.State->Condition.notify_all();
+
+	// NOTE: Pushed to this worker's deque so they run next, on the data the task just produced
+	for (TaskContinuation &Continuation : Continuations)
+	{
+		Push(Task{std::move(Continuation.State), std::move(Continuation.Function)}, Continuation.Priority);
+	}
+
+	if (--m_PendingCount == 0)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(m_SleepMutex);
+		}
+		m_IdleCondition.notify_all();
+	}
+}
+
+void TaskScheduler::RunWorker(size_t WorkerIndex)
+{
+	CurrentScheduler = this;
+	CurrentWorkerIndex = WorkerIndex;
+
+	Task NextTask;
+	while (true)
+	{
+		if (Pop(WorkerIndex, NextTask))
+		{
+			Run(NextTask);
+			NextTask = {};
+			continue;
+		}
+
+		std::unique_lock<std::mutex> Lock(m_SleepMutex);
+		if (m_IsStopping && GetQueuedCount() == 0)
+			return;
+
+		m_SleepingCount++;
+		m_SleepCondition.wait(Lock, [this]() { return m_IsStopping || GetQueuedCount() > 0; });
+		m_SleepingCount--;
+	}
+}
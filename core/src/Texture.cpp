@@ -1,6 +1,12 @@
 #include "Texture.h"
 
+#include "PixelBufferPool.h"
+
 #include <GLAD/glad.h>
+// NOTE: Every stb allocation goes through the pool so decoded pixels land in recycled buffers
+#define STBI_MALLOC(Size) PixelBufferPool::GetInstance().Allocate(Size)
+#define STBI_REALLOC(Buffer, Size) PixelBufferPool::GetInstance().Reallocate(Buffer, Size)
+#define STBI_FREE(Buffer) PixelBufferPool::GetInstance().Free(Buffer)
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
@@ -22,8 +28,6 @@ unsigned int Texture::GetUnit() const
 // **********
 void Texture::Load(const std::string &FilePath, const unsigned int Unit)
 {
-	m_Unit = Unit;
-
 	int Width = 0;
 	int Height = 0;
 	int ChannelsCount = 0;
@@ -32,17 +36,20 @@ void Texture::Load(const std::string &FilePath, const unsigned int Unit)
 	if (!ImageRawData)
 	{
 		// Handles image load failure error
+		m_Unit = Unit;
 		return;
 	}
 
-	glGenTextures(1, &m_ID);
-	Bind();
+	LoadFromPixels(ImageRawData, Width, Height, ChannelsCount, Unit);
 
-	// Sets texture wrapping and filtering options
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	// Frees the image data from CPU memory
+	stbi_image_free(ImageRawData);
+}
+
+void Texture::LoadFromPixels(const unsigned char *Pixels, int Width, int Height, int ChannelsCount,
+                             const unsigned int Unit)
+{
+	m_Unit = Unit;
 
 	// Determines the format based on the number of channels
 	GLenum Format = 0;
@@ -55,18 +62,28 @@ void Texture::Load(const std::string &FilePath, const unsigned int Unit)
 	else
 	{
 		// Handles unsupported format error
-		stbi_image_free(ImageRawData);
 		return;
 	}
 
+	glGenTextures(1, &m_ID);
+	Bind();
+
+	// Sets texture wrapping and filtering options
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// NOTE: Rows of 1 and 3 channel images are not 4 bytes aligned
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
 	// Uploads the image data to the GPU
 	glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(Format), Width, Height, 0, static_cast<GLint>(Format),
-	             GL_UNSIGNED_BYTE, ImageRawData);
+	             GL_UNSIGNED_BYTE, Pixels);
 	// Generates mipmaps
 	glGenerateMipmap(GL_TEXTURE_2D);
 
-	// Frees the image data from CPU memory
-	stbi_image_free(ImageRawData);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 	Unbind();
 }
 
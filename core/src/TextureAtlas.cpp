@@ -0,0 +1,283 @@
+#include "TextureAtlas.h"
+
+#include <GLAD/glad.h>
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <imgui/imstb_rectpack.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <unordered_map>
+
+constexpr size_t TEXTURE_ATLAS_BYTES_PER_PIXEL = 4;
+
+struct TextureAtlas::Rect
+{
+	int X = 0;
+	int Y = 0;
+	int Width = 0;
+	int Height = 0;
+};
+
+struct TextureAtlas::Page
+{
+	unsigned int TextureID = 0;
+	stbrp_context Context = {};
+	// NOTE: Skyline nodes used by stb_rect_pack, kept alive for every incremental pack
+	std::vector<stbrp_node> Nodes;
+	// NOTE: Space of removed images, neighbours sharing a whole edge are merged
+	std::vector<Rect> FreeRects;
+	// NOTE: Keyed by image position, a reused free rectangle may be larger than the image it holds
+	std::unordered_map<int, Rect> ImageRects;
+};
+
+TextureAtlas::TextureAtlas(int PageSize) : m_PageSize(PageSize)
+{
+}
+
+TextureAtlas::~TextureAtlas() = default;
+
+// ***********
+// * GETTERS *
+// ***********
+int TextureAtlas::GetPageSize() const
+{
+	return m_PageSize;
+}
+
+size_t TextureAtlas::GetPagesCount() const
+{
+	return m_Pages.size();
+}
+
+size_t TextureAtlas::GetUsedBytes() const
+{
+	return m_Pages.size() * static_cast<size_t>(m_PageSize) * static_cast<size_t>(m_PageSize) *
+	       TEXTURE_ATLAS_BYTES_PER_PIXEL;
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool TextureAtlas::Add(const unsigned char *RgbaPixels, int Width, int Height, TextureRegion &Region)
+{
+	const int PADDED_WIDTH = Width + TEXTURE_ATLAS_PADDING * 2;
+	const int PADDED_HEIGHT = Height + TEXTURE_ATLAS_PADDING * 2;
+	if (Width <= 0 || Height <= 0 || PADDED_WIDTH > m_PageSize || PADDED_HEIGHT > m_PageSize)
+	{
+		// Handles image too big for a page error
+		return false;
+	}
+
+	// NOTE: Newest page first, older pages are most likely full
+	Rect PageRect = {};
+	for (auto Iterator = m_Pages.rbegin(); Iterator != m_Pages.rend(); Iterator++)
+	{
+		if (!TakeFreeRect(**Iterator, PADDED_WIDTH, PADDED_HEIGHT, PageRect))
+			continue;
+
+		AddToPage(**Iterator, PageRect, RgbaPixels, Width, Height, Region);
+		return true;
+	}
+
+	// Packs image after the skyline when no removed image left enough space
+	stbrp_rect PackedRect = {};
+	PackedRect.w = PADDED_WIDTH;
+	PackedRect.h = PADDED_HEIGHT;
+	for (auto Iterator = m_Pages.rbegin(); Iterator != m_Pages.rend(); Iterator++)
+	{
+		stbrp_pack_rects(&(*Iterator)->Context, &PackedRect, 1);
+		if (!PackedRect.was_packed)
+			continue;
+
+		AddToPage(**Iterator, Rect{PackedRect.x, PackedRect.y, PADDED_WIDTH, PADDED_HEIGHT}, RgbaPixels, Width, Height,
+		          Region);
+		return true;
+	}
+
+	Page *NewPage = AddPage();
+	stbrp_pack_rects(&NewPage->Context, &PackedRect, 1);
+	AddToPage(*NewPage, Rect{PackedRect.x, PackedRect.y, PADDED_WIDTH, PADDED_HEIGHT}, RgbaPixels, Width, Height,
+	          Region);
+	return true;
+}
+
+void TextureAtlas::Remove(const TextureRegion &Region)
+{
+	auto Iterator = std::find_if(m_Pages.begin(), m_Pages.end(), [&Region](const std::unique_ptr<Page> &AtlasPage) {
+		return AtlasPage->TextureID == Region.TextureID;
+	});
+	if (Iterator == m_Pages.end())
+	{
+		// Handles region not in atlas error
+		return;
+	}
+
+	// NOTE: UVs were computed from whole pixels, rounding converts them back exactly
+	Page &AtlasPage = **Iterator;
+	const float PAGE_SIZE = static_cast<float>(m_PageSize);
+	const int X = static_cast<int>(std::lround(Region.UvMin.X * PAGE_SIZE));
+	const int Y = static_cast<int>(std::lround(Region.UvMin.Y * PAGE_SIZE));
+	const int WIDTH = static_cast<int>(std::lround(Region.UvMax.X * PAGE_SIZE)) - X;
+	const int HEIGHT = static_cast<int>(std::lround(Region.UvMax.Y * PAGE_SIZE)) - Y;
+
+	auto RectIterator = AtlasPage.ImageRects.find(Y * m_PageSize + X);
+	if (RectIterator == AtlasPage.ImageRects.end())
+	{
+		// Handles region already removed error
+		return;
+	}
+	const Rect IMAGE_RECT = RectIterator->second;
+	AtlasPage.ImageRects.erase(RectIterator);
+
+	if (AtlasPage.ImageRects.empty())
+	{
+		glDeleteTextures(1, &AtlasPage.TextureID);
+		m_Pages.erase(Iterator);
+		return;
+	}
+
+	// Clears removed image
+	m_TransparentPixels.resize(static_cast<size_t>(WIDTH) * static_cast<size_t>(HEIGHT) *
+	                           TEXTURE_ATLAS_BYTES_PER_PIXEL);
+	glBindTexture(GL_TEXTURE_2D, AtlasPage.TextureID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, X, Y, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, m_TransparentPixels.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	AddFreeRect(AtlasPage, IMAGE_RECT);
+}
+
+void TextureAtlas::Destroy()
+{
+	for (const std::unique_ptr<Page> &AtlasPage : m_Pages)
+	{
+		glDeleteTextures(1, &AtlasPage->TextureID);
+	}
+	m_Pages.clear();
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+TextureAtlas::Page *TextureAtlas::AddPage()
+{
+	std::unique_ptr<Page> NewPage = std::make_unique<Page>();
+	NewPage->Nodes.resize(static_cast<size_t>(m_PageSize));
+	stbrp_init_target(&NewPage->Context, m_PageSize, m_PageSize, NewPage->Nodes.data(),
+	                  static_cast<int>(NewPage->Nodes.size()));
+
+	glGenTextures(1, &NewPage->TextureID);
+	glBindTexture(GL_TEXTURE_2D, NewPage->TextureID);
+
+	// NOTE: No mipmaps, they would blend neighbouring images together
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// Clears page to transparent so padding stays empty
+	const std::vector<unsigned char> TRANSPARENT_PIXELS(
+	    static_cast<size_t>(m_PageSize) * m_PageSize * TEXTURE_ATLAS_BYTES_PER_PIXEL, 0);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_PageSize, m_PageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+	             TRANSPARENT_PIXELS.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	m_Pages.push_back(std::move(NewPage));
+	return m_Pages.back().get();
+}
+
+void TextureAtlas::AddToPage(Page &AtlasPage, const Rect &PageRect, const unsigned char *RgbaPixels, int Width,
+                             int Height, TextureRegion &Region)
+{
+	const int X = PageRect.X + TEXTURE_ATLAS_PADDING;
+	const int Y = PageRect.Y + TEXTURE_ATLAS_PADDING;
+	AtlasPage.ImageRects[Y * m_PageSize + X] = PageRect;
+
+	// Uploads image into its rectangle
+	glBindTexture(GL_TEXTURE_2D, AtlasPage.TextureID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, X, Y, Width, Height, GL_RGBA, GL_UNSIGNED_BYTE, RgbaPixels);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	const float PAGE_SIZE = static_cast<float>(m_PageSize);
+	Region.TextureID = AtlasPage.TextureID;
+	Region.UvMin = Vector2(static_cast<float>(X) / PAGE_SIZE, static_cast<float>(Y) / PAGE_SIZE);
+	Region.UvMax = Vector2(static_cast<float>(X + Width) / PAGE_SIZE, static_cast<float>(Y + Height) / PAGE_SIZE);
+}
+
+bool TextureAtlas::TakeFreeRect(Page &AtlasPage, int Width, int Height, Rect &PageRect)
+{
+	// Picks the smallest free rectangle holding the image
+	size_t BestIndex = AtlasPage.FreeRects.size();
+	long long BestArea = LLONG_MAX;
+	for (size_t i = 0; i < AtlasPage.FreeRects.size(); i++)
+	{
+		const Rect &FreeRect = AtlasPage.FreeRects[i];
+		const long long AREA = static_cast<long long>(FreeRect.Width) * FreeRect.Height;
+		if (FreeRect.Width >= Width && FreeRect.Height >= Height && AREA < BestArea)
+		{
+			BestIndex = i;
+			BestArea = AREA;
+		}
+	}
+	if (BestIndex == AtlasPage.FreeRects.size())
+		return false;
+
+	const Rect FREE_RECT = AtlasPage.FreeRects[BestIndex];
+	AtlasPage.FreeRects[BestIndex] = AtlasPage.FreeRects.back();
+	AtlasPage.FreeRects.pop_back();
+	PageRect = Rect{FREE_RECT.X, FREE_RECT.Y, Width, Height};
+
+	// Splits the leftover along its longer side so the bigger part stays in one piece
+	const int RIGHT_WIDTH = FREE_RECT.Width - Width;
+	const int BOTTOM_HEIGHT = FREE_RECT.Height - Height;
+	const bool IS_RIGHT_FULL_HEIGHT = RIGHT_WIDTH > BOTTOM_HEIGHT;
+	if (RIGHT_WIDTH > 0)
+	{
+		AddFreeRect(AtlasPage, Rect{FREE_RECT.X + Width, FREE_RECT.Y, RIGHT_WIDTH,
+		                            IS_RIGHT_FULL_HEIGHT ? FREE_RECT.Height : Height});
+	}
+	if (BOTTOM_HEIGHT > 0)
+	{
+		AddFreeRect(AtlasPage, Rect{FREE_RECT.X, FREE_RECT.Y + Height, IS_RIGHT_FULL_HEIGHT ? Width : FREE_RECT.Width,
+		                            BOTTOM_HEIGHT});
+	}
+	return true;
+}
+
+void TextureAtlas::AddFreeRect(Page &AtlasPage, Rect PageRect)
+{
+	// Merges with free neighbours sharing a whole edge until none is left
+	bool IsMerged = true;
+	while (IsMerged)
+	{
+		IsMerged = false;
+		for (size_t i = 0; i < AtlasPage.FreeRects.size(); i++)
+		{
+			const Rect &FreeRect = AtlasPage.FreeRects[i];
+			const bool IS_STACKED = FreeRect.X == PageRect.X && FreeRect.Width == PageRect.Width &&
+			                        (FreeRect.Y + FreeRect.Height == PageRect.Y ||
+			                         PageRect.Y + PageRect.Height == FreeRect.Y);
+			const bool IS_SIDE_BY_SIDE = FreeRect.Y == PageRect.Y && FreeRect.Height == PageRect.Height &&
+			                             (FreeRect.X + FreeRect.Width == PageRect.X ||
+			                              PageRect.X + PageRect.Width == FreeRect.X);
+			if (!IS_STACKED && !IS_SIDE_BY_SIDE)
+				continue;
+
+			const int X = std::min(FreeRect.X, PageRect.X);
+			const int Y = std::min(FreeRect.Y, PageRect.Y);
+			PageRect = IS_STACKED ? Rect{X, Y, PageRect.Width, FreeRect.Height + PageRect.Height}
+			                      : Rect{X, Y, FreeRect.Width + PageRect.Width, PageRect.Height};
+			AtlasPage.FreeRects[i] = AtlasPage.FreeRects.back();
+			AtlasPage.FreeRects.pop_back();
+			IsMerged = true;
+			break;
+		}
+	}
+
+	AtlasPage.FreeRects.push_back(PageRect);
+}
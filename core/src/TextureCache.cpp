@@ -0,0 +1,145 @@
+#include "TextureCache.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+std::chrono::steady_clock::duration GetRetryDelay(uint32_t FailuresCount)
+{
+	const double BACKOFF_FACTOR = static_cast<double>(1u << std::min(FailuresCount, 16u));
+	const double DELAY_SECONDS =
+	    std::min(TEXTURE_CACHE_RETRY_MIN_DELAY_SECONDS * BACKOFF_FACTOR, TEXTURE_CACHE_RETRY_MAX_DELAY_SECONDS);
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(DELAY_SECONDS));
+}
+} // namespace
+
+TextureCache::TextureCache(size_t BudgetBytes, unsigned int WorkersCount, TextureFetcher Fetcher)
+    : m_BudgetBytes(BudgetBytes), m_Loader(WorkersCount, std::move(Fetcher))
+{
+	m_Loader.SetAtlas(&m_Atlas);
+}
+
+// ***********
+// * GETTERS *
+// ***********
+size_t TextureCache::GetBudgetBytes() const
+{
+	return m_BudgetBytes;
+}
+
+size_t TextureCache::GetUsedBytes() const
+{
+	return m_Loader.GetUsedBytes();
+}
+
+size_t TextureCache::GetSize() const
+{
+	return m_Entries.size();
+}
+
+// **********
+// * PUBLIC *
+// **********
+void TextureCache::SetBudgetBytes(size_t BudgetBytes)
+{
+	m_BudgetBytes = BudgetBytes;
+}
+
+void TextureCache::SetOnDecoded(std::function<void()> OnDecoded)
+{
+	m_Loader.SetOnDecoded(std::move(OnDecoded));
+}
+
+TextureRegion TextureCache::Get(const std::string &Url, const TextureRegion &PlaceholderRegion)
+{
+	if (Url.empty())
+		return PlaceholderRegion;
+
+	auto Iterator = m_EntriesByUrl.find(Url);
+	if (Iterator == m_EntriesByUrl.end())
+	{
+		Entry NewEntry = {};
+		NewEntry.Url = Url;
+		NewEntry.RequestID = m_Loader.Request(Url);
+		m_Entries.push_front(std::move(NewEntry));
+		Iterator = m_EntriesByUrl.emplace(Url, m_Entries.begin()).first;
+	}
+	else if (Iterator->second != m_Entries.begin())
+	{
+		m_Entries.splice(m_Entries.begin(), m_Entries, Iterator->second);
+	}
+
+	Entry &DrawnEntry = *Iterator->second;
+	DrawnEntry.LastDrawnFrame = m_Frame;
+
+	if (m_Loader.GetState(DrawnEntry.RequestID) == TextureRequestState::Failed)
+	{
+		// Retries the failed load once its delay is spent, the delay doubles on every failure
+		const auto NOW = std::chrono::steady_clock::now();
+		if (DrawnEntry.RetryTime == std::chrono::steady_clock::time_point{})
+		{
+			DrawnEntry.RetryTime = NOW + GetRetryDelay(DrawnEntry.FailuresCount);
+			DrawnEntry.FailuresCount++;
+		}
+		else if (NOW >= DrawnEntry.RetryTime)
+		{
+			m_Loader.Release(DrawnEntry.RequestID);
+			DrawnEntry.RequestID = m_Loader.Request(Url);
+			DrawnEntry.RetryTime = std::chrono::steady_clock::time_point{};
+		}
+	}
+
+	return m_Loader.GetTextureRegion(DrawnEntry.RequestID, PlaceholderRegion);
+}
+
+bool TextureCache::Upload(double TimeBudgetSeconds)
+{
+	return m_Loader.Upload(TimeBudgetSeconds);
+}
+
+void TextureCache::Trim()
+{
+	// Evicts from the least recently drawn end until the budget is met and no failed load is left
+	auto Iterator = m_Entries.end();
+	while ((m_Loader.GetUsedBytes() > m_BudgetBytes || m_Loader.GetFailedCount() > 0) && Iterator != m_Entries.begin())
+	{
+		Iterator--;
+
+		// NOTE: Everything in front was drawn this frame too, evicting it would only reload it next frame
+		if (Iterator->LastDrawnFrame == m_Frame)
+			break;
+
+		// NOTE: Within the budget only failed loads are evicted, they would otherwise stay forever at zero bytes
+		// They are kept until their retry delay is spent so a URL drawn again soon is not fetched again
+		if (m_Loader.GetUsedBytes() <= m_BudgetBytes)
+		{
+			if (m_Loader.GetState(Iterator->RequestID) != TextureRequestState::Failed)
+				continue;
+			if (Iterator->RetryTime == std::chrono::steady_clock::time_point{})
+			{
+				Iterator->RetryTime = std::chrono::steady_clock::now() + GetRetryDelay(Iterator->FailuresCount);
+				Iterator->FailuresCount++;
+			}
+			if (std::chrono::steady_clock::now() < Iterator->RetryTime)
+				continue;
+		}
+
+		// NOTE: Requests still decoding are skipped, they are evicted on a later frame once uploaded
+		if (!m_Loader.Release(Iterator->RequestID))
+			continue;
+
+		m_EntriesByUrl.erase(Iterator->Url);
+		Iterator = m_Entries.erase(Iterator);
+	}
+
+	m_Frame++;
+}
+
+void TextureCache::Destroy()
+{
+	m_Loader.Destroy();
+	m_Atlas.Destroy();
+	m_Entries.clear();
+	m_EntriesByUrl.clear();
+}
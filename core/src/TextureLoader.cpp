@@ -0,0 +1,342 @@
+#include "TextureLoader.h"
+
+#include <stb/stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <utility>
+
+constexpr unsigned int TEXTURE_LOADER_MAX_WORKERS_COUNT = 4;
+
+namespace
+{
+const std::string TEXTURE_LOADER_FILE_URL_PREFIX = "file://";
+
+// Reads file paths and file:// URLs, other schemes need a fetcher
+bool ReadFile(const std::string &Url, std::vector<unsigned char> &Bytes)
+{
+	std::string FilePath = Url;
+	if (FilePath.compare(0, TEXTURE_LOADER_FILE_URL_PREFIX.size(), TEXTURE_LOADER_FILE_URL_PREFIX) == 0)
+		FilePath.erase(0, TEXTURE_LOADER_FILE_URL_PREFIX.size());
+	else if (FilePath.find("://") != std::string::npos)
+		return false;
+
+	FILE *File = std::fopen(FilePath.c_str(), "rb");
+	if (!File)
+	{
+		// Handles file open failure error
+		return false;
+	}
+
+	std::fseek(File, 0, SEEK_END);
+	const long FILE_SIZE = std::ftell(File);
+	std::fseek(File, 0, SEEK_SET);
+	if (FILE_SIZE <= 0)
+	{
+		// Handles empty file error
+		std::fclose(File);
+		return false;
+	}
+
+	Bytes.resize(static_cast<size_t>(FILE_SIZE));
+	const size_t READ_SIZE = std::fread(Bytes.data(), 1, Bytes.size(), File);
+	std::fclose(File);
+	return READ_SIZE == Bytes.size();
+}
+} // namespace
+
+TextureLoader::TextureLoader(unsigned int WorkersCount, TextureFetcher Fetcher)
+    : m_Fetcher(Fetcher ? std::move(Fetcher) : TextureFetcher(ReadFile))
+{
+	if (WorkersCount == 0)
+	{
+		// NOTE: Leaves a core to the render thread
+		const unsigned int HARDWARE_CONCURRENCY = std::thread::hardware_concurrency();
+		WorkersCount = std::clamp(HARDWARE_CONCURRENCY > 1 ? HARDWARE_CONCURRENCY - 1 : 1, 1u,
+		                          TEXTURE_LOADER_MAX_WORKERS_COUNT);
+	}
+
+	for (unsigned int i = 0; i < WorkersCount; i++)
+	{
+		m_Workers.emplace_back(&TextureLoader::RunWorker, this);
+	}
+}
+
+TextureLoader::~TextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> Lock(m_JobsMutex);
+		m_IsStopping = true;
+	}
+	m_JobsCondition.notify_all();
+
+	for (std::thread &Worker : m_Workers)
+	{
+		Worker.join();
+	}
+}
+
+// ***********
+// * GETTERS *
+// ***********
+TextureRequestState TextureLoader::GetState(TextureRequestID ID) const
+{
+	if (ID >= m_Entries.size())
+		return TextureRequestState::Failed;
+
+	return m_Entries[ID].State;
+}
+
+unsigned int TextureLoader::GetTextureID(TextureRequestID ID, unsigned int PlaceholderTextureID) const
+{
+	if (ID >= m_Entries.size() || m_Entries[ID].State != TextureRequestState::Ready)
+		return PlaceholderTextureID;
+
+	return m_Entries[ID].Region.TextureID;
+}
+
+TextureRegion TextureLoader::GetTextureRegion(TextureRequestID ID, const TextureRegion &PlaceholderRegion) const
+{
+	if (ID >= m_Entries.size() || m_Entries[ID].State != TextureRequestState::Ready)
+		return PlaceholderRegion;
+
+	return m_Entries[ID].Region;
+}
+
+size_t TextureLoader::GetUsedBytes() const
+{
+	return m_UsedBytes + (m_Atlas ? m_Atlas->GetUsedBytes() : 0);
+}
+
+size_t TextureLoader::GetFailedCount() const
+{
+	return m_FailedCount;
+}
+
+// **********
+// * PUBLIC *
+// **********
+void TextureLoader::SetAtlas(TextureAtlas *Atlas)
+{
+	m_Atlas = Atlas;
+}
+
+void TextureLoader::SetOnDecoded(std::function<void()> OnDecoded)
+{
+	std::lock_guard<std::mutex> Lock(m_DecodedImagesMutex);
+	m_OnDecoded = std::move(OnDecoded);
+}
+
+TextureRequestID TextureLoader::Request(const std::string &Url)
+{
+	auto Iterator = m_IDsByUrl.find(Url);
+	if (Iterator != m_IDsByUrl.end())
+		return Iterator->second;
+
+	Entry NewEntry = {};
+	NewEntry.Url = Url;
+
+	// Reuses released IDs so the entries stay bounded by the number of live textures
+	TextureRequestID ID = TEXTURE_REQUEST_INVALID_ID;
+	if (!m_FreeIDs.empty())
+	{
+		ID = m_FreeIDs.back();
+		m_FreeIDs.pop_back();
+		m_Entries[ID] = std::move(NewEntry);
+	}
+	else
+	{
+		ID = static_cast<TextureRequestID>(m_Entries.size());
+		m_Entries.push_back(std::move(NewEntry));
+	}
+	m_IDsByUrl.emplace(Url, ID);
+
+	{
+		std::lock_guard<std::mutex> Lock(m_JobsMutex);
+		m_Jobs.push_back(Job{ID, m_Generation, Url});
+	}
+	m_JobsCondition.notify_one();
+
+	return ID;
+}
+
+bool TextureLoader::Upload(double TimeBudgetSeconds)
+{
+	const auto START_TIME = std::chrono::steady_clock::now();
+
+	while (true)
+	{
+		DecodedImage Image = {};
+		{
+			std::lock_guard<std::mutex> Lock(m_DecodedImagesMutex);
+			if (m_DecodedImages.empty())
+				return false;
+
+			Image = std::move(m_DecodedImages.front());
+			m_DecodedImages.pop_front();
+		}
+
+		if (Image.Generation != m_Generation || Image.ID >= m_Entries.size())
+		{
+			// Handles image of a destroyed request, its pixels go back to the pool
+			continue;
+		}
+
+		Entry &ImageEntry = m_Entries[Image.ID];
+		if (Image.IsValid)
+		{
+			const bool IS_PACKABLE = m_Atlas && Image.Width <= TEXTURE_ATLAS_MAX_IMAGE_SIZE &&
+			                         Image.Height <= TEXTURE_ATLAS_MAX_IMAGE_SIZE;
+			const bool IS_PACKED =
+			    IS_PACKABLE && m_Atlas->Add(Image.Pixels.get(), Image.Width, Image.Height, ImageEntry.Region);
+
+			// NOTE: Packed images are accounted for by the atlas pages holding them
+			if (!IS_PACKED)
+			{
+				ImageEntry.LoadedTexture.LoadFromPixels(Image.Pixels.get(), Image.Width, Image.Height,
+				                                        TEXTURE_LOADER_CHANNELS_COUNT, 0);
+				ImageEntry.Region = TextureRegion(ImageEntry.LoadedTexture.GetID());
+				ImageEntry.SizeInBytes = static_cast<size_t>(Image.Width) * static_cast<size_t>(Image.Height) *
+				                         TEXTURE_LOADER_CHANNELS_COUNT;
+			}
+			m_UsedBytes += ImageEntry.SizeInBytes;
+			ImageEntry.State = TextureRequestState::Ready;
+		}
+		else
+		{
+			ImageEntry.State = TextureRequestState::Failed;
+			m_FailedCount++;
+		}
+
+		Image.Pixels.reset();
+
+		// NOTE: Always uploads at least one image per call so the queue keeps draining on slow machines
+		const std::chrono::duration<double> ELAPSED_TIME = std::chrono::steady_clock::now() - START_TIME;
+		if (ELAPSED_TIME.count() >= TimeBudgetSeconds)
+			break;
+	}
+
+	std::lock_guard<std::mutex> Lock(m_DecodedImagesMutex);
+	return !m_DecodedImages.empty();
+}
+
+bool TextureLoader::Release(TextureRequestID ID)
+{
+	if (ID >= m_Entries.size())
+		return false;
+
+	Entry &ReleasedEntry = m_Entries[ID];
+	if (ReleasedEntry.State != TextureRequestState::Ready && ReleasedEntry.State != TextureRequestState::Failed)
+		return false;
+
+	if (ReleasedEntry.State == TextureRequestState::Ready)
+	{
+		if (ReleasedEntry.LoadedTexture.GetID() != 0)
+			ReleasedEntry.LoadedTexture.Destroy();
+		else if (m_Atlas)
+			m_Atlas->Remove(ReleasedEntry.Region);
+
+		m_UsedBytes -= ReleasedEntry.SizeInBytes;
+	}
+	else
+	{
+		m_FailedCount--;
+	}
+
+	m_IDsByUrl.erase(ReleasedEntry.Url);
+	ReleasedEntry = Entry{};
+	ReleasedEntry.State = TextureRequestState::Released;
+	m_FreeIDs.push_back(ID);
+
+	return true;
+}
+
+void TextureLoader::Destroy()
+{
+	// NOTE: Atlas pages are owned by the atlas, only standalone textures are destroyed here
+	for (Entry &LoadedEntry : m_Entries)
+	{
+		LoadedEntry.LoadedTexture.Destroy();
+	}
+	m_Entries.clear();
+	m_IDsByUrl.clear();
+	m_FreeIDs.clear();
+	m_UsedBytes = 0;
+	m_FailedCount = 0;
+	m_Generation++;
+
+	// Drops queued jobs and decoded images, a worker still decoding pushes an image of the old generation
+	{
+		std::lock_guard<std::mutex> Lock(m_JobsMutex);
+		m_Jobs.clear();
+	}
+	std::lock_guard<std::mutex> Lock(m_DecodedImagesMutex);
+	m_DecodedImages.clear();
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void TextureLoader::RunWorker()
+{
+	// NOTE: Reused for every image this worker fetches
+	std::vector<unsigned char> ImageBytes;
+
+	while (true)
+	{
+		Job DecodeJob = {};
+		{
+			std::unique_lock<std::mutex> Lock(m_JobsMutex);
+			m_JobsCondition.wait(Lock, [this]() {
+				return m_IsStopping || !m_Jobs.empty();
+			});
+			if (m_IsStopping)
+				return;
+
+			DecodeJob = std::move(m_Jobs.front());
+			m_Jobs.pop_front();
+		}
+
+		DecodedImage Image = Decode(DecodeJob, ImageBytes);
+
+		std::function<void()> OnDecoded;
+		{
+			std::lock_guard<std::mutex> Lock(m_DecodedImagesMutex);
+			m_DecodedImages.push_back(std::move(Image));
+			OnDecoded = m_OnDecoded;
+		}
+
+		if (OnDecoded)
+			OnDecoded();
+	}
+}
+
+TextureLoader::DecodedImage TextureLoader::Decode(const Job &DecodeJob, std::vector<unsigned char> &ImageBytes)
+{
+	DecodedImage Image = {};
+	Image.ID = DecodeJob.ID;
+	Image.Generation = DecodeJob.Generation;
+
+	// Fetches image
+	ImageBytes.clear();
+	if (!m_Fetcher(DecodeJob.Url, ImageBytes) || ImageBytes.empty())
+	{
+		// Handles fetch failure error
+		return Image;
+	}
+
+	// Decodes image
+	// NOTE: stb allocates through the pixel buffer pool, so the pixels are decoded straight into a pooled buffer
+	int ChannelsCount = 0;
+	Image.Pixels.reset(stbi_load_from_memory(ImageBytes.data(), static_cast<int>(ImageBytes.size()), &Image.Width,
+	                                         &Image.Height, &ChannelsCount, TEXTURE_LOADER_CHANNELS_COUNT));
+	if (!Image.Pixels)
+	{
+		// Handles image decode failure error
+		return Image;
+	}
+
+	Image.IsValid = true;
+	return Image;
+}
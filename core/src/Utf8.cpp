@@ -0,0 +1,297 @@
+#include "Utf8.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define UTF8_HAS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+constexpr char UTF8_REPLACEMENT_CHARACTER[] = "\xEF\xBF\xBD";
+
+bool IsContinuation(unsigned char Byte)
+{
+	return (Byte & 0xC0) == 0x80;
+}
+
+// NOTE: Returns the length of the sequence starting at Data, 0 when it is not valid
+size_t GetSequenceLength(const unsigned char *Data, size_t RemainingSize)
+{
+	const unsigned char LEAD = Data[0];
+	if (LEAD < 0x80)
+		return 1;
+
+	if (LEAD >= 0xC2 && LEAD <= 0xDF)
+		return RemainingSize >= 2 && IsContinuation(Data[1]) ? 2 : 0;
+
+	if (LEAD >= 0xE0 && LEAD <= 0xEF)
+	{
+		if (RemainingSize < 3 || !IsContinuation(Data[1]) || !IsContinuation(Data[2]))
+			return 0;
+		// Handles overlong and surrogate errors
+		if ((LEAD == 0xE0 && Data[1] < 0xA0) || (LEAD == 0xED && Data[1] > 0x9F))
+			return 0;
+		return 3;
+	}
+
+	if (LEAD >= 0xF0 && LEAD <= 0xF4)
+	{
+		if (RemainingSize < 4 || !IsContinuation(Data[1]) || !IsContinuation(Data[2]) || !IsContinuation(Data[3]))
+			return 0;
+		// Handles overlong and past U+10FFFF errors
+		if ((LEAD == 0xF0 && Data[1] < 0x90) || (LEAD == 0xF4 && Data[1] > 0x8F))
+			return 0;
+		return 4;
+	}
+
+	return 0;
+}
+
+bool IsValidScalar(const unsigned char *Data, size_t Size)
+{
+	size_t Offset = 0;
+	while (Offset < Size)
+	{
+		const size_t LENGTH = GetSequenceLength(Data + Offset, Size - Offset);
+		if (LENGTH == 0)
+			return false;
+		Offset += LENGTH;
+	}
+	return true;
+}
+
+#ifdef UTF8_HAS_X86_KERNELS
+// NOTE: Sequences are only ever entered at a character boundary, so a block of ASCII found at one can be skipped whole
+bool IsValidSse2(const unsigned char *Data, size_t Size)
+{
+	size_t Offset = 0;
+	while (Offset < Size)
+	{
+		if (Size - Offset >= 16)
+		{
+			const __m128i BLOCK = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Data + Offset));
+			if (_mm_movemask_epi8(BLOCK) == 0)
+			{
+				Offset += 16;
+				continue;
+			}
+		}
+
+		const size_t LENGTH = GetSequenceLength(Data + Offset, Size - Offset);
+		if (LENGTH == 0)
+			return false;
+		Offset += LENGTH;
+	}
+	return true;
+}
+
+// NOTE: Lookup algorithm of Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"
+// Every byte is classified from its high nibble, the nibbles of the byte before it and the high nibble of the byte
+// after it, each lookup returns the error kinds the nibble allows and an error remains when all three agree
+// Errors spanning 3 and 4 byte sequences are found by checking continuations are where the lead bytes expect them
+constexpr uint8_t UTF8_TOO_SHORT = 1 << 0;
+constexpr uint8_t UTF8_TOO_LONG = 1 << 1;
+constexpr uint8_t UTF8_OVERLONG_3 = 1 << 2;
+constexpr uint8_t UTF8_TOO_LARGE = 1 << 3;
+constexpr uint8_t UTF8_SURROGATE = 1 << 4;
+constexpr uint8_t UTF8_OVERLONG_2 = 1 << 5;
+constexpr uint8_t UTF8_TOO_LARGE_1000 = 1 << 6;
+constexpr uint8_t UTF8_OVERLONG_4 = 1 << 6;
+constexpr uint8_t UTF8_TWO_CONTINUATIONS = 1 << 7;
+constexpr uint8_t UTF8_CARRY = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTINUATIONS;
+
+__attribute__((target("avx2"))) __m256i LookupNibbles(__m256i Nibbles, const uint8_t (&Table)[16])
+{
+	const __m128i TABLE = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Table));
+	return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(TABLE), Nibbles);
+}
+
+__attribute__((target("avx2"))) __m256i GetHighNibbles(__m256i Bytes)
+{
+	return _mm256_and_si256(_mm256_srli_epi16(Bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+// NOTE: Bytes shifted right by Count across the two blocks, the first bytes come from the end of Previous
+template <int Count> __attribute__((target("avx2"))) __m256i GetPreviousBytes(__m256i Current, __m256i Previous)
+{
+	return _mm256_alignr_epi8(Current, _mm256_permute2x128_si256(Previous, Current, 0x21), 16 - Count);
+}
+
+__attribute__((target("avx2"))) __m256i CheckBlock(__m256i Current, __m256i Previous)
+{
+	static constexpr uint8_t BYTE_1_HIGH[16] = {
+	    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+	    UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS, UTF8_TWO_CONTINUATIONS,
+	    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+	    UTF8_TOO_SHORT,
+	    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+	    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+	};
+	static constexpr uint8_t BYTE_1_LOW[16] = {
+	    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+	    UTF8_CARRY | UTF8_OVERLONG_2,
+	    UTF8_CARRY,
+	    UTF8_CARRY,
+	    UTF8_CARRY | UTF8_TOO_LARGE,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	};
+	static constexpr uint8_t BYTE_2_HIGH[16] = {
+	    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+	    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+	    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTINUATIONS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	};
+
+	const __m256i PREVIOUS_1 = GetPreviousBytes<1>(Current, Previous);
+	const __m256i SPECIAL_CASES = _mm256_and_si256(
+	    _mm256_and_si256(LookupNibbles(GetHighNibbles(PREVIOUS_1), BYTE_1_HIGH),
+	                     LookupNibbles(_mm256_and_si256(PREVIOUS_1, _mm256_set1_epi8(0x0F)), BYTE_1_LOW)),
+	    LookupNibbles(GetHighNibbles(Current), BYTE_2_HIGH));
+
+	// NOTE: Only 111_____ and 1111____ leads stay at or above 0x80 after the subtraction
+	const __m256i IS_THIRD_BYTE = _mm256_subs_epu8(GetPreviousBytes<2>(Current, Previous), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+	const __m256i IS_FOURTH_BYTE = _mm256_subs_epu8(GetPreviousBytes<3>(Current, Previous), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+	const __m256i MUST_BE_CONTINUATION = _mm256_and_si256(_mm256_or_si256(IS_THIRD_BYTE, IS_FOURTH_BYTE), _mm256_set1_epi8(static_cast<char>(0x80)));
+
+	return _mm256_xor_si256(MUST_BE_CONTINUATION, SPECIAL_CASES);
+}
+
+// NOTE: Non-zero when the block ends inside a sequence, an error unless the next block completes it
+__attribute__((target("avx2"))) __m256i GetIncompleteSequences(__m256i Block)
+{
+	const __m256i MAX_COMPLETE = _mm256_setr_epi8(
+	    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+	return _mm256_subs_epu8(Block, MAX_COMPLETE);
+}
+
+__attribute__((target("avx2"))) void CheckNextBlock(__m256i Block, __m256i &Previous, __m256i &PreviousIncomplete, __m256i &Errors)
+{
+	if (_mm256_movemask_epi8(Block) == 0)
+	{
+		// NOTE: ASCII can not complete a sequence the previous block left open
+		Errors = _mm256_or_si256(Errors, PreviousIncomplete);
+	}
+	else
+	{
+		Errors = _mm256_or_si256(Errors, CheckBlock(Block, Previous));
+		PreviousIncomplete = GetIncompleteSequences(Block);
+	}
+	Previous = Block;
+}
+
+__attribute__((target("avx2"))) bool IsValidAvx2(const unsigned char *Data, size_t Size)
+{
+	__m256i Previous = _mm256_setzero_si256();
+	__m256i PreviousIncomplete = _mm256_setzero_si256();
+	__m256i Errors = _mm256_setzero_si256();
+
+	size_t Offset = 0;
+	for (; Offset + 32 <= Size; Offset += 32)
+	{
+		CheckNextBlock(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(Data + Offset)), Previous, PreviousIncomplete, Errors);
+	}
+	if (Offset < Size)
+	{
+		// NOTE: Padded with ASCII so the tail is checked as a whole block
+		alignas(32) unsigned char Tail[32] = {};
+		std::memcpy(Tail, Data + Offset, Size - Offset);
+		CheckNextBlock(_mm256_load_si256(reinterpret_cast<const __m256i *>(Tail)), Previous, PreviousIncomplete, Errors);
+	}
+	Errors = _mm256_or_si256(Errors, PreviousIncomplete);
+
+	return _mm256_testz_si256(Errors, Errors) != 0;
+}
+#endif
+} // namespace
+
+Utf8Kernel GetBestUtf8Kernel()
+{
+	static const Utf8Kernel BEST_KERNEL = IsUtf8KernelSupported(Utf8Kernel::Avx2)   ? Utf8Kernel::Avx2
+	                                      : IsUtf8KernelSupported(Utf8Kernel::Sse2) ? Utf8Kernel::Sse2
+	                                                                                : Utf8Kernel::Scalar;
+	return BEST_KERNEL;
+}
+
+bool IsUtf8KernelSupported(Utf8Kernel Kernel)
+{
+	switch (Kernel)
+	{
+	case Utf8Kernel::Scalar:
+		return true;
+#ifdef UTF8_HAS_X86_KERNELS
+	case Utf8Kernel::Sse2:
+		return __builtin_cpu_supports("sse2");
+	case Utf8Kernel::Avx2:
+		return __builtin_cpu_supports("avx2");
+#endif
+	default:
+		return false;
+	}
+}
+
+bool IsValidUtf8(std::string_view Text)
+{
+	return IsValidUtf8(Text, GetBestUtf8Kernel());
+}
+
+bool IsValidUtf8(std::string_view Text, Utf8Kernel Kernel)
+{
+	const unsigned char *DATA = reinterpret_cast<const unsigned char *>(Text.data());
+	switch (Kernel)
+	{
+#ifdef UTF8_HAS_X86_KERNELS
+	case Utf8Kernel::Sse2:
+		return IsValidSse2(DATA, Text.size());
+	case Utf8Kernel::Avx2:
+		return IsValidAvx2(DATA, Text.size());
+#endif
+	default:
+		return IsValidScalar(DATA, Text.size());
+	}
+}
+
+bool SanitizeUtf8(std::string &Text)
+{
+	if (IsValidUtf8(Text))
+		return false;
+
+	// NOTE: Invalid bytes are replaced one by one, a truncated sequence becomes as many replacement characters as it
+	// has bytes
+	std::string Sanitized;
+	Sanitized.reserve(Text.size() + 16);
+	const unsigned char *DATA = reinterpret_cast<const unsigned char *>(Text.data());
+	size_t Offset = 0;
+	while (Offset < Text.size())
+	{
+		const size_t LENGTH = GetSequenceLength(DATA + Offset, Text.size() - Offset);
+		if (LENGTH == 0)
+		{
+			Sanitized.append(UTF8_REPLACEMENT_CHARACTER);
+			Offset++;
+			continue;
+		}
+		Sanitized.append(Text, Offset, LENGTH);
+		Offset += LENGTH;
+	}
+
+	Text = std::move(Sanitized);
+	return true;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// NOTE: Total number of heap allocations made by the process since startup, ImGui allocations are always counted and
+// operator new only in executables linking GuiAllocationHooks
+uint64_t GetHeapAllocationCount();
+void CountHeapAllocation();
+// NOTE: True when GuiAllocationHooks is linked, otherwise only ImGui's allocations are counted
+bool IsOperatorNewCounted();
+void MarkOperatorNewCounted();
+
+// NOTE: Allocator functions handed to ImGui::SetAllocatorFunctions so ImGui's own allocations are counted too
+void* AllocateCounted(size_t Size, void* UserData);
+void FreeCounted(void* Pointer, void* UserData);
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Vector.h"
+
+#include <cstdint>
+#include <vector>
+
+using FlexNodeIndex = uint32_t;
+
+// NOTE: Created with the layout, every other node descends from it
+constexpr FlexNodeIndex FLEX_LAYOUT_ROOT = 0;
+
+enum class FlexDirection
+{
+    Row,
+    Column
+};
+
+// NOTE: Placement of children on the cross axis
+enum class FlexAlignment
+{
+    Start,
+    Center,
+    End,
+    Stretch
+};
+
+struct FlexNode
+{
+    // NOTE: How this node lays out its own children
+    FlexDirection Direction = FlexDirection::Column;
+    FlexAlignment Alignment = FlexAlignment::Stretch;
+    Vector2 Padding = Vector2(0.0f, 0.0f);
+    float Gap = 0.0f;
+
+    // NOTE: Fixed size on the parent's main axis, the space left after every basis and gap is shared by grow ratio
+    float Basis = 0.0f;
+    float Grow = 0.0f;
+    // NOTE: Size on the parent's cross axis, ignored when the parent stretches its children
+    float CrossSize = 0.0f;
+};
+
+struct FlexRect
+{
+    // NOTE: Relative to the origin of the space passed to Solve
+    Vector2 Position = Vector2(0.0f, 0.0f);
+    Vector2 Size = Vector2(0.0f, 0.0f);
+};
+
+// NOTE: Row and column layout solved once and cached, Solve only does work when the available space changed or a node
+// was edited, so drawing a frame just reads back rectangles
+class FlexLayout
+{
+public:
+    FlexLayout();
+
+    FlexNodeIndex Add(FlexNodeIndex Parent, const FlexNode& Node);
+    // NOTE: Marks the layout dirty, the next Solve recomputes every rectangle
+    FlexNode* Edit(FlexNodeIndex Index);
+
+    const FlexNode& Get(FlexNodeIndex Index) const;
+    const FlexRect& GetRect(FlexNodeIndex Index) const;
+    uint64_t GetSolveCount() const;
+
+    // NOTE: Returns true when rectangles were recomputed
+    bool Solve(Vector2 AvailableSpace);
+
+private:
+    struct Entry
+    {
+        FlexNode Node;
+        FlexRect Rect;
+        std::vector<FlexNodeIndex> Children;
+    };
+
+    std::vector<Entry> m_Entries;
+    Vector2 m_SolvedSpace = Vector2(-1.0f, -1.0f);
+    bool m_IsDirty = true;
+    uint64_t m_SolveCount = 0;
+
+    void SolveChildren(FlexNodeIndex Index);
+};
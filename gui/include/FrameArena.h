@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+constexpr size_t FRAME_ARENA_DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+// NOTE: Linear allocator for data that only lives until the end of the frame (IDs, labels, callbacks)
+// Everything is released at once by Reset, which Gui::Clear calls at the start of every frame
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t BlockSize = FRAME_ARENA_DEFAULT_BLOCK_SIZE);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t Size, size_t Alignment = alignof(std::max_align_t));
+    void Reset();
+
+    size_t GetUsedSize() const;
+    size_t GetCapacity() const;
+
+    // NOTE: Returned strings are null terminated and valid until the next Reset
+    const char* Copy(std::string_view Value);
+    const char* Concat(std::string_view Prefix, std::string_view Suffix);
+    const char* Format(const char* Format, ...);
+
+    template <typename Type, typename... Arguments>
+    Type* Create(Arguments&&... Args)
+    {
+        void* Memory = Allocate(sizeof(Type), alignof(Type));
+        Type* Object = new (Memory) Type(std::forward<Arguments>(Args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<Type>)
+        {
+            Destructor* ObjectDestructor = static_cast<Destructor*>(Allocate(sizeof(Destructor), alignof(Destructor)));
+            ObjectDestructor->Destroy = [](void* Pointer) {
+                static_cast<Type*>(Pointer)->~Type();
+            };
+            ObjectDestructor->Object = Object;
+            ObjectDestructor->Next = m_Destructors;
+            m_Destructors = ObjectDestructor;
+        }
+
+        return Object;
+    }
+
+    // NOTE: Moves the callable into the arena and returns a forwarding lambda holding a single pointer
+    // which fits std::function's local storage, so assigning it to DrawContent or OnClick never allocates
+    template <typename Callable>
+    auto Bind(Callable&& Function)
+    {
+        using CallableType = std::decay_t<Callable>;
+        CallableType* StoredFunction = Create<CallableType>(std::forward<Callable>(Function));
+
+        return [StoredFunction](auto&&... Args) -> decltype(auto) {
+            return (*StoredFunction)(std::forward<decltype(Args)>(Args)...);
+        };
+    }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> Data;
+        size_t Size = 0;
+        size_t Offset = 0;
+    };
+
+    struct Destructor
+    {
+        void (*Destroy)(void* Pointer) = nullptr;
+        void* Object = nullptr;
+        Destructor* Next = nullptr;
+    };
+
+    std::vector<Block> m_Blocks;
+    size_t m_BlockSize = FRAME_ARENA_DEFAULT_BLOCK_SIZE;
+    Destructor* m_Destructors = nullptr;
+
+    void AddBlock(size_t MinimumSize);
+    void RunDestructors();
+};
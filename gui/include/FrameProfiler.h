@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// NOTE: History kept for the overlay and the trace dump, about 4 seconds at 60 frames per second
+constexpr size_t FRAME_PROFILER_FRAMES_COUNT = 240;
+// NOTE: Shared by every frame in the history, old frames lose their scopes first when it wraps
+constexpr size_t FRAME_PROFILER_SCOPES_CAPACITY = 32768;
+// NOTE: Scopes past this count are dropped, keeps huge conversations from flushing the whole history in one frame
+constexpr size_t FRAME_PROFILER_MAX_SCOPES_PER_FRAME = 1024;
+constexpr size_t FRAME_PROFILER_MAX_DEPTH = 32;
+// NOTE: Names are copied since container IDs only live until the end of the frame, longer names are truncated
+constexpr size_t FRAME_PROFILER_NAME_SIZE = 32;
+constexpr size_t FRAME_PROFILER_OVERLAY_SCOPES_COUNT = 10;
+constexpr size_t FRAME_PROFILER_OVERLAY_FRAMES_COUNT = 60;
+constexpr uint64_t FRAME_PROFILER_INVALID_SCOPE = UINT64_MAX;
+
+struct ProfileScope
+{
+    char Name[FRAME_PROFILER_NAME_SIZE] = {};
+    uint64_t StartNanoseconds = 0;
+    uint64_t DurationNanoseconds = 0;
+    uint32_t Depth = 0;
+};
+
+struct ProfileFrame
+{
+    uint64_t Index = 0;
+    uint64_t StartNanoseconds = 0;
+    uint64_t DurationNanoseconds = 0;
+    // NOTE: Position of the first scope in the scopes ring, counted since the profiler was enabled
+    uint64_t FirstScope = 0;
+    uint32_t ScopesCount = 0;
+    uint32_t DroppedScopesCount = 0;
+};
+
+// NOTE: Records nested scope timings per frame into fixed ring buffers so profiling never allocates after Enable
+// Only meant to be used from the render thread, every call is a no-op while disabled
+class FrameProfiler
+{
+public:
+    FrameProfiler() = default;
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    bool IsEnabled() const;
+    // NOTE: Allocates the ring buffers the first time, disabling keeps the recorded history
+    void SetEnabled(bool IsEnabled);
+
+    void BeginFrame();
+    void EndFrame();
+    // NOTE: Returns FRAME_PROFILER_INVALID_SCOPE when the scope is not recorded, EndScope ignores it
+    uint64_t BeginScope(std::string_view Name);
+    void EndScope(uint64_t Scope);
+
+    // NOTE: 0 is the oldest frame still in the history
+    size_t GetFramesCount() const;
+    const ProfileFrame& GetFrame(size_t Index) const;
+    // NOTE: Returns nullptr once the scope was overwritten by newer frames
+    const ProfileScope* GetScope(const ProfileFrame& Frame, uint32_t Index) const;
+
+    // NOTE: ImGui window listing the slowest scopes of the last frames, must be called between NewFrame and Render
+    void DrawOverlay();
+    // NOTE: Writes the history as Chrome trace event JSON, opened with chrome://tracing or ui.perfetto.dev
+    bool WriteChromeTrace(const std::string& FilePath) const;
+
+private:
+    std::unique_ptr<ProfileScope[]> m_Scopes;
+    uint64_t m_ScopesWritten = 0;
+    std::unique_ptr<ProfileFrame[]> m_Frames;
+    uint64_t m_FramesWritten = 0;
+    uint64_t m_OpenScopes[FRAME_PROFILER_MAX_DEPTH] = {};
+    uint32_t m_Depth = 0;
+    bool m_IsEnabled = false;
+    bool m_IsFrameOpen = false;
+
+    ProfileFrame& GetCurrentFrame();
+};
+
+// NOTE: Times the enclosing block, nested timers are shown as children of the enclosing one
+class ScopeTimer
+{
+public:
+    ScopeTimer(FrameProfiler& Profiler, std::string_view Name) : m_Profiler(Profiler), m_Scope(Profiler.BeginScope(Name)) {}
+    ~ScopeTimer() { m_Profiler.EndScope(m_Scope); }
+    ScopeTimer(const ScopeTimer&) = delete;
+    ScopeTimer& operator=(const ScopeTimer&) = delete;
+
+private:
+    FrameProfiler& m_Profiler;
+    uint64_t m_Scope = FRAME_PROFILER_INVALID_SCOPE;
+};
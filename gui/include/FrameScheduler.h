@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+
+// NOTE: Frames rendered after input so ImGui can settle hover, active and layout state before the loop sleeps
+constexpr int FRAME_SCHEDULER_SETTLE_FRAMES_COUNT = 3;
+// NOTE: Keeps the text input cursor blinking while a text input is focused
+constexpr double FRAME_SCHEDULER_CURSOR_BLINK_INTERVAL = 0.4;
+
+// NOTE: Replaces glfwPollEvents at the end of the render loop, blocks until something needs to be redrawn
+class FrameScheduler
+{
+public:
+    explicit FrameScheduler(bool IsEventDriven = true);
+
+    bool IsEventDriven() const;
+    void SetEventDriven(bool IsEventDriven);
+
+    // NOTE: Renders the settle frames again, used by state changes made outside of input handling
+    void RequestRedraw();
+    // NOTE: Wakes the loop at the given glfwGetTime() time, used by animation timers
+    void RequestRedrawAt(double Time);
+    void RequestRedrawIn(double Seconds);
+    void WaitForEvents();
+
+    // NOTE: Thread safe, called by the network thread when new data has to be displayed
+    static void Wake();
+
+private:
+    static std::atomic<bool> s_IsWakeRequested;
+
+    bool m_IsEventDriven = true;
+    int m_PendingFramesCount = FRAME_SCHEDULER_SETTLE_FRAMES_COUNT;
+    // NOTE: Negative when no redraw is scheduled
+    double m_NextRedrawTime = -1.0;
+
+    double GetWaitTimeout() const;
+    bool HasPendingInput() const;
+};
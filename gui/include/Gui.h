@@ -1,19 +1,36 @@
 #pragma once
 
 #include "Color.h"
+#include "FrameArena.h"
+#include "FrameProfiler.h"
+#include "GuiString.h"
+#include "StyleBlock.h"
 #include "Vector.h"
 // NOTE: Not inluding header files to avoid conflict with GLAD when imported into client.cpp
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 #include <imgui/imgui.h>
 
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
+
+// NOTE: Glyphs are rasterized into the font atlas the first time they are drawn, once the atlas grows past the
+// compact size the font sizes not drawn for GUI_FONT_ATLAS_STALE_FRAMES frames are dropped and the atlas is repacked
+constexpr int GUI_FONT_ATLAS_COMPACT_SIZE = 2048;
+constexpr int GUI_FONT_ATLAS_MAX_SIZE = 4096;
+constexpr int GUI_FONT_ATLAS_STALE_FRAMES = 600;
+// NOTE: Repacking copies every glyph left, keeps a steady trickle of stale sizes from repacking every frame
+constexpr double GUI_FONT_ATLAS_COMPACT_INTERVAL = 30.0;
 
 struct Button
 {
-    std::string Label;
+    GuiString Label;
     Vector2 Size;
+    // NOTE: Precomputed style applied instead of the style fields below when set, see Theme.h
+    const StyleBlock* Style = nullptr;
     Vector2 Padding = Vector2(0.0f, 0.0f);
     Rgba BgColor = Rgba(255, 0, 0, 255);
     Rgba BgColorActive = {};
@@ -34,8 +51,10 @@ struct ContainerState
 
 struct Container
 {
-    std::string ID;
+    GuiString ID;
     Vector2 Size;
+    // NOTE: Precomputed style applied instead of the style fields below when set, see Theme.h
+    const StyleBlock* Style = nullptr;
     Vector2 Padding = Vector2(0.0f, 0.0f);
     Rgba BgColor = Rgba(0, 0, 0, 255);
     Rgba BgColorHovered = {};
@@ -50,20 +69,23 @@ struct Container
 
 struct Text
 {
-    std::string Value;
+    GuiString Value;
 };
 
 struct Image
 {
     unsigned int TextureID;
     Vector2 Size;
+    // NOTE: Sub-rectangle of the texture to draw, used for images packed in a texture atlas
+    Vector2 UvMin = Vector2(0.0f, 0.0f);
+    Vector2 UvMax = Vector2(1.0f, 1.0f);
     Rgba TintColor = Rgba(255, 255, 255, 255);
     float CornerRounding = 0.0f;
 };
 
 struct ImageButton
 {
-    std::string ID;
+    GuiString ID;
     Image Image;
     Rgba TintColorHovered = {};
 
@@ -72,16 +94,18 @@ struct ImageButton
 
 struct Node
 {
-    std::string Name;
+    GuiString Name;
 
     std::function<void()> DrawContent;
 };
 
 struct TextInput
 {
-    std::string ID;
-    std::string Placeholder;
+    GuiString ID;
+    GuiString Placeholder;
     Vector2 Size;
+    // NOTE: Precomputed style applied instead of the style fields below when set, see Theme.h
+    const StyleBlock* Style = nullptr;
     Vector2 Padding = Vector2(0.0f, 0.0f);
     Rgba BgColor = Rgba(0, 0, 0, 255);
     Rgba TextColor = Rgba(255, 255, 255, 255);
@@ -91,15 +115,17 @@ struct TextInput
 };
 
 struct TreeNode {
-    std::string Name;
+    GuiString Name;
     std::vector<TreeNode> Children;
 };
 
 struct Window
 {
-    std::string Name;
+    GuiString Name;
     Vector2 Size;
     Vector2 Position = Vector2(0.0f, 0.0f);
+    // NOTE: Precomputed style applied instead of the style fields below when set, see Theme.h
+    const StyleBlock* Style = nullptr;
     Vector2 Padding = Vector2(0.0f, 0.0f);
     Rgba BgColor = Rgba(0, 0, 0, 255);
     bool CanSaveSettigs = false;
@@ -112,16 +138,29 @@ struct Window
     std::function<void()> DrawContent;
 };
 
+// NOTE: String fields are GuiString views, they must outlive the Draw call that uses them
+// Strings built during a frame should be allocated from GetFrameArena()
 class Gui
 {
 public:
     Gui() = default;
 
-    void Init(GLFWwindow* GlfwWindow) const;
+    // NOTE: FontData is TrueType data that must outlive the Gui, the font file is read when it is empty
+    void Init(GLFWwindow* GlfwWindow, std::string_view FontData = {}) const;
+    // NOTE: Runs frames without a window or GL context (benchmarks), textures are acknowledged without being uploaded
+    // and draw data is built but never submitted
+    void InitHeadless(Vector2 DisplaySize, std::string_view FontData = {}) const;
+    // NOTE: Merged into the main font, used for codepoints it does not have (scripts, symbols, emoji)
+    // FontData is TrueType data that must outlive the Gui, returns false when it can not be loaded
+    bool AddFallbackFont(std::string_view FontData) const;
     void Destroy() const;
     void Render() const;
     void Clear() const;
 
+    // NOTE: Every PushStyle must be matched by a PopStyle of the same block
+    void PushStyle(const StyleBlock& Style) const;
+    void PopStyle(const StyleBlock& Style) const;
+
     void DrawButton(Button& Button) const;
     void DrawContainer(Container& Container) const;
     void DrawImage(const Image& Image) const;
@@ -129,10 +168,17 @@ public:
     void DrawNode(const Node& Node) const;
     void DrawText(const Text& Text) const;
     void DrawTextWrapped(const Text& Text) const;
+    // NOTE: Returns true on the frames the value was edited
+    bool DrawTextInput(std::string& Value, TextInput& TextInput) const;
     void DrawTextInputMultiline(std::string& Value, TextInput& TextInput) const;
     void DrawTreeNode(const TreeNode& RootTreeNode) const;
     void DrawWindow(Window& Window) const;
 
+    FrameArena& GetFrameArena() const;
+    // NOTE: Disabled by default, Clear, Render and every container subtree are timed once enabled
+    FrameProfiler& GetFrameProfiler() const;
+    uint64_t GetFrameAllocationCount() const;
+
     void AlignCenter(Vector2 ElementSize) const;
     void AlignCenterX(float ElementWidth) const;
     void AlignCenterY(float ElementHeigth) const;
@@ -159,8 +205,19 @@ private:
     };
 
     void DrawImagePositioned(const ImagePositioned& ImagePositioned) const;
+    void DrawTextInputPlaceholder(const std::string& Value, const TextInput& TextInput) const;
     const Vector2 ToVector2(const ImVec2& Vector2) const;
     const Vector4 ToVector4(const ImVec4& Vector4) const;
     const ImVec2 ToImVec2(const Vector2& Vector2) const;
     const ImVec4 ToImVec4(const Vector4& Vector4) const;
+    const char* ToCString(GuiString String) const;
+    void CompactFontAtlas() const;
+
+    mutable FrameArena m_FrameArena;
+    mutable FrameProfiler m_FrameProfiler;
+    // NOTE: Heap allocations made during the previous frame
+    mutable uint64_t m_FrameAllocationCount = 0;
+    mutable uint64_t m_FrameAllocationCountStart = 0;
+    mutable double m_FontAtlasCompactedAt = 0.0;
+    mutable bool m_IsHeadless = false;
 };
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// NOTE: Non-owning text of a widget field (ID, label, value), the text must outlive the Draw call using it
+// Literals, std::string lvalues and frame arena strings are null terminated and handed to ImGui as they are, only plain
+// string views are copied into the frame arena. Temporary std::string values are rejected since they would be
+// destroyed before the widget is drawn
+class GuiString
+{
+public:
+    constexpr GuiString() = default;
+    constexpr GuiString(const char* Value) : m_View(Value), m_IsNullTerminated(true)
+    {
+    }
+    GuiString(const std::string& Value) : m_View(Value), m_IsNullTerminated(true)
+    {
+    }
+    GuiString(std::string&& Value) = delete;
+    constexpr GuiString(std::string_view Value) : m_View(Value)
+    {
+    }
+
+    constexpr operator std::string_view() const
+    {
+        return m_View;
+    }
+
+    constexpr const char* data() const
+    {
+        return m_View.data();
+    }
+
+    constexpr size_t size() const
+    {
+        return m_View.size();
+    }
+
+    constexpr bool empty() const
+    {
+        return m_View.empty();
+    }
+
+    constexpr bool IsNullTerminated() const
+    {
+        return m_IsNullTerminated;
+    }
+
+private:
+    std::string_view m_View;
+    bool m_IsNullTerminated = false;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Color.h"
+
+#include <imgui/imgui.h>
+
+#include <array>
+#include <cstddef>
+
+constexpr size_t STYLE_BLOCK_MAX_VARS_COUNT = 8;
+constexpr size_t STYLE_BLOCK_MAX_COLORS_COUNT = 8;
+
+constexpr ImVec4 RgbaToImVec4(Rgba Color)
+{
+    return ImVec4(
+        static_cast<float>(Color.GetR()) / 255.0f,
+        static_cast<float>(Color.GetG()) / 255.0f,
+        static_cast<float>(Color.GetB()) / 255.0f,
+        static_cast<float>(Color.GetA()) / 255.0f
+    );
+}
+
+// NOTE: Style vars and colors applied and popped together by Gui::PushStyle and Gui::PopStyle
+// Built at compile time so drawing a widget never converts a color, e.g.
+// constexpr StyleBlock PANEL_STYLE = StyleBlock().Var(ImGuiStyleVar_ChildRounding, 10.0f).Color(ImGuiCol_ChildBg, Rgba(50, 56, 102, 255));
+struct StyleBlock
+{
+public:
+    struct StyleVar
+    {
+        ImGuiStyleVar Index = 0;
+        // NOTE: Float vars only use X
+        ImVec2 Value;
+        bool IsVector2 = false;
+    };
+
+    struct StyleColor
+    {
+        ImGuiCol Index = 0;
+        ImVec4 Value;
+    };
+
+    std::array<StyleVar, STYLE_BLOCK_MAX_VARS_COUNT> Vars = {};
+    std::array<StyleColor, STYLE_BLOCK_MAX_COLORS_COUNT> Colors = {};
+    size_t VarsCount = 0;
+    size_t ColorsCount = 0;
+
+    // NOTE: Going over the max counts is an out of bounds write, which fails to compile in a constexpr block
+    constexpr StyleBlock Var(ImGuiStyleVar Index, float Value) const
+    {
+        StyleBlock Block = *this;
+        Block.Vars[Block.VarsCount++] = StyleVar{Index, ImVec2(Value, 0.0f), false};
+        return Block;
+    }
+
+    constexpr StyleBlock Var(ImGuiStyleVar Index, ImVec2 Value) const
+    {
+        StyleBlock Block = *this;
+        Block.Vars[Block.VarsCount++] = StyleVar{Index, Value, true};
+        return Block;
+    }
+
+    constexpr StyleBlock Color(ImGuiCol Index, Rgba Value) const
+    {
+        StyleBlock Block = *this;
+        Block.Colors[Block.ColorsCount++] = StyleColor{Index, RgbaToImVec4(Value)};
+        return Block;
+    }
+};
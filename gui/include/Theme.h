@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Color.h"
+#include "StyleBlock.h"
+
+#include <imgui/imgui.h>
+
+// COLORS
+constexpr Rgba THEME_TRANSPARENT_COLOR = Rgba(0, 0, 0, 0);
+constexpr Rgba THEME_BACKGROUND_COLOR = Rgba(26, 30, 67, 255);
+constexpr Rgba THEME_SURFACE_COLOR = Rgba(50, 56, 102, 255);
+constexpr Rgba THEME_SURFACE_SELECTED_COLOR = Rgba(100, 100, 100, 255);
+constexpr Rgba THEME_SURFACE_HOVERED_COLOR = Rgba(0, 0, 0, 255);
+constexpr Rgba THEME_INPUT_COLOR = Rgba(43, 50, 94, 255);
+constexpr Rgba THEME_PLACEHOLDER_COLOR = Rgba(120, 125, 172, 255);
+constexpr Rgba THEME_TEXT_COLOR = Rgba(255, 255, 255, 255);
+constexpr Rgba THEME_HIGHLIGHT_COLOR = Rgba(200, 200, 0, 255);
+constexpr Rgba THEME_ACCENT_COLOR = Rgba(200, 30, 30, 255);
+constexpr Rgba THEME_ACCENT_ACTIVE_COLOR = Rgba(150, 0, 0, 255);
+constexpr Rgba THEME_ACCENT_HOVERED_COLOR = Rgba(255, 100, 100, 255);
+
+// METRICS
+constexpr float THEME_CORNER_ROUNDING = 10.0f;
+constexpr float THEME_SECTION_PADDING = 15.0f;
+constexpr float THEME_MESSAGE_PADDING = 10.0f;
+
+// STYLES
+constexpr StyleBlock THEME_WINDOW_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f))
+    .Color(ImGuiCol_WindowBg, THEME_BACKGROUND_COLOR);
+
+// NOTE: Transparent container spacing out the panels it holds
+constexpr StyleBlock THEME_SECTION_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_ChildBorderSize, 0.0f)
+    .Var(ImGuiStyleVar_WindowPadding, ImVec2(THEME_SECTION_PADDING, THEME_SECTION_PADDING))
+    .Var(ImGuiStyleVar_ChildRounding, 0.0f)
+    .Color(ImGuiCol_ChildBg, THEME_TRANSPARENT_COLOR);
+
+constexpr StyleBlock THEME_PANEL_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_ChildBorderSize, 0.0f)
+    .Var(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f))
+    .Var(ImGuiStyleVar_ChildRounding, THEME_CORNER_ROUNDING)
+    .Color(ImGuiCol_ChildBg, THEME_SURFACE_COLOR);
+
+constexpr StyleBlock THEME_PANEL_SELECTED_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_ChildBorderSize, 0.0f)
+    .Var(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f))
+    .Var(ImGuiStyleVar_ChildRounding, THEME_CORNER_ROUNDING)
+    .Color(ImGuiCol_ChildBg, THEME_SURFACE_SELECTED_COLOR);
+
+constexpr StyleBlock THEME_MESSAGE_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_ChildBorderSize, 0.0f)
+    .Var(ImGuiStyleVar_WindowPadding, ImVec2(THEME_MESSAGE_PADDING, THEME_MESSAGE_PADDING))
+    .Var(ImGuiStyleVar_ChildRounding, 0.0f)
+    .Color(ImGuiCol_ChildBg, THEME_TRANSPARENT_COLOR);
+
+constexpr StyleBlock THEME_TEXT_INPUT_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_FrameBorderSize, 0.0f)
+    .Var(ImGuiStyleVar_FramePadding, ImVec2(THEME_SECTION_PADDING, THEME_SECTION_PADDING))
+    .Var(ImGuiStyleVar_FrameRounding, THEME_CORNER_ROUNDING)
+    .Color(ImGuiCol_FrameBg, THEME_INPUT_COLOR)
+    .Color(ImGuiCol_Text, THEME_TEXT_COLOR);
+
+constexpr StyleBlock THEME_ACCENT_BUTTON_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_FrameBorderSize, 0.0f)
+    .Var(ImGuiStyleVar_FramePadding, ImVec2(0.0f, 0.0f))
+    .Var(ImGuiStyleVar_FrameRounding, THEME_CORNER_ROUNDING)
+    .Color(ImGuiCol_Button, THEME_ACCENT_COLOR)
+    .Color(ImGuiCol_ButtonHovered, THEME_ACCENT_HOVERED_COLOR)
+    .Color(ImGuiCol_ButtonActive, THEME_ACCENT_ACTIVE_COLOR)
+    .Color(ImGuiCol_Text, THEME_TEXT_COLOR);
+
+// NOTE: Button without any background, used as a clickable area over other widgets
+constexpr StyleBlock THEME_GHOST_BUTTON_STYLE = StyleBlock()
+    .Var(ImGuiStyleVar_FrameBorderSize, 0.0f)
+    .Var(ImGuiStyleVar_FramePadding, ImVec2(0.0f, 0.0f))
+    .Var(ImGuiStyleVar_FrameRounding, 0.0f)
+    .Color(ImGuiCol_Button, THEME_TRANSPARENT_COLOR)
+    .Color(ImGuiCol_ButtonHovered, THEME_TRANSPARENT_COLOR)
+    .Color(ImGuiCol_ButtonActive, THEME_TRANSPARENT_COLOR)
+    .Color(ImGuiCol_Text, THEME_TEXT_COLOR);
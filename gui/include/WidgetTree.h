@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Gui.h"
+#include "Vector.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+constexpr uint32_t WIDGET_HANDLE_INVALID_INDEX = UINT32_MAX;
+
+struct WidgetHandle
+{
+    uint32_t Index = WIDGET_HANDLE_INVALID_INDEX;
+    uint32_t Generation = 0;
+
+    bool IsValid() const
+    {
+        return Index != WIDGET_HANDLE_INVALID_INDEX;
+    }
+
+    bool operator==(WidgetHandle Other) const
+    {
+        return Index == Other.Index && Generation == Other.Generation;
+    }
+
+    bool operator!=(WidgetHandle Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+enum class WidgetType
+{
+    Container,
+    Button,
+    Image,
+    ImageButton,
+    Text,
+    TextWrapped
+};
+
+struct Widget
+{
+    WidgetType Type = WidgetType::Container;
+    std::variant<Container, Button, Image, ImageButton, Text> Content;
+    // NOTE: Position relative to the parent content region, negative values keep ImGui's cursor position
+    Vector2 Position = Vector2(-1.0f, -1.0f);
+    bool IsInline = false;
+    bool IsVisible = true;
+    // NOTE: Only drawn while the parent container is hovered
+    bool IsVisibleOnParentHover = false;
+
+    // NOTE: Called only when the widget is dirty or the parent's available space changed
+    std::function<void(Widget& Widget, const Vector2& AvailableSpace)> OnLayout = {};
+};
+
+// NOTE: Widgets persist between frames and only change through Edit, each frame just walks the tree
+// Widgets must not be added or removed while the tree is being drawn, defer structural changes to the end of the frame
+// The ID, label or text view of a widget is copied into the tree when added, use SetString to change it afterwards
+class WidgetTree
+{
+public:
+    WidgetTree() = default;
+    WidgetTree(const WidgetTree&) = delete;
+    WidgetTree& operator=(const WidgetTree&) = delete;
+
+    WidgetHandle Add(WidgetHandle Parent, Widget Widget);
+    WidgetHandle AddContainer(WidgetHandle Parent, Container Container);
+    WidgetHandle AddButton(WidgetHandle Parent, Button Button);
+    WidgetHandle AddImage(WidgetHandle Parent, Image Image);
+    WidgetHandle AddImageButton(WidgetHandle Parent, ImageButton ImageButton);
+    WidgetHandle AddText(WidgetHandle Parent, Text Text, bool IsWrapped = false);
+    void Remove(WidgetHandle Handle);
+    void RemoveChildren(WidgetHandle Handle);
+    void SetChildren(WidgetHandle Handle, const std::vector<WidgetHandle>& Children);
+    void Clear();
+
+    // NOTE: Replaces the widget's ID, label or text, the tree keeps its own copy of the string
+    void SetString(WidgetHandle Handle, std::string_view Value);
+
+    const Widget* Get(WidgetHandle Handle) const;
+    // NOTE: Marks the widget dirty so its layout is recomputed on the next frame
+    Widget* Edit(WidgetHandle Handle);
+    bool IsDirty(WidgetHandle Handle) const;
+    size_t GetSize() const;
+
+    // NOTE: Draws the root widget and its subtree at the current cursor position
+    void Draw(const Gui& Gui, WidgetHandle Root);
+    // NOTE: Draws only the children of the root widget, used to embed a retained subtree into immediate-mode content
+    void DrawChildren(const Gui& Gui, WidgetHandle Root, const ContainerState& ParentState = {});
+
+private:
+    struct Slot
+    {
+        Widget Value;
+        // NOTE: Heap allocated so views into it survive the slots vector growing
+        std::unique_ptr<std::string> OwnedString;
+        WidgetHandle Parent;
+        std::vector<WidgetHandle> Children;
+        Vector2 LayoutAvailableSpace = Vector2(-1.0f, -1.0f);
+        uint32_t Generation = 0;
+        bool IsOccupied = false;
+        bool IsDirty = true;
+    };
+
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeIndices;
+    const Gui* m_DrawingGui = nullptr;
+
+    static GuiString* GetStringField(Widget& Widget);
+
+    Slot* GetSlot(WidgetHandle Handle);
+    const Slot* GetSlot(WidgetHandle Handle) const;
+    void DrawWidget(const Gui& Gui, WidgetHandle Handle, const Vector2& AvailableSpace, const ContainerState& ParentState);
+};
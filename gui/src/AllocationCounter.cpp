@@ -0,0 +1,44 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+std::atomic<uint64_t> HeapAllocationCount = 0;
+// NOTE: Constant initialized, so it is already false when the hooks set it during static initialization
+bool OperatorNewCounted = false;
+} // namespace
+
+uint64_t GetHeapAllocationCount()
+{
+    return HeapAllocationCount.load(std::memory_order_relaxed);
+}
+
+void CountHeapAllocation()
+{
+    HeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool IsOperatorNewCounted()
+{
+    return OperatorNewCounted;
+}
+
+void MarkOperatorNewCounted()
+{
+    OperatorNewCounted = true;
+}
+
+void* AllocateCounted(size_t Size, void* UserData)
+{
+    (void)UserData;
+    CountHeapAllocation();
+    return std::malloc(Size);
+}
+
+void FreeCounted(void* Pointer, void* UserData)
+{
+    (void)UserData;
+    std::free(Pointer);
+}
@@ -0,0 +1,50 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+// NOTE: Replaces the global allocation functions for the whole executable, the standard library's nothrow variants
+// forward to these. Compiled into the executables linking GuiAllocationHooks only, never into Gui itself
+
+namespace
+{
+// NOTE: Runs during static initialization so counters report heap allocations rather than ImGui's only
+const bool IS_OPERATOR_NEW_COUNTED = (MarkOperatorNewCounted(), true);
+} // namespace
+
+void* operator new(size_t Size)
+{
+    CountHeapAllocation();
+
+    void* Pointer = std::malloc(Size == 0 ? 1 : Size);
+    if (!Pointer) throw std::bad_alloc();
+
+    return Pointer;
+}
+
+void* operator new[](size_t Size)
+{
+    return operator new(Size);
+}
+
+void operator delete(void* Pointer) noexcept
+{
+    std::free(Pointer);
+}
+
+void operator delete[](void* Pointer) noexcept
+{
+    std::free(Pointer);
+}
+
+void operator delete(void* Pointer, size_t Size) noexcept
+{
+    (void)Size;
+    std::free(Pointer);
+}
+
+void operator delete[](void* Pointer, size_t Size) noexcept
+{
+    (void)Size;
+    std::free(Pointer);
+}
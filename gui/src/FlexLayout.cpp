@@ -0,0 +1,132 @@
+#include "FlexLayout.h"
+
+#include <algorithm>
+
+FlexLayout::FlexLayout()
+{
+    m_Entries.push_back(Entry{});
+}
+
+// **********
+// * PUBLIC *
+// **********
+FlexNodeIndex FlexLayout::Add(FlexNodeIndex Parent, const FlexNode& Node)
+{
+    const FlexNodeIndex INDEX = static_cast<FlexNodeIndex>(m_Entries.size());
+
+    Entry NewEntry = {};
+    NewEntry.Node = Node;
+    m_Entries.push_back(NewEntry);
+    m_Entries[Parent].Children.push_back(INDEX);
+    m_IsDirty = true;
+
+    return INDEX;
+}
+
+FlexNode* FlexLayout::Edit(FlexNodeIndex Index)
+{
+    if (Index >= m_Entries.size()) return nullptr;
+
+    m_IsDirty = true;
+    return &m_Entries[Index].Node;
+}
+
+const FlexNode& FlexLayout::Get(FlexNodeIndex Index) const
+{
+    return m_Entries[Index].Node;
+}
+
+const FlexRect& FlexLayout::GetRect(FlexNodeIndex Index) const
+{
+    return m_Entries[Index].Rect;
+}
+
+uint64_t FlexLayout::GetSolveCount() const
+{
+    return m_SolveCount;
+}
+
+bool FlexLayout::Solve(Vector2 AvailableSpace)
+{
+    const bool HAS_SPACE_CHANGED = AvailableSpace.X != m_SolvedSpace.X || AvailableSpace.Y != m_SolvedSpace.Y;
+    if (!m_IsDirty && !HAS_SPACE_CHANGED) return false;
+
+    Entry& Root = m_Entries[FLEX_LAYOUT_ROOT];
+    Root.Rect.Position = Vector2(0.0f, 0.0f);
+    Root.Rect.Size = AvailableSpace;
+
+    // NOTE: Parents always come before their children so a single pass in index order is enough
+    for (FlexNodeIndex i = 0; i < m_Entries.size(); i++)
+    {
+        SolveChildren(i);
+    }
+
+    m_SolvedSpace = AvailableSpace;
+    m_IsDirty = false;
+    m_SolveCount++;
+
+    return true;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void FlexLayout::SolveChildren(FlexNodeIndex Index)
+{
+    const Entry& Parent = m_Entries[Index];
+    if (Parent.Children.empty()) return;
+
+    const FlexNode& PARENT_NODE = Parent.Node;
+    const bool IS_ROW = PARENT_NODE.Direction == FlexDirection::Row;
+
+    const Vector2 CONTENT_POSITION = Parent.Rect.Position + PARENT_NODE.Padding;
+    const Vector2 CONTENT_SIZE = Vector2(
+        std::max(0.0f, Parent.Rect.Size.X - PARENT_NODE.Padding.X * 2.0f),
+        std::max(0.0f, Parent.Rect.Size.Y - PARENT_NODE.Padding.Y * 2.0f)
+    );
+    const float MAIN_SIZE = IS_ROW ? CONTENT_SIZE.X : CONTENT_SIZE.Y;
+    const float CROSS_SIZE = IS_ROW ? CONTENT_SIZE.Y : CONTENT_SIZE.X;
+
+    // Measures space left for growing children
+    float FixedSize = PARENT_NODE.Gap * static_cast<float>(Parent.Children.size() - 1);
+    float GrowTotal = 0.0f;
+    for (FlexNodeIndex Child : Parent.Children)
+    {
+        FixedSize += m_Entries[Child].Node.Basis;
+        GrowTotal += m_Entries[Child].Node.Grow;
+    }
+    const float REMAINING_SIZE = std::max(0.0f, MAIN_SIZE - FixedSize);
+
+    // Places children one after the other on the main axis
+    float MainOffset = 0.0f;
+    for (FlexNodeIndex Child : Parent.Children)
+    {
+        Entry& ChildEntry = m_Entries[Child];
+        const FlexNode& CHILD_NODE = ChildEntry.Node;
+
+        const float GROWN_SIZE = GrowTotal > 0.0f ? REMAINING_SIZE * CHILD_NODE.Grow / GrowTotal : 0.0f;
+        const float CHILD_MAIN_SIZE = CHILD_NODE.Basis + GROWN_SIZE;
+
+        float ChildCrossSize = CROSS_SIZE;
+        float CrossOffset = 0.0f;
+        if (PARENT_NODE.Alignment != FlexAlignment::Stretch)
+        {
+            ChildCrossSize = std::min(CHILD_NODE.CrossSize, CROSS_SIZE);
+            if (PARENT_NODE.Alignment == FlexAlignment::Center) CrossOffset = (CROSS_SIZE - ChildCrossSize) * 0.5f;
+            else if (PARENT_NODE.Alignment == FlexAlignment::End) CrossOffset = CROSS_SIZE - ChildCrossSize;
+        }
+
+        if (IS_ROW)
+        {
+            ChildEntry.Rect.Position = CONTENT_POSITION + Vector2(MainOffset, CrossOffset);
+            ChildEntry.Rect.Size = Vector2(CHILD_MAIN_SIZE, ChildCrossSize);
+        }
+        else
+        {
+            ChildEntry.Rect.Position = CONTENT_POSITION + Vector2(CrossOffset, MainOffset);
+            ChildEntry.Rect.Size = Vector2(ChildCrossSize, CHILD_MAIN_SIZE);
+        }
+
+        MainOffset += CHILD_MAIN_SIZE + PARENT_NODE.Gap;
+    }
+}
@@ -0,0 +1,139 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+FrameArena::FrameArena(size_t BlockSize) : m_BlockSize(BlockSize)
+{
+    AddBlock(m_BlockSize);
+}
+
+FrameArena::~FrameArena()
+{
+    RunDestructors();
+}
+
+// **********
+// * PUBLIC *
+// **********
+void* FrameArena::Allocate(size_t Size, size_t Alignment)
+{
+    Block* CurrentBlock = &m_Blocks.back();
+
+    uintptr_t Address = reinterpret_cast<uintptr_t>(CurrentBlock->Data.get()) + CurrentBlock->Offset;
+    size_t Padding = (Alignment - (Address % Alignment)) % Alignment;
+
+    // Grows arena when current block is full, the extra block is merged into a single one on the next Reset
+    if (CurrentBlock->Offset + Padding + Size > CurrentBlock->Size)
+    {
+        AddBlock(Size + Alignment);
+        CurrentBlock = &m_Blocks.back();
+
+        Address = reinterpret_cast<uintptr_t>(CurrentBlock->Data.get());
+        Padding = (Alignment - (Address % Alignment)) % Alignment;
+    }
+
+    void* Memory = CurrentBlock->Data.get() + CurrentBlock->Offset + Padding;
+    CurrentBlock->Offset += Padding + Size;
+
+    return Memory;
+}
+
+void FrameArena::Reset()
+{
+    RunDestructors();
+
+    // NOTE: Replaces overflowed blocks with a single block big enough for the whole previous frame
+    // so a steady-state frame never allocates
+    if (m_Blocks.size() > 1)
+    {
+        const size_t CAPACITY = GetCapacity();
+        m_Blocks.clear();
+        AddBlock(CAPACITY);
+    }
+
+    m_Blocks.back().Offset = 0;
+}
+
+size_t FrameArena::GetUsedSize() const
+{
+    size_t UsedSize = 0;
+    for (const Block& ArenaBlock : m_Blocks)
+    {
+        UsedSize += ArenaBlock.Offset;
+    }
+    return UsedSize;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    size_t Capacity = 0;
+    for (const Block& ArenaBlock : m_Blocks)
+    {
+        Capacity += ArenaBlock.Size;
+    }
+    return Capacity;
+}
+
+const char* FrameArena::Copy(std::string_view Value)
+{
+    return Concat(Value, {});
+}
+
+const char* FrameArena::Concat(std::string_view Prefix, std::string_view Suffix)
+{
+    char* String = static_cast<char*>(Allocate(Prefix.size() + Suffix.size() + 1, alignof(char)));
+    if (!Prefix.empty()) std::memcpy(String, Prefix.data(), Prefix.size());
+    if (!Suffix.empty()) std::memcpy(String + Prefix.size(), Suffix.data(), Suffix.size());
+    String[Prefix.size() + Suffix.size()] = '\0';
+
+    return String;
+}
+
+const char* FrameArena::Format(const char* Format, ...)
+{
+    va_list Arguments;
+    va_start(Arguments, Format);
+    va_list ArgumentsCopy;
+    va_copy(ArgumentsCopy, Arguments);
+
+    // Measures formatted string before writing it into the arena
+    const int LENGTH = std::vsnprintf(nullptr, 0, Format, Arguments);
+    va_end(Arguments);
+
+    if (LENGTH < 0)
+    {
+        // Handles format error
+        va_end(ArgumentsCopy);
+        return "";
+    }
+
+    char* String = static_cast<char*>(Allocate(static_cast<size_t>(LENGTH) + 1, alignof(char)));
+    std::vsnprintf(String, static_cast<size_t>(LENGTH) + 1, Format, ArgumentsCopy);
+    va_end(ArgumentsCopy);
+
+    return String;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+void FrameArena::AddBlock(size_t MinimumSize)
+{
+    Block NewBlock = {};
+    NewBlock.Size = std::max(m_BlockSize, MinimumSize);
+    NewBlock.Data = std::make_unique<std::byte[]>(NewBlock.Size);
+    m_Blocks.push_back(std::move(NewBlock));
+}
+
+void FrameArena::RunDestructors()
+{
+    for (Destructor* ObjectDestructor = m_Destructors; ObjectDestructor; ObjectDestructor = ObjectDestructor->Next)
+    {
+        ObjectDestructor->Destroy(ObjectDestructor->Object);
+    }
+    m_Destructors = nullptr;
+}
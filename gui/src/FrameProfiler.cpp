@@ -0,0 +1,251 @@
+#include "FrameProfiler.h"
+
+#include <imgui/imgui.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+static uint64_t GetNanoseconds()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static double ToMilliseconds(uint64_t Nanoseconds)
+{
+    return static_cast<double>(Nanoseconds) / 1000000.0;
+}
+
+// NOTE: Names come from container IDs so quotes, backslashes and control characters are escaped
+static void WriteJsonString(FILE* File, const char* String)
+{
+    std::fputc('"', File);
+    for (const char* Character = String; *Character; Character++)
+    {
+        const unsigned char CHARACTER = static_cast<unsigned char>(*Character);
+        if (CHARACTER == '"' || CHARACTER == '\\') std::fprintf(File, "\\%c", CHARACTER);
+        else if (CHARACTER < 0x20) std::fprintf(File, "\\u%04x", CHARACTER);
+        else std::fputc(CHARACTER, File);
+    }
+    std::fputc('"', File);
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool FrameProfiler::IsEnabled() const
+{
+    return m_IsEnabled;
+}
+
+void FrameProfiler::SetEnabled(bool IsEnabled)
+{
+    if (IsEnabled && !m_Scopes)
+    {
+        m_Scopes = std::make_unique<ProfileScope[]>(FRAME_PROFILER_SCOPES_CAPACITY);
+        m_Frames = std::make_unique<ProfileFrame[]>(FRAME_PROFILER_FRAMES_COUNT);
+    }
+
+    // NOTE: Drops the frame in progress, its open scopes would never be closed
+    m_IsFrameOpen = false;
+    m_Depth = 0;
+    m_IsEnabled = IsEnabled;
+}
+
+void FrameProfiler::BeginFrame()
+{
+    if (!m_IsEnabled) return;
+    if (m_IsFrameOpen) EndFrame();
+
+    ProfileFrame& CurrentFrame = GetCurrentFrame();
+    CurrentFrame = ProfileFrame{};
+    CurrentFrame.Index = m_FramesWritten;
+    CurrentFrame.StartNanoseconds = GetNanoseconds();
+    CurrentFrame.FirstScope = m_ScopesWritten;
+
+    m_Depth = 0;
+    m_IsFrameOpen = true;
+}
+
+void FrameProfiler::EndFrame()
+{
+    if (!m_IsEnabled || !m_IsFrameOpen) return;
+
+    ProfileFrame& CurrentFrame = GetCurrentFrame();
+    CurrentFrame.DurationNanoseconds = GetNanoseconds() - CurrentFrame.StartNanoseconds;
+
+    m_FramesWritten++;
+    m_IsFrameOpen = false;
+}
+
+uint64_t FrameProfiler::BeginScope(std::string_view Name)
+{
+    if (!m_IsEnabled || !m_IsFrameOpen || m_Depth >= FRAME_PROFILER_MAX_DEPTH) return FRAME_PROFILER_INVALID_SCOPE;
+
+    ProfileFrame& CurrentFrame = GetCurrentFrame();
+    if (CurrentFrame.ScopesCount >= FRAME_PROFILER_MAX_SCOPES_PER_FRAME)
+    {
+        CurrentFrame.DroppedScopesCount++;
+        return FRAME_PROFILER_INVALID_SCOPE;
+    }
+
+    const uint64_t SCOPE = m_ScopesWritten++;
+    ProfileScope& NewScope = m_Scopes[SCOPE % FRAME_PROFILER_SCOPES_CAPACITY];
+    const size_t NAME_SIZE = std::min(Name.size(), FRAME_PROFILER_NAME_SIZE - 1);
+    std::memcpy(NewScope.Name, Name.data(), NAME_SIZE);
+    NewScope.Name[NAME_SIZE] = '\0';
+    NewScope.Depth = m_Depth;
+    NewScope.DurationNanoseconds = 0;
+
+    m_OpenScopes[m_Depth++] = SCOPE;
+    CurrentFrame.ScopesCount++;
+
+    // NOTE: Read last so the bookkeeping above is not part of the measured time
+    NewScope.StartNanoseconds = GetNanoseconds();
+    return SCOPE;
+}
+
+void FrameProfiler::EndScope(uint64_t Scope)
+{
+    const uint64_t END_NANOSECONDS = GetNanoseconds();
+    // NOTE: Ignores scopes begun before the profiler was toggled or before the current frame started
+    if (Scope == FRAME_PROFILER_INVALID_SCOPE || !m_IsFrameOpen || m_Depth == 0 || m_OpenScopes[m_Depth - 1] != Scope) return;
+
+    ProfileScope& EndedScope = m_Scopes[Scope % FRAME_PROFILER_SCOPES_CAPACITY];
+    EndedScope.DurationNanoseconds = END_NANOSECONDS - EndedScope.StartNanoseconds;
+    m_Depth--;
+}
+
+size_t FrameProfiler::GetFramesCount() const
+{
+    // NOTE: The slot after the newest frame is reused by the frame in progress
+    return static_cast<size_t>(std::min<uint64_t>(m_FramesWritten, FRAME_PROFILER_FRAMES_COUNT - 1));
+}
+
+const ProfileFrame& FrameProfiler::GetFrame(size_t Index) const
+{
+    const uint64_t FRAME = m_FramesWritten - GetFramesCount() + Index;
+    return m_Frames[FRAME % FRAME_PROFILER_FRAMES_COUNT];
+}
+
+const ProfileScope* FrameProfiler::GetScope(const ProfileFrame& Frame, uint32_t Index) const
+{
+    const uint64_t SCOPE = Frame.FirstScope + Index;
+    if (Index >= Frame.ScopesCount || m_ScopesWritten - SCOPE > FRAME_PROFILER_SCOPES_CAPACITY) return nullptr;
+
+    return &m_Scopes[SCOPE % FRAME_PROFILER_SCOPES_CAPACITY];
+}
+
+void FrameProfiler::DrawOverlay()
+{
+    if (!m_IsEnabled) return;
+
+    const size_t FRAMES_COUNT = GetFramesCount();
+    const size_t OVERLAY_FRAMES_COUNT = std::min(FRAMES_COUNT, FRAME_PROFILER_OVERLAY_FRAMES_COUNT);
+
+    // Keeps slowest scopes sorted from slowest to fastest, no allocation since it is called every frame
+    const ProfileScope* SlowestScopes[FRAME_PROFILER_OVERLAY_SCOPES_COUNT] = {};
+    size_t SlowestScopesCount = 0;
+    uint64_t TotalFrameNanoseconds = 0;
+    uint64_t MaxFrameNanoseconds = 0;
+    uint32_t DroppedScopesCount = 0;
+
+    for (size_t i = FRAMES_COUNT - OVERLAY_FRAMES_COUNT; i < FRAMES_COUNT; i++)
+    {
+        const ProfileFrame& FRAME = GetFrame(i);
+        TotalFrameNanoseconds += FRAME.DurationNanoseconds;
+        MaxFrameNanoseconds = std::max(MaxFrameNanoseconds, FRAME.DurationNanoseconds);
+        DroppedScopesCount += FRAME.DroppedScopesCount;
+
+        for (uint32_t j = 0; j < FRAME.ScopesCount; j++)
+        {
+            const ProfileScope* SCOPE = GetScope(FRAME, j);
+            if (!SCOPE) continue;
+
+            size_t Position = SlowestScopesCount;
+            while (Position > 0 && SlowestScopes[Position - 1]->DurationNanoseconds < SCOPE->DurationNanoseconds) Position--;
+            if (Position >= FRAME_PROFILER_OVERLAY_SCOPES_COUNT) continue;
+
+            const size_t MOVED_COUNT = std::min(SlowestScopesCount, FRAME_PROFILER_OVERLAY_SCOPES_COUNT - 1) - Position;
+            std::memmove(&SlowestScopes[Position + 1], &SlowestScopes[Position], MOVED_COUNT * sizeof(SlowestScopes[0]));
+            SlowestScopes[Position] = SCOPE;
+            SlowestScopesCount = std::min(SlowestScopesCount + 1, FRAME_PROFILER_OVERLAY_SCOPES_COUNT);
+        }
+    }
+
+    const ImGuiViewport* VIEWPORT = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(ImVec2(VIEWPORT->WorkPos.x + VIEWPORT->WorkSize.x - 10.0f, VIEWPORT->WorkPos.y + 10.0f), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.85f);
+    const ImGuiWindowFlags FLAGS = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
+    if (ImGui::Begin("FrameProfilerOverlay", nullptr, FLAGS))
+    {
+        const double AVERAGE_FRAME_MILLISECONDS = OVERLAY_FRAMES_COUNT > 0 ? ToMilliseconds(TotalFrameNanoseconds) / OVERLAY_FRAMES_COUNT : 0.0;
+        ImGui::Text("Last %zu frames: %.3f ms average, %.3f ms max", OVERLAY_FRAMES_COUNT, AVERAGE_FRAME_MILLISECONDS, ToMilliseconds(MaxFrameNanoseconds));
+        if (DroppedScopesCount > 0) ImGui::Text("%u scopes dropped", DroppedScopesCount);
+        ImGui::Separator();
+
+        for (size_t i = 0; i < SlowestScopesCount; i++)
+        {
+            ImGui::Text("%8.3f ms  %*s%s", ToMilliseconds(SlowestScopes[i]->DurationNanoseconds), static_cast<int>(SlowestScopes[i]->Depth), "", SlowestScopes[i]->Name);
+        }
+    }
+    ImGui::End();
+}
+
+bool FrameProfiler::WriteChromeTrace(const std::string& FilePath) const
+{
+    FILE* File = std::fopen(FilePath.c_str(), "w");
+    if (!File)
+    {
+        // Handles file open failure error
+        return false;
+    }
+
+    const size_t FRAMES_COUNT = GetFramesCount();
+    const uint64_t ORIGIN_NANOSECONDS = FRAMES_COUNT > 0 ? GetFrame(0).StartNanoseconds : 0;
+    bool IsFirstEvent = true;
+
+    // NOTE: Complete events ("ph":"X") carry their own duration so nesting is rebuilt by the viewer from timestamps
+    auto WriteEvent = [File, ORIGIN_NANOSECONDS, &IsFirstEvent](const char* Name, const char* Category, uint64_t StartNanoseconds, uint64_t DurationNanoseconds) {
+        std::fputs(IsFirstEvent ? "\n" : ",\n", File);
+        IsFirstEvent = false;
+
+        std::fputs("{\"name\":", File);
+        WriteJsonString(File, Name);
+        std::fprintf(File, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}", Category,
+                     static_cast<double>(StartNanoseconds - ORIGIN_NANOSECONDS) / 1000.0, static_cast<double>(DurationNanoseconds) / 1000.0);
+    };
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", File);
+    for (size_t i = 0; i < FRAMES_COUNT; i++)
+    {
+        const ProfileFrame& FRAME = GetFrame(i);
+
+        char FrameName[32] = {};
+        std::snprintf(FrameName, sizeof(FrameName), "Frame %llu", static_cast<unsigned long long>(FRAME.Index));
+        WriteEvent(FrameName, "Frame", FRAME.StartNanoseconds, FRAME.DurationNanoseconds);
+
+        for (uint32_t j = 0; j < FRAME.ScopesCount; j++)
+        {
+            const ProfileScope* SCOPE = GetScope(FRAME, j);
+            if (!SCOPE) continue;
+
+            WriteEvent(SCOPE->Name, "Scope", SCOPE->StartNanoseconds, SCOPE->DurationNanoseconds);
+        }
+    }
+    std::fputs("\n]}\n", File);
+
+    const bool IS_WRITTEN = !std::ferror(File);
+    std::fclose(File);
+
+    return IS_WRITTEN;
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+ProfileFrame& FrameProfiler::GetCurrentFrame()
+{
+    return m_Frames[m_FramesWritten % FRAME_PROFILER_FRAMES_COUNT];
+}
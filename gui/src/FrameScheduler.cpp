@@ -0,0 +1,101 @@
+#include "FrameScheduler.h"
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <imgui/imgui.h>
+#include <imgui/imgui_internal.h>
+
+#include <algorithm>
+
+std::atomic<bool> FrameScheduler::s_IsWakeRequested = false;
+
+FrameScheduler::FrameScheduler(bool IsEventDriven) : m_IsEventDriven(IsEventDriven)
+{
+}
+
+// **********
+// * PUBLIC *
+// **********
+bool FrameScheduler::IsEventDriven() const
+{
+    return m_IsEventDriven;
+}
+
+void FrameScheduler::SetEventDriven(bool IsEventDriven)
+{
+    m_IsEventDriven = IsEventDriven;
+    m_PendingFramesCount = FRAME_SCHEDULER_SETTLE_FRAMES_COUNT;
+}
+
+void FrameScheduler::RequestRedraw()
+{
+    m_PendingFramesCount = FRAME_SCHEDULER_SETTLE_FRAMES_COUNT;
+}
+
+void FrameScheduler::RequestRedrawAt(double Time)
+{
+    m_NextRedrawTime = m_NextRedrawTime < 0.0 ? Time : std::min(m_NextRedrawTime, Time);
+}
+
+void FrameScheduler::RequestRedrawIn(double Seconds)
+{
+    RequestRedrawAt(glfwGetTime() + Seconds);
+}
+
+void FrameScheduler::WaitForEvents()
+{
+    if (!m_IsEventDriven)
+    {
+        glfwPollEvents();
+        return;
+    }
+
+    if (m_PendingFramesCount > 0)
+    {
+        m_PendingFramesCount--;
+        glfwPollEvents();
+    }
+    else
+    {
+        // Sleeps until input, a wake up from another thread or the next scheduled redraw
+        const double TIMEOUT = GetWaitTimeout();
+        if (TIMEOUT < 0.0)
+            glfwWaitEvents();
+        else
+            glfwWaitEventsTimeout(TIMEOUT);
+    }
+
+    // NOTE: Events queued by the ImGui GLFW backend callbacks tell input apart from a timeout
+    const bool IS_WAKE_REQUESTED = s_IsWakeRequested.exchange(false);
+    if (HasPendingInput() || IS_WAKE_REQUESTED) m_PendingFramesCount = FRAME_SCHEDULER_SETTLE_FRAMES_COUNT;
+
+    if (m_NextRedrawTime >= 0.0 && glfwGetTime() >= m_NextRedrawTime) m_NextRedrawTime = -1.0;
+}
+
+void FrameScheduler::Wake()
+{
+    s_IsWakeRequested.store(true);
+    glfwPostEmptyEvent();
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+double FrameScheduler::GetWaitTimeout() const
+{
+    double Timeout = -1.0;
+    if (m_NextRedrawTime >= 0.0) Timeout = std::max(0.0, m_NextRedrawTime - glfwGetTime());
+
+    if (ImGui::GetCurrentContext() && ImGui::GetIO().WantTextInput)
+    {
+        Timeout = Timeout < 0.0 ? FRAME_SCHEDULER_CURSOR_BLINK_INTERVAL : std::min(Timeout, FRAME_SCHEDULER_CURSOR_BLINK_INTERVAL);
+    }
+
+    return Timeout;
+}
+
+bool FrameScheduler::HasPendingInput() const
+{
+    ImGuiContext* Context = ImGui::GetCurrentContext();
+    return Context && Context->InputEventsQueue.Size > 0;
+}
@@ -1,20 +1,40 @@
 #include "Gui.h"
+#include "AllocationCounter.h"
 
 #include <imgui/imgui.h>
+#include <imgui/imgui_internal.h>
 #include <imgui/imgui_stdlib.h>
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
 
+// NOTE: Rgba is packed with ImGui's default layout, colors are handed to ImGui without repacking
+static_assert(IM_COL32(1, 2, 3, 4) == Rgba(1, 2, 3, 4).Packed, "Rgba packing must match IM_COL32");
+
 // **********
 // * PUBLIC *
 // **********
-void Gui::Init(GLFWwindow* GlfwWindow) const
+void Gui::Init(GLFWwindow* GlfwWindow, std::string_view FontData) const
 {
     IMGUI_CHECKVERSION();
+    // NOTE: Routes ImGui allocations through the counter so they show up in the per frame allocation count
+    ImGui::SetAllocatorFunctions(AllocateCounted, FreeCounted);
     ImGui::CreateContext();
     ImGuiIO& Io = ImGui::GetIO();
     (void)Io;
-    Io.Fonts->AddFontFromFileTTF("../../assets/Audiowide-Regular.ttf");
+    // NOTE: Caps atlas growth, CompactFontAtlas drops unused glyphs long before this is reached
+    Io.Fonts->TexMaxWidth = GUI_FONT_ATLAS_MAX_SIZE;
+    Io.Fonts->TexMaxHeight = GUI_FONT_ATLAS_MAX_SIZE;
+    if (FontData.empty())
+    {
+        Io.Fonts->AddFontFromFileTTF("../../assets/Audiowide-Regular.ttf");
+    }
+    else
+    {
+        // NOTE: Data is not copied, glyphs are rasterized from it on demand
+        ImFontConfig FontConfig = {};
+        FontConfig.FontDataOwnedByAtlas = false;
+        Io.Fonts->AddFontFromMemoryTTF(const_cast<char*>(FontData.data()), static_cast<int>(FontData.size()), 0.0f, &FontConfig);
+    }
 
      // Setup Dear ImGui style
     ImGuiStyle& Style = ImGui::GetStyle();
@@ -25,62 +45,201 @@ void Gui::Init(GLFWwindow* GlfwWindow) const
     ImGui_ImplOpenGL3_Init("#version 150");
 }
 
+void Gui::InitHeadless(Vector2 DisplaySize, std::string_view FontData) const
+{
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(AllocateCounted, FreeCounted);
+    ImGui::CreateContext();
+    ImGuiIO& Io = ImGui::GetIO();
+    Io.DisplaySize = ToImVec2(DisplaySize);
+    // NOTE: Keeps runs reproducible, window positions are not restored from a previous run
+    Io.IniFilename = nullptr;
+    // NOTE: Lets the atlas grow on demand like the OpenGL backend does, Render acknowledges the textures
+    Io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    Io.Fonts->TexMaxWidth = GUI_FONT_ATLAS_MAX_SIZE;
+    Io.Fonts->TexMaxHeight = GUI_FONT_ATLAS_MAX_SIZE;
+    if (FontData.empty())
+    {
+        Io.Fonts->AddFontDefault();
+    }
+    else
+    {
+        ImFontConfig FontConfig = {};
+        FontConfig.FontDataOwnedByAtlas = false;
+        Io.Fonts->AddFontFromMemoryTTF(const_cast<char*>(FontData.data()), static_cast<int>(FontData.size()), 0.0f, &FontConfig);
+    }
+
+    ImGui::StyleColorsDark();
+    m_IsHeadless = true;
+}
+
+bool Gui::AddFallbackFont(std::string_view FontData) const
+{
+    // NOTE: Data is not copied, glyphs are rasterized from it when a codepoint missing from the main font is drawn
+    ImFontConfig FontConfig = {};
+    FontConfig.MergeMode = true;
+    FontConfig.FontDataOwnedByAtlas = false;
+    FontConfig.Flags |= ImFontFlags_NoLoadError;
+
+    return ImGui::GetIO().Fonts->AddFontFromMemoryTTF(const_cast<char*>(FontData.data()), static_cast<int>(FontData.size()), 0.0f, &FontConfig) != nullptr;
+}
+
 void Gui::Destroy() const
 {
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+    if (!m_IsHeadless)
+    {
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+    }
     ImGui::DestroyContext();
+    m_IsHeadless = false;
 }
 
 void Gui::Render() const
 {
+    ScopeTimer RenderTimer(m_FrameProfiler, "Gui::Render");
     ImGui::Render();
+
+    if (m_IsHeadless)
+    {
+        // NOTE: Pretends every texture request was served so the font atlas keeps working without a renderer
+        for (ImTextureData* Texture : ImGui::GetPlatformIO().Textures)
+        {
+            if (Texture->Status == ImTextureStatus_WantDestroy)
+            {
+                Texture->SetTexID(ImTextureID_Invalid);
+                Texture->SetStatus(ImTextureStatus_Destroyed);
+                continue;
+            }
+
+            if (Texture->Status == ImTextureStatus_WantCreate) Texture->SetTexID(static_cast<ImTextureID>(Texture->UniqueID + 1));
+            if (Texture->Status != ImTextureStatus_OK && Texture->Status != ImTextureStatus_Destroyed) Texture->SetStatus(ImTextureStatus_OK);
+        }
+        return;
+    }
+
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
 void Gui::Clear() const
 {
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
+    ScopeTimer ClearTimer(m_FrameProfiler, "Gui::Clear");
+
+    // Releases transient strings and callbacks of the previous frame
+    m_FrameArena.Reset();
+
+    const uint64_t HEAP_ALLOCATION_COUNT = GetHeapAllocationCount();
+    m_FrameAllocationCount = HEAP_ALLOCATION_COUNT - m_FrameAllocationCountStart;
+    m_FrameAllocationCountStart = HEAP_ALLOCATION_COUNT;
+
+    CompactFontAtlas();
+
+    if (!m_IsHeadless)
+    {
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+    }
+    else
+    {
+        // NOTE: Fixed step so frames do not depend on how long the previous one took
+        ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+    }
     ImGui::NewFrame();
 }
 
+void Gui::PushStyle(const StyleBlock& Style) const
+{
+    for (size_t i = 0; i < Style.VarsCount; i++)
+    {
+        const StyleBlock::StyleVar& VAR = Style.Vars[i];
+        if (VAR.IsVector2) ImGui::PushStyleVar(VAR.Index, VAR.Value);
+        else ImGui::PushStyleVar(VAR.Index, VAR.Value.x);
+    }
+
+    for (size_t i = 0; i < Style.ColorsCount; i++)
+    {
+        ImGui::PushStyleColor(Style.Colors[i].Index, Style.Colors[i].Value);
+    }
+}
+
+void Gui::PopStyle(const StyleBlock& Style) const
+{
+    if (Style.VarsCount > 0) ImGui::PopStyleVar(static_cast<int>(Style.VarsCount));
+    if (Style.ColorsCount > 0) ImGui::PopStyleColor(static_cast<int>(Style.ColorsCount));
+}
+
 void Gui::DrawButton(Button& Button) const
 {
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, Button.BorderSize);
-    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ToImVec2(Button.Padding));
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, Button.CornerRounding);
-    ImGui::PushStyleColor(ImGuiCol_Button, ToImVec4(Button.BgColor.ToVector4()));
-    ImGui::PushStyleColor(ImGuiCol_Text, ToImVec4(Button.TextColor.ToVector4()));
-    if (!Button.BgColorActive.IsEmpty()) ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ToImVec4(Button.BgColorActive.ToVector4()));
-    if (!Button.BgColorHovered.IsEmpty()) ImGui::PushStyleColor(ImGuiCol_ButtonActive, ToImVec4(Button.BgColorHovered.ToVector4()));
+    int PushedColorsCount = 0;
+    if (Button.Style)
+    {
+        PushStyle(*Button.Style);
+    }
+    else
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, Button.BorderSize);
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ToImVec2(Button.Padding));
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, Button.CornerRounding);
+        ImGui::PushStyleColor(ImGuiCol_Button, Button.BgColor.Packed);
+        ImGui::PushStyleColor(ImGuiCol_Text, Button.TextColor.Packed);
+        PushedColorsCount = 2;
+        if (!Button.BgColorHovered.IsEmpty())
+        {
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, Button.BgColorHovered.Packed);
+            PushedColorsCount++;
+        }
+        if (!Button.BgColorActive.IsEmpty())
+        {
+            ImGui::PushStyleColor(ImGuiCol_ButtonActive, Button.BgColorActive.Packed);
+            PushedColorsCount++;
+        }
+    }
 
     if (Button.IsDisabled)  ImGui::BeginDisabled();
 
-    ImGui::Button(Button.Label.c_str(), ImVec2(Button.Size.X, Button.Size.Y));
+    ImGui::Button(ToCString(Button.Label), ImVec2(Button.Size.X, Button.Size.Y));
     if (ImGui::IsItemClicked()) Button.OnClick();
     if (ImGui::IsItemHovered() && !!Button.OnHover) Button.OnHover();
 
     if (Button.IsDisabled)  ImGui::EndDisabled();
 
-    ImGui::PopStyleVar(3);
-    ImGui::PopStyleColor(2);
-    if (!Button.BgColorActive.IsEmpty()) ImGui::PopStyleColor(1);
-    if (!Button.BgColorHovered.IsEmpty()) ImGui::PopStyleColor(1);
+    if (Button.Style)
+    {
+        PopStyle(*Button.Style);
+    }
+    else
+    {
+        ImGui::PopStyleVar(3);
+        ImGui::PopStyleColor(PushedColorsCount);
+    }
 }
 
 void Gui::DrawContainer(Container& Container) const
 {
+    ScopeTimer ContainerTimer(m_FrameProfiler, Container.ID);
+
     ImGuiChildFlags Flags = ImGuiChildFlags_AlwaysUseWindowPadding;
     if (Container.IsAutoResizableY) Flags |= ImGuiChildFlags_AutoResizeY;
     if (Container.IsAutoResizableX) Flags |= ImGuiChildFlags_AutoResizeX;
 
-    ImGui::PushStyleVar(ImGuiStyleVar_ChildBorderSize, Container.BorderSize);
-    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ToImVec2(Container.Padding));
-    ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, Container.CornerRounding);
-    ImGui::PushStyleColor(ImGuiCol_ChildBg, ToImVec4(Container.BgColor.ToVector4()));
+    if (Container.Style)
+    {
+        PushStyle(*Container.Style);
+    }
+    else
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_ChildBorderSize, Container.BorderSize);
+        ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ToImVec2(Container.Padding));
+        ImGui::PushStyleVar(ImGuiStyleVar_ChildRounding, Container.CornerRounding);
+        ImGui::PushStyleColor(ImGuiCol_ChildBg, Container.BgColor.Packed);
+    }
+
+    // NOTE: Read before BeginChild since the pushed style applies to the child window
+    const float CORNER_ROUNDING = ImGui::GetStyle().ChildRounding;
 
-    if (ImGui::BeginChild(Container.ID.c_str(), ToImVec2(Container.Size), Flags))
+    // NOTE: Hashes the view directly, no need for a null terminated copy
+    const ImGuiID ID = ImGui::GetID(Container.ID.data(), Container.ID.data() + Container.ID.size());
+    if (ImGui::BeginChild(ID, ToImVec2(Container.Size), Flags))
     {
         const bool IS_HOVERED = ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows);
         // Draws rectangle on top of background container when is hovered
@@ -90,18 +249,12 @@ void Gui::DrawContainer(Container& Container) const
 
             ImVec2 BgPositionMin = ImGui::GetCursorScreenPos();
             ImVec2 BgPositionMax = ImVec2(BgPositionMin.x + Container.Size.X, BgPositionMin.y + Container.Size.Y);
-            ImU32 BgColorHovered = IM_COL32(
-                Container.BgColorHovered.R,
-                Container.BgColorHovered.G,
-                Container.BgColorHovered.B,
-                Container.BgColorHovered.A
-            );
 
             WindowDrawList->AddRectFilled(
                 BgPositionMin,
                 BgPositionMax,
-                BgColorHovered,
-                Container.CornerRounding
+                Container.BgColorHovered.Packed,
+                CORNER_ROUNDING
             );
         }
 
@@ -113,8 +266,15 @@ void Gui::DrawContainer(Container& Container) const
     }
     ImGui::EndChild();
 
-    ImGui::PopStyleVar(3);
-    ImGui::PopStyleColor(1);
+    if (Container.Style)
+    {
+        PopStyle(*Container.Style);
+    }
+    else
+    {
+        ImGui::PopStyleVar(3);
+        ImGui::PopStyleColor(1);
+    }
 }
 
 void Gui::DrawImage(const Image& Image) const
@@ -129,7 +289,7 @@ void Gui::DrawImageButton(ImageButton& ImageButton) const
 {
     Image ImageButtonImage = ImageButton.Image;
 
-    ImGui::InvisibleButton(ImageButton.ID.c_str(), ToImVec2(ImageButton.Image.Size));
+    ImGui::InvisibleButton(ToCString(ImageButton.ID), ToImVec2(ImageButton.Image.Size));
     if (ImGui::IsItemClicked()) ImageButton.OnClick();
     if (ImGui::IsItemHovered() && !ImageButton.TintColorHovered.IsEmpty()) ImageButtonImage.TintColor = ImageButton.TintColorHovered;
 
@@ -142,7 +302,7 @@ void Gui::DrawImageButton(ImageButton& ImageButton) const
 
 void Gui::DrawNode(const Node& Node) const
 {
-    if (ImGui::TreeNode(Node.Name.c_str()))
+    if (ImGui::TreeNode(ToCString(Node.Name)))
     {
         Node.DrawContent();
         ImGui::TreePop();
@@ -151,56 +311,84 @@ void Gui::DrawNode(const Node& Node) const
 
 void Gui::DrawText(const Text& Text) const
 {
-    ImGui::TextUnformatted(Text.Value.c_str());
+    ImGui::TextUnformatted(Text.Value.data(), Text.Value.data() + Text.Value.size());
 }
 
 void Gui::DrawTextWrapped(const Text& Text) const
 {
-    ImGui::TextWrapped("%s", Text.Value.c_str());
+    ImGui::TextWrapped("%.*s", static_cast<int>(Text.Value.size()), Text.Value.data());
 }
 
-void Gui::DrawTextInputMultiline(std::string& Value, TextInput& TextInput) const
+bool Gui::DrawTextInput(std::string& Value, TextInput& TextInput) const
 {
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, TextInput.BorderSize);
-    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ToImVec2(TextInput.Padding));
-    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, TextInput.CornerRounding);
-    ImGui::PushStyleColor(ImGuiCol_FrameBg, ToImVec4(TextInput.BgColor.ToVector4()));
-    ImGui::PushStyleColor(ImGuiCol_Text, ToImVec4(TextInput.TextColor.ToVector4()));
+    if (TextInput.Style)
+    {
+        PushStyle(*TextInput.Style);
+    }
+    else
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, TextInput.BorderSize);
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ToImVec2(TextInput.Padding));
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, TextInput.CornerRounding);
+        ImGui::PushStyleColor(ImGuiCol_FrameBg, TextInput.BgColor.Packed);
+        ImGui::PushStyleColor(ImGuiCol_Text, TextInput.TextColor.Packed);
+    }
 
     // NOTE: ## prefix tells ImGui to use the string for internal ID generation but not to display it as a visible label
-    const std::string& ID = "##" + TextInput.ID;
-    ImGui::InputTextMultiline(ID.c_str(), &Value, ToImVec2(TextInput.Size));
+    const char* ID = m_FrameArena.Concat("##", TextInput.ID);
+    ImGui::SetNextItemWidth(TextInput.Size.X);
+    const bool HAS_CHANGED = ImGui::InputText(ID, &Value);
 
-    // Draws placeholder on top of Text input multiline
-    if (!TextInput.Placeholder.empty() && Value.size() == 0)
-    {
-        ImGuiStyle& style = ImGui::GetStyle();
-        ImVec2 FramePadding = style.FramePadding;
+    DrawTextInputPlaceholder(Value, TextInput);
 
-        ImDrawList* ForegroundDrawList = ImGui::GetForegroundDrawList();
-        ImVec2 BoundingBoxMinPosition = ImGui::GetItemRectMin();
+    if (TextInput.Style)
+    {
+        PopStyle(*TextInput.Style);
+    }
+    else
+    {
+        ImGui::PopStyleVar(3);
+        ImGui::PopStyleColor(2);
+    }
 
-        ImVec2 PlaceholderPosition(
-            BoundingBoxMinPosition.x + FramePadding.x,
-            BoundingBoxMinPosition.y + FramePadding.y
-        );
-        ImU32 PlaceholderColor = IM_COL32(
-            TextInput.PlaceholderColor.R,
-            TextInput.PlaceholderColor.G,
-            TextInput.PlaceholderColor.B,
-            TextInput.PlaceholderColor.A
-        );
+    return HAS_CHANGED;
+}
 
-        ForegroundDrawList->AddText(PlaceholderPosition, PlaceholderColor, TextInput.Placeholder.c_str());
+void Gui::DrawTextInputMultiline(std::string& Value, TextInput& TextInput) const
+{
+    if (TextInput.Style)
+    {
+        PushStyle(*TextInput.Style);
+    }
+    else
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, TextInput.BorderSize);
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ToImVec2(TextInput.Padding));
+        ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, TextInput.CornerRounding);
+        ImGui::PushStyleColor(ImGuiCol_FrameBg, TextInput.BgColor.Packed);
+        ImGui::PushStyleColor(ImGuiCol_Text, TextInput.TextColor.Packed);
     }
 
-    ImGui::PopStyleVar(3);
-    ImGui::PopStyleColor(2);
+    // NOTE: ## prefix tells ImGui to use the string for internal ID generation but not to display it as a visible label
+    const char* ID = m_FrameArena.Concat("##", TextInput.ID);
+    ImGui::InputTextMultiline(ID, &Value, ToImVec2(TextInput.Size));
+
+    DrawTextInputPlaceholder(Value, TextInput);
+
+    if (TextInput.Style)
+    {
+        PopStyle(*TextInput.Style);
+    }
+    else
+    {
+        ImGui::PopStyleVar(3);
+        ImGui::PopStyleColor(2);
+    }
 }
 
 void Gui::DrawTreeNode(const TreeNode& RootTreeNode) const
 {
-    if (ImGui::TreeNode(RootTreeNode.Name.c_str()))
+    if (ImGui::TreeNode(ToCString(RootTreeNode.Name)))
     {
         for (const TreeNode& Child : RootTreeNode.Children)
         {
@@ -222,16 +410,45 @@ void Gui::DrawWindow(Window& Window) const
     if (!Window.IsCollapsible) Flags |= ImGuiWindowFlags_NoCollapse;
     if (!Window.IsMovable) Flags |= ImGuiWindowFlags_NoMove;
 
-    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ToImVec2(Window.Padding));
-    ImGui::PushStyleColor(ImGuiCol_WindowBg, ToImVec4(Window.BgColor.ToVector4()));
+    if (Window.Style)
+    {
+        PushStyle(*Window.Style);
+    }
+    else
+    {
+        ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ToImVec2(Window.Padding));
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, Window.BgColor.Packed);
+    }
 
     ImGui::SetNextWindowPos(ToImVec2(Window.Position));
     ImGui::SetNextWindowSize(ToImVec2(Window.Size));
-    if (ImGui::Begin(Window.Name.c_str(), &IsOpen, Flags)) Window.DrawContent();
+    if (ImGui::Begin(ToCString(Window.Name), &IsOpen, Flags)) Window.DrawContent();
     ImGui::End();
 
-    ImGui::PopStyleVar(1);
-    ImGui::PopStyleColor(1);
+    if (Window.Style)
+    {
+        PopStyle(*Window.Style);
+    }
+    else
+    {
+        ImGui::PopStyleVar(1);
+        ImGui::PopStyleColor(1);
+    }
+}
+
+FrameArena& Gui::GetFrameArena() const
+{
+    return m_FrameArena;
+}
+
+FrameProfiler& Gui::GetFrameProfiler() const
+{
+    return m_FrameProfiler;
+}
+
+uint64_t Gui::GetFrameAllocationCount() const
+{
+    return m_FrameAllocationCount;
 }
 
 void Gui::AlignCenter(Vector2 ElementSize) const
@@ -334,14 +551,8 @@ void Gui::DrawImagePositioned(const ImagePositioned& ImagePositioned) const
     ImDrawList* WindowDrawList = ImGui::GetWindowDrawList();
 
     ImVec2 Size = ImVec2(ImagePositioned.Position.X + ImagePositioned.Image.Size.X, ImagePositioned.Position.Y + ImagePositioned.Image.Size.Y);
-    ImVec2 UvPositionStart = ImVec2(0.0f, 0.0f);
-    ImVec2 UvPositionEnd = ImVec2(1.0f, 1.0f);
-    ImU32 TintColor = IM_COL32(
-        ImagePositioned.Image.TintColor.R,
-        ImagePositioned.Image.TintColor.G,
-        ImagePositioned.Image.TintColor.B,
-        ImagePositioned.Image.TintColor.A
-    );
+    ImVec2 UvPositionStart = ToImVec2(ImagePositioned.Image.UvMin);
+    ImVec2 UvPositionEnd = ToImVec2(ImagePositioned.Image.UvMax);
 
     WindowDrawList->AddImageRounded(
         ImagePositioned.Image.TextureID,
@@ -349,12 +560,36 @@ void Gui::DrawImagePositioned(const ImagePositioned& ImagePositioned) const
         Size,
         UvPositionStart,
         UvPositionEnd,
-        TintColor,
+        ImagePositioned.Image.TintColor.Packed,
         ImagePositioned.Image.CornerRounding,
         ImDrawFlags_RoundCornersAll
     );
 }
 
+// NOTE: Drawn on top of the last text input while its value is empty
+void Gui::DrawTextInputPlaceholder(const std::string& Value, const TextInput& TextInput) const
+{
+    if (!TextInput.Placeholder.empty() && Value.size() == 0)
+    {
+        ImGuiStyle& style = ImGui::GetStyle();
+        ImVec2 FramePadding = style.FramePadding;
+
+        ImDrawList* ForegroundDrawList = ImGui::GetForegroundDrawList();
+        ImVec2 BoundingBoxMinPosition = ImGui::GetItemRectMin();
+
+        ImVec2 PlaceholderPosition(
+            BoundingBoxMinPosition.x + FramePadding.x,
+            BoundingBoxMinPosition.y + FramePadding.y
+        );
+        ForegroundDrawList->AddText(
+            PlaceholderPosition,
+            TextInput.PlaceholderColor.Packed,
+            TextInput.Placeholder.data(),
+            TextInput.Placeholder.data() + TextInput.Placeholder.size()
+        );
+    }
+}
+
 const Vector2 Gui::ToVector2(const ImVec2& ImguiVec2) const
 {
     return Vector2(ImguiVec2.x, ImguiVec2.y);
@@ -374,3 +609,35 @@ const ImVec4 Gui::ToImVec4(const Vector4& Vector4) const
 {
     return ImVec4(Vector4.X, Vector4.Y, Vector4.Z, Vector4.W);
 }
+
+const char* Gui::ToCString(GuiString String) const
+{
+    if (String.IsNullTerminated()) return String.data();
+
+    // NOTE: Plain views are not guaranteed to be null terminated, copies them into the frame arena for ImGui
+    return m_FrameArena.Copy(String);
+}
+
+void Gui::CompactFontAtlas() const
+{
+    ImFontAtlas* FontAtlas = ImGui::GetIO().Fonts;
+    if (!FontAtlas->TexData || !FontAtlas->Builder) return;
+
+    const int COMPACT_PIXELS_COUNT = GUI_FONT_ATLAS_COMPACT_SIZE * GUI_FONT_ATLAS_COMPACT_SIZE;
+    if (FontAtlas->TexData->Width * FontAtlas->TexData->Height <= COMPACT_PIXELS_COUNT) return;
+
+    const double TIME = ImGui::GetTime();
+    if (m_FontAtlasCompactedAt > 0.0 && TIME - m_FontAtlasCompactedAt < GUI_FONT_ATLAS_COMPACT_INTERVAL) return;
+
+    // NOTE: ImGui stamps every baked font size with the last frame it was drawn in, only the stale ones are dropped
+    ImFontAtlasBuilder* Builder = FontAtlas->Builder;
+    const int DISCARDED_COUNT = Builder->BakedDiscardedCount;
+    ImFontAtlasBuildDiscardBakes(FontAtlas, GUI_FONT_ATLAS_STALE_FRAMES);
+    if (Builder->BakedDiscardedCount == DISCARDED_COUNT) return;
+    m_FontAtlasCompactedAt = TIME;
+
+    // Shrinks the texture to what is left, sizes still drawn keep their glyphs
+    // NOTE: Runs between frames so no draw list still points into the old texture
+    const ImVec2i TEXTURE_SIZE = ImFontAtlasTextureGetSizeEstimate(FontAtlas);
+    ImFontAtlasTextureRepack(FontAtlas, TEXTURE_SIZE.x, TEXTURE_SIZE.y);
+}
@@ -0,0 +1,318 @@
+#include "WidgetTree.h"
+
+#include <algorithm>
+#include <utility>
+
+// **********
+// * PUBLIC *
+// **********
+WidgetHandle WidgetTree::Add(WidgetHandle Parent, Widget Widget)
+{
+    uint32_t Index = 0;
+    if (!m_FreeIndices.empty())
+    {
+        Index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+    }
+    else
+    {
+        Index = static_cast<uint32_t>(m_Slots.size());
+        m_Slots.emplace_back();
+    }
+
+    Slot& NewSlot = m_Slots[Index];
+    const WidgetHandle HANDLE = WidgetHandle{Index, NewSlot.Generation};
+
+    NewSlot.Value = std::move(Widget);
+    NewSlot.OwnedString.reset();
+    NewSlot.Parent = Parent;
+    NewSlot.Children.clear();
+    NewSlot.LayoutAvailableSpace = Vector2(-1.0f, -1.0f);
+    NewSlot.IsOccupied = true;
+    NewSlot.IsDirty = true;
+
+    // NOTE: Bound once here so walking the tree never allocates a new callable (this + handle fit std::function's local storage)
+    if (NewSlot.Value.Type == WidgetType::Container)
+    {
+        std::get<Container>(NewSlot.Value.Content).DrawContent = [this, HANDLE](const ContainerState& State) {
+            DrawChildren(*m_DrawingGui, HANDLE, State);
+        };
+    }
+
+    GuiString* StringField = GetStringField(NewSlot.Value);
+    if (StringField) SetString(HANDLE, *StringField);
+
+    Slot* ParentSlot = GetSlot(Parent);
+    if (ParentSlot) ParentSlot->Children.push_back(HANDLE);
+
+    return HANDLE;
+}
+
+WidgetHandle WidgetTree::AddContainer(WidgetHandle Parent, Container Container)
+{
+    Widget NewWidget = {};
+    NewWidget.Type = WidgetType::Container;
+    NewWidget.Content = std::move(Container);
+    return Add(Parent, std::move(NewWidget));
+}
+
+WidgetHandle WidgetTree::AddButton(WidgetHandle Parent, Button Button)
+{
+    Widget NewWidget = {};
+    NewWidget.Type = WidgetType::Button;
+    NewWidget.Content = std::move(Button);
+    return Add(Parent, std::move(NewWidget));
+}
+
+WidgetHandle WidgetTree::AddImage(WidgetHandle Parent, Image Image)
+{
+    Widget NewWidget = {};
+    NewWidget.Type = WidgetType::Image;
+    NewWidget.Content = std::move(Image);
+    return Add(Parent, std::move(NewWidget));
+}
+
+WidgetHandle WidgetTree::AddImageButton(WidgetHandle Parent, ImageButton ImageButton)
+{
+    Widget NewWidget = {};
+    NewWidget.Type = WidgetType::ImageButton;
+    NewWidget.Content = std::move(ImageButton);
+    return Add(Parent, std::move(NewWidget));
+}
+
+WidgetHandle WidgetTree::AddText(WidgetHandle Parent, Text Text, bool IsWrapped)
+{
+    Widget NewWidget = {};
+    NewWidget.Type = IsWrapped ? WidgetType::TextWrapped : WidgetType::Text;
+    NewWidget.Content = std::move(Text);
+    return Add(Parent, std::move(NewWidget));
+}
+
+void WidgetTree::Remove(WidgetHandle Handle)
+{
+    Slot* HandleSlot = GetSlot(Handle);
+    if (!HandleSlot) return;
+
+    RemoveChildren(Handle);
+
+    // Detaches widget from its parent
+    Slot* ParentSlot = GetSlot(HandleSlot->Parent);
+    if (ParentSlot)
+    {
+        std::vector<WidgetHandle>& Siblings = ParentSlot->Children;
+        Siblings.erase(std::remove(Siblings.begin(), Siblings.end(), Handle), Siblings.end());
+    }
+
+    // NOTE: Bumping the generation invalidates every handle still pointing at this slot
+    HandleSlot->Value = {};
+    HandleSlot->OwnedString.reset();
+    HandleSlot->Parent = {};
+    HandleSlot->Generation++;
+    HandleSlot->IsOccupied = false;
+    m_FreeIndices.push_back(Handle.Index);
+}
+
+void WidgetTree::RemoveChildren(WidgetHandle Handle)
+{
+    Slot* HandleSlot = GetSlot(Handle);
+    if (!HandleSlot) return;
+
+    // NOTE: Moved out first since removing each child edits the children list
+    std::vector<WidgetHandle> Children = std::move(HandleSlot->Children);
+    for (const WidgetHandle& Child : Children)
+    {
+        Slot* ChildSlot = GetSlot(Child);
+        if (ChildSlot) ChildSlot->Parent = {};
+        Remove(Child);
+    }
+
+    // NOTE: Gives the buffer back to keep its capacity for the next children
+    Children.clear();
+    HandleSlot = GetSlot(Handle);
+    HandleSlot->Children = std::move(Children);
+    HandleSlot->IsDirty = true;
+}
+
+void WidgetTree::SetChildren(WidgetHandle Handle, const std::vector<WidgetHandle>& Children)
+{
+    Slot* HandleSlot = GetSlot(Handle);
+    if (!HandleSlot) return;
+
+    // NOTE: Reuses the existing capacity, reordering children does not allocate once the list reached its size
+    HandleSlot->Children.assign(Children.begin(), Children.end());
+    HandleSlot->IsDirty = true;
+}
+
+void WidgetTree::Clear()
+{
+    for (uint32_t Index = 0; Index < m_Slots.size(); Index++)
+    {
+        Slot& IndexSlot = m_Slots[Index];
+        if (!IndexSlot.IsOccupied) continue;
+
+        IndexSlot.Value = {};
+        IndexSlot.OwnedString.reset();
+        IndexSlot.Parent = {};
+        IndexSlot.Children.clear();
+        IndexSlot.Generation++;
+        IndexSlot.IsOccupied = false;
+        m_FreeIndices.push_back(Index);
+    }
+}
+
+void WidgetTree::SetString(WidgetHandle Handle, std::string_view Value)
+{
+    Slot* HandleSlot = GetSlot(Handle);
+    if (!HandleSlot) return;
+
+    GuiString* StringField = GetStringField(HandleSlot->Value);
+    if (!StringField) return;
+
+    // NOTE: Reuses the existing buffer, assign handles Value being a view into it
+    if (HandleSlot->OwnedString)
+    {
+        HandleSlot->OwnedString->assign(Value.data(), Value.size());
+    }
+    else
+    {
+        HandleSlot->OwnedString = std::make_unique<std::string>(Value);
+    }
+
+    *StringField = *HandleSlot->OwnedString;
+    HandleSlot->IsDirty = true;
+}
+
+const Widget* WidgetTree::Get(WidgetHandle Handle) const
+{
+    const Slot* HandleSlot = GetSlot(Handle);
+    return HandleSlot ? &HandleSlot->Value : nullptr;
+}
+
+Widget* WidgetTree::Edit(WidgetHandle Handle)
+{
+    Slot* HandleSlot = GetSlot(Handle);
+    if (!HandleSlot) return nullptr;
+
+    HandleSlot->IsDirty = true;
+    return &HandleSlot->Value;
+}
+
+bool WidgetTree::IsDirty(WidgetHandle Handle) const
+{
+    const Slot* HandleSlot = GetSlot(Handle);
+    return HandleSlot && HandleSlot->IsDirty;
+}
+
+size_t WidgetTree::GetSize() const
+{
+    return m_Slots.size() - m_FreeIndices.size();
+}
+
+void WidgetTree::Draw(const Gui& Gui, WidgetHandle Root)
+{
+    m_DrawingGui = &Gui;
+    DrawWidget(Gui, Root, Gui.GetAvailableSpace(), {});
+}
+
+void WidgetTree::DrawChildren(const Gui& Gui, WidgetHandle Root, const ContainerState& ParentState)
+{
+    m_DrawingGui = &Gui;
+
+    const Vector2 AVAILABLE_SPACE = Gui.GetAvailableSpace();
+
+    // NOTE: Indexed loop because slots are re-fetched after every child, callbacks may edit widgets
+    for (size_t i = 0;; i++)
+    {
+        const Slot* RootSlot = GetSlot(Root);
+        if (!RootSlot || i >= RootSlot->Children.size()) break;
+
+        DrawWidget(Gui, RootSlot->Children[i], AVAILABLE_SPACE, ParentState);
+    }
+}
+
+// ***********
+// * PRIVATE *
+// ***********
+GuiString* WidgetTree::GetStringField(Widget& Widget)
+{
+    switch (Widget.Type)
+    {
+    case WidgetType::Container:
+        return &std::get<Container>(Widget.Content).ID;
+    case WidgetType::Button:
+        return &std::get<Button>(Widget.Content).Label;
+    case WidgetType::ImageButton:
+        return &std::get<ImageButton>(Widget.Content).ID;
+    case WidgetType::Text:
+    case WidgetType::TextWrapped:
+        return &std::get<Text>(Widget.Content).Value;
+    default:
+        return nullptr;
+    }
+}
+
+WidgetTree::Slot* WidgetTree::GetSlot(WidgetHandle Handle)
+{
+    if (Handle.Index >= m_Slots.size()) return nullptr;
+
+    Slot& HandleSlot = m_Slots[Handle.Index];
+    if (!HandleSlot.IsOccupied || HandleSlot.Generation != Handle.Generation) return nullptr;
+
+    return &HandleSlot;
+}
+
+const WidgetTree::Slot* WidgetTree::GetSlot(WidgetHandle Handle) const
+{
+    if (Handle.Index >= m_Slots.size()) return nullptr;
+
+    const Slot& HandleSlot = m_Slots[Handle.Index];
+    if (!HandleSlot.IsOccupied || HandleSlot.Generation != Handle.Generation) return nullptr;
+
+    return &HandleSlot;
+}
+
+void WidgetTree::DrawWidget(const Gui& Gui, WidgetHandle Handle, const Vector2& AvailableSpace, const ContainerState& ParentState)
+{
+    Slot* HandleSlot = GetSlot(Handle);
+    if (!HandleSlot) return;
+
+    Widget& HandleWidget = HandleSlot->Value;
+    if (!HandleWidget.IsVisible) return;
+    if (HandleWidget.IsVisibleOnParentHover && !ParentState.IsHovered) return;
+
+    // Recomputes layout only when something changed since the last frame
+    const bool HAS_AVAILABLE_SPACE_CHANGED = HandleSlot->LayoutAvailableSpace.X != AvailableSpace.X ||
+                                             HandleSlot->LayoutAvailableSpace.Y != AvailableSpace.Y;
+    if (HandleWidget.OnLayout && (HandleSlot->IsDirty || HAS_AVAILABLE_SPACE_CHANGED))
+    {
+        HandleWidget.OnLayout(HandleWidget, AvailableSpace);
+    }
+    HandleSlot->LayoutAvailableSpace = AvailableSpace;
+    HandleSlot->IsDirty = false;
+
+    if (HandleWidget.IsInline) Gui.DisplayInline();
+    if (HandleWidget.Position.X >= 0.0f) Gui.SetPositionX(HandleWidget.Position.X);
+    if (HandleWidget.Position.Y >= 0.0f) Gui.SetPositionY(HandleWidget.Position.Y);
+
+    switch (HandleWidget.Type)
+    {
+    case WidgetType::Container:
+        Gui.DrawContainer(std::get<Container>(HandleWidget.Content));
+        break;
+    case WidgetType::Button:
+        Gui.DrawButton(std::get<Button>(HandleWidget.Content));
+        break;
+    case WidgetType::Image:
+        Gui.DrawImage(std::get<Image>(HandleWidget.Content));
+        break;
+    case WidgetType::ImageButton:
+        Gui.DrawImageButton(std::get<ImageButton>(HandleWidget.Content));
+        break;
+    case WidgetType::Text:
+        Gui.DrawText(std::get<Text>(HandleWidget.Content));
+        break;
+    case WidgetType::TextWrapped:
+        Gui.DrawTextWrapped(std::get<Text>(HandleWidget.Content));
+        break;
+    }
+}
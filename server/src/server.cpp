@@ -1,16 +1,98 @@
+#include "ClusterNode.h"
+#include "ConsistentHashRing.h"
 #include "SocketServer.h"
 
+#include <atomic>
 #include <cstdlib>
+#include <iostream>
 #include <string>
+#include <thread>
+
+constexpr int CLUSTER_UPDATE_TIMEOUT_MILLISECONDS = 100;
+
+// NOTE: CLUSTER_PEERS lists the other nodes as "NodeID@Host:Port" separated by commas, every peer is linked and put on
+// the ownership ring
+void AddClusterPeers(ClusterNode &cluster_node, ConsistentHashRing &ownership_ring, const std::string &peers)
+{
+	size_t start = 0;
+	while (start < peers.size())
+	{
+		size_t end = peers.find(',', start);
+		if (end == std::string::npos)
+			end = peers.size();
+
+		const std::string peer = peers.substr(start, end - start);
+		const size_t at_index = peer.find('@');
+		const size_t colon_index = peer.rfind(':');
+		if (at_index != std::string::npos && colon_index != std::string::npos && colon_index > at_index)
+		{
+			const std::string node_id = peer.substr(0, at_index);
+			ownership_ring.AddNode(node_id);
+			cluster_node.AddPeer(ClusterPeer{node_id, peer.substr(at_index + 1, colon_index - at_index - 1),
+			                                 static_cast<uint16_t>(std::atoi(peer.c_str() + colon_index + 1))});
+		}
+		else
+		{
+			std::cerr << "Ignoring malformed cluster peer " << peer << std::endl;
+		}
+
+		start = end + 1;
+	}
+}
 
 int main()
 {
 	const int PORT = std::stoi(std::getenv("PORT"));
 
+	// NOTE: Clustering is optional, a single server runs without CLUSTER_NODE_ID
+	const char *CLUSTER_NODE_ID = std::getenv("CLUSTER_NODE_ID");
+	const char *CLUSTER_PORT = std::getenv("CLUSTER_PORT");
+	const char *CLUSTER_PEERS = std::getenv("CLUSTER_PEERS");
+	std::atomic<bool> is_cluster_running = true;
+	std::thread cluster_thread;
+	if (CLUSTER_NODE_ID != nullptr && CLUSTER_PORT != nullptr)
+	{
+		cluster_thread = std::thread([CLUSTER_NODE_ID, CLUSTER_PORT, CLUSTER_PEERS, &is_cluster_running]() {
+			ClusterNode cluster_node(CLUSTER_NODE_ID);
+			if (!cluster_node.Listen(static_cast<uint16_t>(std::stoi(CLUSTER_PORT))))
+			{
+				std::cerr << "Cluster port " << CLUSTER_PORT << " could not be bound" << std::endl;
+				return;
+			}
+
+			// NOTE: Owners of conversations among the configured nodes, every node lists the same nodes so they all
+			// build the same ring whichever links are up, a link flapping never moves a conversation
+			ConsistentHashRing ownership_ring;
+			ownership_ring.AddNode(CLUSTER_NODE_ID);
+			if (CLUSTER_PEERS != nullptr)
+				AddClusterPeers(cluster_node, ownership_ring, CLUSTER_PEERS);
+
+			cluster_node.SetOnMembershipChanged([](const std::string &node_id, bool is_joined) {
+				std::cout << "Cluster node " << node_id << (is_joined ? " linked" : " unlinked") << std::endl;
+			});
+
+			// NOTE: No message handler yet, the socket server has no local members to fan forwarded messages out to
+
+			std::cout << "Cluster node " << CLUSTER_NODE_ID << " listening on port " << cluster_node.GetPort() << ", "
+			          << ownership_ring.GetNodesCount() << " nodes own conversations ..."
+			          << "\n"
+			          << std::endl;
+			while (is_cluster_running)
+			{
+				cluster_node.Update(CLUSTER_UPDATE_TIMEOUT_MILLISECONDS);
+			}
+		});
+	}
+
 	SocketServer socket_server;
 	socket_server.Init(PORT);
 	socket_server.Listen(PORT);
 	socket_server.Close();
 
+	// NOTE: Stops within one update timeout, the cluster node closes its links when it goes out of scope
+	is_cluster_running = false;
+	if (cluster_thread.joinable())
+		cluster_thread.join();
+
 	return 0;
 }
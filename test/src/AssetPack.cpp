@@ -0,0 +1,94 @@
+#include "AssetPack.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+const std::string ASSET_PACK_TEST_FILE_PATH = "AssetPackTest.pack";
+
+void WritePack(const AssetPackHeader &Header, const AssetPackEntry &Entry, const std::string &Data)
+{
+	FILE *File = std::fopen(ASSET_PACK_TEST_FILE_PATH.c_str(), "wb");
+	std::fwrite(&Header, sizeof(Header), 1, File);
+	std::fwrite(&Entry, sizeof(Entry), 1, File);
+	std::fwrite(Data.data(), 1, Data.size(), File);
+	std::fclose(File);
+}
+
+AssetPackEntry MakeEntry(const char *Name, uint64_t Size)
+{
+	AssetPackEntry Entry = {};
+	std::strncpy(Entry.Name, Name, ASSET_PACK_NAME_SIZE - 1);
+	Entry.Type = AssetType::Font;
+	Entry.Offset = sizeof(AssetPackHeader) + sizeof(AssetPackEntry);
+	Entry.Size = Size;
+	return Entry;
+}
+} // namespace
+
+TEST(AssetPackTest, FindsAssetsByName)
+{
+	AssetPackHeader Header = {};
+	Header.EntriesCount = 1;
+	const std::string DATA = "font bytes";
+	WritePack(Header, MakeEntry("Font", DATA.size()), DATA);
+
+	AssetPack Pack = {};
+	ASSERT_TRUE(Pack.Open(ASSET_PACK_TEST_FILE_PATH));
+
+	const AssetPackEntry *Entry = Pack.Find("Font");
+	ASSERT_NE(Entry, nullptr);
+	EXPECT_EQ(Entry->Type, AssetType::Font);
+	EXPECT_EQ(std::string(reinterpret_cast<const char *>(Pack.GetData(*Entry)), Entry->Size), DATA);
+	EXPECT_EQ(Pack.Find("Missing"), nullptr);
+
+	Pack.Close();
+	EXPECT_FALSE(Pack.IsOpen());
+	std::remove(ASSET_PACK_TEST_FILE_PATH.c_str());
+}
+
+TEST(AssetPackTest, RejectsInvalidPacks)
+{
+	AssetPack Pack = {};
+	EXPECT_FALSE(Pack.Open("MissingAssetPackTest.pack"));
+
+	// Stale version
+	AssetPackHeader Header = {};
+	Header.EntriesCount = 1;
+	Header.Version = ASSET_PACK_VERSION + 1;
+	WritePack(Header, MakeEntry("Font", 4), "data");
+	EXPECT_FALSE(Pack.Open(ASSET_PACK_TEST_FILE_PATH));
+
+	// Asset data past the end of the file
+	Header.Version = ASSET_PACK_VERSION;
+	WritePack(Header, MakeEntry("Font", 64), "data");
+	EXPECT_FALSE(Pack.Open(ASSET_PACK_TEST_FILE_PATH));
+	EXPECT_FALSE(Pack.IsOpen());
+
+	// Image dimensions needing more pixels than the entry holds
+	AssetPackEntry ImageEntry = MakeEntry("Image", 4);
+	ImageEntry.Type = AssetType::Image;
+	ImageEntry.Width = 2;
+	ImageEntry.Height = 1;
+	ImageEntry.ChannelsCount = 4;
+	WritePack(Header, ImageEntry, "data");
+	EXPECT_FALSE(Pack.Open(ASSET_PACK_TEST_FILE_PATH));
+
+	// Dimensions whose product overflows
+	ImageEntry.Width = 0x80000000u;
+	ImageEntry.Height = 0x80000000u;
+	WritePack(Header, ImageEntry, "data");
+	EXPECT_FALSE(Pack.Open(ASSET_PACK_TEST_FILE_PATH));
+
+	ImageEntry.Width = 1;
+	ImageEntry.Height = 1;
+	WritePack(Header, ImageEntry, "data");
+	EXPECT_TRUE(Pack.Open(ASSET_PACK_TEST_FILE_PATH));
+	Pack.Close();
+
+	std::remove(ASSET_PACK_TEST_FILE_PATH.c_str());
+}
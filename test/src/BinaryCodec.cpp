@@ -0,0 +1,157 @@
+#include "ModelSchemas.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+
+namespace
+{
+Message MakeMessage()
+{
+	Message NewMessage = {};
+	NewMessage.ID = "Message1";
+	NewMessage.ConversationID = "Conversation1";
+	NewMessage.SenderID = "User1";
+	NewMessage.SenderFirstName = "Olivier";
+	NewMessage.SenderImageUrl = "https://example.com/avatar.png";
+	NewMessage.Text = "Hello there";
+	NewMessage.CreatedAt = 1700000000;
+	NewMessage.Nonce = 0x1234567800000001ull;
+	NewMessage.Sequence = 42;
+	return NewMessage;
+}
+
+struct ProfileV1
+{
+	std::string Name;
+	int32_t Age = 0;
+};
+
+struct ProfileV2
+{
+	std::string Name;
+	int32_t Age = 0;
+	std::string Bio = "Unset";
+};
+} // namespace
+
+template <> struct BinarySchema<ProfileV1>
+{
+	static constexpr uint16_t VERSION = 1;
+	static constexpr auto FIELDS = std::make_tuple(&ProfileV1::Name, &ProfileV1::Age);
+};
+
+template <> struct BinarySchema<ProfileV2>
+{
+	static constexpr uint16_t VERSION = 2;
+	static constexpr auto FIELDS = std::make_tuple(&ProfileV2::Name, &ProfileV2::Age, &ProfileV2::Bio);
+};
+
+TEST(BinaryCodecTest, ReadsMessageWithoutCopying)
+{
+	const Message SENT_MESSAGE = MakeMessage();
+	std::string Buffer;
+	EncodeBinary(SENT_MESSAGE, Buffer);
+
+	const BinaryView<Message> VIEW(Buffer);
+	ASSERT_TRUE(VIEW.IsValid());
+	EXPECT_EQ(VIEW.GetSize(), Buffer.size());
+	EXPECT_EQ(VIEW.GetVersion(), BinarySchema<Message>::VERSION);
+
+	const std::string_view TEXT = VIEW.Get<&Message::Text>();
+	EXPECT_EQ(TEXT, SENT_MESSAGE.Text);
+	EXPECT_GE(TEXT.data(), Buffer.data());
+	EXPECT_LT(TEXT.data(), Buffer.data() + Buffer.size());
+	EXPECT_EQ(VIEW.Get<&Message::CreatedAt>(), SENT_MESSAGE.CreatedAt);
+	EXPECT_EQ(VIEW.Get<&Message::Nonce>(), SENT_MESSAGE.Nonce);
+
+	Message ReceivedMessage = {};
+	ASSERT_TRUE(DecodeBinary(VIEW, ReceivedMessage));
+	EXPECT_EQ(ReceivedMessage.SenderImageUrl, SENT_MESSAGE.SenderImageUrl);
+	EXPECT_EQ(ReceivedMessage.Sequence, SENT_MESSAGE.Sequence);
+}
+
+TEST(BinaryCodecTest, ReadsNestedLists)
+{
+	Conversation SentConversation = {};
+	SentConversation.ID = "Conversation1";
+	SentConversation.CreatedAt = 1700000000;
+	SentConversation.LastActivityAt = 1700000100;
+	SentConversation.Users = {User{"User1", "Olivier", "A"}, User{"User2", "Jim", "B"}};
+	for (int i = 0; i < 3; i++)
+	{
+		Message NewMessage = MakeMessage();
+		NewMessage.Text += std::to_string(i);
+		SentConversation.Messages.push_back(NewMessage);
+	}
+
+	std::string Buffer = "Prefix";
+	EncodeBinary(SentConversation, Buffer);
+
+	const BinaryView<Conversation> VIEW(std::string_view(Buffer).substr(6));
+	ASSERT_TRUE(VIEW.IsValid());
+	ASSERT_EQ(VIEW.Get<&Conversation::Messages>().size(), 3u);
+
+	int Index = 0;
+	for (const BinaryView<Message> MESSAGE : VIEW.Get<&Conversation::Messages>())
+	{
+		EXPECT_EQ(MESSAGE.Get<&Message::Text>(), "Hello there" + std::to_string(Index++));
+	}
+	EXPECT_EQ(Index, 3);
+
+	Conversation ReceivedConversation = {};
+	ASSERT_TRUE(DecodeBinary(VIEW, ReceivedConversation));
+	ASSERT_EQ(ReceivedConversation.Users.size(), 2u);
+	EXPECT_EQ(ReceivedConversation.Users[1].FirstName, "Jim");
+	EXPECT_EQ(ReceivedConversation.Messages[2].Text, "Hello there2");
+	EXPECT_EQ(ReceivedConversation.LastActivityAt, SentConversation.LastActivityAt);
+}
+
+TEST(BinaryCodecTest, ReadsOlderAndNewerVersions)
+{
+	ProfileV1 OldProfile = {"Olivier", 30};
+	std::string OldBuffer;
+	EncodeBinary(OldProfile, OldBuffer);
+
+	// Fields added since the record was written read as their default
+	ProfileV2 UpgradedProfile = {};
+	UpgradedProfile.Bio = "Stale";
+	ASSERT_TRUE(DecodeBinary(BinaryView<ProfileV2>(OldBuffer), UpgradedProfile));
+	EXPECT_EQ(UpgradedProfile.Name, "Olivier");
+	EXPECT_EQ(UpgradedProfile.Age, 30);
+	EXPECT_EQ(UpgradedProfile.Bio, "");
+	EXPECT_EQ(BinaryView<ProfileV2>(OldBuffer).GetVersion(), 1u);
+
+	// Fields unknown to the reader are skipped
+	ProfileV2 NewProfile = {"Jim", 40, "Writes code"};
+	std::string NewBuffer;
+	EncodeBinary(NewProfile, NewBuffer);
+	ProfileV1 DowngradedProfile = {};
+	ASSERT_TRUE(DecodeBinary(BinaryView<ProfileV1>(NewBuffer), DowngradedProfile));
+	EXPECT_EQ(DowngradedProfile.Name, "Jim");
+	EXPECT_EQ(DowngradedProfile.Age, 40);
+}
+
+TEST(BinaryCodecTest, RejectsMalformedRecords)
+{
+	Conversation SentConversation = {};
+	SentConversation.Messages = {MakeMessage()};
+	std::string Buffer;
+	EncodeBinary(SentConversation, Buffer);
+
+	// Every truncation is detected
+	for (size_t Size = 0; Size < Buffer.size(); Size++)
+	{
+		EXPECT_FALSE(BinaryView<Conversation>(std::string_view(Buffer.data(), Size)).IsValid());
+	}
+
+	// A string pointing past the record is rejected even though the header is intact
+	std::string Corrupted = Buffer;
+	const uint32_t OUT_OF_BOUNDS_LENGTH = static_cast<uint32_t>(Buffer.size());
+	std::memcpy(&Corrupted[sizeof(BinaryRecordHeader) + sizeof(uint32_t)], &OUT_OF_BOUNDS_LENGTH, sizeof(uint32_t));
+	EXPECT_FALSE(BinaryView<Conversation>(Corrupted).IsValid());
+
+	Conversation ReceivedConversation = {};
+	EXPECT_FALSE(DecodeBinary(BinaryView<Conversation>(Corrupted), ReceivedConversation));
+}
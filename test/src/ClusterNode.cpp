@@ -0,0 +1,158 @@
+#include "ClusterNode.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Updates every node until Predicate holds, false once the deadline passed
+bool UpdateUntil(const std::vector<ClusterNode *> &Nodes, const std::function<bool()> &Predicate)
+{
+	const auto DEADLINE = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!Predicate())
+	{
+		if (std::chrono::steady_clock::now() > DEADLINE)
+			return false;
+
+		for (ClusterNode *Node : Nodes)
+		{
+			Node->Update(1);
+		}
+	}
+	return true;
+}
+
+// Lists every node as a peer of every other one, as a server would from its configuration
+void ConnectAll(const std::vector<ClusterNode *> &Nodes)
+{
+	for (ClusterNode *Node : Nodes)
+	{
+		ASSERT_TRUE(Node->Listen(0));
+	}
+	for (ClusterNode *Node : Nodes)
+	{
+		for (ClusterNode *Peer : Nodes)
+		{
+			Node->AddPeer(ClusterPeer{Peer->GetNodeID(), "127.0.0.1", Peer->GetPort()});
+		}
+	}
+}
+
+Message MakeMessage(const std::string &ConversationID, uint64_t Sequence)
+{
+	Message NewMessage = {};
+	NewMessage.ID = "Message" + std::to_string(Sequence);
+	NewMessage.ConversationID = ConversationID;
+	NewMessage.SenderID = "User1";
+	NewMessage.Text = "Hello " + std::to_string(Sequence);
+	NewMessage.Sequence = Sequence;
+	return NewMessage;
+}
+} // namespace
+
+TEST(ClusterNodeTest, ForwardsOnceToEachSubscribedNode)
+{
+	ClusterNode NodeA("NodeA");
+	ClusterNode NodeB("NodeB");
+	ClusterNode NodeC("NodeC");
+	const std::vector<ClusterNode *> NODES = {&NodeA, &NodeB, &NodeC};
+	ConnectAll(NODES);
+
+	std::vector<Message> ReceivedByB;
+	std::vector<Message> ReceivedByC;
+	NodeB.SetOnMessage([&ReceivedByB](const Message &ForwardedMessage, const std::string &FromNodeID) {
+		EXPECT_EQ(FromNodeID, "NodeA");
+		ReceivedByB.push_back(ForwardedMessage);
+	});
+	NodeC.SetOnMessage([&ReceivedByC](const Message &ForwardedMessage, const std::string &FromNodeID) {
+		ReceivedByC.push_back(ForwardedMessage);
+	});
+
+	NodeB.Subscribe("Conversation1");
+	NodeC.Subscribe("Conversation1");
+	NodeC.Subscribe("Conversation2");
+	ASSERT_TRUE(UpdateUntil(NODES, [&NodeA]() {
+		return NodeA.HasRemoteSubscriber("NodeB", "Conversation1") &&
+		       NodeA.HasRemoteSubscriber("NodeC", "Conversation1");
+	}));
+
+	// More than a batch so the burst is split over several frames
+	const uint64_t MESSAGES_COUNT = CLUSTER_BATCH_MAX_MESSAGES * 2 + 10;
+	for (uint64_t Sequence = 1; Sequence <= MESSAGES_COUNT; Sequence++)
+	{
+		NodeA.Publish(MakeMessage("Conversation1", Sequence));
+	}
+	// Nobody is subscribed to it, it is not forwarded at all
+	NodeA.Publish(MakeMessage("Conversation3", 1));
+	EXPECT_EQ(NodeA.GetForwardedCount(), MESSAGES_COUNT * 2);
+
+	ASSERT_TRUE(UpdateUntil(NODES, [&]() {
+		return ReceivedByB.size() >= MESSAGES_COUNT && ReceivedByC.size() >= MESSAGES_COUNT;
+	}));
+	EXPECT_EQ(ReceivedByB.size(), MESSAGES_COUNT);
+	EXPECT_EQ(ReceivedByC.size(), MESSAGES_COUNT);
+	for (uint64_t i = 0; i < MESSAGES_COUNT; i++)
+	{
+		EXPECT_EQ(ReceivedByB[i].Sequence, i + 1);
+		EXPECT_EQ(ReceivedByC[i].Text, "Hello " + std::to_string(i + 1));
+	}
+}
+
+TEST(ClusterNodeTest, StopsForwardingOnceUnsubscribed)
+{
+	ClusterNode NodeA("NodeA");
+	ClusterNode NodeB("NodeB");
+	const std::vector<ClusterNode *> NODES = {&NodeA, &NodeB};
+	ConnectAll(NODES);
+
+	size_t ReceivedCount = 0;
+	NodeB.SetOnMessage([&ReceivedCount](const Message &ForwardedMessage, const std::string &FromNodeID) {
+		ReceivedCount++;
+	});
+
+	// Subscribed before the link exists, the subscription set is sent once it is opened
+	NodeB.Subscribe("Conversation1");
+	ASSERT_TRUE(UpdateUntil(NODES, [&NodeA]() { return NodeA.HasRemoteSubscriber("NodeB", "Conversation1"); }));
+	NodeA.Publish(MakeMessage("Conversation1", 1));
+	ASSERT_TRUE(UpdateUntil(NODES, [&ReceivedCount]() { return ReceivedCount == 1; }));
+
+	NodeB.Unsubscribe("Conversation1");
+	ASSERT_TRUE(UpdateUntil(NODES, [&NodeA]() { return !NodeA.HasRemoteSubscriber("NodeB", "Conversation1"); }));
+	NodeA.Publish(MakeMessage("Conversation1", 2));
+	EXPECT_EQ(NodeA.GetForwardedCount(), 1u);
+}
+
+TEST(ClusterNodeTest, ReconnectsToRestartedPeer)
+{
+	ClusterNode NodeA("NodeA");
+	std::vector<std::string> MembershipChanges;
+	NodeA.SetOnMembershipChanged([&MembershipChanges](const std::string &NodeID, bool IsJoined) {
+		MembershipChanges.push_back((IsJoined ? "+" : "-") + NodeID);
+	});
+	std::unique_ptr<ClusterNode> NodeB = std::make_unique<ClusterNode>("NodeB");
+	ConnectAll({&NodeA, NodeB.get()});
+	const uint16_t PORT_B = NodeB->GetPort();
+	ASSERT_TRUE(UpdateUntil({&NodeA, NodeB.get()}, [&NodeA]() { return NodeA.IsConnected("NodeB"); }));
+
+	NodeB.reset();
+	ASSERT_TRUE(UpdateUntil({&NodeA}, [&NodeA]() { return !NodeA.IsConnected("NodeB"); }));
+
+	// Restarted on the same port, NodeA opens the link again after its reconnect delay
+	NodeB = std::make_unique<ClusterNode>("NodeB");
+	ASSERT_TRUE(NodeB->Listen(PORT_B));
+	size_t ReceivedCount = 0;
+	NodeB->SetOnMessage([&ReceivedCount](const Message &ForwardedMessage, const std::string &FromNodeID) {
+		ReceivedCount++;
+	});
+	NodeB->Subscribe("Conversation1");
+	ASSERT_TRUE(UpdateUntil({&NodeA, NodeB.get()}, [&NodeA]() { return NodeA.HasRemoteSubscriber("NodeB", "Conversation1"); }));
+
+	NodeA.Publish(MakeMessage("Conversation1", 1));
+	EXPECT_TRUE(UpdateUntil({&NodeA, NodeB.get()}, [&ReceivedCount]() { return ReceivedCount == 1; }));
+	EXPECT_EQ(MembershipChanges, std::vector<std::string>({"+NodeB", "-NodeB", "+NodeB"}));
+}
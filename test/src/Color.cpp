@@ -0,0 +1,26 @@
+#include "Color.h"
+
+#include "gtest/gtest.h"
+
+TEST(ColorTest, PacksChannelsAtCompileTime)
+{
+	constexpr Rgba COLOR = Rgba(50, 56, 102, 255);
+	static_assert(COLOR.Packed == 0xFF663832, "Channels are packed as 0xAABBGGRR");
+
+	EXPECT_EQ(COLOR.GetR(), 50);
+	EXPECT_EQ(COLOR.GetG(), 56);
+	EXPECT_EQ(COLOR.GetB(), 102);
+	EXPECT_EQ(COLOR.GetA(), 255);
+	EXPECT_FALSE(COLOR.IsEmpty());
+}
+
+TEST(ColorTest, ClampsChannelsAndTracksEmptyColors)
+{
+	constexpr Rgba COLOR = Rgba(-10, 300, 0, 0);
+	EXPECT_EQ(COLOR.GetR(), RGBA_MIN_VALUE);
+	EXPECT_EQ(COLOR.GetG(), RGBA_MAX_VALUE);
+
+	// NOTE: Transparent black is a set color, unlike a default constructed one
+	EXPECT_FALSE(Rgba(0, 0, 0, 0).IsEmpty());
+	EXPECT_TRUE(Rgba().IsEmpty());
+}
@@ -0,0 +1,165 @@
+#include "ConsistentHashRing.h"
+#include "ConversationShards.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+std::vector<std::string> MakeConversationIDs(size_t Count)
+{
+	std::vector<std::string> ConversationIDs;
+	for (size_t i = 0; i < Count; i++)
+	{
+		ConversationIDs.push_back("Conversation" + std::to_string(i));
+	}
+	return ConversationIDs;
+}
+
+bool AppendAndWait(ConversationShards &Shards, const Message &NewMessage)
+{
+	Shards.Append(NewMessage, 0);
+	ShardDelivery Delivery;
+	for (int i = 0; i < 1000; i++)
+	{
+		while (Shards.Poll(0, Delivery))
+		{
+			if (Delivery.IsAcknowledgement)
+				return true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+
+ConsistentHashRing MakeRing(const std::vector<std::string> &NodeIDs)
+{
+	ConsistentHashRing Ring;
+	for (const std::string &NodeID : NodeIDs)
+	{
+		Ring.AddNode(NodeID);
+	}
+	return Ring;
+}
+} // namespace
+
+TEST(ConsistentHashRingTest, SpreadsConversationsEvenly)
+{
+	const ConsistentHashRing RING = MakeRing({"NodeA", "NodeB", "NodeC", "NodeD"});
+	const std::vector<std::string> CONVERSATION_IDS = MakeConversationIDs(40000);
+
+	std::unordered_map<std::string, size_t> CountsByNodeID;
+	for (const std::string &ConversationID : CONVERSATION_IDS)
+	{
+		CountsByNodeID[RING.GetOwner(ConversationID)]++;
+	}
+
+	ASSERT_EQ(CountsByNodeID.size(), 4u);
+	const double AVERAGE_COUNT = CONVERSATION_IDS.size() / 4.0;
+	for (const auto &[NodeID, Count] : CountsByNodeID)
+	{
+		EXPECT_GT(Count, AVERAGE_COUNT * 0.85);
+		EXPECT_LT(Count, AVERAGE_COUNT * 1.15);
+	}
+}
+
+TEST(ConsistentHashRingTest, MovesOnlyConversationsOfTheJoiningOrLeavingNode)
+{
+	const ConsistentHashRing RING = MakeRing({"NodeA", "NodeB", "NodeC", "NodeD"});
+	const std::vector<std::string> CONVERSATION_IDS = MakeConversationIDs(20000);
+
+	// Owners only depend on the members, not on the order they joined in
+	const ConsistentHashRing SHUFFLED_RING = MakeRing({"NodeC", "NodeA", "NodeD", "NodeB"});
+	EXPECT_TRUE(RING.GetMoves(SHUFFLED_RING, CONVERSATION_IDS).empty());
+
+	ConsistentHashRing JoinedRing = RING;
+	EXPECT_TRUE(JoinedRing.AddNode("NodeE"));
+	EXPECT_FALSE(JoinedRing.AddNode("NodeE"));
+	const std::vector<ConversationMove> JOIN_MOVES = RING.GetMoves(JoinedRing, CONVERSATION_IDS);
+	for (const ConversationMove &Move : JOIN_MOVES)
+	{
+		EXPECT_EQ(Move.ToNodeID, "NodeE");
+	}
+	// About a fifth of the conversations move, to the new node only
+	EXPECT_GT(JOIN_MOVES.size(), CONVERSATION_IDS.size() * 15 / 100);
+	EXPECT_LT(JOIN_MOVES.size(), CONVERSATION_IDS.size() * 25 / 100);
+
+	ConsistentHashRing LeftRing = RING;
+	EXPECT_TRUE(LeftRing.RemoveNode("NodeB"));
+	EXPECT_FALSE(LeftRing.HasNode("NodeB"));
+	const std::vector<ConversationMove> LEAVE_MOVES = RING.GetMoves(LeftRing, CONVERSATION_IDS);
+	size_t OwnedByBCount = 0;
+	for (const std::string &ConversationID : CONVERSATION_IDS)
+	{
+		OwnedByBCount += RING.GetOwner(ConversationID) == "NodeB" ? 1 : 0;
+	}
+	EXPECT_EQ(LEAVE_MOVES.size(), OwnedByBCount);
+	for (const ConversationMove &Move : LEAVE_MOVES)
+	{
+		EXPECT_EQ(Move.FromNodeID, "NodeB");
+	}
+
+	EXPECT_EQ(ConsistentHashRing().GetOwner("Conversation1"), "");
+}
+
+TEST(ConsistentHashRingTest, RebalanceWarmsMovedConversationsOnly)
+{
+	std::mutex Mutex;
+	std::unordered_map<std::string, int> LoadCounts;
+	ConversationShards Shards(2, 1, [&Mutex, &LoadCounts](const std::string &ConversationID, ShardConversationState &State) {
+		std::lock_guard<std::mutex> Lock(Mutex);
+		LoadCounts[ConversationID]++;
+		State.MemberIDs = {"User1", "User2"};
+		return true;
+	}, [](Message &NewMessage) { return true; });
+
+	// What NodeE does once it joined, warms what it now owns
+	const ConsistentHashRing RING = MakeRing({"NodeA", "NodeB", "NodeC", "NodeD"});
+	ConsistentHashRing JoinedRing = RING;
+	JoinedRing.AddNode("NodeE");
+	const std::vector<std::string> CONVERSATION_IDS = MakeConversationIDs(200);
+	const std::vector<ConversationMove> MOVES = RING.GetMoves(JoinedRing, CONVERSATION_IDS);
+	ASSERT_GT(MOVES.size(), 1u);
+	for (const ConversationMove &Move : MOVES)
+	{
+		Shards.Warm(Move.ConversationID);
+	}
+
+	// A first message only waits for the store when its conversation was not warmed
+	const std::string &WARMED_ID = MOVES.front().ConversationID;
+	Message NewMessage = {};
+	NewMessage.ConversationID = WARMED_ID;
+	NewMessage.SenderID = "User1";
+	ASSERT_TRUE(AppendAndWait(Shards, NewMessage));
+	// Warms of the other shard may still be running
+	for (int i = 0; i < 1000; i++)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			if (LoadCounts.size() == MOVES.size())
+				break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		EXPECT_EQ(LoadCounts.size(), MOVES.size());
+		for (const ConversationMove &Move : MOVES)
+		{
+			EXPECT_EQ(LoadCounts[Move.ConversationID], 1);
+		}
+	}
+
+	// Moved away again, only that conversation is dropped and loaded back on its next message
+	Shards.Evict(WARMED_ID);
+	ASSERT_TRUE(AppendAndWait(Shards, NewMessage));
+	std::lock_guard<std::mutex> Lock(Mutex);
+	EXPECT_EQ(LoadCounts[WARMED_ID], 2);
+	EXPECT_EQ(LoadCounts[MOVES.back().ConversationID], 1);
+}
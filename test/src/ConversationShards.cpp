@@ -0,0 +1,138 @@
+#include "ConversationShards.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+bool WaitForDelivery(ConversationShards &Shards, size_t ReactorIndex, ShardDelivery &Delivery)
+{
+	for (int i = 0; i < 1000; i++)
+	{
+		if (Shards.Poll(ReactorIndex, Delivery))
+			return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+
+Message MakeMessage(const std::string &ConversationID, const std::string &SenderID, uint64_t Nonce)
+{
+	Message NewMessage = {};
+	NewMessage.ConversationID = ConversationID;
+	NewMessage.SenderID = SenderID;
+	NewMessage.Nonce = Nonce;
+	return NewMessage;
+}
+} // namespace
+
+TEST(ConversationShardsTest, QueueKeepsOrderOfEveryProducer)
+{
+	constexpr int PRODUCERS_COUNT = 4;
+	constexpr int VALUES_COUNT = 20000;
+	MpscQueue<int> Queue;
+
+	std::vector<std::thread> Producers;
+	for (int Producer = 0; Producer < PRODUCERS_COUNT; Producer++)
+	{
+		Producers.emplace_back([&Queue, Producer]() {
+			for (int i = 0; i < VALUES_COUNT; i++)
+			{
+				Queue.Push(Producer * VALUES_COUNT + i);
+			}
+		});
+	}
+
+	std::vector<int> NextValues(PRODUCERS_COUNT, 0);
+	int PoppedCount = 0;
+	bool IsOrdered = true;
+	while (PoppedCount < PRODUCERS_COUNT * VALUES_COUNT)
+	{
+		int Value = 0;
+		if (!Queue.TryPop(Value))
+			continue;
+
+		const int PRODUCER = Value / VALUES_COUNT;
+		IsOrdered = IsOrdered && Value % VALUES_COUNT == NextValues[PRODUCER];
+		NextValues[PRODUCER]++;
+		PoppedCount++;
+	}
+	for (std::thread &Producer : Producers)
+	{
+		Producer.join();
+	}
+
+	EXPECT_TRUE(IsOrdered);
+	EXPECT_TRUE(Queue.IsEmpty());
+}
+
+TEST(ConversationShardsTest, SequencesAndFansOutByReactor)
+{
+	ConversationShards Shards(
+	    4, 2,
+	    [](const std::string &ConversationID, ShardConversationState &State) {
+		    State.LastSequence = 10;
+		    return ConversationID == "Conversation1";
+	    },
+	    [](Message &NewMessage) {
+		    NewMessage.ID = "Message" + std::to_string(NewMessage.Sequence);
+		    return true;
+	    });
+	std::atomic<int> WakesCount = 0;
+	Shards.SetOnDelivery([&WakesCount](size_t ReactorIndex) { WakesCount++; });
+
+	Shards.Connect("Alice", 0);
+	Shards.Connect("Bob", 1);
+	Shards.Connect("Carol", 1);
+	Shards.SetMembers("Conversation1", {"Alice", "Bob", "Carol", "Dave"});
+	Shards.Append(MakeMessage("Conversation1", "Alice", 1), 0);
+
+	ShardDelivery Delivery;
+	ASSERT_TRUE(WaitForDelivery(Shards, 0, Delivery));
+	EXPECT_TRUE(Delivery.IsAcknowledgement);
+	EXPECT_TRUE(Delivery.RecipientIDs.empty());
+	EXPECT_EQ(Delivery.StoredMessage->Sequence, 11u);
+	EXPECT_EQ(Delivery.StoredMessage->ID, "Message11");
+
+	ASSERT_TRUE(WaitForDelivery(Shards, 1, Delivery));
+	EXPECT_FALSE(Delivery.IsAcknowledgement);
+	EXPECT_EQ(Delivery.RecipientIDs, std::vector<std::string>({"Bob", "Carol"}));
+	EXPECT_EQ(Delivery.StoredMessage->Nonce, 1u);
+
+	// Bob answers from reactor 1, Carol left so only Alice is delivered to
+	Shards.Disconnect("Carol", 1);
+	Shards.Append(MakeMessage("Conversation1", "Bob", 2), 1);
+	ASSERT_TRUE(WaitForDelivery(Shards, 0, Delivery));
+	EXPECT_FALSE(Delivery.IsAcknowledgement);
+	EXPECT_EQ(Delivery.RecipientIDs, std::vector<std::string>({"Alice"}));
+	ASSERT_TRUE(WaitForDelivery(Shards, 1, Delivery));
+	EXPECT_TRUE(Delivery.IsAcknowledgement);
+	EXPECT_TRUE(Delivery.RecipientIDs.empty());
+	EXPECT_EQ(Delivery.StoredMessage->Sequence, 12u);
+	EXPECT_GE(WakesCount.load(), 3);
+}
+
+TEST(ConversationShardsTest, LeavesFailedAppendsUnacknowledged)
+{
+	std::atomic<bool> IsFailing = true;
+	ConversationShards Shards(
+	    2, 1, [](const std::string &ConversationID, ShardConversationState &State) { return ConversationID == "Known"; },
+	    [&IsFailing](Message &NewMessage) { return !IsFailing.load(); });
+
+	Shards.Append(MakeMessage("Unknown", "Alice", 1), 0);
+	Shards.Append(MakeMessage("Known", "Alice", 2), 0);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	ShardDelivery Delivery;
+	EXPECT_FALSE(Shards.Poll(0, Delivery));
+
+	// The retry takes the sequence the failed append did not use
+	IsFailing = false;
+	Shards.Append(MakeMessage("Known", "Alice", 2), 0);
+	ASSERT_TRUE(WaitForDelivery(Shards, 0, Delivery));
+	EXPECT_EQ(Delivery.StoredMessage->Sequence, 1u);
+}
@@ -0,0 +1,75 @@
+#include "ConversationStore.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+Conversation MakeConversation(const std::string &ID, std::time_t CreatedAt)
+{
+	Conversation NewConversation = {};
+	NewConversation.ID = ID;
+	NewConversation.CreatedAt = CreatedAt;
+	return NewConversation;
+}
+
+std::vector<std::string> GetIDsByActivity(const ConversationStore &Store)
+{
+	std::vector<std::string> IDs;
+	for (const ConversationActivity &Activity : Store)
+	{
+		IDs.push_back(Store.Get(Activity.Handle)->ID);
+	}
+	return IDs;
+}
+} // namespace
+
+TEST(ConversationStoreTest, FindsConversationsByID)
+{
+	ConversationStore Store = {};
+	ConversationHandle Handle = Store.Add(MakeConversation("Conversation1", 10));
+
+	EXPECT_EQ(Store.Find("Conversation1"), Handle);
+	EXPECT_FALSE(Store.Find("Missing").IsValid());
+	EXPECT_EQ(Store.GetSize(), 1);
+}
+
+TEST(ConversationStoreTest, OrdersByLastActivity)
+{
+	ConversationStore Store = {};
+	Store.Add(MakeConversation("Conversation1", 10));
+	ConversationHandle Handle2 = Store.Add(MakeConversation("Conversation2", 20));
+	ConversationHandle Handle3 = Store.Add(MakeConversation("Conversation3", 30));
+
+	EXPECT_EQ(GetIDsByActivity(Store), (std::vector<std::string>{"Conversation3", "Conversation2", "Conversation1"}));
+
+	Message NewMessage = {};
+	NewMessage.Text = "Hello";
+	NewMessage.CreatedAt = 40;
+	Store.AddMessage(Handle2, NewMessage);
+
+	EXPECT_EQ(GetIDsByActivity(Store), (std::vector<std::string>{"Conversation2", "Conversation3", "Conversation1"}));
+	EXPECT_EQ(Store.GetMostRecent(), Handle2);
+	EXPECT_EQ(Store.Get(Handle2)->Messages.size(), 1);
+	EXPECT_EQ(Store.Get(Handle3)->LastActivityAt, 30);
+}
+
+TEST(ConversationStoreTest, HandlesStayStableAcrossRemovals)
+{
+	ConversationStore Store = {};
+	ConversationHandle Handle1 = Store.Add(MakeConversation("Conversation1", 10));
+	ConversationHandle Handle2 = Store.Add(MakeConversation("Conversation2", 20));
+
+	EXPECT_TRUE(Store.Remove(Handle1));
+	EXPECT_EQ(Store.Get(Handle1), nullptr);
+	EXPECT_FALSE(Store.Remove(Handle1));
+	EXPECT_EQ(Store.Get(Handle2)->ID, "Conversation2");
+
+	// NOTE: Reuses the freed slot, the stale handle must not resolve to the new conversation
+	ConversationHandle Handle3 = Store.Add(MakeConversation("Conversation3", 30));
+	EXPECT_EQ(Handle3.Index, Handle1.Index);
+	EXPECT_EQ(Store.Get(Handle1), nullptr);
+	EXPECT_EQ(Store.Get(Handle3)->ID, "Conversation3");
+}
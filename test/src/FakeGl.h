@@ -0,0 +1,105 @@
+#pragma once
+
+#include <GLAD/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+// NOTE: Replaces the texture functions loaded by glad with fakes so textures can be tested without a GL context
+// Only records what was uploaded, pixels are not copied
+
+struct FakeGlUpload
+{
+  public:
+	unsigned int TextureID = 0;
+	int X = 0;
+	int Y = 0;
+	int Width = 0;
+	int Height = 0;
+	const void *Pixels = nullptr;
+};
+
+struct FakeGlState
+{
+  public:
+	unsigned int NextTextureID = 1;
+	unsigned int BoundTextureID = 0;
+	size_t LiveTexturesCount = 0;
+	std::vector<FakeGlUpload> Uploads;
+};
+
+inline FakeGlState &GetFakeGlState()
+{
+	static FakeGlState State;
+	return State;
+}
+
+namespace FakeGl
+{
+inline void APIENTRY GenTextures(GLsizei Count, GLuint *TextureIDs)
+{
+	for (GLsizei i = 0; i < Count; i++)
+	{
+		TextureIDs[i] = GetFakeGlState().NextTextureID++;
+		GetFakeGlState().LiveTexturesCount++;
+	}
+}
+
+inline void APIENTRY DeleteTextures(GLsizei Count, const GLuint *TextureIDs)
+{
+	for (GLsizei i = 0; i < Count; i++)
+	{
+		if (TextureIDs[i] != 0)
+			GetFakeGlState().LiveTexturesCount--;
+	}
+}
+
+inline void APIENTRY BindTexture(GLenum Target, GLuint TextureID)
+{
+	GetFakeGlState().BoundTextureID = TextureID;
+}
+
+inline void APIENTRY TexImage2D(GLenum Target, GLint Level, GLint InternalFormat, GLsizei Width, GLsizei Height,
+                                GLint Border, GLenum Format, GLenum Type, const void *Pixels)
+{
+	GetFakeGlState().Uploads.push_back(
+	    FakeGlUpload{GetFakeGlState().BoundTextureID, 0, 0, Width, Height, Pixels});
+}
+
+inline void APIENTRY TexSubImage2D(GLenum Target, GLint Level, GLint X, GLint Y, GLsizei Width, GLsizei Height,
+                                   GLenum Format, GLenum Type, const void *Pixels)
+{
+	GetFakeGlState().Uploads.push_back(FakeGlUpload{GetFakeGlState().BoundTextureID, X, Y, Width, Height, Pixels});
+}
+
+inline void APIENTRY ActiveTexture(GLenum Unit)
+{
+}
+
+inline void APIENTRY TexParameteri(GLenum Target, GLenum Name, GLint Value)
+{
+}
+
+inline void APIENTRY PixelStorei(GLenum Name, GLint Value)
+{
+}
+
+inline void APIENTRY GenerateMipmap(GLenum Target)
+{
+}
+} // namespace FakeGl
+
+// NOTE: Resets the recorded state, called at the start of every test using textures
+inline void InstallFakeGl()
+{
+	GetFakeGlState() = FakeGlState{};
+	glad_glGenTextures = FakeGl::GenTextures;
+	glad_glDeleteTextures = FakeGl::DeleteTextures;
+	glad_glBindTexture = FakeGl::BindTexture;
+	glad_glTexImage2D = FakeGl::TexImage2D;
+	glad_glTexSubImage2D = FakeGl::TexSubImage2D;
+	glad_glActiveTexture = FakeGl::ActiveTexture;
+	glad_glTexParameteri = FakeGl::TexParameteri;
+	glad_glPixelStorei = FakeGl::PixelStorei;
+	glad_glGenerateMipmap = FakeGl::GenerateMipmap;
+}
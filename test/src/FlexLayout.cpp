@@ -0,0 +1,76 @@
+#include "FlexLayout.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+FlexNode MakeNode(FlexDirection Direction, float Grow, float Basis = 0.0f)
+{
+	FlexNode Node = {};
+	Node.Direction = Direction;
+	Node.Grow = Grow;
+	Node.Basis = Basis;
+	return Node;
+}
+} // namespace
+
+TEST(FlexLayoutTest, SharesSpaceByGrowRatio)
+{
+	FlexLayout Layout = {};
+	Layout.Edit(FLEX_LAYOUT_ROOT)->Direction = FlexDirection::Row;
+	Layout.Edit(FLEX_LAYOUT_ROOT)->Padding = Vector2(10.0f, 10.0f);
+	Layout.Edit(FLEX_LAYOUT_ROOT)->Gap = 20.0f;
+
+	const FlexNodeIndex SIDEBAR = Layout.Add(FLEX_LAYOUT_ROOT, MakeNode(FlexDirection::Column, 0.0f, 100.0f));
+	const FlexNodeIndex CONTENT = Layout.Add(FLEX_LAYOUT_ROOT, MakeNode(FlexDirection::Column, 3.0f));
+	const FlexNodeIndex DETAILS = Layout.Add(FLEX_LAYOUT_ROOT, MakeNode(FlexDirection::Column, 1.0f));
+
+	// NOTE: 1000 - 2 * 10 padding - 2 * 20 gaps - 100 basis leaves 840 to grow
+	ASSERT_TRUE(Layout.Solve(Vector2(1000.0f, 500.0f)));
+
+	EXPECT_EQ(Layout.GetRect(SIDEBAR).Position.X, 10.0f);
+	EXPECT_EQ(Layout.GetRect(SIDEBAR).Size.X, 100.0f);
+	EXPECT_EQ(Layout.GetRect(SIDEBAR).Size.Y, 480.0f);
+	EXPECT_EQ(Layout.GetRect(CONTENT).Position.X, 130.0f);
+	EXPECT_EQ(Layout.GetRect(CONTENT).Size.X, 630.0f);
+	EXPECT_EQ(Layout.GetRect(DETAILS).Position.X, 780.0f);
+	EXPECT_EQ(Layout.GetRect(DETAILS).Size.X, 210.0f);
+}
+
+TEST(FlexLayoutTest, AlignsChildrenOnCrossAxis)
+{
+	FlexLayout Layout = {};
+	Layout.Edit(FLEX_LAYOUT_ROOT)->Alignment = FlexAlignment::Center;
+
+	FlexNode ButtonNode = MakeNode(FlexDirection::Row, 1.0f);
+	ButtonNode.CrossSize = 40.0f;
+	const FlexNodeIndex BUTTON = Layout.Add(FLEX_LAYOUT_ROOT, ButtonNode);
+
+	Layout.Solve(Vector2(100.0f, 60.0f));
+	EXPECT_EQ(Layout.GetRect(BUTTON).Position.X, 30.0f);
+	EXPECT_EQ(Layout.GetRect(BUTTON).Size.X, 40.0f);
+	EXPECT_EQ(Layout.GetRect(BUTTON).Size.Y, 60.0f);
+}
+
+TEST(FlexLayoutTest, SolvesNestedNodesOnlyWhenChanged)
+{
+	FlexLayout Layout = {};
+	const FlexNodeIndex BODY = Layout.Add(FLEX_LAYOUT_ROOT, MakeNode(FlexDirection::Row, 1.0f));
+	const FlexNodeIndex LEFT = Layout.Add(BODY, MakeNode(FlexDirection::Column, 1.0f));
+	const FlexNodeIndex RIGHT = Layout.Add(BODY, MakeNode(FlexDirection::Column, 1.0f));
+
+	EXPECT_TRUE(Layout.Solve(Vector2(200.0f, 100.0f)));
+	EXPECT_FALSE(Layout.Solve(Vector2(200.0f, 100.0f)));
+	EXPECT_EQ(Layout.GetSolveCount(), 1u);
+	EXPECT_EQ(Layout.GetRect(RIGHT).Position.X, 100.0f);
+
+	// Resizing solves again
+	EXPECT_TRUE(Layout.Solve(Vector2(400.0f, 100.0f)));
+	EXPECT_EQ(Layout.GetRect(RIGHT).Position.X, 200.0f);
+
+	// Editing a node solves again
+	Layout.Edit(LEFT)->Grow = 3.0f;
+	EXPECT_TRUE(Layout.Solve(Vector2(400.0f, 100.0f)));
+	EXPECT_EQ(Layout.GetRect(LEFT).Size.X, 300.0f);
+	EXPECT_EQ(Layout.GetSolveCount(), 3u);
+}
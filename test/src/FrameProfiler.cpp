@@ -0,0 +1,97 @@
+#include "FrameProfiler.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+TEST(FrameProfilerTest, RecordsNestedScopesPerFrame)
+{
+	FrameProfiler Profiler = {};
+	Profiler.BeginFrame();
+	{
+		ScopeTimer Ignored(Profiler, "Ignored");
+	}
+	Profiler.EndFrame();
+	ASSERT_EQ(Profiler.GetFramesCount(), 0u);
+
+	Profiler.SetEnabled(true);
+	Profiler.BeginFrame();
+	{
+		ScopeTimer Outer(Profiler, "Outer");
+		{
+			ScopeTimer Inner(Profiler, "Inner");
+		}
+	}
+	Profiler.EndFrame();
+
+	ASSERT_EQ(Profiler.GetFramesCount(), 1u);
+	const ProfileFrame &FRAME = Profiler.GetFrame(0);
+	ASSERT_EQ(FRAME.ScopesCount, 2u);
+
+	const ProfileScope *OUTER = Profiler.GetScope(FRAME, 0);
+	const ProfileScope *INNER = Profiler.GetScope(FRAME, 1);
+	ASSERT_NE(OUTER, nullptr);
+	ASSERT_NE(INNER, nullptr);
+	EXPECT_STREQ(OUTER->Name, "Outer");
+	EXPECT_EQ(OUTER->Depth, 0u);
+	EXPECT_STREQ(INNER->Name, "Inner");
+	EXPECT_EQ(INNER->Depth, 1u);
+	EXPECT_GE(OUTER->DurationNanoseconds, INNER->DurationNanoseconds);
+	EXPECT_GE(FRAME.DurationNanoseconds, OUTER->DurationNanoseconds);
+}
+
+TEST(FrameProfilerTest, KeepsBoundedHistory)
+{
+	FrameProfiler Profiler = {};
+	Profiler.SetEnabled(true);
+
+	for (size_t i = 0; i < FRAME_PROFILER_FRAMES_COUNT * 2; i++)
+	{
+		Profiler.BeginFrame();
+		for (size_t j = 0; j < FRAME_PROFILER_MAX_SCOPES_PER_FRAME + 10; j++)
+		{
+			ScopeTimer Timer(Profiler, "AVeryLongScopeNameThatDoesNotFitInTheProfiler");
+		}
+		Profiler.EndFrame();
+	}
+
+	ASSERT_EQ(Profiler.GetFramesCount(), FRAME_PROFILER_FRAMES_COUNT - 1);
+	const ProfileFrame &NEWEST = Profiler.GetFrame(Profiler.GetFramesCount() - 1);
+	EXPECT_EQ(NEWEST.Index, FRAME_PROFILER_FRAMES_COUNT * 2 - 1);
+	EXPECT_EQ(NEWEST.ScopesCount, FRAME_PROFILER_MAX_SCOPES_PER_FRAME);
+	EXPECT_EQ(NEWEST.DroppedScopesCount, 10u);
+	ASSERT_NE(Profiler.GetScope(NEWEST, 0), nullptr);
+	EXPECT_EQ(std::string(Profiler.GetScope(NEWEST, 0)->Name).size(), FRAME_PROFILER_NAME_SIZE - 1);
+
+	// NOTE: Oldest frames lost their scopes to newer ones
+	EXPECT_EQ(Profiler.GetScope(Profiler.GetFrame(0), 0), nullptr);
+}
+
+TEST(FrameProfilerTest, WritesChromeTrace)
+{
+	const std::string TRACE_FILE_PATH = "FrameProfilerTest.json";
+
+	FrameProfiler Profiler = {};
+	Profiler.SetEnabled(true);
+	Profiler.BeginFrame();
+	{
+		ScopeTimer Timer(Profiler, "Quoted \"Scope\"");
+	}
+	Profiler.EndFrame();
+
+	ASSERT_TRUE(Profiler.WriteChromeTrace(TRACE_FILE_PATH));
+
+	std::ifstream File(TRACE_FILE_PATH);
+	std::stringstream Content;
+	Content << File.rdbuf();
+	std::remove(TRACE_FILE_PATH.c_str());
+
+	const std::string TRACE = Content.str();
+	EXPECT_NE(TRACE.find("\"traceEvents\":["), std::string::npos);
+	EXPECT_NE(TRACE.find("\"name\":\"Frame 0\""), std::string::npos);
+	EXPECT_NE(TRACE.find("\"name\":\"Quoted \\\"Scope\\\"\""), std::string::npos);
+	EXPECT_NE(TRACE.find("\"ph\":\"X\""), std::string::npos);
+}
@@ -0,0 +1,84 @@
+#include "HistoryPrefetcher.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::vector<Message> LoadFakePage(const std::string &ConversationID, size_t MessagesCount)
+{
+	std::vector<Message> Messages(MessagesCount);
+	for (size_t i = 0; i < MessagesCount; i++)
+	{
+		Messages[i].ConversationID = ConversationID;
+		Messages[i].ID = ConversationID + std::to_string(i);
+	}
+	return Messages;
+}
+
+bool WaitUntilReady(const HistoryPrefetcher &Prefetcher, const std::string &ConversationID)
+{
+	for (int i = 0; i < 1000; i++)
+	{
+		if (Prefetcher.IsReady(ConversationID))
+			return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+} // namespace
+
+TEST(HistoryPrefetcherTest, LoadsPageOnce)
+{
+	std::atomic<int> LoadsCount = 0;
+	HistoryPrefetcherLimits Limits = {};
+	Limits.PageMessagesCount = 3;
+	HistoryPrefetcher Prefetcher(
+	    [&LoadsCount](const std::string &ConversationID, size_t MessagesCount) {
+		    LoadsCount++;
+		    return LoadFakePage(ConversationID, MessagesCount);
+	    },
+	    Limits);
+
+	Prefetcher.Prefetch("Conversation1");
+	ASSERT_TRUE(WaitUntilReady(Prefetcher, "Conversation1"));
+	Prefetcher.Prefetch("Conversation1");
+
+	std::vector<std::string> ReadyConversationIDs;
+	Prefetcher.Poll([&ReadyConversationIDs](const std::string &ConversationID, const std::vector<Message> &Messages) {
+		ReadyConversationIDs.push_back(ConversationID);
+	});
+	ASSERT_EQ(ReadyConversationIDs.size(), 1u);
+	EXPECT_EQ(ReadyConversationIDs[0], "Conversation1");
+
+	std::vector<Message> Messages;
+	ASSERT_TRUE(Prefetcher.Take("Conversation1", Messages));
+	ASSERT_EQ(Messages.size(), 3u);
+	EXPECT_EQ(Messages[2].ID, "Conversation12");
+	EXPECT_FALSE(Prefetcher.Take("Conversation1", Messages));
+	EXPECT_EQ(Prefetcher.GetUsedBytes(), 0u);
+	EXPECT_EQ(LoadsCount, 1);
+}
+
+TEST(HistoryPrefetcherTest, EvictsOldestPagesOverBudget)
+{
+	HistoryPrefetcherLimits Limits = {};
+	Limits.PageMessagesCount = 10;
+	// NOTE: Fits a single page
+	Limits.MemoryBudgetBytes = 10 * sizeof(Message) + 1024;
+	Limits.BandwidthBytesPerSecond = 0;
+	HistoryPrefetcher Prefetcher(LoadFakePage, Limits);
+
+	Prefetcher.Prefetch("Conversation1");
+	ASSERT_TRUE(WaitUntilReady(Prefetcher, "Conversation1"));
+	Prefetcher.Prefetch("Conversation2");
+	ASSERT_TRUE(WaitUntilReady(Prefetcher, "Conversation2"));
+
+	EXPECT_FALSE(Prefetcher.IsReady("Conversation1"));
+	EXPECT_LE(Prefetcher.GetUsedBytes(), Limits.MemoryBudgetBytes);
+}
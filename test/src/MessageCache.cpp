@@ -0,0 +1,239 @@
+#include "MessageCache.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+const std::string MESSAGE_CACHE_TEST_DIRECTORY_PATH = ".";
+const std::string MESSAGE_CACHE_TEST_ACCOUNT_ID = "MessageCacheTest";
+const std::string MESSAGE_CACHE_TEST_LOG_FILE_PATH = "./MessageCacheTest.log";
+const std::string MESSAGE_CACHE_TEST_INDEX_FILE_PATH = "./MessageCacheTest.index";
+
+void RemoveCacheFiles()
+{
+	std::remove(MESSAGE_CACHE_TEST_LOG_FILE_PATH.c_str());
+	std::remove(MESSAGE_CACHE_TEST_INDEX_FILE_PATH.c_str());
+}
+
+Conversation MakeConversation(const std::string &ID, std::time_t CreatedAt)
+{
+	Conversation NewConversation = {};
+	NewConversation.ID = ID;
+	NewConversation.CreatedAt = CreatedAt;
+	NewConversation.Users = {User{"User1", "Olivier", "http://fake.image.url"}};
+	return NewConversation;
+}
+
+Message MakeMessage(const std::string &ConversationID, const std::string &ID, std::time_t CreatedAt)
+{
+	Message NewMessage = {};
+	NewMessage.ID = ID;
+	NewMessage.ConversationID = ConversationID;
+	NewMessage.SenderID = "User1";
+	NewMessage.SenderFirstName = "Olivier";
+	NewMessage.Text = "Text of " + ID;
+	NewMessage.CreatedAt = CreatedAt;
+	return NewMessage;
+}
+
+void FillCache(MessageCache &Cache)
+{
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	ASSERT_TRUE(Cache.AppendConversation(MakeConversation("Old", 100)));
+	ASSERT_TRUE(Cache.AppendConversation(MakeConversation("Recent", 200)));
+	for (int i = 0; i < 5; i++)
+	{
+		ASSERT_TRUE(Cache.AppendMessage(MakeMessage("Old", "Old" + std::to_string(i), 300 + i)));
+		ASSERT_TRUE(Cache.AppendMessage(MakeMessage("Recent", "Recent" + std::to_string(i), 400 + i)));
+	}
+}
+
+void ExpectRecentConversations(MessageCache &Cache)
+{
+	const std::vector<Conversation> CONVERSATIONS = Cache.LoadRecent(10, 3);
+	ASSERT_EQ(CONVERSATIONS.size(), 2u);
+	EXPECT_EQ(CONVERSATIONS[0].ID, "Recent");
+	EXPECT_EQ(CONVERSATIONS[1].ID, "Old");
+	ASSERT_EQ(CONVERSATIONS[0].Users.size(), 1u);
+	EXPECT_EQ(CONVERSATIONS[0].Users[0].FirstName, "Olivier");
+
+	// NOTE: Newest messages only, in chronological order
+	ASSERT_EQ(CONVERSATIONS[0].Messages.size(), 3u);
+	EXPECT_EQ(CONVERSATIONS[0].Messages[0].ID, "Recent2");
+	EXPECT_EQ(CONVERSATIONS[0].Messages[2].ID, "Recent4");
+	EXPECT_EQ(CONVERSATIONS[0].Messages[2].Text, "Text of Recent4");
+	ASSERT_EQ(CONVERSATIONS[1].Messages.size(), 3u);
+	EXPECT_EQ(CONVERSATIONS[1].Messages[2].ID, "Old4");
+}
+} // namespace
+
+TEST(MessageCacheTest, LoadsRecentConversationsAfterReopen)
+{
+	RemoveCacheFiles();
+	{
+		MessageCache Cache = {};
+		FillCache(Cache);
+		ExpectRecentConversations(Cache);
+	}
+
+	MessageCache Cache = {};
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	ExpectRecentConversations(Cache);
+
+	ASSERT_TRUE(Cache.RemoveConversation("Old"));
+	EXPECT_FALSE(Cache.HasConversation("Old"));
+	Cache.Close();
+
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	EXPECT_EQ(Cache.GetConversationsCount(), 1u);
+	Cache.Close();
+	RemoveCacheFiles();
+}
+
+TEST(MessageCacheTest, ReplaysLogWithoutIndex)
+{
+	RemoveCacheFiles();
+	{
+		MessageCache Cache = {};
+		FillCache(Cache);
+	}
+	std::remove(MESSAGE_CACHE_TEST_INDEX_FILE_PATH.c_str());
+
+	MessageCache Cache = {};
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	ExpectRecentConversations(Cache);
+	Cache.Close();
+	RemoveCacheFiles();
+}
+
+TEST(MessageCacheTest, CutsTornRecord)
+{
+	RemoveCacheFiles();
+	{
+		MessageCache Cache = {};
+		FillCache(Cache);
+	}
+
+	// Simulates a crash in the middle of an append
+	FILE *File = std::fopen(MESSAGE_CACHE_TEST_LOG_FILE_PATH.c_str(), "ab");
+	const MessageCacheRecordHeader HEADER = {1000, 0, MessageCacheRecordType::Message, 0};
+	std::fwrite(&HEADER, sizeof(HEADER), 1, File);
+	std::fwrite("partial", 1, 7, File);
+	std::fclose(File);
+
+	MessageCache Cache = {};
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	ASSERT_TRUE(Cache.AppendMessage(MakeMessage("Recent", "Recent5", 500)));
+	Cache.Close();
+
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	const std::vector<Conversation> CONVERSATIONS = Cache.LoadRecent(1, 2);
+	ASSERT_EQ(CONVERSATIONS.size(), 1u);
+	ASSERT_EQ(CONVERSATIONS[0].Messages.size(), 2u);
+	EXPECT_EQ(CONVERSATIONS[0].Messages[0].ID, "Recent4");
+	EXPECT_EQ(CONVERSATIONS[0].Messages[1].ID, "Recent5");
+	Cache.Close();
+	RemoveCacheFiles();
+}
+
+TEST(MessageCacheTest, KeepsPendingMessagesUntilAcknowledged)
+{
+	RemoveCacheFiles();
+	{
+		MessageCache Cache = {};
+		FillCache(Cache);
+
+		// Both sent, only the first one is acknowledged before the client stops
+		Message Acknowledged = MakeMessage("Recent", "", 500);
+		Acknowledged.Nonce = 1;
+		Message Pending = MakeMessage("Recent", "", 501);
+		Pending.Nonce = 2;
+		ASSERT_TRUE(Cache.AppendMessage(Acknowledged));
+		Acknowledged.ID = "Recent5";
+		Acknowledged.Sequence = 6;
+		ASSERT_TRUE(Cache.AppendMessage(Acknowledged));
+		ASSERT_TRUE(Cache.AppendMessage(Pending));
+	}
+
+	MessageCache Cache = {};
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+
+	const std::vector<Message> PENDING_MESSAGES = Cache.LoadPendingMessages();
+	ASSERT_EQ(PENDING_MESSAGES.size(), 1u);
+	EXPECT_EQ(PENDING_MESSAGES[0].Nonce, 2u);
+	EXPECT_TRUE(PENDING_MESSAGES[0].IsPending());
+
+	// The acknowledged copy replaces the pending one
+	const std::vector<Message> MESSAGES = Cache.LoadMessages("Recent", 3);
+	ASSERT_EQ(MESSAGES.size(), 3u);
+	EXPECT_EQ(MESSAGES[0].ID, "Recent4");
+	EXPECT_EQ(MESSAGES[1].ID, "Recent5");
+	EXPECT_EQ(MESSAGES[2].Nonce, 2u);
+	Cache.Close();
+
+	// Replaying the log finds the same pending message
+	std::remove(MESSAGE_CACHE_TEST_INDEX_FILE_PATH.c_str());
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	ASSERT_EQ(Cache.LoadPendingMessages().size(), 1u);
+	Cache.Close();
+	RemoveCacheFiles();
+}
+
+TEST(MessageCacheTest, CompactsDeadRecords)
+{
+	RemoveCacheFiles();
+	MessageCache Cache = {};
+	FillCache(Cache);
+
+	// Sent then acknowledged, the pending copy is dead once the acknowledged one is appended
+	Message Sent = MakeMessage("Recent", "", 500);
+	Sent.Nonce = 1;
+	ASSERT_TRUE(Cache.AppendMessage(Sent));
+	Sent.ID = "Recent5";
+	Sent.Sequence = 6;
+	ASSERT_TRUE(Cache.AppendMessage(Sent));
+	Message Pending = MakeMessage("Recent", "", 501);
+	Pending.Nonce = 2;
+	ASSERT_TRUE(Cache.AppendMessage(Pending));
+
+	// Enough large messages in a removed conversation for most of the log to be dead
+	ASSERT_TRUE(Cache.AppendConversation(MakeConversation("Removed", 50)));
+	const size_t REMOVED_MESSAGES_COUNT = MESSAGE_CACHE_COMPACTION_MIN_DEAD_BYTES / 10000 + 50;
+	for (size_t i = 0; i < REMOVED_MESSAGES_COUNT; i++)
+	{
+		Message Large = MakeMessage("Removed", "Removed" + std::to_string(i), 50);
+		Large.Text.assign(10000, 'x');
+		ASSERT_TRUE(Cache.AppendMessage(Large));
+	}
+	const size_t LOG_SIZE = Cache.GetLogSize();
+	ASSERT_TRUE(Cache.RemoveConversation("Removed"));
+	EXPECT_GE(Cache.GetDeadBytes(), REMOVED_MESSAGES_COUNT * 10000);
+
+	ASSERT_TRUE(Cache.Flush());
+	EXPECT_EQ(Cache.GetDeadBytes(), 0u);
+	EXPECT_LT(Cache.GetLogSize(), LOG_SIZE - REMOVED_MESSAGES_COUNT * 10000);
+	EXPECT_EQ(Cache.GetConversationsCount(), 2u);
+
+	// Appends after the compaction link to the compacted messages
+	ASSERT_TRUE(Cache.AppendMessage(MakeMessage("Old", "Old5", 305)));
+	Cache.Close();
+
+	ASSERT_TRUE(Cache.Open(MESSAGE_CACHE_TEST_DIRECTORY_PATH, MESSAGE_CACHE_TEST_ACCOUNT_ID));
+	EXPECT_FALSE(Cache.HasConversation("Removed"));
+	const std::vector<Message> MESSAGES = Cache.LoadMessages("Recent", 10);
+	ASSERT_EQ(MESSAGES.size(), 7u);
+	EXPECT_EQ(MESSAGES[0].ID, "Recent0");
+	EXPECT_EQ(MESSAGES[5].ID, "Recent5");
+	EXPECT_EQ(MESSAGES[6].Nonce, 2u);
+	ASSERT_EQ(Cache.LoadPendingMessages().size(), 1u);
+
+	const std::vector<Message> OLD_MESSAGES = Cache.LoadMessages("Old", 10);
+	ASSERT_EQ(OLD_MESSAGES.size(), 6u);
+	EXPECT_EQ(OLD_MESSAGES[5].ID, "Old5");
+	Cache.Close();
+	RemoveCacheFiles();
+}
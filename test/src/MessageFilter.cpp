@@ -0,0 +1,125 @@
+#include "MessageFilter.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace
+{
+Conversation MakeConversation(const std::string &ID, const std::vector<std::string> &Texts)
+{
+	Conversation NewConversation = {};
+	NewConversation.ID = ID;
+	for (const std::string &Text : Texts)
+	{
+		Message NewMessage = {};
+		NewMessage.ConversationID = ID;
+		NewMessage.Text = Text;
+		NewConversation.Messages.push_back(NewMessage);
+	}
+	return NewConversation;
+}
+
+bool WaitForResult(MessageFilter &Filter, MessageFilterResult &Result)
+{
+	for (int i = 0; i < 1000; i++)
+	{
+		if (Filter.Poll(Result))
+			return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+} // namespace
+
+TEST(MessageFilterTest, FindsSubstringAtEveryPosition)
+{
+	const std::string TEXT = "the quick brown fox jumps over the lazy dog, then the quick cat";
+	for (size_t Size = 1; Size <= 6; Size++)
+	{
+		for (size_t Position = 0; Position + Size <= TEXT.size(); Position++)
+		{
+			const std::string NEEDLE = TEXT.substr(Position, Size);
+			EXPECT_EQ(FindSubstring(TEXT, NEEDLE), TEXT.find(NEEDLE));
+		}
+	}
+	EXPECT_EQ(FindSubstring(TEXT, "quick dog"), std::string_view::npos);
+	EXPECT_EQ(FindSubstring("ab", "abc"), std::string_view::npos);
+	EXPECT_EQ(FindSubstring(TEXT, ""), 0u);
+}
+
+TEST(MessageFilterTest, MatchesMessagesAndTitlesCaseInsensitively)
+{
+	MessageFilter Filter;
+	Conversation First = MakeConversation("Conversation1", {"Hello World", "nothing here", "WORLDWIDE news"});
+	User Alice = {};
+	Alice.FirstName = "Alice";
+	First.Users.push_back(Alice);
+	Filter.UpdateConversation(First);
+	Filter.UpdateConversation(MakeConversation("Conversation2", {"hello there"}));
+
+	MessageFilterResult Result;
+	Filter.SetQuery("World");
+	ASSERT_TRUE(WaitForResult(Filter, Result));
+	EXPECT_EQ(Result.Query, "world");
+	ASSERT_EQ(Result.MatchesByConversationID.size(), 1u);
+	const MessageFilterMatch &Match = Result.MatchesByConversationID.at("Conversation1");
+	EXPECT_FALSE(Match.IsTitleMatch);
+	EXPECT_EQ(Match.MessageIndices, std::vector<uint32_t>({0, 2}));
+
+	Filter.SetQuery("ALI");
+	ASSERT_TRUE(WaitForResult(Filter, Result));
+	ASSERT_EQ(Result.MatchesByConversationID.size(), 1u);
+	EXPECT_TRUE(Result.MatchesByConversationID.at("Conversation1").IsTitleMatch);
+	EXPECT_TRUE(Result.MatchesByConversationID.at("Conversation1").MessageIndices.empty());
+
+	Filter.SetQuery("");
+	ASSERT_TRUE(Filter.Poll(Result));
+	EXPECT_TRUE(Result.Query.empty());
+	EXPECT_TRUE(Result.MatchesByConversationID.empty());
+}
+
+TEST(MessageFilterTest, RefinesPreviousResultAndIndexesAppendedMessages)
+{
+	MessageFilter Filter;
+	std::vector<std::string> Texts;
+	for (size_t i = 0; i < MESSAGE_FILTER_CHUNK_MESSAGES_COUNT * 2 + 10; i++)
+	{
+		Texts.push_back(i % 3 == 0 ? "meeting at " + std::to_string(i) : "lunch " + std::to_string(i));
+	}
+	Conversation Long = MakeConversation("Long", Texts);
+	Filter.UpdateConversation(Long);
+	EXPECT_EQ(Filter.GetMessagesCount(), Texts.size());
+
+	MessageFilterResult Result;
+	Filter.SetQuery("meet");
+	ASSERT_TRUE(WaitForResult(Filter, Result));
+	EXPECT_EQ(Result.MatchesByConversationID.at("Long").MessageIndices.size(), (Texts.size() + 2) / 3);
+
+	// Grows the query, only the messages matching "meet" are candidates
+	Filter.SetQuery("meeting at 30");
+	ASSERT_TRUE(WaitForResult(Filter, Result));
+	std::vector<uint32_t> Expected;
+	for (size_t i = 0; i < Texts.size(); i++)
+	{
+		if (Texts[i].find("meeting at 30") != std::string::npos)
+			Expected.push_back(static_cast<uint32_t>(i));
+	}
+	EXPECT_EQ(Result.MatchesByConversationID.at("Long").MessageIndices, Expected);
+
+	Message Appended = {};
+	Appended.Text = "Meeting AT 30 again";
+	Long.Messages.push_back(Appended);
+	Filter.UpdateConversation(Long);
+	Filter.SetQuery("meeting at 30");
+	ASSERT_TRUE(WaitForResult(Filter, Result));
+	EXPECT_EQ(Result.MatchesByConversationID.at("Long").MessageIndices.back(), Texts.size());
+
+	Filter.RemoveConversation("Long");
+	EXPECT_EQ(Filter.GetMessagesCount(), 0u);
+	Filter.SetQuery("meeting at 3");
+	ASSERT_TRUE(WaitForResult(Filter, Result));
+	EXPECT_TRUE(Result.MatchesByConversationID.empty());
+}
@@ -0,0 +1,154 @@
+#include "MessageReceiver.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+std::string EncodeMessages(const std::vector<uint64_t> &Nonces)
+{
+	std::vector<Message> Messages(Nonces.size());
+	std::vector<const Message *> SentMessages;
+	for (size_t i = 0; i < Nonces.size(); i++)
+	{
+		Messages[i].Nonce = Nonces[i];
+		Messages[i].ConversationID = "Conversation1";
+		Messages[i].SenderID = "Spoofed";
+		Messages[i].Text = "Hello";
+		SentMessages.push_back(&Messages[i]);
+	}
+
+	std::string Frame;
+	EncodeSendMessagesFrame(SentMessages, Frame);
+	return Frame.substr(sizeof(ChatFrameHeader));
+}
+
+std::vector<MessageAcknowledgement> DecodeResponse(const std::string &Response)
+{
+	std::vector<MessageAcknowledgement> Acknowledgements;
+	ChatFrameHeader Header = {};
+	std::string_view Payload;
+	bool IsValid = true;
+	EXPECT_EQ(ReadChatFrame(Response, Header, Payload, IsValid), Response.size());
+	EXPECT_EQ(Header.Type, ChatFrameType::Acknowledgements);
+	EXPECT_TRUE(DecodeAcknowledgementsFrame(Payload, Acknowledgements));
+	return Acknowledgements;
+}
+} // namespace
+
+TEST(MessageReceiverTest, AcknowledgesRetriesWithoutStoringThemAgain)
+{
+	std::vector<Message> StoredMessages;
+	size_t FanOutsCount = 0;
+	MessageReceiver Receiver(
+	    [&StoredMessages](Message &ReceivedMessage) {
+		    ReceivedMessage.Sequence = StoredMessages.size() + 1;
+		    ReceivedMessage.ID = "Message" + std::to_string(ReceivedMessage.Sequence);
+		    StoredMessages.push_back(ReceivedMessage);
+		    return true;
+	    },
+	    [&FanOutsCount](const Message &) { FanOutsCount++; });
+
+	std::string Response;
+	ASSERT_TRUE(Receiver.Receive("User1", EncodeMessages({10, 11}), 0.0, Response));
+	std::vector<MessageAcknowledgement> Acknowledgements = DecodeResponse(Response);
+	ASSERT_EQ(Acknowledgements.size(), 2u);
+	EXPECT_EQ(StoredMessages.size(), 2u);
+	EXPECT_EQ(StoredMessages[0].SenderID, "User1");
+
+	// Resent after a reconnect along with a new message
+	Response.clear();
+	ASSERT_TRUE(Receiver.Receive("User1", EncodeMessages({11, 12}), 5.0, Response));
+	Acknowledgements = DecodeResponse(Response);
+	ASSERT_EQ(Acknowledgements.size(), 2u);
+	EXPECT_EQ(Acknowledgements[0].Nonce, 11u);
+	EXPECT_EQ(Acknowledgements[0].Sequence, 2u);
+	EXPECT_EQ(Acknowledgements[0].MessageID, "Message2");
+	EXPECT_EQ(Acknowledgements[1].Sequence, 3u);
+	EXPECT_EQ(StoredMessages.size(), 3u);
+	EXPECT_EQ(FanOutsCount, 3u);
+
+	// Nonces are only compared between messages of the same user
+	Response.clear();
+	ASSERT_TRUE(Receiver.Receive("User2", EncodeMessages({11}), 5.0, Response));
+	EXPECT_EQ(StoredMessages.size(), 4u);
+	EXPECT_EQ(Receiver.GetUsersCount(), 2u);
+
+	Receiver.Expire(1.0e6);
+	EXPECT_EQ(Receiver.GetUsersCount(), 0u);
+
+	EXPECT_FALSE(Receiver.Receive("User1", "Malformed", 0.0, Response));
+}
+
+TEST(MessageReceiverTest, LeavesUnstoredMessagesUnacknowledged)
+{
+	bool IsStoreAvailable = false;
+	MessageReceiver Receiver([&IsStoreAvailable](Message &ReceivedMessage) { return IsStoreAvailable; }, {});
+
+	std::string Response;
+	ASSERT_TRUE(Receiver.Receive("User1", EncodeMessages({10}), 0.0, Response));
+	EXPECT_TRUE(Response.empty());
+
+	IsStoreAvailable = true;
+	ASSERT_TRUE(Receiver.Receive("User1", EncodeMessages({10}), 1.0, Response));
+	EXPECT_EQ(DecodeResponse(Response).size(), 1u);
+}
+
+TEST(MessageReceiverTest, RepairsMalformedText)
+{
+	std::string StoredText;
+	MessageReceiver Receiver(
+	    [&StoredText](Message &ReceivedMessage) {
+		    StoredText = ReceivedMessage.Text;
+		    return true;
+	    },
+	    {});
+
+	Message SentMessage = {};
+	SentMessage.Nonce = 1;
+	SentMessage.Text = "caf\xC3";
+	std::string Frame;
+	EncodeSendMessagesFrame({&SentMessage}, Frame);
+
+	std::string Response;
+	ASSERT_TRUE(Receiver.Receive("User1", std::string_view(Frame).substr(sizeof(ChatFrameHeader)), 0.0, Response));
+	EXPECT_EQ(StoredText, "caf\xEF\xBF\xBD");
+}
+
+TEST(MessageReceiverTest, StoresEveryMessageWithoutNonce)
+{
+	std::vector<std::string> StoredTexts;
+	MessageReceiver Receiver(
+	    [&StoredTexts](Message &ReceivedMessage) {
+		    StoredTexts.push_back(ReceivedMessage.Text);
+		    ReceivedMessage.Sequence = StoredTexts.size();
+		    return true;
+	    },
+	    {});
+
+	Message FirstMessage = {};
+	FirstMessage.Text = "First";
+	Message SecondMessage = {};
+	SecondMessage.Text = "Second";
+	std::string FirstFrame;
+	EncodeSendMessagesFrame({&FirstMessage}, FirstFrame);
+	std::string SecondFrame;
+	EncodeSendMessagesFrame({&SecondMessage}, SecondFrame);
+
+	std::string Response;
+	ASSERT_TRUE(
+	    Receiver.Receive("User1", std::string_view(FirstFrame).substr(sizeof(ChatFrameHeader)), 0.0, Response));
+	Response.clear();
+	ASSERT_TRUE(
+	    Receiver.Receive("User1", std::string_view(SecondFrame).substr(sizeof(ChatFrameHeader)), 1.0, Response));
+	ASSERT_EQ(StoredTexts.size(), 2u);
+	EXPECT_EQ(StoredTexts[0], "First");
+	EXPECT_EQ(StoredTexts[1], "Second");
+
+	const std::vector<MessageAcknowledgement> ACKNOWLEDGEMENTS = DecodeResponse(Response);
+	ASSERT_EQ(ACKNOWLEDGEMENTS.size(), 1u);
+	EXPECT_EQ(ACKNOWLEDGEMENTS[0].Sequence, 2u);
+}
@@ -0,0 +1,116 @@
+#include "MessageSearchIndex.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+Message MakeMessage(const std::string &ConversationID, uint64_t Sequence, const std::string &Text)
+{
+	Message StoredMessage = {};
+	StoredMessage.ID = ConversationID + "-" + std::to_string(Sequence);
+	StoredMessage.ConversationID = ConversationID;
+	StoredMessage.Sequence = Sequence;
+	StoredMessage.Text = Text;
+	return StoredMessage;
+}
+} // namespace
+
+TEST(MessageSearchIndexTest, TokenizesText)
+{
+	std::vector<std::string> Tokens;
+	TokenizeMessageText("Hello, WORLD! caf\xC3\xA9 x2  ", Tokens);
+	ASSERT_EQ(Tokens.size(), 4u);
+	EXPECT_EQ(Tokens[0], "hello");
+	EXPECT_EQ(Tokens[1], "world");
+	EXPECT_EQ(Tokens[2], "caf\xC3\xA9");
+	EXPECT_EQ(Tokens[3], "x2");
+}
+
+TEST(MessageSearchIndexTest, FindsMessagesHoldingEveryTerm)
+{
+	MessageSearchIndex Index;
+	ASSERT_TRUE(Index.Add(MakeMessage("Conversation1", 1, "Lunch at noon?")));
+	ASSERT_TRUE(Index.Add(MakeMessage("Conversation1", 2, "Noon works, see you at lunch")));
+	ASSERT_TRUE(Index.Add(MakeMessage("Conversation1", 3, "Lunch moved to one")));
+	ASSERT_TRUE(Index.Add(MakeMessage("Conversation2", 1, "lunch at noon")));
+	// Already indexed
+	EXPECT_FALSE(Index.Add(MakeMessage("Conversation1", 2, "noon")));
+	EXPECT_EQ(Index.GetMessagesCount(), 4u);
+
+	std::vector<std::string> MessageIDs;
+	Index.Search("Conversation1", "LUNCH noon", 10, MessageIDs);
+	ASSERT_EQ(MessageIDs.size(), 2u);
+	EXPECT_EQ(MessageIDs[0], "Conversation1-2");
+	EXPECT_EQ(MessageIDs[1], "Conversation1-1");
+
+	Index.Search("Conversation1", "lunch", 2, MessageIDs);
+	ASSERT_EQ(MessageIDs.size(), 2u);
+	EXPECT_EQ(MessageIDs[0], "Conversation1-3");
+
+	Index.Search("Conversation1", "lunch dinner", 10, MessageIDs);
+	EXPECT_TRUE(MessageIDs.empty());
+	Index.Search("Conversation3", "lunch", 10, MessageIDs);
+	EXPECT_TRUE(MessageIDs.empty());
+}
+
+TEST(MessageSearchIndexTest, IntersectsAcrossBlocks)
+{
+	MessageSearchIndex Index;
+	const uint64_t MESSAGES_COUNT = 20 * MESSAGE_SEARCH_BLOCK_SIZE;
+	for (uint64_t Sequence = 1; Sequence <= MESSAGES_COUNT; Sequence++)
+	{
+		std::string Text = "common";
+		if (Sequence % 3 == 0)
+			Text += " three";
+		if (Sequence % 7 == 0)
+			Text += " seven";
+		if (Sequence % 500 == 0)
+			Text += " rare";
+		ASSERT_TRUE(Index.Add(MakeMessage("Conversation1", Sequence, Text)));
+	}
+
+	std::vector<std::string> MessageIDs;
+	Index.Search("Conversation1", "three seven common", MESSAGE_SEARCH_MAX_RESULTS_COUNT, MessageIDs);
+	ASSERT_EQ(MessageIDs.size(), MESSAGES_COUNT / 21);
+	for (size_t i = 0; i < MessageIDs.size(); i++)
+	{
+		EXPECT_EQ(MessageIDs[i], "Conversation1-" + std::to_string((MESSAGES_COUNT / 21 - i) * 21));
+	}
+
+	Index.Search("Conversation1", "rare common three", 10, MessageIDs);
+	ASSERT_EQ(MessageIDs.size(), 1u);
+	EXPECT_EQ(MessageIDs[0], "Conversation1-1500");
+}
+
+TEST(MessageSearchIndexTest, RespondsToSearchFrames)
+{
+	MessageSearchIndex Index;
+	ASSERT_TRUE(Index.Add(MakeMessage("Conversation1", 1, "ship it")));
+
+	SearchMessagesRequest Request = {};
+	Request.RequestID = 9;
+	Request.ConversationID = "Conversation1";
+	Request.Query = "Ship";
+	Request.MaxResultsCount = 5;
+	std::string RequestFrame;
+	EncodeSearchMessagesFrame(Request, RequestFrame);
+
+	std::string Response;
+	ASSERT_TRUE(Index.Respond(std::string_view(RequestFrame).substr(sizeof(ChatFrameHeader)), Response));
+
+	ChatFrameHeader Header = {};
+	std::string_view Payload;
+	bool IsValid = true;
+	ASSERT_EQ(ReadChatFrame(Response, Header, Payload, IsValid), Response.size());
+	EXPECT_EQ(Header.Type, ChatFrameType::SearchResults);
+
+	SearchMessagesResults Results = {};
+	ASSERT_TRUE(DecodeSearchResultsFrame(Payload, Results));
+	EXPECT_EQ(Results.RequestID, 9u);
+	ASSERT_EQ(Results.MessageIDs.size(), 1u);
+	EXPECT_EQ(Results.MessageIDs[0], "Conversation1-1");
+}
@@ -0,0 +1,71 @@
+#include "NonceDeduplicator.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+
+namespace
+{
+MessageAcknowledgement MakeAcknowledgement(uint64_t Nonce)
+{
+	MessageAcknowledgement Acknowledgement = {};
+	Acknowledgement.Nonce = Nonce;
+	Acknowledgement.Sequence = Nonce & 0xFFFF;
+	Acknowledgement.MessageID = "Message" + std::to_string(Nonce & 0xFFFF);
+	return Acknowledgement;
+}
+} // namespace
+
+TEST(NonceDeduplicatorTest, FindsInsertedNonces)
+{
+	NonceDeduplicator Deduplicator;
+	const uint64_t NONCE_PREFIX = 0xABCD000000000000ull;
+
+	for (uint64_t i = 1; i <= NONCE_DEDUPLICATOR_BUCKET_CAPACITY; i++)
+	{
+		Deduplicator.Insert(MakeAcknowledgement(NONCE_PREFIX | i), 0.0);
+	}
+
+	// Every nonce of a full bucket is found, no filter collision hides one
+	for (uint64_t i = 1; i <= NONCE_DEDUPLICATOR_BUCKET_CAPACITY; i++)
+	{
+		const MessageAcknowledgement *Acknowledgement = Deduplicator.Find(NONCE_PREFIX | i, 1.0);
+		ASSERT_NE(Acknowledgement, nullptr);
+		EXPECT_EQ(Acknowledgement->Sequence, i);
+	}
+	for (uint64_t i = NONCE_DEDUPLICATOR_BUCKET_CAPACITY + 1; i <= 4 * NONCE_DEDUPLICATOR_BUCKET_CAPACITY; i++)
+	{
+		EXPECT_EQ(Deduplicator.Find(NONCE_PREFIX | i, 1.0), nullptr);
+	}
+}
+
+TEST(NonceDeduplicatorTest, ForgetsNoncesOutsideWindow)
+{
+	NonceDeduplicator Deduplicator;
+	const double WINDOW = NONCE_DEDUPLICATOR_BUCKET_DURATION * NONCE_DEDUPLICATOR_BUCKETS_COUNT;
+
+	Deduplicator.Insert(MakeAcknowledgement(1), 0.0);
+	Deduplicator.Insert(MakeAcknowledgement(2), NONCE_DEDUPLICATOR_BUCKET_DURATION);
+	EXPECT_NE(Deduplicator.Find(1, WINDOW - 1.0), nullptr);
+	EXPECT_EQ(Deduplicator.Find(1, WINDOW), nullptr);
+	EXPECT_NE(Deduplicator.Find(2, WINDOW), nullptr);
+	EXPECT_FALSE(Deduplicator.IsExpired(WINDOW));
+	EXPECT_TRUE(Deduplicator.IsExpired(NONCE_DEDUPLICATOR_BUCKET_DURATION + WINDOW));
+}
+
+TEST(NonceDeduplicatorTest, MemoryIsBoundedForFloodingSender)
+{
+	NonceDeduplicator Deduplicator;
+
+	const uint64_t NONCES_COUNT = 10 * NONCE_DEDUPLICATOR_BUCKETS_COUNT * NONCE_DEDUPLICATOR_BUCKET_CAPACITY;
+	for (uint64_t i = 1; i <= NONCES_COUNT; i++)
+	{
+		Deduplicator.Insert(MakeAcknowledgement(i), 0.0);
+	}
+
+	EXPECT_LE(Deduplicator.GetNoncesCount(), NONCE_DEDUPLICATOR_BUCKETS_COUNT * NONCE_DEDUPLICATOR_BUCKET_CAPACITY);
+	// The most recent nonces are still recognized
+	EXPECT_NE(Deduplicator.Find(NONCES_COUNT, 0.0), nullptr);
+	EXPECT_EQ(Deduplicator.Find(1, 0.0), nullptr);
+}
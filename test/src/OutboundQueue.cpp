@@ -0,0 +1,169 @@
+#include "OutboundQueue.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+Message MakeMessage(const std::string &Text)
+{
+	Message NewMessage = {};
+	NewMessage.ConversationID = "Conversation1";
+	NewMessage.SenderID = "User1";
+	NewMessage.Text = Text;
+	return NewMessage;
+}
+
+// NOTE: Decodes every frame written to the transport
+struct FakeTransport
+{
+	std::vector<std::vector<Message>> Batches;
+	bool IsConnected = true;
+
+	OutboundTransport Get()
+	{
+		return [this](std::string_view Frame) {
+			if (!IsConnected)
+				return false;
+
+			ChatFrameHeader Header = {};
+			std::string_view Payload;
+			bool IsValid = true;
+			while (const size_t FRAME_SIZE = ReadChatFrame(Frame, Header, Payload, IsValid))
+			{
+				std::vector<Message> Messages;
+				EXPECT_EQ(Header.Type, ChatFrameType::SendMessages);
+				EXPECT_TRUE(DecodeSendMessagesFrame(Payload, Messages));
+				Batches.push_back(std::move(Messages));
+				Frame.remove_prefix(FRAME_SIZE);
+			}
+			EXPECT_TRUE(IsValid);
+			EXPECT_TRUE(Frame.empty());
+			return true;
+		};
+	}
+};
+} // namespace
+
+TEST(OutboundQueueTest, BatchesMessagesSentWithinWindow)
+{
+	FakeTransport Transport;
+	OutboundQueue Queue(0x1234567800000000ull);
+	Queue.SetTransport(Transport.Get());
+
+	Message First = MakeMessage("First");
+	Message Second = MakeMessage("Second");
+	const uint64_t FIRST_NONCE = Queue.Enqueue(First, 10.0);
+	const uint64_t SECOND_NONCE = Queue.Enqueue(Second, 10.001);
+	EXPECT_NE(FIRST_NONCE, SECOND_NONCE);
+	EXPECT_TRUE(First.IsPending());
+
+	// Waits for the window of the oldest message
+	EXPECT_NEAR(Queue.Update(10.002), 10.0 + OUTBOUND_QUEUE_BATCH_WINDOW, 1e-9);
+	EXPECT_TRUE(Transport.Batches.empty());
+
+	Queue.Update(10.0 + OUTBOUND_QUEUE_BATCH_WINDOW);
+	ASSERT_EQ(Transport.Batches.size(), 1u);
+	ASSERT_EQ(Transport.Batches[0].size(), 2u);
+	EXPECT_EQ(Transport.Batches[0][0].Nonce, FIRST_NONCE);
+	EXPECT_EQ(Transport.Batches[0][0].Text, "First");
+	EXPECT_EQ(Transport.Batches[0][1].Nonce, SECOND_NONCE);
+}
+
+TEST(OutboundQueueTest, RetriesWithSameNonceUntilAcknowledged)
+{
+	FakeTransport Transport;
+	OutboundQueue Queue(0x1234567800000000ull);
+	Queue.SetTransport(Transport.Get());
+
+	Message Sent = MakeMessage("Hello");
+	const uint64_t NONCE = Queue.Enqueue(Sent, 0.0);
+	Queue.Update(1.0);
+	ASSERT_EQ(Transport.Batches.size(), 1u);
+
+	// Not acknowledged, sent again with a doubled interval each time
+	EXPECT_NEAR(Queue.Update(1.5), 1.0 + OUTBOUND_QUEUE_RETRY_INTERVAL, 1e-9);
+	Queue.Update(2.0);
+	ASSERT_EQ(Transport.Batches.size(), 2u);
+	EXPECT_EQ(Transport.Batches[1][0].Nonce, NONCE);
+	EXPECT_NEAR(Queue.Update(2.5), 2.0 + 2.0 * OUTBOUND_QUEUE_RETRY_INTERVAL, 1e-9);
+
+	// A failed send blocks the transport instead of trying again every frame
+	Transport.IsConnected = false;
+	Queue.Update(4.0);
+	EXPECT_NEAR(Queue.Update(4.1), 4.0 + OUTBOUND_QUEUE_RETRY_INTERVAL, 1e-9);
+
+	// Reconnecting sends everything again right away
+	Transport.IsConnected = true;
+	Queue.Resend();
+	Queue.Update(4.2);
+	ASSERT_EQ(Transport.Batches.size(), 3u);
+	EXPECT_EQ(Transport.Batches[2][0].Nonce, NONCE);
+}
+
+TEST(OutboundQueueTest, AcknowledgementsResolvePendingMessages)
+{
+	FakeTransport Transport;
+	OutboundQueue Queue(0x1234567800000000ull);
+	Queue.SetTransport(Transport.Get());
+
+	std::vector<Message> AcknowledgedMessages;
+	Queue.SetOnAcknowledged([&AcknowledgedMessages](const Message &AcknowledgedMessage) {
+		AcknowledgedMessages.push_back(AcknowledgedMessage);
+	});
+
+	Message Sent = MakeMessage("Hello");
+	const uint64_t NONCE = Queue.Enqueue(Sent, 0.0);
+	Queue.Update(1.0);
+
+	// The server acknowledges the first send and the retry, only the first one resolves the message
+	MessageAcknowledgement Acknowledgement = {};
+	Acknowledgement.Nonce = NONCE;
+	Acknowledgement.Sequence = 7;
+	Acknowledgement.MessageID = "Message7";
+	std::string Frame;
+	EncodeAcknowledgementsFrame({Acknowledgement, Acknowledgement}, Frame);
+
+	ChatFrameHeader Header = {};
+	std::string_view Payload;
+	bool IsValid = true;
+	ASSERT_EQ(ReadChatFrame(Frame, Header, Payload, IsValid), Frame.size());
+	EXPECT_EQ(Header.Type, ChatFrameType::Acknowledgements);
+	EXPECT_TRUE(Queue.ReadAcknowledgements(Payload));
+
+	ASSERT_EQ(AcknowledgedMessages.size(), 1u);
+	EXPECT_EQ(AcknowledgedMessages[0].ID, "Message7");
+	EXPECT_EQ(AcknowledgedMessages[0].Sequence, 7u);
+	EXPECT_EQ(AcknowledgedMessages[0].Text, "Hello");
+	EXPECT_FALSE(AcknowledgedMessages[0].IsPending());
+	EXPECT_EQ(Queue.GetPendingCount(), 0u);
+	EXPECT_LT(Queue.Update(10.0), 0.0);
+
+	// Truncated payloads are rejected
+	EXPECT_FALSE(Queue.ReadAcknowledgements(Payload.substr(0, Payload.size() - 1)));
+}
+
+TEST(OutboundQueueTest, RequeuesPendingMessagesWithTheirNonce)
+{
+	FakeTransport Transport;
+	OutboundQueue Queue(0x1234567800000000ull);
+	Queue.SetTransport(Transport.Get());
+
+	// Left pending by a run whose nonces were ahead of this one
+	Message PendingMessage = MakeMessage("Hello");
+	PendingMessage.Nonce = 0x1234567800000005ull;
+	Queue.Requeue(PendingMessage, 0.0);
+	EXPECT_TRUE(Queue.IsPending(PendingMessage.Nonce));
+
+	Message Sent = MakeMessage("World");
+	EXPECT_GT(Queue.Enqueue(Sent, 0.0), PendingMessage.Nonce);
+
+	Queue.Update(1.0);
+	ASSERT_EQ(Transport.Batches.size(), 1u);
+	ASSERT_EQ(Transport.Batches[0].size(), 2u);
+	EXPECT_EQ(Transport.Batches[0][0].Nonce, PendingMessage.Nonce);
+	EXPECT_EQ(Transport.Batches[0][1].Text, "World");
+}
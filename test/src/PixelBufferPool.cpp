@@ -0,0 +1,77 @@
+#include "PixelBufferPool.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstring>
+
+TEST(PixelBufferPoolTest, ReusesFreedBuffers)
+{
+	PixelBufferPool Pool;
+	const size_t SIZE = PIXEL_BUFFER_POOL_MIN_BUFFER_SIZE * 4;
+
+	void *FirstBuffer = Pool.Allocate(SIZE);
+	ASSERT_NE(FirstBuffer, nullptr);
+	EXPECT_EQ(reinterpret_cast<uintptr_t>(FirstBuffer) % 16, 0u);
+	Pool.Free(FirstBuffer);
+	EXPECT_EQ(Pool.GetFreeBuffersCount(), 1u);
+
+	// A smaller image fits in the pooled buffer, a larger one does not
+	void *SecondBuffer = Pool.Allocate(SIZE / 2);
+	EXPECT_EQ(SecondBuffer, FirstBuffer);
+	EXPECT_EQ(Pool.GetFreeBuffersCount(), 0u);
+	void *LargerBuffer = Pool.Allocate(SIZE * 2);
+	EXPECT_NE(LargerBuffer, FirstBuffer);
+
+	Pool.Free(SecondBuffer);
+	Pool.Free(LargerBuffer);
+	EXPECT_EQ(Pool.GetFreeBuffersCount(), 2u);
+}
+
+TEST(PixelBufferPoolTest, KeepsSmallBuffersOutOfThePool)
+{
+	PixelBufferPool Pool;
+	void *Buffer = Pool.Allocate(16);
+	ASSERT_NE(Buffer, nullptr);
+	Pool.Free(Buffer);
+	EXPECT_EQ(Pool.GetFreeBuffersCount(), 0u);
+}
+
+TEST(PixelBufferPoolTest, ReallocateKeepsContents)
+{
+	PixelBufferPool Pool;
+	unsigned char *Buffer = static_cast<unsigned char *>(Pool.Allocate(16));
+	ASSERT_NE(Buffer, nullptr);
+	std::memset(Buffer, 7, 16);
+
+	// Fits in the block already allocated, it is not moved
+	EXPECT_EQ(Pool.Reallocate(Buffer, 8), Buffer);
+
+	unsigned char *GrownBuffer = static_cast<unsigned char *>(Pool.Reallocate(Buffer, PIXEL_BUFFER_POOL_MIN_BUFFER_SIZE));
+	ASSERT_NE(GrownBuffer, nullptr);
+	for (size_t i = 0; i < 16; i++)
+	{
+		EXPECT_EQ(GrownBuffer[i], 7);
+	}
+	Pool.Free(GrownBuffer);
+}
+
+TEST(PixelBufferPoolTest, BoundsPooledBuffers)
+{
+	PixelBufferPool Pool;
+	void *Buffers[PIXEL_BUFFER_POOL_MAX_BUFFERS_COUNT + 1] = {};
+	for (size_t i = 0; i <= PIXEL_BUFFER_POOL_MAX_BUFFERS_COUNT; i++)
+	{
+		Buffers[i] = Pool.Allocate(PIXEL_BUFFER_POOL_MIN_BUFFER_SIZE + i);
+	}
+	for (void *Buffer : Buffers)
+	{
+		Pool.Free(Buffer);
+	}
+	EXPECT_EQ(Pool.GetFreeBuffersCount(), PIXEL_BUFFER_POOL_MAX_BUFFERS_COUNT);
+
+	// The smallest buffer was the one dropped
+	void *Buffer = Pool.Allocate(PIXEL_BUFFER_POOL_MIN_BUFFER_SIZE);
+	EXPECT_NE(Buffer, Buffers[0]);
+	Pool.Free(Buffer);
+}
@@ -0,0 +1,84 @@
+#include "TaskScheduler.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(TaskSchedulerTest, RunsEveryTaskAndNestedTask)
+{
+	TaskScheduler Scheduler(4);
+	std::atomic<int> RunCount = 0;
+	for (int i = 0; i < 100; i++)
+	{
+		Scheduler.Submit([&Scheduler, &RunCount]() {
+			RunCount++;
+			// NOTE: Pushed to the submitting worker's own deque, the other workers have to steal them
+			for (int j = 0; j < 10; j++)
+			{
+				Scheduler.Submit([&RunCount]() { RunCount++; });
+			}
+		});
+	}
+
+	Scheduler.WaitIdle();
+	EXPECT_EQ(RunCount.load(), 1100);
+}
+
+TEST(TaskSchedulerTest, RunsContinuationsAfterTheirTask)
+{
+	TaskScheduler Scheduler(2);
+	std::mutex Mutex;
+	std::vector<int> Order;
+	auto Record = [&Mutex, &Order](int Value) {
+		std::lock_guard<std::mutex> Lock(Mutex);
+		Order.push_back(Value);
+	};
+
+	TaskHandle First = Scheduler.Submit([&Record]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		Record(1);
+	});
+	TaskHandle Second = Scheduler.Then(First, [&Record]() { Record(2); });
+	TaskHandle Third = Scheduler.Then(Second, [&Record]() { Record(3); }, TaskPriority::High);
+	Third.Wait();
+	EXPECT_TRUE(First.IsDone());
+	EXPECT_EQ(Order, std::vector<int>({1, 2, 3}));
+
+	// Continuing an already done task submits it right away
+	TaskHandle Fourth = Scheduler.Then(First, [&Record]() { Record(4); });
+	Scheduler.WaitIdle();
+	EXPECT_TRUE(Fourth.IsDone());
+	EXPECT_EQ(Order.back(), 4);
+
+	// A default constructed handle refers to no task, continuing it submits right away
+	const TaskHandle INVALID_HANDLE;
+	EXPECT_FALSE(INVALID_HANDLE.IsValid());
+	EXPECT_TRUE(INVALID_HANDLE.IsDone());
+	INVALID_HANDLE.Wait();
+	Scheduler.Then(INVALID_HANDLE, [&Record]() { Record(5); }).Wait();
+	EXPECT_EQ(Order.back(), 5);
+}
+
+TEST(TaskSchedulerTest, RunsHigherPriorityFirst)
+{
+	TaskScheduler Scheduler(1);
+	std::atomic<bool> IsBlocked = true;
+	std::vector<TaskPriority> Order;
+
+	// Holds the only worker so every following task is queued before any runs
+	Scheduler.Submit([&IsBlocked]() {
+		while (IsBlocked)
+			std::this_thread::yield();
+	});
+	Scheduler.Submit([&Order]() { Order.push_back(TaskPriority::Low); }, TaskPriority::Low);
+	Scheduler.Submit([&Order]() { Order.push_back(TaskPriority::Normal); }, TaskPriority::Normal);
+	Scheduler.Submit([&Order]() { Order.push_back(TaskPriority::High); }, TaskPriority::High);
+	IsBlocked = false;
+
+	Scheduler.WaitIdle();
+	EXPECT_EQ(Order, std::vector<TaskPriority>({TaskPriority::High, TaskPriority::Normal, TaskPriority::Low}));
+}
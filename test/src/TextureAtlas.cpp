@@ -0,0 +1,103 @@
+#include "TextureAtlas.h"
+
+#include "FakeGl.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace
+{
+constexpr int TEXTURE_ATLAS_TEST_PAGE_SIZE = 256;
+constexpr int TEXTURE_ATLAS_TEST_IMAGE_SIZE = 60;
+
+// Adds images until a second page is needed, returns the regions packed into the first page
+std::vector<TextureRegion> FillFirstPage(TextureAtlas &Atlas, const std::vector<unsigned char> &Pixels)
+{
+	std::vector<TextureRegion> Regions;
+	while (Atlas.GetPagesCount() < 2)
+	{
+		TextureRegion Region;
+		EXPECT_TRUE(Atlas.Add(Pixels.data(), TEXTURE_ATLAS_TEST_IMAGE_SIZE, TEXTURE_ATLAS_TEST_IMAGE_SIZE, Region));
+		Regions.push_back(Region);
+	}
+	return Regions;
+}
+} // namespace
+
+TEST(TextureAtlasTest, ReusesSpaceOfRemovedImages)
+{
+	InstallFakeGl();
+	TextureAtlas Atlas(TEXTURE_ATLAS_TEST_PAGE_SIZE);
+	const std::vector<unsigned char> PIXELS(
+	    static_cast<size_t>(TEXTURE_ATLAS_TEST_IMAGE_SIZE) * TEXTURE_ATLAS_TEST_IMAGE_SIZE * 4, 0xFF);
+
+	std::vector<TextureRegion> Regions = FillFirstPage(Atlas, PIXELS);
+	ASSERT_GE(Regions.size(), 2u);
+	EXPECT_EQ(Atlas.GetUsedBytes(), 2u * TEXTURE_ATLAS_TEST_PAGE_SIZE * TEXTURE_ATLAS_TEST_PAGE_SIZE * 4);
+
+	// The second page only holds the last image, removing it destroys the page
+	Atlas.Remove(Regions.back());
+	Regions.pop_back();
+	EXPECT_EQ(Atlas.GetPagesCount(), 1u);
+	EXPECT_EQ(GetFakeGlState().LiveTexturesCount, 1u);
+
+	// The removed image is cleared and its space is used by the next image instead of a new page
+	const TextureRegion REMOVED_REGION = Regions[Regions.size() / 2];
+	Atlas.Remove(REMOVED_REGION);
+	const FakeGlUpload CLEAR_UPLOAD = GetFakeGlState().Uploads.back();
+	EXPECT_EQ(CLEAR_UPLOAD.TextureID, REMOVED_REGION.TextureID);
+	EXPECT_EQ(CLEAR_UPLOAD.Width, TEXTURE_ATLAS_TEST_IMAGE_SIZE);
+	EXPECT_EQ(CLEAR_UPLOAD.Height, TEXTURE_ATLAS_TEST_IMAGE_SIZE);
+
+	TextureRegion Region;
+	ASSERT_TRUE(Atlas.Add(PIXELS.data(), TEXTURE_ATLAS_TEST_IMAGE_SIZE, TEXTURE_ATLAS_TEST_IMAGE_SIZE, Region));
+	EXPECT_EQ(Atlas.GetPagesCount(), 1u);
+	EXPECT_EQ(Region.TextureID, REMOVED_REGION.TextureID);
+	EXPECT_FLOAT_EQ(Region.UvMin.X, REMOVED_REGION.UvMin.X);
+	EXPECT_FLOAT_EQ(Region.UvMin.Y, REMOVED_REGION.UvMin.Y);
+
+	// Smaller images fit in the freed space of a bigger one
+	Atlas.Remove(Region);
+	TextureRegion SmallRegion;
+	ASSERT_TRUE(Atlas.Add(PIXELS.data(), 20, 20, SmallRegion));
+	EXPECT_EQ(Atlas.GetPagesCount(), 1u);
+	EXPECT_EQ(SmallRegion.TextureID, REMOVED_REGION.TextureID);
+
+	Atlas.Destroy();
+	EXPECT_EQ(Atlas.GetPagesCount(), 0u);
+	EXPECT_EQ(GetFakeGlState().LiveTexturesCount, 0u);
+}
+
+TEST(TextureAtlasTest, PacksImagesTightly)
+{
+	InstallFakeGl();
+	TextureAtlas Atlas(TEXTURE_ATLAS_TEST_PAGE_SIZE);
+	const std::vector<unsigned char> PIXELS(static_cast<size_t>(30) * 30 * 4, 0xFF);
+
+	// Padded images tile the whole page
+	const int IMAGES_COUNT = (TEXTURE_ATLAS_TEST_PAGE_SIZE / 32) * (TEXTURE_ATLAS_TEST_PAGE_SIZE / 32);
+	for (int i = 0; i < IMAGES_COUNT; i++)
+	{
+		TextureRegion Region;
+		ASSERT_TRUE(Atlas.Add(PIXELS.data(), 30, 30, Region));
+	}
+	EXPECT_EQ(Atlas.GetPagesCount(), 1u);
+
+	TextureRegion Region;
+	ASSERT_TRUE(Atlas.Add(PIXELS.data(), 30, 30, Region));
+	EXPECT_EQ(Atlas.GetPagesCount(), 2u);
+}
+
+TEST(TextureAtlasTest, RejectsImagesBiggerThanPage)
+{
+	InstallFakeGl();
+	TextureAtlas Atlas(TEXTURE_ATLAS_TEST_PAGE_SIZE);
+	const std::vector<unsigned char> PIXELS(static_cast<size_t>(TEXTURE_ATLAS_TEST_PAGE_SIZE) * 4, 0xFF);
+
+	TextureRegion Region;
+	EXPECT_FALSE(Atlas.Add(PIXELS.data(), TEXTURE_ATLAS_TEST_PAGE_SIZE, 1, Region));
+	EXPECT_FALSE(Atlas.Add(PIXELS.data(), 0, 1, Region));
+	EXPECT_EQ(Atlas.GetPagesCount(), 0u);
+	EXPECT_EQ(Atlas.GetUsedBytes(), 0u);
+}
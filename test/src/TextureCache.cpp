@@ -0,0 +1,151 @@
+#include "TextureCache.h"
+
+#include "FakeGl.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const std::vector<std::string> TEXTURE_CACHE_TEST_FILE_PATHS = {"./TextureCacheTestA.ppm", "./TextureCacheTestB.ppm",
+                                                                "./TextureCacheTestC.ppm"};
+// NOTE: Wider than the atlas accepts so every image gets its own texture of a known size
+constexpr int TEXTURE_CACHE_TEST_IMAGE_WIDTH = TEXTURE_ATLAS_MAX_IMAGE_SIZE + 44;
+constexpr int TEXTURE_CACHE_TEST_IMAGE_HEIGHT = 2;
+constexpr size_t TEXTURE_CACHE_TEST_IMAGE_BYTES =
+    static_cast<size_t>(TEXTURE_CACHE_TEST_IMAGE_WIDTH) * TEXTURE_CACHE_TEST_IMAGE_HEIGHT * TEXTURE_LOADER_CHANNELS_COUNT;
+
+const std::string TEXTURE_CACHE_TEST_REMOTE_URL = "https://example.com/avatar.ppm";
+const std::string TEXTURE_CACHE_TEST_MISSING_URL = "https://example.com/missing.ppm";
+
+std::vector<unsigned char> MakeImage()
+{
+	const std::string HEADER = "P6\n" + std::to_string(TEXTURE_CACHE_TEST_IMAGE_WIDTH) + " " +
+	                           std::to_string(TEXTURE_CACHE_TEST_IMAGE_HEIGHT) + "\n255\n";
+	std::vector<unsigned char> Image(HEADER.begin(), HEADER.end());
+	Image.resize(Image.size() + TEXTURE_CACHE_TEST_IMAGE_BYTES / TEXTURE_LOADER_CHANNELS_COUNT * 3, 0x7F);
+	return Image;
+}
+
+void WriteImages()
+{
+	const std::vector<unsigned char> IMAGE = MakeImage();
+	for (const std::string &FilePath : TEXTURE_CACHE_TEST_FILE_PATHS)
+	{
+		FILE *File = std::fopen(FilePath.c_str(), "wb");
+		std::fwrite(IMAGE.data(), 1, IMAGE.size(), File);
+		std::fclose(File);
+	}
+}
+
+void RemoveImages()
+{
+	for (const std::string &FilePath : TEXTURE_CACHE_TEST_FILE_PATHS)
+	{
+		std::remove(FilePath.c_str());
+	}
+}
+
+bool WaitUntilUsedBytes(TextureCache &Cache, size_t UsedBytes)
+{
+	for (int i = 0; i < 1000; i++)
+	{
+		Cache.Upload(1.0);
+		if (Cache.GetUsedBytes() == UsedBytes)
+			return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+} // namespace
+
+TEST(TextureCacheTest, EvictsLeastRecentlyDrawnOverBudget)
+{
+	InstallFakeGl();
+	WriteImages();
+	TextureCache Cache(TEXTURE_CACHE_TEST_IMAGE_BYTES * 2 + TEXTURE_CACHE_TEST_IMAGE_BYTES / 2, 1);
+	const TextureRegion PLACEHOLDER_REGION;
+
+	for (const std::string &FilePath : TEXTURE_CACHE_TEST_FILE_PATHS)
+	{
+		EXPECT_EQ(Cache.Get(FilePath, PLACEHOLDER_REGION).TextureID, 0u);
+	}
+	ASSERT_TRUE(WaitUntilUsedBytes(Cache, TEXTURE_CACHE_TEST_IMAGE_BYTES * 3));
+
+	// Everything was drawn this frame, nothing is evicted even over budget
+	Cache.Trim();
+	EXPECT_EQ(Cache.GetSize(), 3u);
+
+	// B is the least recently drawn
+	EXPECT_NE(Cache.Get(TEXTURE_CACHE_TEST_FILE_PATHS[0], PLACEHOLDER_REGION).TextureID, 0u);
+	EXPECT_NE(Cache.Get(TEXTURE_CACHE_TEST_FILE_PATHS[2], PLACEHOLDER_REGION).TextureID, 0u);
+	Cache.Trim();
+	EXPECT_EQ(Cache.GetSize(), 2u);
+	EXPECT_EQ(Cache.GetUsedBytes(), TEXTURE_CACHE_TEST_IMAGE_BYTES * 2);
+	EXPECT_EQ(GetFakeGlState().LiveTexturesCount, 2u);
+
+	// Within budget nothing else is evicted, B is loaded again on its next draw
+	Cache.Trim();
+	EXPECT_EQ(Cache.GetSize(), 2u);
+	EXPECT_NE(Cache.Get(TEXTURE_CACHE_TEST_FILE_PATHS[2], PLACEHOLDER_REGION).TextureID, 0u);
+	EXPECT_EQ(Cache.Get(TEXTURE_CACHE_TEST_FILE_PATHS[1], PLACEHOLDER_REGION).TextureID, 0u);
+	EXPECT_EQ(Cache.GetSize(), 3u);
+
+	Cache.Destroy();
+	EXPECT_EQ(GetFakeGlState().LiveTexturesCount, 0u);
+	RemoveImages();
+}
+
+TEST(TextureCacheTest, FetchesUrlsAndKeepsFailures)
+{
+	InstallFakeGl();
+	std::atomic<int> FetchesCount = 0;
+	TextureCache Cache(TEXTURE_CACHE_DEFAULT_BUDGET_BYTES, 1,
+	                   [&FetchesCount](const std::string &Url, std::vector<unsigned char> &Bytes) {
+		                   FetchesCount++;
+		                   if (Url != TEXTURE_CACHE_TEST_REMOTE_URL)
+			                   return false;
+		                   Bytes = MakeImage();
+		                   return true;
+	                   });
+	const TextureRegion PLACEHOLDER_REGION;
+
+	// NOTE: A single worker fetches in order, the missing image has failed once the other one is uploaded
+	EXPECT_EQ(Cache.Get(TEXTURE_CACHE_TEST_MISSING_URL, PLACEHOLDER_REGION).TextureID, 0u);
+	EXPECT_EQ(Cache.Get(TEXTURE_CACHE_TEST_REMOTE_URL, PLACEHOLDER_REGION).TextureID, 0u);
+	ASSERT_TRUE(WaitUntilUsedBytes(Cache, TEXTURE_CACHE_TEST_IMAGE_BYTES));
+	EXPECT_NE(Cache.Get(TEXTURE_CACHE_TEST_REMOTE_URL, PLACEHOLDER_REGION).TextureID, 0u);
+
+	// The failure is cached, drawn or not, until its retry delay is spent
+	for (int Frame = 0; Frame < 3; Frame++)
+	{
+		EXPECT_EQ(Cache.Get(TEXTURE_CACHE_TEST_MISSING_URL, PLACEHOLDER_REGION).TextureID, 0u);
+		Cache.Trim();
+		Cache.Trim();
+	}
+	EXPECT_EQ(Cache.GetSize(), 2u);
+	EXPECT_EQ(FetchesCount, 2);
+
+	Cache.Destroy();
+}
+
+TEST(TextureCacheTest, ReadsFileUrlsByDefault)
+{
+	InstallFakeGl();
+	WriteImages();
+	TextureCache Cache(TEXTURE_CACHE_DEFAULT_BUDGET_BYTES, 1);
+	const TextureRegion PLACEHOLDER_REGION;
+
+	EXPECT_EQ(Cache.Get("file://" + TEXTURE_CACHE_TEST_FILE_PATHS[0], PLACEHOLDER_REGION).TextureID, 0u);
+	ASSERT_TRUE(WaitUntilUsedBytes(Cache, TEXTURE_CACHE_TEST_IMAGE_BYTES));
+	EXPECT_NE(Cache.Get("file://" + TEXTURE_CACHE_TEST_FILE_PATHS[0], PLACEHOLDER_REGION).TextureID, 0u);
+
+	Cache.Destroy();
+	RemoveImages();
+}
@@ -0,0 +1,153 @@
+#include "TextureLoader.h"
+
+#include "FakeGl.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const std::string TEXTURE_LOADER_TEST_FIRST_FILE_PATH = "./TextureLoaderTestFirst.ppm";
+const std::string TEXTURE_LOADER_TEST_SECOND_FILE_PATH = "./TextureLoaderTestSecond.ppm";
+// NOTE: Big enough for the RGBA pixels to be pooled, stb decodes binary PPM files without any other format enabled
+constexpr int TEXTURE_LOADER_TEST_IMAGE_SIZE = 130;
+
+void WriteImage(const std::string &FilePath, int Width, int Height)
+{
+	const std::string HEADER = "P6\n" + std::to_string(Width) + " " + std::to_string(Height) + "\n255\n";
+	const std::vector<unsigned char> PIXELS(static_cast<size_t>(Width) * static_cast<size_t>(Height) * 3, 0x7F);
+
+	FILE *File = std::fopen(FilePath.c_str(), "wb");
+	std::fwrite(HEADER.data(), 1, HEADER.size(), File);
+	std::fwrite(PIXELS.data(), 1, PIXELS.size(), File);
+	std::fclose(File);
+}
+
+void RemoveImages()
+{
+	std::remove(TEXTURE_LOADER_TEST_FIRST_FILE_PATH.c_str());
+	std::remove(TEXTURE_LOADER_TEST_SECOND_FILE_PATH.c_str());
+}
+
+bool WaitUntilUploaded(TextureLoader &Loader, TextureRequestID ID)
+{
+	for (int i = 0; i < 1000; i++)
+	{
+		Loader.Upload(1.0);
+		if (Loader.GetState(ID) != TextureRequestState::Decoding)
+			return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+} // namespace
+
+TEST(TextureLoaderTest, UploadsFromPooledBuffer)
+{
+	InstallFakeGl();
+	WriteImage(TEXTURE_LOADER_TEST_FIRST_FILE_PATH, TEXTURE_LOADER_TEST_IMAGE_SIZE, TEXTURE_LOADER_TEST_IMAGE_SIZE);
+	WriteImage(TEXTURE_LOADER_TEST_SECOND_FILE_PATH, TEXTURE_LOADER_TEST_IMAGE_SIZE, TEXTURE_LOADER_TEST_IMAGE_SIZE);
+	TextureLoader Loader(1);
+
+	const TextureRequestID FIRST_ID = Loader.Request(TEXTURE_LOADER_TEST_FIRST_FILE_PATH);
+	EXPECT_EQ(Loader.Request(TEXTURE_LOADER_TEST_FIRST_FILE_PATH), FIRST_ID);
+	ASSERT_TRUE(WaitUntilUploaded(Loader, FIRST_ID));
+	ASSERT_EQ(Loader.GetState(FIRST_ID), TextureRequestState::Ready);
+	ASSERT_EQ(GetFakeGlState().Uploads.size(), 1u);
+	EXPECT_EQ(GetFakeGlState().Uploads[0].Width, TEXTURE_LOADER_TEST_IMAGE_SIZE);
+	EXPECT_EQ(GetFakeGlState().Uploads[0].Height, TEXTURE_LOADER_TEST_IMAGE_SIZE);
+	EXPECT_NE(Loader.GetTextureID(FIRST_ID, 0), 0u);
+	EXPECT_EQ(Loader.GetUsedBytes(), static_cast<size_t>(TEXTURE_LOADER_TEST_IMAGE_SIZE) *
+	                                     TEXTURE_LOADER_TEST_IMAGE_SIZE * TEXTURE_LOADER_CHANNELS_COUNT);
+
+	// The next image of the same size is decoded into the buffer the first one was uploaded from
+	const TextureRequestID SECOND_ID = Loader.Request(TEXTURE_LOADER_TEST_SECOND_FILE_PATH);
+	ASSERT_TRUE(WaitUntilUploaded(Loader, SECOND_ID));
+	ASSERT_EQ(GetFakeGlState().Uploads.size(), 2u);
+	EXPECT_EQ(GetFakeGlState().Uploads[1].Pixels, GetFakeGlState().Uploads[0].Pixels);
+
+	EXPECT_TRUE(Loader.Release(FIRST_ID));
+	EXPECT_EQ(Loader.GetState(FIRST_ID), TextureRequestState::Released);
+	Loader.Destroy();
+	EXPECT_EQ(GetFakeGlState().LiveTexturesCount, 0u);
+	RemoveImages();
+}
+
+TEST(TextureLoaderTest, FailsMissingFile)
+{
+	InstallFakeGl();
+	RemoveImages();
+	TextureLoader Loader(1);
+
+	const TextureRequestID ID = Loader.Request(TEXTURE_LOADER_TEST_FIRST_FILE_PATH);
+	ASSERT_TRUE(WaitUntilUploaded(Loader, ID));
+	EXPECT_EQ(Loader.GetState(ID), TextureRequestState::Failed);
+	EXPECT_EQ(Loader.GetTextureID(ID, 42), 42u);
+	EXPECT_EQ(Loader.GetFailedCount(), 1u);
+	EXPECT_TRUE(GetFakeGlState().Uploads.empty());
+
+	EXPECT_TRUE(Loader.Release(ID));
+	EXPECT_EQ(Loader.GetFailedCount(), 0u);
+}
+
+TEST(TextureLoaderTest, DropsImagesDecodedBeforeDestroy)
+{
+	InstallFakeGl();
+	WriteImage(TEXTURE_LOADER_TEST_FIRST_FILE_PATH, TEXTURE_LOADER_TEST_IMAGE_SIZE, TEXTURE_LOADER_TEST_IMAGE_SIZE);
+	TextureLoader Loader(1);
+	std::atomic<int> DecodedCount = 0;
+	Loader.SetOnDecoded([&DecodedCount]() { DecodedCount++; });
+
+	Loader.Request(TEXTURE_LOADER_TEST_FIRST_FILE_PATH);
+	for (int i = 0; i < 1000 && DecodedCount == 0; i++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	ASSERT_EQ(DecodedCount, 1);
+
+	// The decoded image belongs to a request that no longer exists
+	Loader.Destroy();
+	EXPECT_FALSE(Loader.Upload(1.0));
+	EXPECT_TRUE(GetFakeGlState().Uploads.empty());
+
+	const TextureRequestID ID = Loader.Request(TEXTURE_LOADER_TEST_FIRST_FILE_PATH);
+	ASSERT_TRUE(WaitUntilUploaded(Loader, ID));
+	EXPECT_EQ(Loader.GetState(ID), TextureRequestState::Ready);
+	EXPECT_EQ(GetFakeGlState().Uploads.size(), 1u);
+
+	Loader.Destroy();
+	RemoveImages();
+}
+
+TEST(TextureLoaderTest, PacksSmallImagesIntoAtlas)
+{
+	InstallFakeGl();
+	WriteImage(TEXTURE_LOADER_TEST_FIRST_FILE_PATH, TEXTURE_LOADER_TEST_IMAGE_SIZE, TEXTURE_LOADER_TEST_IMAGE_SIZE);
+	TextureAtlas Atlas(512);
+	TextureLoader Loader(1);
+	Loader.SetAtlas(&Atlas);
+
+	const TextureRequestID ID = Loader.Request(TEXTURE_LOADER_TEST_FIRST_FILE_PATH);
+	ASSERT_TRUE(WaitUntilUploaded(Loader, ID));
+	ASSERT_EQ(Loader.GetState(ID), TextureRequestState::Ready);
+	EXPECT_EQ(Atlas.GetPagesCount(), 1u);
+	EXPECT_EQ(Loader.GetUsedBytes(), Atlas.GetUsedBytes());
+
+	const TextureRegion REGION = Loader.GetTextureRegion(ID, TextureRegion());
+	EXPECT_NE(REGION.TextureID, 0u);
+	EXPECT_LT(REGION.UvMax.X, 1.0f);
+	EXPECT_LT(REGION.UvMax.Y, 1.0f);
+
+	// The page is destroyed with its last image
+	EXPECT_TRUE(Loader.Release(ID));
+	EXPECT_EQ(Atlas.GetPagesCount(), 0u);
+	EXPECT_EQ(Loader.GetUsedBytes(), 0u);
+	EXPECT_EQ(GetFakeGlState().LiveTexturesCount, 0u);
+	RemoveImages();
+}
@@ -0,0 +1,125 @@
+#include "Utf8.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+const Utf8Kernel KERNELS[] = {Utf8Kernel::Scalar, Utf8Kernel::Sse2, Utf8Kernel::Avx2};
+
+// NOTE: Pads with ASCII on both sides so sequences land at every position of the SIMD blocks
+std::string PadToOffset(const std::string &Text, size_t Offset)
+{
+	return std::string(Offset, 'a') + Text + std::string(40, 'b');
+}
+} // namespace
+
+TEST(Utf8Test, AcceptsValidText)
+{
+	const std::vector<std::string> VALID_TEXTS = {
+	    "",
+	    "Hello",
+	    "caf\xC3\xA9",
+	    "\xE2\x82\xAC 10",
+	    "\xED\x9F\xBF",
+	    "\xEE\x80\x80",
+	    "\xF0\x9F\x98\x80",
+	    "\xF4\x8F\xBF\xBF",
+	    "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E",
+	};
+
+	for (const Utf8Kernel KERNEL : KERNELS)
+	{
+		if (!IsUtf8KernelSupported(KERNEL))
+			continue;
+
+		for (const std::string &VALID_TEXT : VALID_TEXTS)
+		{
+			for (size_t Offset = 0; Offset < 64; Offset++)
+			{
+				EXPECT_TRUE(IsValidUtf8(PadToOffset(VALID_TEXT, Offset), KERNEL));
+			}
+			EXPECT_TRUE(IsValidUtf8(VALID_TEXT, KERNEL));
+		}
+	}
+}
+
+TEST(Utf8Test, RejectsMalformedText)
+{
+	const std::vector<std::string> INVALID_TEXTS = {
+	    "\x80",             // Stray continuation
+	    "\xC3",             // Truncated 2 byte sequence
+	    "\xC3\x28",         // Lead followed by ASCII
+	    "\xC0\xAF",         // Overlong 2 byte sequence
+	    "\xC1\xBF",         // Overlong 2 byte sequence
+	    "\xE0\x80\xAF",     // Overlong 3 byte sequence
+	    "\xE2\x82",         // Truncated 3 byte sequence
+	    "\xED\xA0\x80",     // Surrogate
+	    "\xF0\x80\x80\xAF", // Overlong 4 byte sequence
+	    "\xF4\x90\x80\x80", // Past U+10FFFF
+	    "\xF5\x80\x80\x80", // Invalid lead
+	    "\xF0\x9F\x98",     // Truncated 4 byte sequence
+	    "\xC3\xA9\xA9",     // Too many continuations
+	    "\xFF",
+	};
+
+	for (const Utf8Kernel KERNEL : KERNELS)
+	{
+		if (!IsUtf8KernelSupported(KERNEL))
+			continue;
+
+		for (const std::string &INVALID_TEXT : INVALID_TEXTS)
+		{
+			for (size_t Offset = 0; Offset < 64; Offset++)
+			{
+				EXPECT_FALSE(IsValidUtf8(PadToOffset(INVALID_TEXT, Offset), KERNEL));
+			}
+			// Also at the very end of the input, where the SIMD kernels check incomplete sequences
+			EXPECT_FALSE(IsValidUtf8(std::string(37, 'a') + INVALID_TEXT, KERNEL));
+		}
+	}
+}
+
+TEST(Utf8Test, KernelsAgreeOnRandomText)
+{
+	// NOTE: Mostly valid characters with occasional random bytes, so errors are rare enough for valid runs to happen
+	const std::vector<std::string> PIECES = {"a", "Z ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xED\x9F\xBF"};
+	std::mt19937 Random(1234);
+
+	for (int i = 0; i < 2000; i++)
+	{
+		std::string Text;
+		const size_t PIECES_COUNT = Random() % 80;
+		for (size_t j = 0; j < PIECES_COUNT; j++)
+		{
+			if (Random() % 64 == 0)
+				Text += static_cast<char>(Random() & 0xFF);
+			else
+				Text += PIECES[Random() % PIECES.size()];
+		}
+
+		const bool IS_VALID = IsValidUtf8(Text, Utf8Kernel::Scalar);
+		for (const Utf8Kernel KERNEL : KERNELS)
+		{
+			if (IsUtf8KernelSupported(KERNEL))
+			{
+				EXPECT_EQ(IsValidUtf8(Text, KERNEL), IS_VALID);
+			}
+		}
+	}
+}
+
+TEST(Utf8Test, SanitizeReplacesInvalidBytes)
+{
+	std::string Valid = "caf\xC3\xA9";
+	EXPECT_FALSE(SanitizeUtf8(Valid));
+	EXPECT_EQ(Valid, "caf\xC3\xA9");
+
+	std::string Invalid = "a\xC3(b\xED\xA0\x80";
+	EXPECT_TRUE(SanitizeUtf8(Invalid));
+	EXPECT_EQ(Invalid, "a\xEF\xBF\xBD(b\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD");
+	EXPECT_TRUE(IsValidUtf8(Invalid));
+}